@@ -4,8 +4,10 @@
 #include "../cont/elementType.hpp"
 #include "generateAdjacent.hpp"
 #include "../func.hpp"
+#include "../concurrency/ThreadList.hpp"
 #include <vector>
 #include <algorithm>
+#include <thread>
 
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(alg) {
 
@@ -27,6 +29,62 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(alg) {
         return indexMapNewToOld;
     }
 
+    // Like computeSortIndexesBySizeAndPred(), but sort is stable (i.e. indexes of equal elements are in ascending order) and done
+    // using nThreadCount threads: index ranges are sorted concurrently after which they are merged pairwise, also concurrently.
+    // If nThreadCount is 0, uses std::thread::hardware_concurrency().
+    // Note: pred gets called concurrently from multiple threads.
+    template <class Index_T = size_t, class Pred_T>
+    std::vector<Index_T> computeSortIndexesBySizeAndPredParallel(const size_t nMaxIndex, Pred_T&& pred, size_t nThreadCount = 0)
+    {
+        if (nThreadCount == 0)
+            nThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        nThreadCount = (std::max)(size_t(1), (std::min)(nThreadCount, nMaxIndex / 1024)); // Not using threads for small inputs.
+
+        std::vector<Index_T> indexes(nMaxIndex);
+        generateAdjacent(indexes, Index_T(0), Index_T(1));
+        const auto indexPred = [&](const Index_T a, const Index_T b) { return pred(a, b); };
+
+        // Range boundaries: range i is [bounds[i], bounds[i + 1]).
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i < nThreadCount; ++i)
+            bounds.push_back(i * nMaxIndex / nThreadCount);
+        bounds.push_back(nMaxIndex);
+
+        const auto forEachRangeConcurrently = [](const size_t nRangeCount, auto&& func)
+        {
+            ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+            for (size_t i = 1; i < nRangeCount; ++i)
+                threads.push_back(std::thread([&, i]() { func(i); }));
+            func(0);
+        };
+
+        forEachRangeConcurrently(bounds.size() - 1, [&](const size_t i)
+        {
+            std::stable_sort(indexes.begin() + bounds[i], indexes.begin() + bounds[i + 1], indexPred);
+        });
+
+        std::vector<Index_T> buffer(nMaxIndex);
+        while (bounds.size() > 2)
+        {
+            std::vector<size_t> newBounds;
+            for (size_t i = 0; i < bounds.size(); i += 2)
+                newBounds.push_back(bounds[i]);
+            if (newBounds.back() != nMaxIndex)
+                newBounds.push_back(nMaxIndex);
+            forEachRangeConcurrently(newBounds.size() - 1, [&](const size_t i)
+            {
+                const auto nFirst = bounds[2 * i];
+                const auto nMiddle = bounds[2 * i + 1];
+                const auto nLast = (2 * i + 2 < bounds.size()) ? bounds[2 * i + 2] : nMiddle;
+                // std::merge takes elements from the first range on ties so merged result remains stable.
+                std::merge(indexes.begin() + nFirst, indexes.begin() + nMiddle, indexes.begin() + nMiddle, indexes.begin() + nLast, buffer.begin() + nFirst, indexPred);
+            });
+            indexes.swap(buffer);
+            bounds.swap(newBounds);
+        }
+        return indexes;
+    }
+
     // For given iterable, returns a list of indexes that define the order of elements in sortSeq if it was sorted using predicate pred.
     // For example if sortSeq = {2.5, 3.1, 1.2} and pred is 'less than', returned list will be {2, 0, 1} which corresponds to sequence {1.2, 2.5, 3.1}.
     template <class T, class Pred_T>
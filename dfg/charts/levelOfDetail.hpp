@@ -0,0 +1,322 @@
+#pragma once
+
+#include "../dfgDefs.hpp"
+#include "../dfgBaseTypedefs.hpp"
+#include "../dfgAssert.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Level-of-detail tools for rendering large xy-series: min/max-per-bucket ("M4") downsampling and a multi-resolution pyramid
+// from which downsampled data can be taken without scanning through all points.
+
+DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(charts) {
+
+namespace DFG_DETAIL_NS
+{
+    // Collects indexes of first, minimum, maximum and last point of a contiguous sequence of points.
+    // If sequence contains NaN-values, index of first NaN is collected as well so that gaps remain visible.
+    // Note: when there are multiple min/max values, the first one is collected.
+    class MinMaxIndexCollector
+    {
+    public:
+        bool isEmpty() const { return m_nFirst == s_invalidIndex; }
+
+        void clear() { m_nFirst = s_invalidIndex; m_nFirstNaN = s_invalidIndex; }
+
+        void operator()(const size_t nIndex, const double y)
+        {
+            if (isEmpty())
+            {
+                m_nFirst = nIndex;
+                m_nMin = (std::isnan(y)) ? s_invalidIndex : nIndex;
+                m_nMax = m_nMin;
+                m_minValue = y;
+                m_maxValue = y;
+            }
+            if (std::isnan(y))
+            {
+                if (m_nFirstNaN == s_invalidIndex)
+                    m_nFirstNaN = nIndex;
+            }
+            else if (m_nMin == s_invalidIndex)
+            {
+                m_nMin = nIndex;
+                m_nMax = nIndex;
+                m_minValue = y;
+                m_maxValue = y;
+            }
+            else if (y < m_minValue)
+            {
+                m_nMin = nIndex;
+                m_minValue = y;
+            }
+            else if (y > m_maxValue)
+            {
+                m_nMax = nIndex;
+                m_maxValue = y;
+            }
+            m_nLast = nIndex;
+        }
+
+        // Calls func(index) for collected indexes in increasing order without duplicates and clears collector.
+        // Returns the number of func-calls.
+        template <class Func_T>
+        size_t flush(Func_T&& func)
+        {
+            if (isEmpty())
+                return 0;
+            size_t indexes[] = { m_nFirst, m_nMin, m_nMax, m_nLast, m_nFirstNaN };
+            std::sort(std::begin(indexes), std::end(indexes));
+            size_t nCallCount = 0;
+            for (size_t i = 0; i < DFG_COUNTOF(indexes) && indexes[i] != s_invalidIndex; ++i)
+            {
+                if (i > 0 && indexes[i] == indexes[i - 1])
+                    continue;
+                func(indexes[i]);
+                ++nCallCount;
+            }
+            clear();
+            return nCallCount;
+        }
+
+        static constexpr size_t s_invalidIndex = size_t(-1);
+        size_t m_nFirst = s_invalidIndex;
+        size_t m_nMin = s_invalidIndex;
+        size_t m_nMax = s_invalidIndex;
+        size_t m_nLast = s_invalidIndex;
+        size_t m_nFirstNaN = s_invalidIndex;
+        double m_minValue = 0;
+        double m_maxValue = 0;
+    }; // class MinMaxIndexCollector
+
+    // Helper for feeding indexes to MinMaxIndexCollector bucket by bucket.
+    template <class BucketOf_T, class YAt_T, class Output_T>
+    class MinMaxPerBucketSampler
+    {
+    public:
+        MinMaxPerBucketSampler(BucketOf_T& bucketOf, YAt_T& yAt, Output_T& output)
+            : m_bucketOf(bucketOf)
+            , m_yAt(yAt)
+            , m_output(output)
+        {}
+
+        void operator()(const size_t nIndex)
+        {
+            const int64 nBucket = m_bucketOf(nIndex);
+            if (!m_collector.isEmpty() && nBucket != m_nCurrentBucket)
+                m_nOutputCount += m_collector.flush(m_output);
+            m_nCurrentBucket = nBucket;
+            m_collector(nIndex, m_yAt(nIndex));
+        }
+
+        size_t finish()
+        {
+            m_nOutputCount += m_collector.flush(m_output);
+            return m_nOutputCount;
+        }
+
+        BucketOf_T& m_bucketOf;
+        YAt_T& m_yAt;
+        Output_T& m_output;
+        MinMaxIndexCollector m_collector;
+        int64 m_nCurrentBucket = 0;
+        size_t m_nOutputCount = 0;
+    }; // class MinMaxPerBucketSampler
+} // namespace DFG_DETAIL_NS
+
+// Min/max-per-bucket downsampling of points [nBegin, nEnd) that are in x-sorted order.
+//  -bucketOf(i) returns bucket (e.g. pixel column) of point i as int64; must be monotonic in i.
+//  -yAt(i) returns y-value of point i
+//  -output(i) gets called for every index that is kept, in increasing order.
+// For every bucket keeps the first, min, max and last point (and first NaN, if any) so when buckets are pixel columns,
+// lines and steps drawn through the kept points look the same as when drawn through all points.
+// Returns the number of output()-calls.
+template <class BucketOf_T, class YAt_T, class Output_T>
+size_t minMaxPerBucketDownsample(const size_t nBegin, const size_t nEnd, BucketOf_T&& bucketOf, YAt_T&& yAt, Output_T&& output)
+{
+    DFG_DETAIL_NS::MinMaxPerBucketSampler<BucketOf_T, YAt_T, Output_T> sampler(bucketOf, yAt, output);
+    for (size_t i = nBegin; i < nEnd; ++i)
+        sampler(i);
+    return sampler.finish();
+}
+
+// Multi-resolution pyramid of min/max-reduced point indexes for x-sorted data.
+//  -Level 0 is the raw data itself and is not stored.
+//  -Level 1 has min/max-reduction of every group of 16 raw points, each following level reduces groups of 4 groups of previous level;
+//   i.e. group of level L covers 4^(L+1) raw points and level sizes decrease roughly by factor 4.
+// Since a group keeps its first, min, max and last point, downsample() can produce exactly the same result as
+// minMaxPerBucketDownsample() over raw data while reading only a fraction of the points: groups that lie within a single bucket
+// are taken as such from coarse level and only groups that straddle bucket boundaries are opened from finer levels.
+class LevelOfDetailPyramid
+{
+public:
+    static constexpr size_t s_nFirstLevelGroupSize = 16;
+    static constexpr size_t s_nGroupsPerGroup = 4;
+
+    // Builds pyramid for nCount points, yAt(i) must return y-value of point i.
+    template <class YAt_T>
+    void build(size_t nCount, YAt_T&& yAt);
+
+    // Returns the number of points in raw data.
+    size_t size() const { return m_nSize; }
+
+    // Returns the number of levels including raw level 0.
+    size_t levelCount() const { return m_levels.size() + 1; }
+
+    // Returns the number of indexes stored in given level, for level 0 returns size().
+    size_t levelSize(const size_t nLevel) const;
+
+    // Returns the number of raw points covered by one group of given level, for level 0 returns 1.
+    static size_t rawPointsPerGroup(const size_t nLevel);
+
+    // Min/max-per-bucket downsampling of raw points [nBegin, nEnd). nBucketCount is the approximate number of distinct buckets
+    // within the range and is used for selecting the level to start from. Other arguments and return value are as in minMaxPerBucketDownsample().
+    template <class BucketOf_T, class YAt_T, class Output_T>
+    size_t downsample(size_t nBegin, size_t nEnd, size_t nBucketCount, BucketOf_T&& bucketOf, YAt_T&& yAt, Output_T&& output) const;
+
+    void clear() { m_levels.clear(); m_nSize = 0; }
+
+private:
+    struct Level
+    {
+        size_t groupCount() const { return (!m_groupStarts.empty()) ? m_groupStarts.size() - 1 : 0; }
+
+        std::vector<size_t> m_indexes;      // Raw indexes of kept points in increasing order.
+        std::vector<size_t> m_groupStarts;  // Group g has indexes [m_groupStarts[g], m_groupStarts[g + 1]).
+    };
+
+    const Level& level(const size_t nLevel) const { DFG_ASSERT_UB(nLevel >= 1 && nLevel <= m_levels.size()); return m_levels[nLevel - 1]; }
+
+    size_t groupCount(const size_t nLevel) const { return (nLevel == 0) ? m_nSize : level(nLevel).groupCount(); }
+
+    template <class Sampler_T>
+    void sampleGroup(size_t nLevel, size_t nGroup, size_t nBegin, size_t nEnd, Sampler_T& sampler) const;
+
+    std::vector<Level> m_levels; // Levels starting from level 1.
+    size_t m_nSize = 0;
+}; // class LevelOfDetailPyramid
+
+template <class YAt_T>
+void LevelOfDetailPyramid::build(const size_t nCount, YAt_T&& yAt)
+{
+    clear();
+    m_nSize = nCount;
+    DFG_DETAIL_NS::MinMaxIndexCollector collector;
+    const auto pushIndex = [&](const size_t i) { m_levels.back().m_indexes.push_back(i); };
+
+    // Level 1 from raw data
+    if (nCount > s_nFirstLevelGroupSize)
+    {
+        m_levels.emplace_back();
+        auto& rLevel = m_levels.back();
+        rLevel.m_indexes.reserve(4 * (nCount / s_nFirstLevelGroupSize + 1));
+        for (size_t nGroupBegin = 0; nGroupBegin < nCount; nGroupBegin += s_nFirstLevelGroupSize)
+        {
+            rLevel.m_groupStarts.push_back(rLevel.m_indexes.size());
+            const auto nGroupEnd = (std::min)(nCount, nGroupBegin + s_nFirstLevelGroupSize);
+            for (size_t i = nGroupBegin; i < nGroupEnd; ++i)
+                collector(i, yAt(i));
+            collector.flush(pushIndex);
+        }
+        rLevel.m_groupStarts.push_back(rLevel.m_indexes.size());
+    }
+
+    // Coarser levels from previous level
+    while (!m_levels.empty() && m_levels.back().groupCount() > s_nGroupsPerGroup)
+    {
+        m_levels.emplace_back();
+        const auto& rPrev = m_levels[m_levels.size() - 2];
+        auto& rLevel = m_levels.back();
+        const auto nPrevGroupCount = rPrev.groupCount();
+        rLevel.m_indexes.reserve(rPrev.m_indexes.size() / s_nGroupsPerGroup + 4);
+        for (size_t nGroupBegin = 0; nGroupBegin < nPrevGroupCount; nGroupBegin += s_nGroupsPerGroup)
+        {
+            rLevel.m_groupStarts.push_back(rLevel.m_indexes.size());
+            const auto nPosBegin = rPrev.m_groupStarts[nGroupBegin];
+            const auto nPosEnd = rPrev.m_groupStarts[(std::min)(nPrevGroupCount, nGroupBegin + s_nGroupsPerGroup)];
+            for (size_t nPos = nPosBegin; nPos < nPosEnd; ++nPos)
+            {
+                const auto i = rPrev.m_indexes[nPos];
+                collector(i, yAt(i));
+            }
+            collector.flush(pushIndex);
+        }
+        rLevel.m_groupStarts.push_back(rLevel.m_indexes.size());
+    }
+}
+
+inline size_t LevelOfDetailPyramid::levelSize(const size_t nLevel) const
+{
+    if (nLevel == 0)
+        return m_nSize;
+    return (nLevel <= m_levels.size()) ? level(nLevel).m_indexes.size() : 0;
+}
+
+inline size_t LevelOfDetailPyramid::rawPointsPerGroup(const size_t nLevel)
+{
+    size_t n = 1;
+    if (nLevel >= 1)
+        n = s_nFirstLevelGroupSize;
+    for (size_t i = 2; i <= nLevel; ++i)
+        n *= s_nGroupsPerGroup;
+    return n;
+}
+
+template <class Sampler_T>
+void LevelOfDetailPyramid::sampleGroup(const size_t nLevel, const size_t nGroup, const size_t nBegin, const size_t nEnd, Sampler_T& sampler) const
+{
+    if (nLevel == 0)
+    {
+        if (nGroup >= nBegin && nGroup < nEnd)
+            sampler(nGroup);
+        return;
+    }
+    const auto& rLevel = level(nLevel);
+    const auto nPosBegin = rLevel.m_groupStarts[nGroup];
+    const auto nPosEnd = rLevel.m_groupStarts[nGroup + 1];
+    if (nPosBegin == nPosEnd)
+        return;
+    // First and last index of a group are always kept so they define the raw range that the group covers.
+    const auto nFirst = rLevel.m_indexes[nPosBegin];
+    const auto nLast = rLevel.m_indexes[nPosEnd - 1];
+    if (nLast < nBegin || nFirst >= nEnd)
+        return;
+    if (nFirst >= nBegin && nLast < nEnd && sampler.m_bucketOf(nFirst) == sampler.m_bucketOf(nLast))
+    {
+        // Group is within a single bucket -> its min/max-reduction is all that is needed.
+        for (size_t nPos = nPosBegin; nPos < nPosEnd; ++nPos)
+            sampler(rLevel.m_indexes[nPos]);
+        return;
+    }
+    // Group is not entirely within requested range or straddles bucket boundary -> opening it from finer level.
+    const auto nChildGroupsPerGroup = (nLevel == 1) ? s_nFirstLevelGroupSize : s_nGroupsPerGroup;
+    const auto nChildBegin = nGroup * nChildGroupsPerGroup;
+    const auto nChildEnd = (std::min)(groupCount(nLevel - 1), nChildBegin + nChildGroupsPerGroup);
+    for (size_t nChild = nChildBegin; nChild < nChildEnd; ++nChild)
+        sampleGroup(nLevel - 1, nChild, nBegin, nEnd, sampler);
+}
+
+template <class BucketOf_T, class YAt_T, class Output_T>
+size_t LevelOfDetailPyramid::downsample(size_t nBegin, size_t nEnd, const size_t nBucketCount, BucketOf_T&& bucketOf, YAt_T&& yAt, Output_T&& output) const
+{
+    nEnd = (std::min)(nEnd, m_nSize);
+    if (nBegin >= nEnd)
+        return 0;
+    // Choosing the coarsest level that still has at least one group per bucket; finer levels get opened only at bucket boundaries.
+    const auto nRangeSize = nEnd - nBegin;
+    size_t nLevel = m_levels.size();
+    while (nLevel > 0 && nRangeSize / rawPointsPerGroup(nLevel) < nBucketCount)
+        --nLevel;
+    if (nLevel == 0)
+        return minMaxPerBucketDownsample(nBegin, nEnd, bucketOf, yAt, output);
+
+    DFG_DETAIL_NS::MinMaxPerBucketSampler<BucketOf_T, YAt_T, Output_T> sampler(bucketOf, yAt, output);
+    const auto nRawPerGroup = rawPointsPerGroup(nLevel);
+    const auto nGroupEnd = (std::min)(groupCount(nLevel), (nEnd - 1) / nRawPerGroup + 1);
+    for (size_t nGroup = nBegin / nRawPerGroup; nGroup < nGroupEnd; ++nGroup)
+        sampleGroup(nLevel, nGroup, nBegin, nEnd, sampler);
+    return sampler.finish();
+}
+
+} } // Module namespace
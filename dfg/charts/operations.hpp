@@ -8,12 +8,15 @@
 #include "commonChartTools.hpp"
 #include "../dfgAssert.hpp"
 #include <algorithm>
+#include <cmath>
 #include <deque>
 #include <functional>
+#include <optional>
 #include <vector>
 #include <regex>
 #include "../dataAnalysis/smoothWithNeighbourAverages.hpp"
 #include "../dataAnalysis/smoothWithNeighbourMedians.hpp"
+#include "../dataAnalysis/smoothWithNeighbourParallel.hpp"
 #include "../math/FormulaParser.hpp"
 #include "../cont/Flags.hpp"
 
@@ -489,6 +492,24 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(charts) {
         // Returns ChartEntryOperation() from case that creation args were invalid.
         static ChartEntryOperation privInvalidCreationArgsResult();
 
+        // Value of indexDependencyRadius() for operations that can't be updated incrementally.
+        static constexpr size_t nonIncrementalIndexRadius() { return (std::numeric_limits<size_t>::max)(); }
+
+        // Declares that output at index i depends only on input indexes [i - nRadius, i + nRadius] so that after change in input rows
+        // only the neighbourhood of changed rows needs to be recomputed. 'bMayRemoveRows' tells whether operation may drop rows (e.g. filters),
+        // in which case indexes after the operation no longer match input indexes.
+        // By default operations are non-incremental.
+        void setIndexDependencyRadius(size_t nRadius, bool bMayRemoveRows = false);
+
+        size_t indexDependencyRadius() const { return m_nIndexDependencyRadius; }
+        bool isIncrementallyUpdatable() const { return m_nIndexDependencyRadius != nonIncrementalIndexRadius(); }
+        bool mayRemoveRows() const { return m_bMayRemoveRows; }
+
+        // Sets hint for the number of threads that operation may use, 0 = std::thread::hardware_concurrency().
+        // Callers that already run operations of several entries concurrently should set this to 1.
+        void setThreadCountHint(const size_t nThreadCount) { m_nThreadCountHint = nThreadCount; }
+        size_t threadCountHint() const { return m_nThreadCountHint; }
+
         size_t argCount() const { return Max(m_argList.size(), m_argStrList.size()); }
 
         double       argAsDouble(const size_t nIndex) const;
@@ -506,6 +527,9 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(charts) {
         DefinitionArgList    m_argList;
         DefinitionArgStrList m_argStrList; // TODO: unify arglist to single variant list.
         StringT           m_sDefinition;            // For (optionally) storing the text from which operation was created from.
+        size_t            m_nIndexDependencyRadius = nonIncrementalIndexRadius();
+        bool              m_bMayRemoveRows = false;
+        size_t            m_nThreadCountHint = 0;
     }; // ChartEntryOperation
 
     inline ChartEntryOperation::ChartEntryOperation(OperationCall call)
@@ -530,6 +554,12 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(charts) {
         return (m_errors & err).operator bool();
     }
 
+    inline void ChartEntryOperation::setIndexDependencyRadius(const size_t nRadius, const bool bMayRemoveRows)
+    {
+        m_nIndexDependencyRadius = nRadius;
+        m_bMayRemoveRows = bMayRemoveRows;
+    }
+
     inline double ChartEntryOperation::argAsDouble(const size_t nIndex) const
     {
         return isValidIndex(this->m_argList, nIndex) ? this->m_argList[nIndex] : std::numeric_limits<double>::quiet_NaN();
@@ -751,6 +781,7 @@ namespace operations
             op.storeArg(0, axis);
             op.storeArg(1, argList.valueAs<double>(1));
             op.storeArg(2, argList.valueAs<double>(2));
+            op.setIndexDependencyRadius(0, true);
             return op;
         }
 
@@ -784,6 +815,7 @@ namespace operations
      *      -The same number of vectors as in input
      *  Details:
      *      -NaN handling: unspecified
+     *      -Incremental update: element-wise, may remove rows.
      */
     class PassWindowOperation : public DFG_DETAIL_NS::FilterOperation<PassWindowOperation>
     {
@@ -838,6 +870,8 @@ namespace operations
      *      -[x], [y] or [z] depending on parameter 0
      *  Outputs:
      *      -The same number of vectors as in input
+     *  Details:
+     *      -Incremental update: element-wise, may remove rows.
      */
     class TextFilterOperation : public ChartEntryOperation
     {
@@ -894,6 +928,7 @@ namespace operations
         op.storeArg(1, svMatchPattern);
         op.storeArg(2, svPatternType);
         op.storeArg(3, svNegate);
+        op.setIndexDependencyRadius(0, true);
         return op;
     }
 
@@ -952,6 +987,7 @@ namespace operations
     *           -https://stackoverflow.com/questions/60600550/force-utf-8-handling-for-stdstring-in-fmt
     *           -TODO: should have proper specification for this.
     *      -If regex doesn't match or format string is not valid, result will be an empty string.
+    *      -Incremental update: element-wise.
     *  Examples
     *      -Basic example:
     *           -0: x
@@ -1002,6 +1038,7 @@ namespace operations
         op.storeArg(0, axis);
         op.storeArg(1, svRegex);
         op.storeArg(2, svFormat);
+        op.setIndexDependencyRadius(0);
         return op;
     }
 
@@ -1062,6 +1099,9 @@ namespace operations
      *  Details:
      *      -If input vector count != 2, considered as error.
      *      -If either side has less than 'radius' neighbours at some point, smoothing may be unbalanced, i.e. takes less neighbours from other size.
+     *      -Incremental update: output at index i depends on input indexes [i - radius, i + radius].
+     *      -Cost per point is O(1) for average and O(log(radius)) for median, large inputs are processed concurrently in chunks
+     *       using at most threadCountHint() threads.
      */
     class Smoothing_indexNb : public ChartEntryOperation
     {
@@ -1102,6 +1142,7 @@ namespace operations
         ChartEntryOperation op(&Smoothing_indexNb::operation);
         op.storeArg(0, arg0);
         op.storeArg(1, arg1);
+        op.setIndexDependencyRadius(static_cast<size_t>(arg0));
         return op;
     }
 
@@ -1129,9 +1170,9 @@ namespace operations
         }
         const auto smoothingType = (op.argCount() >= 2) ? op.argAsDouble(1) : smoothingTypeAverage();
         if (smoothingType == smoothingTypeAverage())
-            ::DFG_MODULE_NS(dataAnalysis)::smoothWithNeighbourAverages(*pY, nNbRadius);
+            ::DFG_MODULE_NS(dataAnalysis)::smoothWithNeighbourAveragesParallel(*pY, nNbRadius, op.threadCountHint());
         else if (smoothingType == smoothingTypeMedian())
-            ::DFG_MODULE_NS(dataAnalysis)::smoothWithNeighbourMedians(*pY, nNbRadius);
+            ::DFG_MODULE_NS(dataAnalysis)::smoothWithNeighbourMediansParallel(*pY, nNbRadius, op.threadCountHint());
         else
             op.setError(error_badCreationArgs);
     }
@@ -1149,6 +1190,7 @@ namespace operations
     *       -Same data structure as inputs; element values may have changed only on axis specified by first argument.
     *  Details:
     *       -The following variables are available in formula (if they are available in input): x (value of x[i]), y (value of y[i])
+    *       -Incremental update: element-wise.
     *  Examples:
     *       -formula("x", "y + 10"): for each element i, x[i] = y[i] + 10
     */
@@ -1180,6 +1222,7 @@ namespace operations
 
         op.storeArg(0, axis);;
         op.storeArg(1, argList.value(1));
+        op.setIndexDependencyRadius(0);
         return op;
     }
 
@@ -1310,6 +1353,29 @@ public:
     using BaseClass::BaseClass; // Inheriting constructor
 
     void executeAll(ChartOperationPipeData& pipeData);
+
+    // Returns index dependency radius of the whole operation chain, i.e. how far from a changed input row output may change,
+    // or ChartEntryOperation::nonIncrementalIndexRadius() if the chain can't be updated incrementally.
+    // Note: after an operation that may remove rows, output indexes no longer correspond to input indexes so chain is considered
+    //       non-incremental if such operation is followed by one with non-zero radius.
+    size_t indexDependencyRadius() const;
+
+    // Returns true iff output of the chain can be updated by recomputing only the neighbourhood of changed input rows.
+    bool isIncrementallyUpdatable() const { return indexDependencyRadius() != ChartEntryOperation::nonIncrementalIndexRadius(); }
+
+    // Given inclusive range of changed input rows [nFirst, nLast] in input of size nInputSize, returns inclusive range of input row indexes
+    // whose output may have changed, or std::nullopt if the chain is not incremental. Recomputing the returned range requires input
+    // from the range widened by indexDependencyRadius() from both sides.
+    std::optional<std::pair<size_t, size_t>> affectedRowRange(size_t nFirst, size_t nLast, size_t nInputSize) const;
+
+    // Given rOutput that is result of executeAll() for input (prevX, prevY), updates it to correspond to input (x, y) by running
+    // the chain only on the neighbourhood of changed rows.
+    // Returns true if rOutput is up-to-date on return, false if incremental update was not possible in which case rOutput is unchanged
+    // and caller should use executeAll(). Incremental update requires that input sizes have not changed, chain is incremental and no
+    // operation may remove rows.
+    // Vectors of rOutput are edited in place so they must not refer to any of the input vectors.
+    // Note: result may differ from that of executeAll() by rounding, e.g. average smoothing uses running sums.
+    bool updateOutputIncrementally(const ValueVectorD& prevX, const ValueVectorD& prevY, const ValueVectorD& x, const ValueVectorD& y, ChartOperationPipeData& rOutput);
 };
 
 
@@ -1323,3 +1389,106 @@ inline void ::DFG_MODULE_NS(charts)::ChartEntryOperationList::executeAll(ChartOp
         op(pipeData);
     }
 }
+
+inline size_t ::DFG_MODULE_NS(charts)::ChartEntryOperationList::indexDependencyRadius() const
+{
+    const auto nNonIncremental = ChartEntryOperation::nonIncrementalIndexRadius();
+    size_t nRadius = 0;
+    bool bRowsMayHaveBeenRemoved = false;
+    for (const auto& op : (*this))
+    {
+        const auto nOpRadius = op.indexDependencyRadius();
+        if (nOpRadius == nNonIncremental || (bRowsMayHaveBeenRemoved && nOpRadius > 0))
+            return nNonIncremental;
+        // Radii of chained operations accumulate, e.g. smoothing twice with radius 1 makes output depend on input indexes [i - 2, i + 2].
+        if (nOpRadius >= nNonIncremental - nRadius)
+            return nNonIncremental;
+        nRadius += nOpRadius;
+        bRowsMayHaveBeenRemoved = bRowsMayHaveBeenRemoved || op.mayRemoveRows();
+    }
+    return nRadius;
+}
+
+inline auto ::DFG_MODULE_NS(charts)::ChartEntryOperationList::affectedRowRange(const size_t nFirst, const size_t nLast, const size_t nInputSize) const -> std::optional<std::pair<size_t, size_t>>
+{
+    const auto nRadius = indexDependencyRadius();
+    if (nRadius == ChartEntryOperation::nonIncrementalIndexRadius() || nFirst > nLast || nInputSize == 0)
+        return std::nullopt;
+    const auto nFirstAffected = (nFirst >= nRadius) ? nFirst - nRadius : 0;
+    const auto nLastAffected = (nLast < nInputSize - 1 && nInputSize - 1 - nLast > nRadius) ? nLast + nRadius : nInputSize - 1;
+    return std::make_pair(nFirstAffected, nLastAffected);
+}
+
+inline bool ::DFG_MODULE_NS(charts)::ChartEntryOperationList::updateOutputIncrementally(const ValueVectorD& prevX, const ValueVectorD& prevY, const ValueVectorD& x, const ValueVectorD& y, ChartOperationPipeData& rOutput)
+{
+    const auto nSize = x.size();
+    if (y.size() != nSize || prevX.size() != nSize || prevY.size() != nSize)
+        return false;
+    const auto isSame = [](const double a, const double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+    const auto isSameRow = [&](const size_t i) { return isSame(x[i], prevX[i]) && isSame(y[i], prevY[i]); };
+    size_t nFirst = 0;
+    while (nFirst < nSize && isSameRow(nFirst))
+        ++nFirst;
+    if (nFirst == nSize)
+        return true; // Input has not changed so output is up-to-date.
+    size_t nLast = nSize - 1;
+    while (nLast > nFirst && isSameRow(nLast))
+        --nLast;
+
+    if (std::any_of(this->begin(), this->end(), [](const ChartEntryOperation& op) { return op.mayRemoveRows(); }))
+        return false;
+    const auto optAffected = affectedRowRange(nFirst, nLast, nSize);
+    if (!optAffected)
+        return false;
+    const auto affected = *optAffected;
+    const auto nRadius = indexDependencyRadius();
+    const auto nSliceFirst = (affected.first >= nRadius) ? affected.first - nRadius : 0;
+    const auto nSliceLast = (nSize - 1 - affected.second > nRadius) ? affected.second + nRadius : nSize - 1;
+    const auto nSliceSize = nSliceLast - nSliceFirst + 1;
+
+    ValueVectorD xSlice(nSliceSize);
+    ValueVectorD ySlice(nSliceSize);
+    std::copy(x.begin() + nSliceFirst, x.begin() + nSliceLast + 1, xSlice.begin());
+    std::copy(y.begin() + nSliceFirst, y.begin() + nSliceLast + 1, ySlice.begin());
+    ChartOperationPipeData sliceData(&xSlice, &ySlice);
+    executeAll(sliceData);
+
+    // Checking that slice output is structurally compatible with existing output before modifying anything.
+    const auto nVectorCount = rOutput.vectorCount();
+    if (sliceData.vectorCount() != nVectorCount)
+        return false;
+    for (size_t i = 0; i < nVectorCount; ++i)
+    {
+        const auto pOutValues = rOutput.constValuesByIndex(i);
+        const auto pSliceValues = sliceData.constValuesByIndex(i);
+        const auto pOutStrings = rOutput.constStringsByIndex(i);
+        const auto pSliceStrings = sliceData.constStringsByIndex(i);
+        if ((pOutValues == nullptr) != (pSliceValues == nullptr) || (pOutStrings == nullptr) != (pSliceStrings == nullptr))
+            return false;
+        if (pOutValues && (pOutValues->size() != nSize || pSliceValues->size() != nSliceSize))
+            return false;
+        if (pOutStrings && (pOutStrings->size() != nSize || pSliceStrings->size() != nSliceSize))
+            return false;
+    }
+
+    const auto nOffset = affected.first - nSliceFirst;
+    const auto nCopyCount = affected.second - affected.first + 1;
+    for (size_t i = 0; i < nVectorCount; ++i)
+    {
+        if (const auto pSliceValues = sliceData.constValuesByIndex(i))
+        {
+            auto pOutValues = rOutput.valuesByIndex(i);
+            if (!pOutValues)
+                return false;
+            std::copy(pSliceValues->begin() + nOffset, pSliceValues->begin() + nOffset + nCopyCount, pOutValues->begin() + affected.first);
+        }
+        else if (const auto pSliceStrings = sliceData.constStringsByIndex(i))
+        {
+            auto pOutStrings = rOutput.stringsByIndex(i);
+            if (!pOutStrings)
+                return false;
+            std::copy(pSliceStrings->begin() + nOffset, pSliceStrings->begin() + nOffset + nCopyCount, pOutStrings->begin() + affected.first);
+        }
+    }
+    return true;
+}
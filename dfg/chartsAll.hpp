@@ -2,3 +2,4 @@
 
 #include "charts/commonChartTools.hpp"
 #include "charts/operations.hpp"
+#include "charts/levelOfDetail.hpp"
@@ -5,6 +5,8 @@
 #include "../math.hpp"
 #include "../numericTypeTools.hpp"
 #include "../numeric/algNumeric.hpp"
+#include <utility>
+#include <vector>
 
 
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(cont) {
@@ -49,6 +51,10 @@ public:
 
     bool empty() const;
 
+    // Returns true iff both sets have exactly the same elements.
+    bool operator==(const IntervalSet& other) const;
+    bool operator!=(const IntervalSet& other) const { return !(*this == other); }
+
     // Returns the number of elements in range [lower, uppper].
     // Note: like with sizeOfSet(), this will return faulty result if count would be > maxOf(sizeType).
     sizeType countOfElementsInRange(const T lower, const T upper) const;
@@ -265,6 +271,31 @@ bool IntervalSet<T>::empty() const
     return m_intervals.empty();
 }
 
+template <class T>
+bool IntervalSet<T>::operator==(const IntervalSet& other) const
+{
+    // Intervals are disjoint and ordered, but adjacent integer intervals (e.g. [1, 3] and [4, 5]) may be stored separately,
+    // so comparing lists where such intervals are merged.
+    const auto mergedIntervals = [](const IntervalSet& is)
+    {
+        std::vector<std::pair<T, T>> intervals;
+        is.forEachContiguousRange([&](const T& lower, const T& upper)
+        {
+            if constexpr (std::is_integral<T>::value)
+            {
+                if (!intervals.empty() && intervals.back().second + 1 == lower) // Note: can't overflow since back().second < lower.
+                {
+                    intervals.back().second = upper;
+                    return;
+                }
+            }
+            intervals.emplace_back(lower, upper);
+        });
+        return intervals;
+    };
+    return mergedIntervals(*this) == mergedIntervals(other);
+}
+
 // Returns the largest element in the set.
 // Precondition: !empty()
 template <class T>
@@ -192,6 +192,38 @@ public:
             m_spStorage[nIndex] = val;
         }
 
+        // Sets items [nSubIndex, nSubIndex + nCount[ from source range pSrc, with every value passed through transform().
+        // Unlike in setMapping(), defaultValue() items are allowed and clear the corresponding mapping.
+        // Precondition: nSubIndex + nCount <= nBlockSize
+        template <class Transform_T>
+        void assignRange(const IndexT nSubIndex, const T* pSrc, const IndexT nCount, const IndexT nBlockSize, Transform_T&& transform)
+        {
+            DFG_ASSERT_UB(nSubIndex + nCount <= nBlockSize);
+            if (nCount == 0)
+                return;
+            if (!m_spStorage)
+                m_spStorage.reset(new T[nBlockSize]);
+            if (nSubIndex > m_nEffectiveBlockSize)
+                std::fill(begin() + m_nEffectiveBlockSize, begin() + nSubIndex, defaultValue());
+            auto pDest = begin() + nSubIndex;
+            for (IndexT i = 0; i < nCount; ++i)
+                pDest[i] = (isExistingMapping(pSrc[i])) ? transform(pSrc[i]) : defaultValue();
+            m_nEffectiveBlockSize = Max(m_nEffectiveBlockSize, nSubIndex + nCount);
+            while (m_nEffectiveBlockSize > 0 && !isExistingMapping(m_spStorage[m_nEffectiveBlockSize - 1]))
+                --m_nEffectiveBlockSize;
+        }
+
+        // Applies transform() to every existing mapping in this block.
+        template <class Transform_T>
+        void transformValues(Transform_T&& transform)
+        {
+            for (IndexT i = 0; i < m_nEffectiveBlockSize; ++i)
+            {
+                if (isExistingMapping(m_spStorage[i]))
+                    m_spStorage[i] = transform(m_spStorage[i]);
+            }
+        }
+
         // Visits each subindex [nLowest, backIndex()] in order from last.
         template <class Func_T>
         void forEachKeyUntil_reverse(const IndexT nLowest, Func_T&& func)
@@ -467,6 +499,59 @@ public:
         });
     }
 
+    // Moves all mappings from 'other' to 'this' shifting keys by nKeyOffset, i.e. mapping (key, value) in 'other' becomes
+    // (nKeyOffset + key, transform(value)) in 'this'. 'other' is cleared.
+    // Instead of setting items one by one, this operates on whole blocks: if target block is aligned with source block
+    // and has no storage yet, source block storage is moved as such; otherwise content is copied in block-sized ranges.
+    // Precondition: empty() || backKey() < nKeyOffset
+    // Precondition: other.empty() || other.backKey() <= maxKey() - nKeyOffset
+    template <class Transform_T>
+    void appendWithMove(MapBlockIndex& other, const KeyT nKeyOffset, Transform_T&& transform)
+    {
+        DFG_ASSERT_CORRECTNESS(this != &other);
+        DFG_ASSERT_CORRECTNESS(empty() || backKey() < nKeyOffset);
+        DFG_ASSERT_CORRECTNESS(other.empty() || other.backKey() <= maxKey() - nKeyOffset);
+        if (this->blockSize() != other.blockSize())
+        {
+            // Block sizes differ (possible only with dynamic block size) -> using generic item-by-item implementation.
+            for (const auto& item : other)
+                set(nKeyOffset + item.first, transform(item.second));
+            other.clear();
+            return;
+        }
+        const auto nBlockSize = this->blockSize();
+        for (IndexT nSrcBlock = 0, nSrcBlockCount = other.blockCount(); nSrcBlock < nSrcBlockCount; ++nSrcBlock)
+        {
+            auto& srcBlock = other.m_blocks[nSrcBlock];
+            if (srcBlock.m_nEffectiveBlockSize == 0)
+                continue;
+            KeyT nDestKey = nKeyOffset + other.privBlockIndexToLinearIndex(nSrcBlock);
+            const T* pSrc = srcBlock.begin();
+            IndexT nRemaining = srcBlock.m_nEffectiveBlockSize;
+            while (nRemaining > 0)
+            {
+                const auto nDestBlock = blockIndex(nDestKey);
+                const auto nDestSubIndex = subIndex(nDestKey);
+                if (!isValidIndex(m_blocks, nDestBlock))
+                    m_blocks.resize(nDestBlock + 1);
+                auto& destBlock = m_blocks[nDestBlock];
+                if (nDestSubIndex == 0 && destBlock.m_nEffectiveBlockSize == 0 && pSrc == srcBlock.begin())
+                {
+                    // Aligned and target has no content -> taking source storage as such.
+                    destBlock = std::move(srcBlock);
+                    destBlock.transformValues(transform);
+                    break;
+                }
+                const auto nCount = Min(nRemaining, nBlockSize - nDestSubIndex);
+                destBlock.assignRange(nDestSubIndex, pSrc, nCount, nBlockSize, transform);
+                pSrc += nCount;
+                nDestKey += nCount;
+                nRemaining -= nCount;
+            }
+        }
+        other.clear();
+    }
+
     const_iterator find(const KeyT key) const
     {
         auto v = value(key);
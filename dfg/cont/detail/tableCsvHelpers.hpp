@@ -69,7 +69,15 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(cont)
                                                 //     To force given thread count to be used even for small files, set threadReadBlockSizeMinimum to zero
             readOpt_threadBlockSizeMinimum,    // Defines minimum size (in bytes) of read block that thread should have. This is used to control that reading is 
                                                 // distributed to multiple thread only if there is enough work to be done, e.g. to not spread reading of 1 kB file to 16 threads.
-            lastPropertyId = readOpt_threadBlockSizeMinimum
+            readOpt_memoryMappedCellStorage,   // If true, readFromFile() keeps the file memory mapped (read-only) for the lifetime of the table content and cells refer
+                                                // directly to the mapping instead of being copied to table's own storage. Effective only for UTF-8 input with single byte separator,
+                                                // cells that can't be referred to as such (e.g. having escaped enclosing chars) are copied as usual.
+            writeOpt_threadCount,              // Defines request for number of threads to use when writing, value 0 is interpreted as "autodetermine".
+                                                //     With value other than 1, TableCsv::writeToStream(strm) uses writeToStreamMultiThreaded().
+            writeOpt_threadBlockRowCount,      // Defines number of rows in a block that a write thread formats at a time.
+            writeOpt_maxInFlightBlockCount,    // Defines maximum number of formatted blocks held in memory while writing, i.e. bounds memory usage of multithreaded write.
+                                                //     Value 0 is interpreted as twice the thread count.
+            lastPropertyId = writeOpt_maxInFlightBlockCount
         }; // enum PropertyId
 
 
@@ -93,6 +101,10 @@ public:
     // Default value is 10 MB. In practice default should be dependent on runtime context (how fast processor etc.),
     // but simply hardcoding a value that is at least reasonable in some contexts; user should set a better value as needed.
     static uint64     getDefaultValue(PropertyIntegralConstant<PropertyId::readOpt_threadBlockSizeMinimum>) { return 10000000; }
+    static bool       getDefaultValue(PropertyIntegralConstant<PropertyId::readOpt_memoryMappedCellStorage>) { return false; }
+    static uint32     getDefaultValue(PropertyIntegralConstant<PropertyId::writeOpt_threadCount>) { return uint32(1); }
+    static uint32     getDefaultValue(PropertyIntegralConstant<PropertyId::writeOpt_threadBlockRowCount>) { return uint32(10000); }
+    static uint32     getDefaultValue(PropertyIntegralConstant<PropertyId::writeOpt_maxInFlightBlockCount>) { return uint32(0); }
 
     template <PropertyId Id_T> using IdType = decltype(getDefaultValue(PropertyIntegralConstant<Id_T>()));
 
@@ -140,11 +152,15 @@ public:
 
 StringViewAscii TableCsvReadWriteOptions::privPropertyIdAsString(const PropertyId id)
 {
-    DFG_STATIC_ASSERT(static_cast<int>(PropertyId::lastPropertyId) == 1, "PropertyId count has changed, privPropertyIdAsString() needs to be updated");
+    DFG_STATIC_ASSERT(static_cast<int>(PropertyId::lastPropertyId) == 5, "PropertyId count has changed, privPropertyIdAsString() needs to be updated");
     switch (id)
     {
         case PropertyId::readOpt_threadCount:              return SzPtrAscii("TableCsvRwo_threadCount");
         case PropertyId::readOpt_threadBlockSizeMinimum:   return SzPtrAscii("TableCsvRwo_threadBlockSizeMinimum");
+        case PropertyId::readOpt_memoryMappedCellStorage:  return SzPtrAscii("TableCsvRwo_memoryMappedCellStorage");
+        case PropertyId::writeOpt_threadCount:             return SzPtrAscii("TableCsvRwo_writeThreadCount");
+        case PropertyId::writeOpt_threadBlockRowCount:     return SzPtrAscii("TableCsvRwo_writeThreadBlockRowCount");
+        case PropertyId::writeOpt_maxInFlightBlockCount:   return SzPtrAscii("TableCsvRwo_writeMaxInFlightBlockCount");
         default: DFG_ASSERT_CORRECTNESS(false);            return DFG_ASCII("");
     }
 }
@@ -152,7 +168,10 @@ StringViewAscii TableCsvReadWriteOptions::privPropertyIdAsString(const PropertyI
 template <TableCsvReadWriteOptions::PropertyId Id_T>
 void TableCsvReadWriteOptions::setPropertyT(const IdType<Id_T> prop)
 {
-    BaseClass::setProperty(privPropertyIdAsString(Id_T), ::DFG_MODULE_NS(str)::toStrC(prop));
+    if constexpr (std::is_same_v<IdType<Id_T>, bool>)
+        BaseClass::setProperty(privPropertyIdAsString(Id_T), (prop) ? "true" : "false");
+    else
+        BaseClass::setProperty(privPropertyIdAsString(Id_T), ::DFG_MODULE_NS(str)::toStrC(prop));
 }
 
 template <TableCsvReadWriteOptions::PropertyId Id_T>
@@ -4,6 +4,7 @@
 #include "../dfgAssert.hpp"
 #include "../dfgBase.hpp"
 #include "../str.hpp"
+#include "../str/strToBatch.hpp"
 #include "../alg/sortMultiple.hpp"
 #include "../io/textEncodingTypes.hpp"
 #include "../numericTypeTools.hpp"
@@ -11,6 +12,10 @@
 #include <vector>
 #include <memory>
 #include <numeric>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include "Vector.hpp"
 #include "TrivialPair.hpp"
 #include "../build/languageFeatureInfo.hpp"
@@ -527,6 +532,97 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             }
         }; // class RowToContentMapBlockIndex
 
+        // Typed (e.g. double or int64) representation of string column: contiguous value array with validity bitmap, both indexed by row.
+        // Value of rows that have no content or whose content is not convertible to Value_T is invalidValue().
+        template <class Value_T>
+        class TableTypedColumnCache
+        {
+        public:
+            using value_type = Value_T;
+
+            static Value_T invalidValue()
+            {
+                if constexpr (std::numeric_limits<Value_T>::has_quiet_NaN)
+                    return std::numeric_limits<Value_T>::quiet_NaN();
+                else
+                    return Value_T();
+            }
+
+            size_t size() const { return m_values.size(); }
+
+            const Value_T* data() const { return m_values.data(); }
+
+            // Returns true iff cell at given row has content that was converted to Value_T successfully.
+            bool isValid(const size_t nRow) const { return nRow < m_validity.size() && m_validity[nRow]; }
+
+            Value_T value(const size_t nRow) const { return (nRow < m_values.size()) ? m_values[nRow] : invalidValue(); }
+
+            size_t validCount() const { return static_cast<size_t>(std::count(m_validity.begin(), m_validity.end(), true)); }
+
+            std::vector<Value_T> m_values;
+            std::vector<bool> m_validity;
+        }; // class TableTypedColumnCache
+
+        class TableTypedColumnCaches
+        {
+        public:
+            std::unique_ptr<TableTypedColumnCache<double>> m_spDouble;
+            std::unique_ptr<TableTypedColumnCache<int64>> m_spInt64;
+
+            template <class T>
+            std::unique_ptr<TableTypedColumnCache<T>>& get()
+            {
+                DFG_STATIC_ASSERT((std::is_same_v<T, double> || std::is_same_v<T, int64>), "Only double and int64 caches are supported");
+                if constexpr (std::is_same_v<T, double>)
+                    return m_spDouble;
+                else
+                    return m_spInt64;
+            }
+
+            template <class T>
+            const TableTypedColumnCache<T>* get() const
+            {
+                return const_cast<TableTypedColumnCaches&>(*this).template get<T>().get();
+            }
+        }; // class TableTypedColumnCaches
+
+        // Read-only character range (e.g. memory mapped file) that table cells can refer to without copying, see TableSz::setElementToExternalView().
+        // Since content in such range is not null terminated, content of a cell referring to it is defined to extend from cell pointer
+        // up to the first terminator char or to the end of the range.
+        template <class Char_T>
+        class TableExternalViewStorage
+        {
+        public:
+            TableExternalViewStorage(std::shared_ptr<const void> spOwner, const Char_T* pBegin, const Char_T* pEnd, std::basic_string<Char_T> sTerminators)
+                : m_spOwner(std::move(spOwner))
+                , m_pBegin(pBegin)
+                , m_pEnd(pEnd)
+                , m_sTerminators(std::move(sTerminators))
+            {}
+
+            bool contains(const Char_T* p) const
+            {
+                return !std::less<const Char_T*>()(p, m_pBegin) && std::less<const Char_T*>()(p, m_pEnd);
+            }
+
+            // Precondition: contains(p)
+            const Char_T* contentEnd(const Char_T* p) const
+            {
+                return std::find_first_of(p, m_pEnd, m_sTerminators.begin(), m_sTerminators.end());
+            }
+
+            // Returns true iff [p, p + nCount[ is non-empty content that can be referred to as such, i.e. it is within range and is followed by terminator or end of range.
+            bool isViewable(const Char_T* p, const size_t nCount) const
+            {
+                return nCount > 0 && contains(p) && nCount <= static_cast<size_t>(m_pEnd - p) && contentEnd(p) == p + nCount;
+            }
+
+            std::shared_ptr<const void> m_spOwner;
+            const Char_T* m_pBegin;
+            const Char_T* m_pEnd;
+            std::basic_string<Char_T> m_sTerminators;
+        }; // class TableExternalViewStorage
+
     } // namespace DFG_DETAIL_NS
 
     // Class for efficiently storing big table of small strings with no embedded nulls.
@@ -614,6 +710,12 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 return nCount <= m_nCapacity - m_nSize;
             }
 
+            // Discards content, but keeps capacity.
+            void clear_noDealloc()
+            {
+                m_nSize = 0;
+            }
+
         private:
             void assignImpl(CharStorageItem&& other) DFG_NOEXCEPT_TRUE
             {
@@ -645,6 +747,18 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         typedef typename InterfaceTypes_T::SzPtrR SzPtrR;
         typedef typename InterfaceTypes_T::StringT StringT;
         using StringViewT = typename InterfaceTypes_T::StringViewT;
+        template <class T> using TypedColumnCache = DFG_DETAIL_NS::TableTypedColumnCache<T>;
+        using ExternalViewStorage = DFG_DETAIL_NS::TableExternalViewStorage<Char_T>;
+
+        // Null terminated copies of external view cells created on demand by operator()(), keyed by cell pointer.
+        // Read paths that don't need a pointer that outlives the call (viewAt(), forEachFwdRowInColumn(), withTerminatedContentAt()) don't create these.
+        class TerminatedViewCopies
+        {
+        public:
+            std::mutex m_mutex;
+            std::unordered_map<const Char_T*, const Char_T*> m_copies;
+            CharStorage m_storage;
+        };
 
         // Type that is guaranteed to be able to hold the number of non-empty cells.
         using LinearIndexT = typename IntegerTypeBySizeAndSign<Min(sizeof(size_t), 2 * sizeof(Index_T)), false>::type;
@@ -689,17 +803,8 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         // Note: Even in case of overwrite, previous item is not cleared from string storage (this is implementation detail that is not part of the interface, i.e. it is not to be relied on).
         bool addString(const StringViewT sv, const Index_T nRow, const Index_T nCol)
         {
-            // Checking (row, column) index validity.
-            if (nRow < 0 || nCol < 0 || nRow > maxRowIndex() || nCol > maxColumnIndex())
+            if (!privPrepareCell(nRow, nCol))
                 return false;
-            if (!isValidIndex(m_colToRows, nCol))
-            {
-                DFG_ASSERT_UB(m_colToRows.size() == m_charBuffers.size());
-                if (nCol >= NumericTraits<Index_T>::maxValue) // Guard for nCol + 1 overflow.
-                    return false;
-                m_colToRows.resize(nCol + 1);
-                m_charBuffers.resize(nCol + 1);
-            }
 
             const auto nLength = sv.length();
 
@@ -720,7 +825,14 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 // If content has length greater than block size and block size is not allowed to be exceeded, return false as item can't be added.
                 if (nLength >= nNewBlockSize)
                     return false;
-                bufferCont.push_back(CharStorageItem(nNewBlockSize));
+                if (!m_spareCharStorageItems.empty() && m_spareCharStorageItems.back().capacity() == nNewBlockSize)
+                {
+                    // Reusing storage released by clear_noDealloc().
+                    bufferCont.push_back(std::move(m_spareCharStorageItems.back()));
+                    m_spareCharStorageItems.pop_back();
+                }
+                else
+                    bufferCont.push_back(CharStorageItem(nNewBlockSize));
             }
 
             auto& currentBuffer = bufferCont.back();
@@ -738,36 +850,96 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             return true;
         }
 
-        // Appends content on given tables on column nCol to 'this'. It is safe to call this function
-        // concurrently for different columns, i.e. can append columns in different threads concurrently.
-        void appendColumnWithMoveImpl(const IndexT nCol, const IndexT nOriginalRowCount, const std::vector<TableSz*>& others)
+        // Sets element at (nRow, nCol) to refer to content [p, p + nCount[ without copying it to table's own string storage.
+        // This is possible only if content is within storage added with addExternalViewStorage() and it is followed by terminator char or end of storage,
+        // otherwise content is copied like in setElement().
+        // Return: true if element was set, false otherwise.
+        bool setElementToExternalView(const size_t nRow, const size_t nCol, const Char_T* p, const size_t nCount)
+        {
+            using namespace ::DFG_MODULE_NS(math);
+            Index_T r = 0, c = 0;
+            if (!isNumberConvertibleTo<Index_T>(nRow, &r) || !isNumberConvertibleTo<Index_T>(nCol, &c))
+                return false;
+            const auto pStorage = (nCount > 0) ? privExternalViewStorageOf(p) : nullptr;
+            if (!pStorage || !pStorage->isViewable(p, nCount))
+                return addString(StringViewT(SzPtrR(p), nCount), r, c);
+            if (!privPrepareCell(r, c))
+                return false;
+            m_colToRows[c].setContent(r, p);
+            return true;
+        }
+
+        // Adds read-only range [pBegin, pEnd[ whose content cells can refer to with setElementToExternalView(). Since content is not null terminated,
+        // cell content extends up to first char in sTerminators, for example csv separator and eol chars.
+        // Table shares ownership of spOwner, which should keep the range valid, until clear() is called or table is destroyed.
+        void addExternalViewStorage(std::shared_ptr<const void> spOwner, const Char_T* pBegin, const Char_T* pEnd, std::basic_string<Char_T> sTerminators)
         {
+            const auto existing = std::find_if(m_externalViewStorages.begin(), m_externalViewStorages.end(), [&](const ExternalViewStorage& storage)
+            {
+                return storage.m_pBegin == pBegin && storage.m_pEnd == pEnd && storage.m_sTerminators == sTerminators;
+            });
+            if (existing != m_externalViewStorages.end()) // Already added, e.g. when appending tables read from the same input.
+                return;
+            m_externalViewStorages.push_back(ExternalViewStorage(std::move(spOwner), pBegin, pEnd, std::move(sTerminators)));
+            if (!m_spTerminatedViewCopies)
+                m_spTerminatedViewCopies = std::make_unique<TerminatedViewCopies>();
+        }
+
+        // Returns true iff table has storage added with addExternalViewStorage().
+        bool hasExternalStorage() const
+        {
+            return !m_externalViewStorages.empty();
+        }
+
+        // Returns vector of size others.size() + 1 where item i is the row in 'this' where content of others[i] gets appended to and last item is the resulting row count.
+        // Null items in 'others' have zero row count.
+        // Precondition: Resulting row count must fit into IndexT.
+        std::vector<IndexT> appendTargetRowOffsets(const IndexT nOriginalRowCount, const std::vector<TableSz*>& others) const
+        {
+            std::vector<IndexT> rowOffsets(others.size() + 1, nOriginalRowCount);
+            for (size_t i = 0; i < others.size(); ++i)
+            {
+                const TableSz* pTable = others[i];
+                const auto nSourceRowCount = (!pTable) ? 0 : ((pTable != this) ? pTable->rowCountByMaxRowIndex() : nOriginalRowCount);
+                rowOffsets[i + 1] = rowOffsets[i] + nSourceRowCount;
+            }
+            return rowOffsets;
+        }
+
+        // Appends content on given tables on column nCol to 'this' to rows given by rowOffsets, which is expected to be the one returned by appendTargetRowOffsets().
+        // Row mappings are spliced block-wise from source tables, so source tables are left in a partially moved state and must be cleared afterwards.
+        // It is safe to call this function concurrently for different columns, i.e. can append columns in different threads concurrently.
+        void appendColumnWithMoveImpl(const IndexT nCol, const std::vector<IndexT>& rowOffsets, const std::vector<TableSz*>& others)
+        {
+            DFG_ASSERT_UB(rowOffsets.size() == others.size() + 1);
             auto& colToRows = this->m_colToRows[nCol];
+            privInvalidateTypedColumnCache(nCol);
 
-            IndexT nRowOffset = nOriginalRowCount;
-            for (TableSz* pTable : others)
+            for (size_t i = 0; i < others.size(); ++i)
             {
+                TableSz* pTable = others[i];
                 if (!pTable)
                     continue;
                 auto& rTable = *pTable;
-                const auto nSourceRowCount = (pTable != this) ? rTable.rowCountByMaxRowIndex() : nOriginalRowCount;
+                const auto nRowOffset = rowOffsets[i];
+                const auto nSourceRowCount = rowOffsets[i + 1] - nRowOffset;
                 if (this != pTable)
                 {
-                    // For each row in source table in current column, creating row -> data entries for 'this'.
-                    rTable.forEachFwdRowInColumn(nCol, [&](const IndexT nRow, const SzPtrR content)
-                        {
-                            // Note: check for content != rTable.m_emptyString is there to make sure that 'this' won't be referring to emptyString of other table that may dangle any time after appending.
-                            colToRows.setContent(nRowOffset + nRow, // Sum should not overflow since row counts are checked in the beginning.
-                                (toCharPtr_raw(content) != &rTable.m_emptyString) ? toCharPtr_raw(content) : &this->m_emptyString);
-                        });
+                    // Splicing row -> data blocks of source table to 'this'.
+                    if (isValidIndex(rTable.m_colToRows, nCol))
+                    {
+                        // Note: mapping of rTable.m_emptyString is there to make sure that 'this' won't be referring to emptyString of other table that may dangle any time after appending.
+                        colToRows.appendWithMove(rTable.m_colToRows[nCol], nRowOffset,
+                            [&](const Char_T* p) { return (p != &rTable.m_emptyString) ? p : &this->m_emptyString; });
+                    }
                 }
-                else // Case: source is 'this'. Need separate handling as above forEachFwdRowInColumn() would be modifying the structure inside forEach.
+                else // Case: source is 'this'. Need separate handling as above appendWithMove() would be moving from the structure being appended to.
                 {
                     // Accessing by index; inefficient for sparse content.
                     for (IndexT r = 0; r < nSourceRowCount; ++r)
                     {
-                        const auto data = (*this)(r, nCol);
-                        colToRows.setContent(nRowOffset + r, toCharPtr_raw(data)); // Sum should not overflow since row counts are checked in the beginning.
+                        const auto pData = colToRows.content(r, m_charBuffers); // Note: raw content so that external view cells remain views.
+                        colToRows.setContent(nRowOffset + r, pData); // Sum should not overflow since row counts are checked in the beginning.
                     }
                 }
 
@@ -776,13 +948,15 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 {
                     if (isValidIndex(rTable.m_charBuffers, nCol))
                     {
-                        for (auto& bufferItem : rTable.m_charBuffers[nCol])
-                        {
-                            this->m_charBuffers[nCol].push_back(std::move(bufferItem));
-                        }
+                        auto& destBuffers = this->m_charBuffers[nCol];
+                        auto& srcBuffers = rTable.m_charBuffers[nCol];
+                        if (destBuffers.empty())
+                            destBuffers = std::move(srcBuffers);
+                        else
+                            destBuffers.insert(destBuffers.end(), std::make_move_iterator(srcBuffers.begin()), std::make_move_iterator(srcBuffers.end()));
+                        srcBuffers.clear();
                     }
                 }
-                nRowOffset += nSourceRowCount;
             }
         }
 
@@ -798,6 +972,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         {
             const auto nOriginalRowCount = this->rowCountByMaxRowIndex();
             const auto nOriginalColCount = this->colCountByMaxColIndex();
+            releaseTypedColumnCaches();
 
             // Checking that final table has row count that fits to maxRowCount() and resizing column structure in 'this' if necessary.
             {
@@ -822,18 +997,23 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 mergeImpl(*this);
             else // ...otherwise using default non-threaded, in-order merging.
             {
+                const auto rowOffsets = appendTargetRowOffsets(nOriginalRowCount, others);
                 // Appending content in column order (i.e. first append content on column 0, then column 1 etc.).
                 this->forEachFwdColumnIndex([&](const IndexT nCol)
                     {
-                        appendColumnWithMoveImpl(nCol, nOriginalRowCount, others);
+                        appendColumnWithMoveImpl(nCol, rowOffsets, others);
                     }); // for each column
             }
 
-            // Clearing source tables
+            // Taking ownership of external view storages and clearing source tables
             for (auto pTable : others)
             {
                 if (pTable && pTable != this)
+                {
+                    for (auto& storage : pTable->m_externalViewStorages)
+                        this->addExternalViewStorage(std::move(storage.m_spOwner), storage.m_pBegin, storage.m_pEnd, std::move(storage.m_sTerminators));
                     pTable->clear();
+                }
             }
             
             return true;
@@ -905,10 +1085,56 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             return privRowIteratorToRawContent(nCol, iter, static_cast<const RowToContentMap*>(nullptr));
         }
 
-        // Precondition: iter must be dereferencable.
-        SzPtrR privRowIteratorToContentView(const Index_T nCol, typename RowToContentMap::const_iterator iter) const
+        // Returns external view storage that p refers to or nullptr if p is not an external view cell.
+        const DFG_DETAIL_NS::TableExternalViewStorage<Char_T>* privExternalViewStorageOf(const Char_T* p) const
+        {
+            for (const auto& storage : m_externalViewStorages)
+            {
+                if (storage.contains(p))
+                    return &storage;
+            }
+            return nullptr;
+        }
+
+        // Returns null terminated version of raw cell content: for external view cells this is a terminated copy that gets created on first call
+        // and remains valid until clear(), for other cells this is the content itself.
+        SzPtrR privRawContentToSzPtr(const Char_T* p) const
         {
-            return SzPtrR(privRowIteratorToRawContent(nCol, iter));
+            if (!p || m_externalViewStorages.empty())
+                return SzPtrR(p);
+            const auto pStorage = privExternalViewStorageOf(p);
+            if (!pStorage)
+                return SzPtrR(p);
+            auto& copies = *m_spTerminatedViewCopies;
+            std::lock_guard<std::mutex> lock(copies.m_mutex);
+            auto insertRv = copies.m_copies.insert(std::make_pair(p, nullptr));
+            if (insertRv.second)
+            {
+                const auto nLength = static_cast<size_t>(pStorage->contentEnd(p) - p);
+                if (copies.m_storage.empty() || !copies.m_storage.back().hasCapacityFor(nLength + 1))
+                    copies.m_storage.push_back(CharStorageItem(Max(m_nBlockSize, nLength + 1)));
+                auto& rItem = copies.m_storage.back();
+                const auto nBeginIndex = rItem.size();
+                rItem.append_unchecked(p, nLength);
+                rItem.append_unchecked('\0');
+                insertRv.first->second = &rItem[nBeginIndex];
+            }
+            return SzPtrR(insertRv.first->second);
+        }
+
+        // Calls func with null terminated content of raw cell content p. Unlike privRawContentToSzPtr(), this does not store terminated copies of external view cells,
+        // i.e. pointer given to func is valid only during the call. Intended for reading through all content, for example when writing table to stream.
+        template <class Func_T>
+        void privWithTerminatedRawContent(const Char_T* p, std::basic_string<Char_T>& sBuffer, Func_T&& func) const
+        {
+            const auto pStorage = (p && !m_externalViewStorages.empty()) ? privExternalViewStorageOf(p) : nullptr;
+            if (pStorage)
+            {
+                sBuffer.assign(p, pStorage->contentEnd(p));
+                func(sBuffer.c_str());
+            }
+            else
+                func(p);
         }
 
         // Precondition: iter is dereferencable.
@@ -945,6 +1171,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
 
         // Like forEachFwdRowInColumn, but goes through column only as long as whileFunc returns true.
         // whileFunc is given one parameter (row index) and it should return bool.
+        // Note: for cells referring to external view storage, pointer given to func is a temporary terminated copy that is valid only during the call.
         // TODO: test
         template <class Func_T, class WhileFunc_T>
         void forEachFwdRowInColumnWhile(const Index_T nCol, WhileFunc_T&& whileFunc, Func_T&& func) const
@@ -953,10 +1180,14 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 return;
 
             const auto& rowContent = m_colToRows[nCol];
+            std::basic_string<Char_T> sBuffer;
             for (auto iter = rowContent.begin(), iterEnd = rowContent.end(); iter != iterEnd && whileFunc(rowContent.iteratorToRow(iter)); ++iter)
             {
                 if (rowContent.isExistingRow(iter))
-                    func(rowContent.iteratorToRow(iter), privRowIteratorToContentView(nCol, iter));
+                {
+                    const auto nRow = rowContent.iteratorToRow(iter);
+                    privWithTerminatedRawContent(privRowIteratorToRawContent(nCol, iter), sBuffer, [&](const Char_T* p) { func(nRow, SzPtrR(p)); });
+                }
             }
         }
 
@@ -1012,6 +1243,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             if (nRow < 0 || nRow > nCurrentCount)
                 nRow = nCurrentCount;
             nInsertCount = Min(nInsertCount, static_cast<IndexT>(maxRowCount() - nCurrentCount));
+            releaseTypedColumnCaches();
             forEachFwdColumnIndex([&](const Index_T nCol)
             {
                 this->m_colToRows[nCol].insertRowsAt(nRow, nInsertCount);
@@ -1023,6 +1255,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             if (nRow < 0 || nRemoveCount <= 0 || nRow > maxRowIndex())
                 return;
             limitMax(nRemoveCount, static_cast<IndexT>(maxRowCount() - nRow));
+            releaseTypedColumnCaches();
             forEachFwdColumnIndex([&](const Index_T nCol)
             {
                 this->m_colToRows[nCol].removeRows(nRow, nRemoveCount);
@@ -1038,6 +1271,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             if (nCol < 0 || nCol > nColCount)
                 nCol = nColCount;
             nInsertCount = Min(nInsertCount, IndexT(maxColumnCount() - nColCount));
+            releaseTypedColumnCaches();
 
             // Inserting new columns to m_colToRows. Since insert() doesn't work in case of move-only m_colToRows-items, doing it
             // with resize() & rotate()
@@ -1060,6 +1294,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             if (nCol < 0 || nCol > nColCount)
                 nCol = nColCount;
             nRemoveCount = Min(nRemoveCount, nColCount - nCol);
+            releaseTypedColumnCaches();
             m_colToRows.erase(m_colToRows.begin() + nCol, m_colToRows.begin() + nCol + nRemoveCount);
             m_charBuffers.erase(m_charBuffers.begin() + nCol, m_charBuffers.begin() + nCol + nRemoveCount);
         }
@@ -1067,17 +1302,38 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         // Returns either pointer to null terminated string or nullptr, if no element exists.
         // Note: Returned pointer remains valid even if adding new strings. For behaviour in case of 
         //       overwriting item at (row, col), see documentation for addString.
+        // Note: for cells referring to external view storage, this creates a terminated copy that is kept until clear();
+        //       read loops should use viewAt(), withTerminatedContentAt() or forEachFwdRowInColumn() instead.
         SzPtrR operator()(Index_T row, Index_T col) const
         {
             if (!isValidIndex(m_colToRows, col))
                 return SzPtrR(nullptr);
             const auto& colContent = m_colToRows[col];
-            return SzPtrR(colContent.content(row, m_charBuffers));
+            return privRawContentToSzPtr(colContent.content(row, m_charBuffers));
+        }
+
+        // Returns raw cell content pointer, which is not null terminated for external view cells, or nullptr if no element exists.
+        const Char_T* privRawContent(const Index_T row, const Index_T col) const
+        {
+            return (isValidIndex(m_colToRows, col)) ? m_colToRows[col].content(row, m_charBuffers) : nullptr;
         }
 
+        // Returns view to content at (r, c). Unlike operator()(), this does not need to create terminated copies of external view cells.
         StringViewT viewAt(const IndexT r, const IndexT c) const
         {
-            return StringViewT((*this)(r, c));
+            const auto p = privRawContent(r, c);
+            const auto pStorage = (p && !m_externalViewStorages.empty()) ? privExternalViewStorageOf(p) : nullptr;
+            if (pStorage)
+                return StringViewT(SzPtrR(p), static_cast<size_t>(pStorage->contentEnd(p) - p));
+            return StringViewT(SzPtrR(p));
+        }
+
+        // Calls func(SzPtrR) with null terminated content at (r, c), or with nullptr if no element exists. For cells referring to external view storage,
+        // content is copied to sBuffer instead of storing terminated copy like operator()() does, so pointer given to func is valid only during the call.
+        template <class Func_T>
+        void withTerminatedContentAt(const Index_T r, const Index_T c, std::basic_string<Char_T>& sBuffer, Func_T&& func) const
+        {
+            privWithTerminatedRawContent(privRawContent(r, c), sBuffer, [&](const Char_T* p) { func(SzPtrR(p)); });
         }
 
         // Returns the number of non-empty cells in the table.
@@ -1085,14 +1341,15 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         LinearIndexT cellCountNonEmpty() const
         {
             LinearIndexT nCount = 0;
-            forEachFwdColumnIndex([&](Index_T col)
+            for (const auto& rowContent : m_colToRows)
             {
-                forEachFwdRowInColumn(col, [&](const Index_T, const SzPtrR psz)
+                // Note: using raw content since only the first char is needed, e.g. external view cells don't need terminated copy.
+                for (auto iter = rowContent.begin(), iterEnd = rowContent.end(); iter != iterEnd; ++iter)
                 {
-                    if (!DFG_MODULE_NS(str)::isEmptyStr(psz))
+                    if (rowContent.isExistingRow(iter) && *iter->second != '\0')
                         nCount++;
-                });
-            });
+                }
+            }
             return nCount;
         }
 
@@ -1114,12 +1371,70 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         {
             m_charBuffers.clear();
             m_colToRows.clear();
+            m_externalViewStorages.clear();
+            m_spTerminatedViewCopies.reset();
+            m_spareCharStorageItems.clear();
+            m_typedColumnCaches.clear();
+        }
+
+        // Like clear(), but instead of deallocating char storage blocks of default block size, keeps them for reuse by subsequent additions.
+        // Intended for cases where table is repeatedly cleared and refilled with similar content, e.g. in chunked reading.
+        void clear_noDealloc()
+        {
+            for (auto& charStorage : m_charBuffers)
+            {
+                for (auto& storageItem : charStorage)
+                {
+                    if (storageItem.capacity() != m_nBlockSize)
+                        continue;
+                    storageItem.clear_noDealloc();
+                    m_spareCharStorageItems.push_back(std::move(storageItem));
+                }
+            }
+            m_charBuffers.clear();
+            m_colToRows.clear();
+            m_externalViewStorages.clear();
+            m_spTerminatedViewCopies.reset();
+            m_typedColumnCaches.clear();
+        }
+
+        // Returns cache of column nCol with content converted to T (double or int64), building it if not already available.
+        // Cache is kept until content of the column is modified, so repeated numeric queries on unchanged column don't need to parse cell strings again.
+        // Size of the cache is the row count of the table at the time the cache was built.
+        // Returned reference is valid until content of the column is modified or caches are released.
+        template <class T>
+        const TypedColumnCache<T>& typedColumnCache(const Index_T nCol)
+        {
+            if (!isValidIndex(m_colToRows, nCol))
+            {
+                static const TypedColumnCache<T> emptyCache;
+                return emptyCache;
+            }
+            if (!isValidIndex(m_typedColumnCaches, nCol))
+                m_typedColumnCaches.resize(m_colToRows.size());
+            auto& spCache = m_typedColumnCaches[nCol].template get<T>();
+            if (!spCache)
+                spCache = privBuildTypedColumnCache<T>(nCol);
+            return *spCache;
+        }
+
+        // Returns cache of column nCol if it has been built and is up-to-date, nullptr otherwise.
+        template <class T>
+        const TypedColumnCache<T>* typedColumnCacheIfAvailable(const Index_T nCol) const
+        {
+            return (isValidIndex(m_typedColumnCaches, nCol)) ? m_typedColumnCaches[nCol].template get<T>() : nullptr;
+        }
+
+        void releaseTypedColumnCaches()
+        {
+            m_typedColumnCaches.clear();
         }
 
         void clearCell(const IndexT nRow, const IndexT nCol)
         {
             if (!isValidIndex(m_colToRows, nCol))
                 return;
+            privInvalidateTypedColumnCache(nCol);
             // Simply clearing mapping without clearing the string content.
             m_colToRows[nCol].clearMapping(nRow);
         }
@@ -1150,6 +1465,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             for (auto c = nFirstCol; c <= nLastCol; ++c) // Note: can't overflow because nLastCol is one less than maximum IndexT (tested in unit test)
             {
                 m_colToRows[c].clearMappingRange(rt, rb);
+                privInvalidateTypedColumnCache(c);
             }
         }
 
@@ -1178,6 +1494,7 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
 
         void swapCellContentInColumn(const Index_T nCol, RowToContentMap& colItems, const Index_T r0, const Index_T r1)
         {
+            privInvalidateTypedColumnCache(nCol);
             auto iterA = colItems.find(r0);
             auto iterB = colItems.find(r1);
             const bool br0Match = (iterA != colItems.end());
@@ -1186,12 +1503,12 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 return;
             if (!br0Match)
             {
-                colItems.setContent(r0, toCharPtr_raw(privRowIteratorToContentView(nCol, iterB)));
+                colItems.setContent(r0, privRowIteratorToRawContent(nCol, iterB));
                 colItems.setContent(r1, nullptr);
             }
             else if (!br1Match)
             {
-                colItems.setContent(r1, toCharPtr_raw(privRowIteratorToContentView(nCol, iterA)));
+                colItems.setContent(r1, privRowIteratorToRawContent(nCol, iterA));
                 colItems.setContent(r0, nullptr);
             }
             else
@@ -1206,13 +1523,22 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
                 return;
             const auto nCount = rowCountByMaxRowIndex();
             auto& colItems = m_colToRows[nCol];
+            std::basic_string<Char_T> sBufferA, sBufferB; // For terminated copies of external view cells.
             auto indexes = DFG_MODULE_NS(alg)::computeSortIndexesBySizeAndPred(nCount, [&](const size_t a, const size_t b) -> bool
             {
                 auto iterA = colItems.find(static_cast<Index_T>(a));
                 auto iterB = colItems.find(static_cast<Index_T>(b));
-                auto pA = (iterA != colItems.end()) ? privRowIteratorToContentView(nCol, iterA) : nullptr;
-                auto pB = (iterB != colItems.end()) ? privRowIteratorToContentView(nCol, iterB) : nullptr;
-                return pred(pA, pB);
+                const Char_T* pRawA = (iterA != colItems.end()) ? privRowIteratorToRawContent(nCol, iterA) : nullptr;
+                const Char_T* pRawB = (iterB != colItems.end()) ? privRowIteratorToRawContent(nCol, iterB) : nullptr;
+                bool bLess = false;
+                privWithTerminatedRawContent(pRawA, sBufferA, [&](const Char_T* pA)
+                {
+                    privWithTerminatedRawContent(pRawB, sBufferB, [&](const Char_T* pB)
+                    {
+                        bLess = pred(SzPtrR(pA), SzPtrR(pB));
+                    });
+                });
+                return bLess;
             });
             forEachFwdColumnIndex([&](const Index_T nCol)
             {
@@ -1238,6 +1564,113 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
             });
         }
 
+    private:
+        // Checks index validity and makes sure that column structures exist for given cell.
+        // Return: true if cell can be set, false otherwise.
+        bool privPrepareCell(const Index_T nRow, const Index_T nCol)
+        {
+            // Checking (row, column) index validity.
+            if (nRow < 0 || nCol < 0 || nRow > maxRowIndex() || nCol > maxColumnIndex())
+                return false;
+            if (!isValidIndex(m_colToRows, nCol))
+            {
+                DFG_ASSERT_UB(m_colToRows.size() == m_charBuffers.size());
+                if (nCol >= NumericTraits<Index_T>::maxValue) // Guard for nCol + 1 overflow.
+                    return false;
+                m_colToRows.resize(nCol + 1);
+                m_charBuffers.resize(nCol + 1);
+            }
+            privInvalidateTypedColumnCache(nCol);
+            return true;
+        }
+
+        void privInvalidateTypedColumnCache(const Index_T nCol)
+        {
+            if (isValidIndex(m_typedColumnCaches, nCol))
+                m_typedColumnCaches[nCol] = DFG_DETAIL_NS::TableTypedColumnCaches();
+        }
+
+        template <class T>
+        std::unique_ptr<TypedColumnCache<T>> privBuildTypedColumnCache(const Index_T nCol) const
+        {
+            auto spCache = std::make_unique<TypedColumnCache<T>>();
+            const auto nRowCount = static_cast<size_t>(rowCountByMaxRowIndex());
+            spCache->m_values.assign(nRowCount, TypedColumnCache<T>::invalidValue());
+            spCache->m_validity.assign(nRowCount, false);
+            if constexpr (sizeof(Char_T) == 1)
+            {
+                // Converting cells of the column in batches with strToBatch() which has fast paths for plain decimal numbers.
+                // strToBatch() needs null terminated input, so cells referring to external view storage are copied to batch buffer
+                // while other cells are referred to directly. Pointers to copies are set only when batch is converted as buffer may reallocate.
+                const size_t nBatchSize = 1024;
+                std::vector<StringViewC> cells;
+                std::vector<Index_T> rows;
+                std::vector<std::pair<size_t, size_t>> copiedCells; // Pairs of (index in cells, offset in sCopyBuffer).
+                std::string sCopyBuffer;
+                std::vector<T> values(nBatchSize);
+                std::vector<bool> validity;
+                cells.reserve(nBatchSize);
+                rows.reserve(nBatchSize);
+                const auto convertBatch = [&]()
+                {
+                    for (const auto& item : copiedCells)
+                        cells[item.first] = StringViewC(sCopyBuffer.data() + item.second, cells[item.first].size());
+                    ::DFG_MODULE_NS(str)::strToBatch(cells.data(), cells.size(), values.data(), &validity);
+                    for (size_t i = 0; i < rows.size(); ++i)
+                    {
+                        if (!validity[i])
+                            continue;
+                        spCache->m_values[static_cast<size_t>(rows[i])] = values[i];
+                        spCache->m_validity[static_cast<size_t>(rows[i])] = true;
+                    }
+                    cells.clear();
+                    rows.clear();
+                    copiedCells.clear();
+                    sCopyBuffer.clear();
+                };
+                const auto& rowContent = m_colToRows[nCol];
+                for (auto iter = rowContent.begin(), iterEnd = rowContent.end(); iter != iterEnd; ++iter)
+                {
+                    if (!rowContent.isExistingRow(iter))
+                        continue;
+                    const Char_T* p = privRowIteratorToRawContent(nCol, iter);
+                    const auto pStorage = (!m_externalViewStorages.empty()) ? privExternalViewStorageOf(p) : nullptr;
+                    if (pStorage)
+                    {
+                        const auto pEnd = pStorage->contentEnd(p);
+                        copiedCells.push_back(std::make_pair(cells.size(), sCopyBuffer.size()));
+                        sCopyBuffer.append(reinterpret_cast<const char*>(p), reinterpret_cast<const char*>(pEnd));
+                        sCopyBuffer.push_back('\0');
+                        cells.push_back(StringViewC(reinterpret_cast<const char*>(p), static_cast<size_t>(pEnd - p)));
+                    }
+                    else
+                    {
+                        const char* psz = reinterpret_cast<const char*>(p);
+                        cells.push_back(StringViewC(psz, std::strlen(psz)));
+                    }
+                    rows.push_back(rowContent.iteratorToRow(iter));
+                    if (cells.size() >= nBatchSize)
+                        convertBatch();
+                }
+                if (!cells.empty())
+                    convertBatch();
+            }
+            else
+            {
+                forEachFwdRowInColumn(nCol, [&](const Index_T nRow, const SzPtrR psz)
+                {
+                    bool bOk = false;
+                    const auto val = ::DFG_MODULE_NS(str)::strTo<T>(psz, &bOk);
+                    if (!bOk)
+                        return;
+                    spCache->m_values[static_cast<size_t>(nRow)] = val;
+                    spCache->m_validity[static_cast<size_t>(nRow)] = true;
+                });
+            }
+            return spCache;
+        }
+
+    public:
         // TODO: Implement copying and moving. Currently hidden because default copy causes the pointers in m_colToRows in the new
         //       object to refer to the old table strings.
         DFG_HIDE_COPY_CONSTRUCTOR_AND_COPY_ASSIGNMENT(TableSz);
@@ -1247,12 +1680,18 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(cont) {
         Storage implementation:
             -m_charBuffers is a map column -> CharStorage,  where CharStorage's store null terminated strings in blocks of contiguous memory for each column.
             -m_colToRows[nCol] gives list of (row,psz) pairs ordered by row in column nCol.
+             Usually psz points to m_charBuffers, but it may also point to range in m_externalViewStorages, in which case content is not null terminated
+             and operator()() returns terminated copy from m_spTerminatedViewCopies.
             If table has cell at (row,col), it can be accessed by finding row from m_colToRows[nCol].
             Since m_colToRows[nCol] is ordered by row, it can be searched with binary search.
         */
         const Char_T m_emptyString; // Shared empty item.
         CharStorageContainer m_charBuffers;
         TableIndexContainer m_colToRows;
+        std::vector<ExternalViewStorage> m_externalViewStorages; // Read-only storages that m_colToRows may refer to in addition to m_charBuffers.
+        mutable std::unique_ptr<TerminatedViewCopies> m_spTerminatedViewCopies; // Exists if m_externalViewStorages is not empty.
+        CharStorage m_spareCharStorageItems; // Empty storage items released by clear_noDealloc() waiting to be reused.
+        std::vector<DFG_DETAIL_NS::TableTypedColumnCaches> m_typedColumnCaches; // Typed caches by column, item may be missing or empty if cache hasn't been built or it has been invalidated.
         size_t m_nBlockSize;
         bool m_bAllowStringsLongerThanBlockSize; // If false, strings longer than m_nBlockSize can't be added to table.
     }; // Class TableSz
@@ -24,12 +24,17 @@
 #include "../time/timerCpu.hpp"
 #include "../Span.hpp"
 #include "Flags.hpp"
+#include "../io/BasicOmcByteStream.hpp"
 
 #include "../concurrency/ConditionCounter.hpp"
 #include "../concurrency/ThreadList.hpp"
 
 #include "../str/format_fmt.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <mutex>
 
 DFG_ROOT_NS_BEGIN{ 
@@ -239,6 +244,132 @@ DFG_ROOT_NS_BEGIN{
             }; // RowContentFilter
 
 
+            // State machine for finding record boundaries from csv with enclosed cells without actually parsing cells.
+            // Transitions correspond to cell parsing in DelimitedTextReader::readCell() when leading whitespaces are not skipped.
+            // Used in quote-aware block splitting for multithreaded reading and in building record index for TableCsvLazy.
+            // Enclosing char may be DelimitedTextReader::s_nMetaCharNone, other chars must be ASCII.
+            class CsvRecordBoundaryStateMachine
+            {
+            public:
+                enum State : uint8
+                {
+                    stateCellStart,     // At start of cell (=start of input or after separator or eol)
+                    stateNaked,         // In naked cell
+                    stateEnclosed,      // In enclosed cell
+                    stateEnclosedQuote, // In enclosed cell after enclosing char, i.e. either after ending enclosing char or first of double enclosing.
+                    statePastEnclosed,  // After ending enclosing char but before separator or eol.
+                    stateCount
+                };
+                using StateArray = std::array<State, stateCount>;
+
+                CsvRecordBoundaryStateMachine(const int32 cEnc, const char cSep, const char cEol)
+                    : m_structuralChars({ (hasEnclosingChar(cEnc)) ? static_cast<char>(cEnc) : cSep, cSep, cEol })
+                    , m_bHasEnc(hasEnclosingChar(cEnc))
+                {}
+
+                static bool hasEnclosingChar(const int32 cEnc) { return cEnc != ::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharNone; }
+
+                // Returns state after non-empty sequence of non-structural chars.
+                static State afterOtherChars(const State state)
+                {
+                    if (state == stateCellStart)
+                        return stateNaked;
+                    else if (state == stateEnclosedQuote)
+                        return statePastEnclosed;
+                    else
+                        return state;
+                }
+
+                // Returns state after structural char c. If c ends a record, sets *pbRecordEnd to true.
+                State afterStructuralChar(const State state, const char c, bool* pbRecordEnd = nullptr) const
+                {
+                    if (m_bHasEnc && c == enc())
+                    {
+                        switch (state)
+                        {
+                            case stateCellStart:     return stateEnclosed;
+                            case stateEnclosed:      return stateEnclosedQuote;
+                            case stateEnclosedQuote: return stateEnclosed;
+                            default:                 return state; // Enclosing char in naked cell or after ending enclosing is just a regular char.
+                        }
+                    }
+                    if (state == stateEnclosed)
+                        return state; // Separator or eol in enclosed cell is regular cell content.
+                    if (c == eol() && pbRecordEnd)
+                        *pbRecordEnd = true;
+                    return stateCellStart;
+                }
+
+                // Returns array where item i is the state at the end of range [pBegin, pEnd[ given that state at pBegin is i.
+                StateArray transitionFunction(const char* const pBegin, const char* const pEnd) const
+                {
+                    StateArray states;
+                    for (size_t i = 0; i < states.size(); ++i)
+                        states[i] = static_cast<State>(i);
+                    auto pNonStructuralStart = pBegin;
+                    const auto advanceOtherChars = [&](const char* p)
+                    {
+                        if (p != pNonStructuralStart)
+                        {
+                            for (auto& state : states)
+                                state = afterOtherChars(state);
+                        }
+                    };
+                    ::DFG_MODULE_NS(io)::DFG_DETAIL_NS::forEachStructuralChar(pBegin, pEnd, m_structuralChars, [&](const char* p)
+                    {
+                        advanceOtherChars(p);
+                        for (auto& state : states)
+                            state = afterStructuralChar(state, *p);
+                        pNonStructuralStart = p + 1;
+                    });
+                    advanceOtherChars(pEnd);
+                    return states;
+                }
+
+                // Given state at pBegin, calls func(p, bRecordEnd) for every separator and eol in range [pBegin, pEnd[ that ends a cell, i.e. is not enclosed cell content.
+                // bRecordEnd is true for eol. func must return bool: if it returns false, iteration is stopped.
+                // Returns state after last char visited.
+                template <class Func_T>
+                State forEachCellEnd(const char* const pBegin, const char* const pEnd, State state, Func_T&& func) const
+                {
+                    auto pNonStructuralStart = pBegin;
+                    const auto pStop = ::DFG_MODULE_NS(io)::DFG_DETAIL_NS::forEachStructuralChar(pBegin, pEnd, m_structuralChars, [&](const char* p)
+                    {
+                        if (p != pNonStructuralStart)
+                            state = afterOtherChars(state);
+                        pNonStructuralStart = p + 1;
+                        bool bRecordEnd = false;
+                        state = afterStructuralChar(state, *p, &bRecordEnd);
+                        if (state != stateCellStart)
+                            return true; // Not a cell end
+                        return static_cast<bool>(func(p, bRecordEnd));
+                    });
+                    if (pStop == pEnd && pEnd != pNonStructuralStart)
+                        state = afterOtherChars(state);
+                    return state;
+                }
+
+                // Given state at pBegin, returns pointer to first record start that is in range ]pBegin, pEnd[, or pEnd if there is no such position.
+                const char* findNextRecordStart(const char* const pBegin, const char* const pEnd, const State state) const
+                {
+                    const char* pRecordStart = pEnd;
+                    forEachCellEnd(pBegin, pEnd, state, [&](const char* p, const bool bRecordEnd)
+                    {
+                        if (!bRecordEnd)
+                            return true;
+                        pRecordStart = p + 1;
+                        return false;
+                    });
+                    return pRecordStart;
+                }
+
+                char enc() const { return m_structuralChars[0]; }
+                char eol() const { return m_structuralChars[2]; }
+
+                std::array<char, 3> m_structuralChars; // Enclosing char, separator and eol. If there is no enclosing char, first item is separator.
+                bool m_bHasEnc;
+            }; // class CsvRecordBoundaryStateMachine
+
             template <class Table_T, class RowContentFilter_T>
             class FilterCellHandler
             {
@@ -316,6 +447,7 @@ DFG_ROOT_NS_BEGIN{
             using ThisClass = TableCsv;
             using BaseClass = TableSz<Char_T, Index_T, InternalEncoding_T>;
             using IndexT = typename BaseClass::IndexT;
+            using ExternalViewStorage = typename BaseClass::ExternalViewStorage;
             typedef DFG_ROOT_NS::CsvFormatDefinition CsvFormatDefinition;
             typedef typename TableSz<Char_T, Index_T>::RowToContentMap RowToContentMap;
             typedef DFG_MODULE_NS(io)::DelimitedTextReader::CharBuffer<char> DelimitedTextReaderBufferTypeC;
@@ -360,9 +492,16 @@ DFG_ROOT_NS_BEGIN{
                 template <class Derived_T>
                 Derived_T makeConcurrencyClone(TableCsv& rTable) { return Derived_T(rTable); }
 
+                // During memory mapped read (see readOpt_memoryMappedCellStorage), cells refer directly to read-only input bytes when possible
+                // instead of being copied, see TableSz::setElementToExternalView(). Since this is done here, it applies also to derived handlers.
                 void operator()(const size_t nRow, const size_t nCol, const Char_T* pData, const size_t nCount)
                 {
                     DFG_STATIC_ASSERT(InternalEncoding_T == DFG_MODULE_NS(io)::encodingUTF8, "Implimentation exists only for UTF8-encoding");
+                    if (m_rTable.m_spExternalViewReadInput)
+                    {
+                        m_rTable.privSetElementFromExternalViewReadInput(nRow, nCol, pData, nCount);
+                        return;
+                    }
                     // TODO: this effectively assumes that user given input is valid UTF8.
                     m_rTable.setElement(nRow, nCol, StringViewUtf8(TypedCharPtrUtf8R(pData), nCount));
                 };
@@ -423,6 +562,8 @@ DFG_ROOT_NS_BEGIN{
                         auto p0 = (*this)(r, c);
                         auto p1 = other(r, c);
                         // TODO: revise logics: implementation below treats null and empty cells as different.
+                        if (!p0 && !p1)
+                            continue;
                         if ((!p0 && p1) || (p0 && !p1) || (std::strcmp(toCharPtr_raw(p0), toCharPtr_raw(p1)) != 0)) // TODO: Create comparison function instead of using strcmp().
                             return false;
                     }
@@ -430,6 +571,8 @@ DFG_ROOT_NS_BEGIN{
                 return true;
             }
 
+            // Note: if formatDef has readOpt_memoryMappedCellStorage set, file is memory mapped and cells refer to the mapping also when reading with custom reader
+            //       as long as it stores cells through DefaultCellHandler::operator()().
             void readFromFile(const ReadOnlySzParamC& sPath) { readFromFileImpl(sPath, defaultReadFormat()); }
             void readFromFile(const ReadOnlySzParamW& sPath) { readFromFileImpl(sPath, defaultReadFormat()); }
             void readFromFile(const ReadOnlySzParamC& sPath, const CsvFormatDefinition& formatDef) { readFromFileImpl(sPath, formatDef); }
@@ -444,9 +587,65 @@ DFG_ROOT_NS_BEGIN{
                 readFromFileImpl(sPath, formatDef, defaultCellHandler());
             }
 
+            // Reads file so that cells refer to read-only memory mapping of the file, which is owned by the table.
+            // Returns false if file couldn't be read this way, in which case caller should fall back to regular read.
+            template <class Char_T1, class Reader_T>
+            bool privReadFromFileToMemoryMappedCellStorage(const ReadOnlySzParam<Char_T1>& sPath, const CsvFormatDefinition& formatDef, Reader_T& reader)
+            {
+                // Cell content in mapping is terminated by separator, enclosing or eol chars, so they must be known single byte chars.
+                // With separator auto-detection, all candidate separators are used as terminators: cells whose content would end
+                // at a candidate that is not the actual separator are not viewable and get copied, see TableExternalViewStorage::isViewable().
+                const auto isSingleByteChar = [](const int32 c) { return c >= 0 && c < 0x80; };
+                const auto cSep = formatDef.separatorChar();
+                const auto cEnc = formatDef.enclosingChar();
+                std::string sTerminators = { '\n', '\r' };
+                if (cSep == DelimitedTextReader::s_nMetaCharAutoDetect)
+                    sTerminators += ",;\t\x1f";
+                else if (isSingleByteChar(cSep))
+                    sTerminators.push_back(static_cast<char>(cSep));
+                else
+                    return false;
+                if (isSingleByteChar(cEnc))
+                    sTerminators.push_back(static_cast<char>(cEnc));
+                try
+                {
+                    auto spMapping = std::make_shared<DFG_MODULE_NS(io)::FileMemoryMapped>(sPath);
+                    if (!spMapping->is_open())
+                        return false;
+                    const auto pData = spMapping->data();
+                    const auto nSize = spMapping->size();
+                    m_spExternalViewReadInput = std::make_shared<ExternalViewStorage>(std::move(spMapping), pData, pData + nSize, std::move(sTerminators));
+                    readFromMemory(pData, nSize, formatDef, reader);
+                    m_spExternalViewReadInput.reset();
+                    return true;
+                }
+                catch (...)
+                {
+                    // Read failed e.g. due to mapping failure or exception in multithreaded reading.
+                    m_spExternalViewReadInput.reset();
+                    this->clear();
+                    return false;
+                }
+            }
+
+            // Adds cell during memory mapped read, see DefaultCellHandler::operator()().
+            void privSetElementFromExternalViewReadInput(const size_t nRow, const size_t nCol, const Char_T* pData, const size_t nCount)
+            {
+                // Adding storage on first cell instead of before reading since reading clears the table.
+                if (!this->hasExternalStorage())
+                {
+                    const auto& input = *m_spExternalViewReadInput;
+                    this->addExternalViewStorage(input.m_spOwner, input.m_pBegin, input.m_pEnd, input.m_sTerminators);
+                }
+                this->setElementToExternalView(nRow, nCol, pData, nCount);
+            }
+
             template <class Char_T1, class Reader_T>
             void readFromFileImpl(const ReadOnlySzParam<Char_T1>& sPath, const CsvFormatDefinition& formatDef, Reader_T&& reader)
             {
+                using PropertyId = TableCsvReadWriteOptions::PropertyId;
+                if (TableCsvReadWriteOptions::getPropertyT<PropertyId::readOpt_memoryMappedCellStorage>(formatDef, false) && privReadFromFileToMemoryMappedCellStorage(sPath, formatDef, reader))
+                    return;
                 bool bRead = false;
                 try
                 {
@@ -470,6 +669,7 @@ DFG_ROOT_NS_BEGIN{
                     read(istrm, formatDef, defaultAppender(), std::forward<Reader_T>(reader));
                     m_readFormat.textEncoding(istrm.encoding());
                     m_saveFormat = m_readFormat;
+                    privBuildDeclaredTypedColumnCaches();
                 }
             }
 
@@ -507,6 +707,66 @@ DFG_ROOT_NS_BEGIN{
                 return blockStarts;
             }
 
+            // Like determineBlockStartPos(), but also handles enclosed cells: returned positions are guaranteed to be record starts
+            // even if enclosed cells have eol-chars in them.
+            // Uses two-pass approach:
+            //      1. Input is divided into raw chunks and for every chunk, in parallel, it is determined how parse state at chunk end depends on state at chunk start.
+            //      2. Actual parse state at every chunk start is resolved sequentially from the results of the first pass
+            //         and block start is set to the first record start found from the chunk.
+            // Precondition: isEnclosedFormatBlockSplittable() returns true for given chars.
+            static std::vector<size_t> determineBlockStartPosEnclosingAware(RangeIterator_T<const char*> bytes, const size_t nBlockCount, const int32 cEol, const int32 cEnc, const int32 cSep)
+            {
+                using StateMachine = DFG_DETAIL_NS::CsvRecordBoundaryStateMachine;
+                if (nBlockCount <= 1 || bytes.empty())
+                    return std::vector<size_t>();
+                DFG_ASSERT_CORRECTNESS(isEnclosedFormatBlockSplittable(cEol, cEnc, cSep));
+                const StateMachine stateMachine(cEnc, static_cast<char>(cSep), static_cast<char>(cEol));
+                const auto chunkBegin = [&](const size_t i) { return bytes.begin() + static_cast<size_t>(uint64(i) * uint64(bytes.size()) / uint64(nBlockCount)); };
+
+                // First pass: computing state transition function for all but the last chunk, in parallel.
+                std::vector<StateMachine::StateArray> transitions(nBlockCount - 1);
+                {
+                    ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+                    for (size_t i = 1; i < transitions.size(); ++i)
+                    {
+                        threads.push_back(std::thread([&, i]()
+                        {
+                            transitions[i] = stateMachine.transitionFunction(chunkBegin(i), chunkBegin(i + 1));
+                        }));
+                    }
+                    transitions[0] = stateMachine.transitionFunction(chunkBegin(0), chunkBegin(1));
+                } // ThreadList destructor joins threads.
+
+                // Second pass: resolving state at chunk starts and finding first record start from every chunk.
+                std::vector<size_t> blockStarts;
+                auto state = StateMachine::stateCellStart;
+                for (size_t i = 1; i < nBlockCount; ++i)
+                {
+                    state = transitions[i - 1][state];
+                    const auto pChunkBegin = chunkBegin(i);
+                    const auto nMinPos = (!blockStarts.empty()) ? blockStarts.back() : 0;
+                    if (static_cast<size_t>(pChunkBegin - bytes.begin()) < nMinPos)
+                        continue; // Chunk start is within previous block (i.e. previous chunk had no record start)
+                    const auto pRecordStart = (pChunkBegin != bytes.begin() && *(pChunkBegin - 1) == static_cast<char>(cEol) && state == StateMachine::stateCellStart)
+                                                ? pChunkBegin // Chunk begins right after record-ending eol.
+                                                : stateMachine.findNextRecordStart(pChunkBegin, bytes.end(), state);
+                    const auto nPos = static_cast<size_t>(pRecordStart - bytes.begin());
+                    if (nPos >= bytes.size())
+                        break;
+                    if (nPos > nMinPos)
+                        blockStarts.push_back(nPos);
+                }
+                DFG_ASSERT_CORRECTNESS(blockStarts.size() < nBlockCount);
+                return blockStarts;
+            }
+
+            // Returns true if format with given control chars can be split into read blocks with determineBlockStartPosEnclosingAware().
+            static bool isEnclosedFormatBlockSplittable(const int32 cEol, const int32 cEnc, const int32 cSep)
+            {
+                const auto isAscii = [](const int32 c) { return c >= 0 && c < 128; };
+                return isAscii(cEol) && isAscii(cEnc) && isAscii(cSep) && cEnc != cSep && cEnc != cEol;
+            }
+
             CsvFormatDefinition defaultReadFormat() const
             {
                 return CsvFormatDefinition(DelimitedTextReader::s_nMetaCharAutoDetect,
@@ -653,12 +913,18 @@ DFG_ROOT_NS_BEGIN{
                 // Note: this is more of a implementation limitation. e.g. UTF16 input could be divided into read blocks, but not implemented.
                 const auto bIsEncodingMultithreadCompatible = (encoding == ::DFG_MODULE_NS(io)::encodingUnknown || ::DFG_MODULE_NS(io)::areAsciiBytesValidContentInEncoding(encoding));
 
-                if (bIsEncodingMultithreadCompatible && (formatDef.enclosingChar() == DelimitedTextReader::s_nMetaCharNone))
+                // With enclosing char, blocks are determined with quote-aware splitting, which requires control chars to be known ASCII-chars.
+                const bool bHasEnclosingChar = (formatDef.enclosingChar() != DelimitedTextReader::s_nMetaCharNone);
+                const auto bIsFormatMultithreadCompatible = !bHasEnclosingChar || isEnclosedFormatBlockSplittable(formatDef.eolCharFromEndOfLineType(), formatDef.enclosingChar(), formatDef.separatorChar());
+
+                if (bIsEncodingMultithreadCompatible && bIsFormatMultithreadCompatible)
                 {
                     using readerConcurrencySafety = decltype(std::remove_reference<Reader_T>::type::isConcurrencySafeT());
                     const auto readStreamCreatorBasic    = [](const char* pData, const size_t nSize) { return ::DFG_MODULE_NS(io)::BasicImStream(pData, nSize); };
                     const auto readStreamCreatorEncoding = [=](const char* pData, const size_t nSize) { return ::DFG_MODULE_NS(io)::ImStreamWithEncoding(pData, nSize, encoding); };
-                    if (encoding == encodingUtf8)
+                    if (encoding == encodingUtf8 && bHasEnclosingChar)
+                        privReadFromMemory_maybeMultithreaded(readerConcurrencySafety(), pData, nSize, encoding, formatDef, DelimitedTextReader::CharAppenderStringViewCBufferWithEnclosedCellSupport(), std::forward<Reader_T>(reader), readStreamCreatorBasic);
+                    else if (encoding == encodingUtf8)
                         privReadFromMemory_maybeMultithreaded(readerConcurrencySafety(), pData, nSize, encoding, formatDef, DelimitedTextReader::CharAppenderStringViewCBuffer(), std::forward<Reader_T>(reader), readStreamCreatorBasic);
                     else if (encoding == encodingLatin1 || encoding == encodingUnknown)
                         privReadFromMemory_maybeMultithreaded(readerConcurrencySafety(), pData, nSize, encoding, formatDef, defaultAppender(), std::forward<Reader_T>(reader), readStreamCreatorBasic);
@@ -671,6 +937,7 @@ DFG_ROOT_NS_BEGIN{
                 }
 
                 m_readFormat.textEncoding(encoding);
+                privBuildDeclaredTypedColumnCaches();
                 const auto elapsed = timer.elapsedWallSeconds();
                 if (isReadStatsEnabled())
                     m_readFormat.setReadStat<TableCsvReadStat::timeTotal>(elapsed);
@@ -682,6 +949,24 @@ DFG_ROOT_NS_BEGIN{
                 return true;
             }
 
+            // Declares that typed cache of type T (double or int64) is to be built for column nCol after every read, see TableSz::typedColumnCache().
+            template <class T>
+            void declareTypedColumnCache(const IndexT nCol)
+            {
+                m_typedColumnCacheDeclarations.push_back([nCol](TableCsv& rTable) { rTable.template typedColumnCache<T>(nCol); });
+            }
+
+            void clearTypedColumnCacheDeclarations()
+            {
+                m_typedColumnCacheDeclarations.clear();
+            }
+
+            void privBuildDeclaredTypedColumnCaches()
+            {
+                for (const auto& buildCache : m_typedColumnCacheDeclarations)
+                    buildCache(*this);
+            }
+
             // Returns true on success, false on failure. In case of failure, extended error details may be available through TableCsvReadStat::errorInfo
             template <class Strm_T, class CharAppender_T, class Reader_T>
             bool read(Strm_T& strm, const CsvFormatDefinition& formatDef, CharAppender_T, Reader_T&& cellHandler)
@@ -748,8 +1033,13 @@ DFG_ROOT_NS_BEGIN{
             {
                 ::DFG_MODULE_NS(time)::TimerCpu timerBlockReads;
                 const auto nBlockCount = Max<size_t>(1, nThreadCountRequest);
-                const auto additionalBlockStarts = determineBlockStartPos(makeRange(strm.beginPtr(), strm.endPtr()), nBlockCount, formatDef.eolCharFromEndOfLineType());
+                const auto inputRange = makeRange(strm.beginPtr(), strm.endPtr());
+                const auto additionalBlockStarts = (formatDef.enclosingChar() == DelimitedTextReader::s_nMetaCharNone)
+                    ? determineBlockStartPos(inputRange, nBlockCount, formatDef.eolCharFromEndOfLineType())
+                    : determineBlockStartPosEnclosingAware(inputRange, nBlockCount, formatDef.eolCharFromEndOfLineType(), formatDef.enclosingChar(), formatDef.separatorChar());
                 std::vector<TableCsv> tables(additionalBlockStarts.size());
+                for (auto& table : tables)
+                    table.m_spExternalViewReadInput = m_spExternalViewReadInput;
                 std::vector<BaseClass*> tablePtrs(tables.size());
                 std::transform(tables.begin(), tables.end(), tablePtrs.begin(), [](TableCsv& rTable) { return &rTable; });
 
@@ -762,26 +1052,19 @@ DFG_ROOT_NS_BEGIN{
 
                 const auto blockSize = [&](const size_t i) { return (i + 1 < additionalBlockStarts.size()) ? additionalBlockStarts[i + 1] - additionalBlockStarts[i] : strm.sizeInCharacters() - additionalBlockStarts[i]; };
 
-                std::mutex mutexMergeFlags;
-                typename std::make_unsigned<IndexT>::type nNextColumnToMerge = 0; // Accesses must be done while holding mutexMergeFlags
+                std::atomic<size_t> nNextColumnToMerge{ 0 };
                 IndexT nSeedTableOriginalRowCount = 0;
+                // Following are written before merge threads are released through conditionCanStartMerge and are read-only after that.
                 IndexT nColumnCount = 0;
+                std::vector<IndexT> mergeRowOffsets;
 
-                // Defining column merge function. It merges columns as long as there are unprocessed columns available using variable nNextColumnToMerge.
+                // Defining column merge function. It merges columns as long as there are unprocessed columns available using atomic column cursor nNextColumnToMerge.
+                // Columns are independent so no other synchronization is needed.
                 const auto mergeColumns = [&]()
                 {
-                    while (true)
-                    {
-                        IndexT nColToMerge = 0;
-                        {
-                            std::lock_guard<decltype(mutexMergeFlags)> lock(mutexMergeFlags);
-                            if (static_cast<IndexT>(nNextColumnToMerge) >= nColumnCount)
-                                return;
-                            nColToMerge = static_cast<IndexT>(nNextColumnToMerge);
-                            ++nNextColumnToMerge;
-                        }
-                        this->appendColumnWithMoveImpl(nColToMerge, nSeedTableOriginalRowCount, tablePtrs);
-                    }
+                    const auto nColCount = static_cast<size_t>(nColumnCount);
+                    for (auto nCol = nNextColumnToMerge.fetch_add(1, std::memory_order_relaxed); nCol < nColCount; nCol = nNextColumnToMerge.fetch_add(1, std::memory_order_relaxed))
+                        this->appendColumnWithMoveImpl(static_cast<IndexT>(nCol), mergeRowOffsets, tablePtrs);
                 };
 
                 ::DFG_MODULE_NS(concurrency)::ThreadList threads;
@@ -835,6 +1118,7 @@ DFG_ROOT_NS_BEGIN{
                     {
                         // Now that all threads have completed reading and column vectors have been resized properly by appendTablesWithMoveImpl(), notify threads to proceed to column merging.
                         DFG_ASSERT_UB(rTable.colCountByMaxColIndex() == nColumnCount);
+                        mergeRowOffsets = this->appendTargetRowOffsets(nSeedTableOriginalRowCount, tablePtrs);
                         conditionCanStartMerge.decrementCounter();
                         mergeColumns();
                         // Waiting other block handlers to complete.
@@ -1000,6 +1284,7 @@ DFG_ROOT_NS_BEGIN{
                         nextColItemRowIters[nCol] = this->m_colToRows[nCol].cbegin();
                 });
                 const auto nMaxColCount = this->colCountByMaxColIndex();
+                std::string sViewBuffer; // Buffer for null terminated content of external view cells.
                 for (Index_T nRow = 0; !nextColItemRowIters.empty(); ++nRow)
                 {
                     for (Index_T nCol = 0; nCol < nMaxColCount; ++nCol)
@@ -1008,8 +1293,10 @@ DFG_ROOT_NS_BEGIN{
                         if (iter != nextColItemRowIters.end() && this->privRowIteratorToRowNumber(nCol, iter->second) == nRow) // Case: (row, col) has item
                         {
                             auto& rowEntryIter = iter->second;
-                            const auto pData = this->privRowIteratorToRawContent(nCol, rowEntryIter);
-                            policy.write(strm, pData, this->privRowIteratorToRowNumber(nCol, rowEntryIter), nCol);
+                            this->privWithTerminatedRawContent(this->privRowIteratorToRawContent(nCol, rowEntryIter), sViewBuffer, [&](const char* pData)
+                            {
+                                policy.write(strm, pData, this->privRowIteratorToRowNumber(nCol, rowEntryIter), nCol);
+                            });
                             ++rowEntryIter;
                             if (rowEntryIter == this->m_colToRows[nCol].cend())
                                 nextColItemRowIters.erase(iter);
@@ -1022,16 +1309,205 @@ DFG_ROOT_NS_BEGIN{
             }
 
             // Convenience overload, see implementation version for comments.
+            // If save format has writeOpt_threadCount other than 1, writes using writeToStreamMultiThreaded().
             template <class Strm_T>
             void writeToStream(Strm_T& strm) const
             {
+                if (TableCsvReadWriteOptions::getPropertyT<TableCsvReadWriteOptions::PropertyId::writeOpt_threadCount>(m_saveFormat, 1) != 1)
+                {
+                    writeToStreamMultiThreaded(strm, m_saveFormat);
+                    return;
+                }
                 auto policy = createWritePolicy<Strm_T>();
                 writeToStream(strm, policy);
             }
 
+            // Stream type to which write policies used in writeToStreamMultiThreaded() write.
+            using WriteBlockStream = ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string>;
+
+            // Writes table like writeToStream() using given format and WritePolicySimple, see the policy-creator overload for details.
+            template <class Strm_T>
+            void writeToStreamMultiThreaded(Strm_T& strm, const CsvFormatDefinition& format) const
+            {
+                writeToStreamMultiThreaded(strm, format, [&]() { return createWritePolicy<WriteBlockStream>(format); }, [](const WritePolicySimple<WriteBlockStream>&) {});
+            }
+
+            // Writes table to strm with output identical to writeToStream(), but rows are formatted (including enclosing, escaping and encoding) concurrently:
+            //      -Rows are divided to blocks of writeOpt_threadBlockRowCount rows.
+            //      -Every worker thread has its own write policy created with createPolicy() (called in worker thread) and formats blocks to its own byte buffers.
+            //      -Calling thread writes formatted blocks to strm in row order.
+            //      -At most writeOpt_maxInFlightBlockCount blocks are formatted or waiting to be written at a time, which bounds memory usage.
+            // Thread count is determined by writeOpt_threadCount (0 = autodetermine) in threadOptions and is limited by block count.
+            // onPolicyFinished(policy) is called for every policy after it has written its last block; calls are serialized.
+            // Policies must have the same interface as WritePolicySimple<WriteBlockStream>, BOM is written with a separately created policy.
+            // If formatting throws, other threads are stopped and exception is rethrown to caller.
+            template <class Strm_T, class PolicyCreator_T, class PolicyFinished_T>
+            void writeToStreamMultiThreaded(Strm_T& strm, const CsvFormatDefinition& threadOptions, PolicyCreator_T&& createPolicy, PolicyFinished_T&& onPolicyFinished) const
+            {
+                using PropertyId = TableCsvReadWriteOptions::PropertyId;
+                const auto nRowCount = this->rowCountByMaxRowIndex();
+                const auto nColCount = this->colCountByMaxColIndex();
+                const auto nRowsPerBlock = Max<uint64>(1, TableCsvReadWriteOptions::getPropertyT<PropertyId::writeOpt_threadBlockRowCount>(threadOptions, 10000));
+                const auto nBlockCount = static_cast<size_t>((static_cast<uint64>(nRowCount) + nRowsPerBlock - 1) / nRowsPerBlock);
+                const auto blockRowRange = [&](const size_t nBlock)
+                {
+                    const auto nBegin = static_cast<uint64>(nBlock) * nRowsPerBlock;
+                    return std::make_pair(static_cast<Index_T>(nBegin), static_cast<Index_T>(Min<uint64>(nBegin + nRowsPerBlock, static_cast<uint64>(nRowCount))));
+                };
+
+                size_t nThreadCount = TableCsvReadWriteOptions::getPropertyT<PropertyId::writeOpt_threadCount>(threadOptions, 0);
+                if (nThreadCount == 0)
+                    nThreadCount = Max<unsigned int>(1, std::thread::hardware_concurrency());
+                nThreadCount = Min(nThreadCount, nBlockCount);
+                size_t nMaxInFlightBlockCount = TableCsvReadWriteOptions::getPropertyT<PropertyId::writeOpt_maxInFlightBlockCount>(threadOptions, 0);
+                if (nMaxInFlightBlockCount == 0)
+                    nMaxInFlightBlockCount = 2 * nThreadCount;
+                nMaxInFlightBlockCount = Max<size_t>(1, nMaxInFlightBlockCount);
+
+                const auto writeBytes = [&](const std::string& s) { ::DFG_MODULE_NS(io)::writeBinary(strm, s.data(), s.size()); };
+                std::string sBuffer;
+
+                if (nThreadCount <= 1) // Case: single-threaded, formatting blocks in calling thread.
+                {
+                    auto policy = createPolicy();
+                    WriteBlockStream blockStrm(&sBuffer);
+                    policy.writeBom(blockStrm);
+                    writeBytes(sBuffer);
+                    for (size_t nBlock = 0; nBlock < nBlockCount; ++nBlock)
+                    {
+                        sBuffer.clear();
+                        const auto rowRange = blockRowRange(nBlock);
+                        privWriteRowRangeToStream(blockStrm, policy, rowRange.first, rowRange.second, nColCount);
+                        writeBytes(sBuffer);
+                    }
+                    onPolicyFinished(policy);
+                    return;
+                }
+
+                {
+                    WriteBlockStream bomStrm(&sBuffer);
+                    createPolicy().writeBom(bomStrm);
+                    writeBytes(sBuffer);
+                }
+
+                // Block nBlock is formatted to slot nBlock % nMaxInFlightBlockCount and a block can be taken for formatting only after
+                // the block that previously used the slot has been written.
+                struct Slot
+                {
+                    std::string m_bytes;
+                    bool m_bReady = false;
+                };
+                std::vector<Slot> slots(nMaxInFlightBlockCount);
+                std::mutex mutex;
+                std::condition_variable condVar;
+                size_t nNextBlockToFormat = 0;
+                size_t nNextBlockToWrite = 0;
+                bool bAbort = false;
+                std::exception_ptr spException;
+
+                const auto abort = [&](std::exception_ptr sp)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!spException)
+                            spException = sp;
+                        bAbort = true;
+                    }
+                    condVar.notify_all();
+                };
+
+                const auto threadFunc = [&]()
+                {
+                    try
+                    {
+                        auto policy = createPolicy();
+                        for (;;)
+                        {
+                            size_t nBlock;
+                            {
+                                std::unique_lock<std::mutex> lock(mutex);
+                                condVar.wait(lock, [&] { return bAbort || nNextBlockToFormat >= nBlockCount || nNextBlockToFormat < nNextBlockToWrite + nMaxInFlightBlockCount; });
+                                if (bAbort || nNextBlockToFormat >= nBlockCount)
+                                    break;
+                                nBlock = nNextBlockToFormat++;
+                            }
+                            auto& slot = slots[nBlock % nMaxInFlightBlockCount];
+                            slot.m_bytes.clear();
+                            WriteBlockStream blockStrm(&slot.m_bytes);
+                            const auto rowRange = blockRowRange(nBlock);
+                            privWriteRowRangeToStream(blockStrm, policy, rowRange.first, rowRange.second, nColCount);
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                slot.m_bReady = true;
+                            }
+                            condVar.notify_all();
+                        }
+                        std::lock_guard<std::mutex> lock(mutex);
+                        onPolicyFinished(policy);
+                    }
+                    catch (...)
+                    {
+                        abort(std::current_exception());
+                    }
+                };
+
+                {
+                    ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+                    try
+                    {
+                        for (size_t i = 0; i < nThreadCount; ++i)
+                            threads.push_back(std::thread(threadFunc));
+                        for (size_t nBlock = 0; nBlock < nBlockCount; ++nBlock)
+                        {
+                            auto& slot = slots[nBlock % nMaxInFlightBlockCount];
+                            {
+                                std::unique_lock<std::mutex> lock(mutex);
+                                condVar.wait(lock, [&] { return bAbort || slot.m_bReady; });
+                                if (bAbort)
+                                    break;
+                            }
+                            writeBytes(slot.m_bytes); // Slot is not touched by workers before nNextBlockToWrite is incremented.
+                            {
+                                std::lock_guard<std::mutex> lock(mutex);
+                                slot.m_bReady = false;
+                                ++nNextBlockToWrite;
+                            }
+                            condVar.notify_all();
+                        }
+                    }
+                    catch (...)
+                    {
+                        abort(std::current_exception());
+                    }
+                } // ThreadList destructor joins threads.
+                if (spException)
+                    std::rethrow_exception(spException);
+            }
+
+            // Writes rows [nRowBegin, nRowEnd[ in the same format as writeToStream().
+            template <class Strm_T, class Policy_T>
+            void privWriteRowRangeToStream(Strm_T& strm, Policy_T& policy, const Index_T nRowBegin, const Index_T nRowEnd, const Index_T nColCount) const
+            {
+                std::string sViewBuffer; // Buffer for null terminated content of external view cells.
+                for (Index_T nRow = nRowBegin; nRow < nRowEnd; ++nRow)
+                {
+                    for (Index_T nCol = 0; nCol < nColCount; ++nCol)
+                    {
+                        const auto pRaw = this->privRawContent(nRow, nCol);
+                        if (pRaw)
+                            this->privWithTerminatedRawContent(pRaw, sViewBuffer, [&](const char* pData) { policy.write(strm, pData, nRow, nCol); });
+                        if (nCol + 1 < nColCount) // Write separator for all but the last column.
+                            policy.writeSeparator(strm, nRow, nCol);
+                    }
+                    policy.writeEol(strm);
+                }
+            }
+
             TableCsvReadWriteOptions m_readFormat; // Stores the format of previously read input. If no read is done, stores to default output format.
                                                    // TODO: specify content in case of interrupted read.
             TableCsvReadWriteOptions m_saveFormat; // Format to be used when saving
+            std::vector<std::function<void (TableCsv&)>> m_typedColumnCacheDeclarations;
+            std::shared_ptr<const ExternalViewStorage> m_spExternalViewReadInput; // Input that cells may refer to, set only during memory mapped read.
         }; // class TableCsv
 
 } } // module namespace
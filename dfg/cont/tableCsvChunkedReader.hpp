@@ -0,0 +1,196 @@
+#pragma once
+
+#include "tableCsv.hpp"
+#include <functional>
+
+DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(cont) {
+
+namespace DFG_DETAIL_NS
+{
+    // Table-like write target for cell handlers in chunked reading: forwards elements to chunk table so that first row of chunk is at row 0
+    // and passes chunk to callback when row index goes past the chunk. Rows must be written in non-decreasing order.
+    template <class Table_T>
+    class TableCsvChunkWriter
+    {
+    public:
+        using IndexT = typename Table_T::IndexT;
+        using ChunkFunc = std::function<bool (const Table_T&, IndexT)>;
+
+        TableCsvChunkWriter(Table_T& rChunk, const IndexT nRowsPerChunk)
+            : m_rChunk(rChunk)
+            , m_nRowsPerChunk(Max<IndexT>(1, nRowsPerChunk))
+        {}
+
+        template <class Str_T>
+        bool setElement(const IndexT nRow, const IndexT nCol, const Str_T& sv)
+        {
+            if (m_bHasContent && nRow - m_nChunkFirstRow >= m_nRowsPerChunk && !flush())
+                throw typename Table_T::OperationCancelledException();
+            if (!m_bHasContent)
+            {
+                m_nChunkFirstRow = nRow;
+                m_bHasContent = true;
+            }
+            return m_rChunk.setElement(nRow - m_nChunkFirstRow, nCol, sv);
+        }
+
+        // Passes current chunk (if any) to callback and clears chunk content keeping its storage for reuse.
+        // Returns false if callback requested stopping.
+        bool flush()
+        {
+            if (!m_bHasContent)
+                return !m_bStopped;
+            m_bHasContent = false;
+            ++m_nChunkCount;
+            m_bStopped = !m_chunkFunc(m_rChunk, m_nChunkFirstRow);
+            m_rChunk.clear_noDealloc();
+            return !m_bStopped;
+        }
+
+        void reset(ChunkFunc chunkFunc)
+        {
+            m_chunkFunc = std::move(chunkFunc);
+            m_nChunkFirstRow = 0;
+            m_nChunkCount = 0;
+            m_bHasContent = false;
+            m_bStopped = false;
+        }
+
+        Table_T& m_rChunk;
+        IndexT m_nRowsPerChunk;
+        ChunkFunc m_chunkFunc;
+        IndexT m_nChunkFirstRow = 0; // Row index in final (=unchunked) table of row 0 in chunk.
+        size_t m_nChunkCount = 0;
+        bool m_bHasContent = false;
+        bool m_bStopped = false;
+    }; // class TableCsvChunkWriter
+} // namespace DFG_DETAIL_NS
+
+// Reads csv-input in chunks of rows so that at most one chunk is in memory at a time regardless of input size:
+// rows are parsed to a reusable TableCsv and when chunk gets full, it is passed to user callback after which it is cleared for the next rows.
+// Char storage of the chunk table is recycled between chunks.
+// Filtering works like with TableCsv: create filter handler with createFilterCellHandler() and pass it to read function.
+// Example:
+//      TableCsvChunkedReader<char, uint32> reader(10000);
+//      reader.readFromFile(sPath, formatDef, [&](const TableCsv<char, uint32>& chunk, const uint32 nFirstRow) { /* process chunk */ });
+template <class Char_T, class Index_T>
+class TableCsvChunkedReader
+{
+public:
+    using TableCsvT = TableCsv<Char_T, Index_T>;
+    using IndexT = typename TableCsvT::IndexT;
+    using ChunkWriter = DFG_DETAIL_NS::TableCsvChunkWriter<TableCsvT>;
+    template <class StringMatcher_T> using RowContentFilter = DFG_DETAIL_NS::RowContentFilter<ChunkWriter, StringMatcher_T>;
+
+    class DefaultCellHandler : public TableCsvT::CellHandlerBase
+    {
+    public:
+        DefaultCellHandler(ChunkWriter& rWriter)
+            : m_rWriter(rWriter)
+        {}
+
+        void operator()(const size_t nRow, const size_t nCol, const Char_T* pData, const size_t nCount)
+        {
+            if (isValWithinLimitsOfType<IndexT>(nRow) && isValWithinLimitsOfType<IndexT>(nCol))
+                m_rWriter.setElement(static_cast<IndexT>(nRow), static_cast<IndexT>(nCol), StringViewUtf8(TypedCharPtrUtf8R(pData), nCount));
+        }
+
+        ChunkWriter& m_rWriter;
+    }; // class DefaultCellHandler
+
+    TableCsvChunkedReader(const IndexT nRowsPerChunk = 10000)
+        : m_writer(m_chunk, nRowsPerChunk)
+    {}
+
+    IndexT rowsPerChunk() const { return m_writer.m_nRowsPerChunk; }
+
+    // Sets chunk size for subsequent chunks. Can be called also from chunk callback, e.g. to use small first chunk and bigger chunks after that.
+    void setRowsPerChunk(const IndexT nRowsPerChunk) { m_writer.m_nRowsPerChunk = Max<IndexT>(1, nRowsPerChunk); }
+
+    DefaultCellHandler defaultCellHandler()
+    {
+        return DefaultCellHandler(m_writer);
+    }
+
+    // Creates filter cell handler for chunked reading, semantics are the same as in TableCsv::createFilterCellHandler().
+    // Row indexes passed to chunk callback are indexes in the filtered table.
+    // Note: lifetime of returned object is bound to lifetime of 'this'
+    auto createFilterCellHandler() -> DFG_DETAIL_NS::FilterCellHandler<ChunkWriter, DFG_DETAIL_NS::RowContentDummyFilter>
+    {
+        auto rv = DFG_DETAIL_NS::FilterCellHandler<ChunkWriter, DFG_DETAIL_NS::RowContentDummyFilter>(m_writer, DFG_DETAIL_NS::RowContentDummyFilter());
+        rv.setIncludeColumns(IntervalSet<IndexT>::makeSingleInterval(0, maxValueOfType<IndexT>()));
+        return rv;
+    }
+
+    template <class StringMatcher_T>
+    auto createFilterCellHandler(StringMatcher_T matcher, const IndexT nMatchCol = DFG_DETAIL_NS::anyColumn<IndexT>()) -> DFG_DETAIL_NS::FilterCellHandler<ChunkWriter, RowContentFilter<StringMatcher_T>>
+    {
+        auto rv = DFG_DETAIL_NS::FilterCellHandler<ChunkWriter, RowContentFilter<StringMatcher_T>>(m_writer, RowContentFilter<StringMatcher_T>(matcher, nMatchCol));
+        rv.setIncludeRows(IntervalSet<IndexT>::makeSingleInterval(0, maxValueOfType<IndexT>()));
+        rv.setIncludeColumns(IntervalSet<IndexT>::makeSingleInterval(0, maxValueOfType<IndexT>()));
+        return rv;
+    }
+
+    // Reads file calling func(const TableCsvT& chunk, const IndexT nFirstRow) for every chunk, where nFirstRow is the row index of chunk row 0 in the whole table.
+    // func may return void or bool; if it returns false, reading is stopped.
+    // Returns true if whole input was read successfully, false if reading failed or was stopped.
+    template <class Func_T>
+    bool readFromFile(const ReadOnlySzParamC& sPath, const CsvFormatDefinition& formatDef, Func_T&& func)
+    {
+        return readFromFile(sPath, formatDef, defaultCellHandler(), std::forward<Func_T>(func));
+    }
+
+    template <class CellHandler_T, class Func_T>
+    bool readFromFile(const ReadOnlySzParamC& sPath, const CsvFormatDefinition& formatDef, CellHandler_T&& cellHandler, Func_T&& func)
+    {
+        return privRead([&]() { m_chunk.readFromFile(sPath, formatDef, cellHandler); }, std::forward<Func_T>(func));
+    }
+
+    template <class Func_T>
+    bool readFromMemory(const char* const pData, const size_t nSize, const CsvFormatDefinition& formatDef, Func_T&& func)
+    {
+        return readFromMemory(pData, nSize, formatDef, defaultCellHandler(), std::forward<Func_T>(func));
+    }
+
+    template <class CellHandler_T, class Func_T>
+    bool readFromMemory(const char* const pData, const size_t nSize, const CsvFormatDefinition& formatDef, CellHandler_T&& cellHandler, Func_T&& func)
+    {
+        return privRead([&]() { m_chunk.readFromMemory(pData, nSize, formatDef, cellHandler); }, std::forward<Func_T>(func));
+    }
+
+    // Returns format of previous read, see TableCsv::readFormat().
+    const TableCsvReadWriteOptions& readFormat() const { return m_chunk.readFormat(); }
+
+    // Returns the number of chunks passed to callback in previous read.
+    size_t chunkCount() const { return m_writer.m_nChunkCount; }
+
+private:
+    template <class ReadFunc_T, class Func_T>
+    bool privRead(ReadFunc_T&& readFunc, Func_T&& func)
+    {
+        m_writer.reset([&](const TableCsvT& chunk, const IndexT nFirstRow) -> bool
+        {
+            if constexpr (std::is_same_v<decltype(func(chunk, nFirstRow)), void>)
+            {
+                func(chunk, nFirstRow);
+                return true;
+            }
+            else
+                return func(chunk, nFirstRow);
+        });
+        m_chunk.m_readFormat.template setReadStat<TableCsvReadStat::errorInfo>(CsvConfig()); // Clearing possible error info from previous read.
+        readFunc();
+        const bool bReadOk = m_chunk.readFormat().template getReadStat<TableCsvReadStat::errorInfo>().empty();
+        const bool bCompleted = bReadOk && m_writer.flush();
+        m_chunk.clear();
+        m_writer.m_chunkFunc = nullptr;
+        return bCompleted;
+    }
+
+    DFG_HIDE_COPY_CONSTRUCTOR_AND_COPY_ASSIGNMENT(TableCsvChunkedReader);
+
+    TableCsvT m_chunk;
+    ChunkWriter m_writer;
+}; // class TableCsvChunkedReader
+
+}} // namespace dfg::cont
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "tableCsv.hpp"
+#include <memory>
+#include <vector>
+
+DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(cont) {
+
+// Read-only csv-table that parses rows on demand.
+// When input is opened, it is scanned once to build sparse record index: byte offset of every N'th record start (N = rows per chunk) and column count.
+// Cell content is not parsed at this point; when a cell is accessed, the chunk of N records containing it is parsed to TableCsv and cached.
+// Number of cached chunks is bounded (see setMaxLoadedChunkCount()): when the limit is reached, least recently used chunk is released before
+// parsing a new one. This makes opening of large files fast and keeps memory usage bounded regardless of file size and access pattern.
+// Limitations:
+//      -Input must be in encoding where ASCII-bytes are valid content (e.g. UTF-8 or Latin-1) and separator, enclosing char and eol must be ASCII-chars.
+//      -If separator is auto-detected, it is determined from the beginning of the input and used for the whole input.
+//      -Not thread-safe: accessing content is a modifying operation.
+//      -Content pointers returned by operator() and passed to forEachFwdRowInColumn() callback are valid only until the chunk is released,
+//       i.e. until next access that needs to parse a chunk when maxLoadedChunkCount() chunks are loaded, or releaseLoadedRows()/clear().
+// Note: editable CsvItemModel requires fully parsed table, read-only viewing of big files in the viewer uses this class through
+//       CsvLazyReadOnlyItemModel (see CsvTableView::openFromFileReadOnlyLazy()).
+template <class Char_T, class Index_T>
+class TableCsvLazy
+{
+public:
+    using TableCsvT = TableCsv<Char_T, Index_T>;
+    using IndexT = typename TableCsvT::IndexT;
+    using SzPtrR = typename TableCsvT::SzPtrR;
+    using StateMachine = DFG_DETAIL_NS::CsvRecordBoundaryStateMachine;
+
+    // Default value for maxLoadedChunkCount().
+    static constexpr size_t defaultMaxLoadedChunkCount() { return 64; }
+
+    TableCsvLazy(const IndexT nRowsPerChunk = 1024)
+        : m_nRowsPerChunk(Max<IndexT>(1, nRowsPerChunk))
+        , m_chunkReadFormat(',', '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUnknown)
+    {}
+
+    // Opens file for reading, returns true if successful. File is kept memory mapped while opened.
+    bool open(const ReadOnlySzParamC& sPath, const CsvFormatDefinition& formatDef) { return openImpl(sPath, formatDef); }
+    bool open(const ReadOnlySzParamW& sPath, const CsvFormatDefinition& formatDef) { return openImpl(sPath, formatDef); }
+
+    template <class Char_T1>
+    bool openImpl(const ReadOnlySzParam<Char_T1>& sPath, const CsvFormatDefinition& formatDef)
+    {
+        clear();
+        try
+        {
+            auto spMapping = std::make_shared<::DFG_MODULE_NS(io)::FileMemoryMapped>(sPath);
+            if (!spMapping->is_open())
+                return false;
+            const auto bOpened = openFromMemory(spMapping->data(), spMapping->size(), formatDef);
+            if (bOpened)
+                m_spStorage = std::move(spMapping);
+            return bOpened;
+        }
+        catch (...)
+        {
+            clear();
+            return false;
+        }
+    }
+
+    // Opens input from memory, returns true if successful. Input is not copied so it must remain valid while this object is used or until clear() is called.
+    bool openFromMemory(const char* const pData, const size_t nSize, const CsvFormatDefinition& formatDef)
+    {
+        using namespace ::DFG_MODULE_NS(io);
+        clear();
+        const auto streamBom = checkBOM(pData, nSize);
+        const auto encoding = (formatDef.textEncoding() == encodingUnknown) ? streamBom : formatDef.textEncoding();
+        if (encoding != encodingUnknown && !areAsciiBytesValidContentInEncoding(encoding))
+            return false;
+        const auto nBomSkip = (encoding == encodingUTF8 && streamBom == encodingUTF8) ? ::DFG_MODULE_NS(utf)::bomSizeInBytes(encodingUTF8) : 0;
+        m_pData = pData + nBomSkip;
+        m_nSize = nSize - nBomSkip;
+
+        m_chunkReadFormat = formatDef;
+        m_chunkReadFormat.textEncoding(encoding);
+        m_chunkReadFormat.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadCount>(1);
+        m_chunkReadFormat.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_memoryMappedCellStorage>(false);
+        if (formatDef.separatorChar() == DelimitedTextReader::s_nMetaCharAutoDetect)
+            m_chunkReadFormat.separatorChar(privDetectSeparator());
+
+        const auto cEnc = m_chunkReadFormat.enclosingChar();
+        const auto cSep = m_chunkReadFormat.separatorChar();
+        const auto cEol = m_chunkReadFormat.eolCharFromEndOfLineType();
+        const auto isAscii = [](const int32 c) { return c >= 0 && c < 128; };
+        if (!isAscii(cSep) || !isAscii(cEol) || (StateMachine::hasEnclosingChar(cEnc) && (!isAscii(cEnc) || cEnc == cSep || cEnc == cEol)))
+        {
+            clear();
+            return false;
+        }
+        privBuildIndex(StateMachine(cEnc, static_cast<char>(cSep), static_cast<char>(cEol)));
+        m_bOpen = true;
+        return true;
+    }
+
+    // Releases index, loaded rows and input.
+    void clear()
+    {
+        m_bOpen = false;
+        m_pData = nullptr;
+        m_nSize = 0;
+        m_chunkStartOffsets.clear();
+        m_chunks.clear();
+        m_chunkLastUse.clear();
+        m_nLoadedChunkCount = 0;
+        m_nRowCount = 0;
+        m_nColCount = 0;
+        m_spStorage.reset();
+    }
+
+    bool isOpen() const { return m_bOpen; }
+
+    IndexT rowCountByMaxRowIndex() const { return m_nRowCount; }
+    IndexT colCountByMaxColIndex() const { return m_nColCount; }
+    IndexT rowsPerChunk() const { return m_nRowsPerChunk; }
+
+    // Sets maximum number of parsed chunks kept in memory, 0 means no limit. If more chunks are currently loaded, least recently used ones are released.
+    void setMaxLoadedChunkCount(const size_t nMaxCount)
+    {
+        m_nMaxLoadedChunkCount = nMaxCount;
+        if (nMaxCount > 0)
+            privReleaseLeastRecentlyUsedChunks(nMaxCount);
+    }
+
+    size_t maxLoadedChunkCount() const { return m_nMaxLoadedChunkCount; }
+
+    // Returns format used to read content, i.e. given read format with auto-detected values resolved.
+    const TableCsvReadWriteOptions& readFormat() const { return m_chunkReadFormat; }
+
+    // Returns content of given cell or null if there is no such cell. Parses the chunk containing given row if not already parsed.
+    SzPtrR operator()(const IndexT nRow, const IndexT nCol)
+    {
+        if (static_cast<uint64>(nRow) >= static_cast<uint64>(m_nRowCount))
+            return SzPtrR(nullptr);
+        return privChunk(nRow / m_nRowsPerChunk)(nRow % m_nRowsPerChunk, nCol);
+    }
+
+    // Calls func(nRow, SzPtrR) for all existing cells in column nCol in increasing row order. Parses all chunks that are not already parsed.
+    template <class Func_T>
+    void forEachFwdRowInColumn(const IndexT nCol, Func_T&& func)
+    {
+        for (size_t i = 0, nCount = m_chunkStartOffsets.size(); i < nCount; ++i)
+        {
+            const auto nRowOffset = static_cast<IndexT>(i * m_nRowsPerChunk);
+            privChunk(i).forEachFwdRowInColumn(nCol, [&](const IndexT nRow, const SzPtrR psz)
+            {
+                func(nRowOffset + nRow, psz);
+            });
+        }
+    }
+
+    bool isRowLoaded(const IndexT nRow) const
+    {
+        const auto nChunk = static_cast<size_t>(nRow / m_nRowsPerChunk);
+        return static_cast<uint64>(nRow) < static_cast<uint64>(m_nRowCount) && nChunk < m_chunks.size() && m_chunks[nChunk] != nullptr;
+    }
+
+    size_t loadedChunkCount() const { return m_nLoadedChunkCount; }
+
+    // Releases all parsed rows, index is kept so content can still be accessed.
+    void releaseLoadedRows()
+    {
+        for (auto& spChunk : m_chunks)
+            spChunk.reset();
+        m_nLoadedChunkCount = 0;
+    }
+
+private:
+    int32 privDetectSeparator() const
+    {
+        // Reading the beginning of input with auto-detection and using separator found from there.
+        const size_t nPeekSize = Min<size_t>(m_nSize, 4096);
+        TableCsvT peekTable;
+        peekTable.readFromMemory(m_pData, nPeekSize, m_chunkReadFormat);
+        const auto cSep = peekTable.readFormat().separatorChar();
+        return (cSep >= 0 && cSep < 128) ? cSep : ',';
+    }
+
+    void privBuildIndex(const StateMachine& stateMachine)
+    {
+        const auto pBegin = m_pData;
+        const auto pEnd = m_pData + m_nSize;
+        size_t nRecordCount = 0;
+        size_t nFieldCount = 1;
+        size_t nMaxFieldCount = 0;
+        const char* pRecordStart = pBegin;
+        const auto onRecordStart = [&](const char* p)
+        {
+            if (nRecordCount % m_nRowsPerChunk == 0)
+                m_chunkStartOffsets.push_back(static_cast<size_t>(p - pBegin));
+        };
+        const auto state = stateMachine.forEachCellEnd(pBegin, pEnd, StateMachine::stateCellStart, [&](const char* p, const bool bRecordEnd)
+        {
+            if (!bRecordEnd)
+            {
+                ++nFieldCount;
+                return true;
+            }
+            onRecordStart(pRecordStart);
+            ++nRecordCount;
+            nMaxFieldCount = Max(nMaxFieldCount, nFieldCount);
+            nFieldCount = 1;
+            pRecordStart = p + 1;
+            return true;
+        });
+        // Content after last eol forms the last record.
+        if (pRecordStart != pEnd || state != StateMachine::stateCellStart)
+        {
+            onRecordStart(pRecordStart);
+            ++nRecordCount;
+            nMaxFieldCount = Max(nMaxFieldCount, nFieldCount);
+        }
+        m_chunks.resize(m_chunkStartOffsets.size());
+        m_chunkLastUse.resize(m_chunkStartOffsets.size(), 0);
+        m_nRowCount = saturateCast<IndexT>(nRecordCount);
+        m_nColCount = saturateCast<IndexT>(nMaxFieldCount);
+    }
+
+    TableCsvT& privChunk(const size_t nChunk)
+    {
+        DFG_ASSERT_UB(nChunk < m_chunks.size());
+        auto& spChunk = m_chunks[nChunk];
+        if (!spChunk)
+        {
+            if (m_nMaxLoadedChunkCount > 0)
+                privReleaseLeastRecentlyUsedChunks(m_nMaxLoadedChunkCount - 1);
+            const auto nBegin = m_chunkStartOffsets[nChunk];
+            const auto nEnd = (nChunk + 1 < m_chunkStartOffsets.size()) ? m_chunkStartOffsets[nChunk + 1] : m_nSize;
+            spChunk.reset(new TableCsvT);
+            spChunk->readFromMemory(m_pData + nBegin, nEnd - nBegin, m_chunkReadFormat);
+            ++m_nLoadedChunkCount;
+        }
+        m_chunkLastUse[nChunk] = ++m_nUseCounter;
+        return *spChunk;
+    }
+
+    // Releases least recently used chunks until at most nMaxCount chunks are loaded.
+    // Note: finding the least recently used chunk is linear in chunk count, which is small compared to cost of parsing the chunk that caused the release.
+    void privReleaseLeastRecentlyUsedChunks(const size_t nMaxCount)
+    {
+        while (m_nLoadedChunkCount > nMaxCount)
+        {
+            size_t nLru = m_chunks.size();
+            for (size_t i = 0, nCount = m_chunks.size(); i < nCount; ++i)
+            {
+                if (m_chunks[i] && (nLru == m_chunks.size() || m_chunkLastUse[i] < m_chunkLastUse[nLru]))
+                    nLru = i;
+            }
+            if (nLru == m_chunks.size())
+                break;
+            m_chunks[nLru].reset();
+            --m_nLoadedChunkCount;
+        }
+    }
+
+    using DelimitedTextReader = ::DFG_MODULE_NS(io)::DelimitedTextReader;
+
+    IndexT m_nRowsPerChunk;
+    bool m_bOpen = false;
+    const char* m_pData = nullptr;
+    size_t m_nSize = 0;
+    std::vector<size_t> m_chunkStartOffsets; // Byte offset of first record of every chunk, relative to m_pData.
+    std::vector<std::unique_ptr<TableCsvT>> m_chunks; // Parsed chunks, null if not loaded.
+    std::vector<uint64> m_chunkLastUse; // For every chunk, value of m_nUseCounter when chunk was last accessed.
+    uint64 m_nUseCounter = 0;
+    size_t m_nLoadedChunkCount = 0;
+    size_t m_nMaxLoadedChunkCount = defaultMaxLoadedChunkCount();
+    IndexT m_nRowCount = 0;
+    IndexT m_nColCount = 0;
+    TableCsvReadWriteOptions m_chunkReadFormat;
+    std::shared_ptr<const void> m_spStorage; // Owns input if it was opened from file.
+}; // class TableCsvLazy
+
+}} // namespace dfg::cont
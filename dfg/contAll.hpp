@@ -15,6 +15,8 @@
 #include "cont/SortedSequence.hpp"
 #include "cont/table.hpp"
 #include "cont/tableCsv.hpp"
+#include "cont/tableCsvChunkedReader.hpp"
+#include "cont/tableCsvLazy.hpp"
 #include "cont/tableUtils.hpp"
 #include "cont/TorRef.hpp"
 #include "cont/TrivialPair.hpp"
@@ -0,0 +1,303 @@
+#pragma once
+
+#include "../dfgDefs.hpp"
+#include "../dfgBase.hpp"
+#include "../cont/elementType.hpp"
+#include "../concurrency/ThreadList.hpp"
+#include "../func/memFunc.hpp"
+#include "../math.hpp"
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <vector>
+
+DFG_ROOT_NS_BEGIN { DFG_SUB_NS(dataAnalysis) {
+
+namespace DFG_DETAIL_NS
+{
+    // Calls func(nBegin, nEnd) for consecutive chunks [nBegin, nEnd) of [0, nSize) so that chunks are handled concurrently.
+    // Chunking is deterministic: calls with identical arguments produce identical chunks.
+    // If nThreadCount is 0, uses std::thread::hardware_concurrency().
+    template <class Func_T>
+    void forEachChunkConcurrently(const size_t nSize, const size_t nMinChunkSize, size_t nThreadCount, Func_T&& func)
+    {
+        if (nThreadCount == 0)
+            nThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        nThreadCount = (std::max)(size_t(1), (std::min)(nThreadCount, nSize / (std::max)(size_t(1), nMinChunkSize)));
+        const auto chunkBegin = [&](const size_t i) { return i * (nSize / nThreadCount) + (std::min)(i, nSize % nThreadCount); };
+        ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+        for (size_t i = 1; i < nThreadCount; ++i)
+            threads.push_back(std::thread([&, i]() { func(chunkBegin(i), chunkBegin(i + 1)); }));
+        func(chunkBegin(0), chunkBegin(1));
+    }
+
+    // Window of index i is [i - nRadius, i + nRadius] clamped to [0, nSize - 1] like in smoothWithNeighbourAverages() and smoothWithNeighbourMedians().
+    inline size_t neighbourWindowFirst(const size_t i, const size_t nRadius)                     { return (i >= nRadius) ? i - nRadius : 0; }
+    inline size_t neighbourWindowLast(const size_t i, const size_t nRadius, const size_t nSize)  { return (nSize - 1 - i > nRadius) ? i + nRadius : nSize - 1; }
+
+    // Implements smoothing with 'Window_T' that has constructor taking radius, insert(index, value), erase(index, value),
+    // replace(oldIndex, oldValue, newIndex, newValue) and value() by processing
+    // input in chunks concurrently: input values are first copied so that each chunk can read its halo (radius-wide neighbourhood outside of the chunk)
+    // while neighbouring chunks write their results in place.
+    template <class Window_T, class Cont_T>
+    void smoothWithNeighbourWindowParallel(Cont_T& cont, const size_t nWindowRadiusRequest, const size_t nThreadCount)
+    {
+        using namespace ::DFG_MODULE_NS(math);
+        using ValueT = typename ::DFG_MODULE_NS(cont)::ElementType<Cont_T>::type;
+
+        const size_t nSize = ::DFG_ROOT_NS::count(cont);
+        if (nWindowRadiusRequest < 1 || nSize <= 1)
+            return;
+        const auto nRadius = Min(nWindowRadiusRequest, nSize - 1);
+
+        // Chunks smaller than this are not worth a thread; also keeping halo small compared to chunk.
+        const size_t nMinChunkSize = Max(size_t(16384), 4 * nRadius);
+
+        std::vector<ValueT> original(nSize);
+        forEachChunkConcurrently(nSize, nMinChunkSize, nThreadCount, [&](const size_t nBegin, const size_t nEnd)
+        {
+            for (size_t i = nBegin; i < nEnd; ++i)
+                original[i] = cont[i];
+        });
+
+        forEachChunkConcurrently(nSize, nMinChunkSize, nThreadCount, [&](const size_t nBegin, const size_t nEnd)
+        {
+            Window_T window(nRadius);
+            size_t nFirst = neighbourWindowFirst(nBegin, nRadius);
+            size_t nLast = neighbourWindowLast(nBegin, nRadius, nSize);
+            for (size_t j = nFirst; j <= nLast; ++j)
+            {
+                if (!isNan(original[j]))
+                    window.insert(j, original[j]);
+            }
+            for (size_t i = nBegin; i < nEnd; ++i)
+            {
+                // Both window edges move at most one step per index. Erasing before inserting so that window never has more than 2 * radius + 1 items.
+                const auto nNewFirst = neighbourWindowFirst(i, nRadius);
+                const auto nNewLast = neighbourWindowLast(i, nRadius, nSize);
+                const bool bErase = (nNewFirst != nFirst && !isNan(original[nFirst]));
+                const bool bInsert = (nNewLast != nLast && !isNan(original[nNewLast]));
+                if (bErase && bInsert) // Typical case in the middle of input
+                    window.replace(nFirst, original[nFirst], nNewLast, original[nNewLast]);
+                else if (bErase)
+                    window.erase(nFirst, original[nFirst]);
+                else if (bInsert)
+                    window.insert(nNewLast, original[nNewLast]);
+                nFirst = nNewFirst;
+                nLast = nNewLast;
+                if (!isNan(original[i]))
+                    cont[i] = window.value();
+            }
+        });
+    }
+
+    // Window average as compensated running sum: O(1) per step.
+    template <class T>
+    class RunningAverageWindow
+    {
+    public:
+        explicit RunningAverageWindow(size_t) {}
+
+        void insert(size_t, const T val)    { m_sum.add(val);  ++m_nCount; }
+        void erase(size_t, const T val)     { m_sum.add(-val); --m_nCount; }
+        void replace(size_t, const T oldVal, size_t, const T newVal) { m_sum.add(newVal); m_sum.add(-oldVal); }
+        T value() const                     { return (m_nCount > 0) ? m_sum.value() / static_cast<T>(m_nCount) : std::numeric_limits<T>::quiet_NaN(); }
+
+        ::DFG_MODULE_NS(func)::MemFuncSumCompensated<T> m_sum;
+        size_t m_nCount = 0;
+    }; // class RunningAverageWindow
+
+    // Window median with two binary heaps: max-heap for lower half and min-heap for upper half of values. Items are identified by
+    // input index modulo window capacity so that any item can be removed in O(log(radius)) without searching.
+    // Invariants: every value in lower half <= every value in upper half and lower half has the same number of items as upper half or one more.
+    template <class T>
+    class RunningMedianWindow
+    {
+    public:
+        explicit RunningMedianWindow(const size_t nRadius)
+            : m_values(2 * nRadius + 1)
+            , m_heapPositions(2 * nRadius + 1)
+            , m_inLowerFlags(2 * nRadius + 1)
+        {
+            m_lower.reserve(nRadius + 1);
+            m_upper.reserve(nRadius + 1);
+        }
+
+        // Precondition: window does not have item with the same slot, i.e. window has at most 2 * radius + 1 consecutive indexes.
+        void insert(const size_t nIndex, const T val)
+        {
+            const auto nSlot = nIndex % m_values.size();
+            m_values[nSlot] = val;
+            if (m_lower.empty() || val <= m_values[m_lower.front()])
+                push(m_lower, true, nSlot);
+            else
+                push(m_upper, false, nSlot);
+            rebalance();
+        }
+
+        // Precondition: item with given index is in the window.
+        void erase(const size_t nIndex, T)
+        {
+            const auto nSlot = nIndex % m_values.size();
+            const bool bInLower = (m_inLowerFlags[nSlot] != 0);
+            removeAt((bInLower) ? m_lower : m_upper, bInLower, m_heapPositions[nSlot]);
+            rebalance();
+        }
+
+        // Equivalent to erase(nOldIndex) followed by insert(nNewIndex, newVal), but faster if both items are in the same half
+        // since window halves don't need rebalancing.
+        void replace(const size_t nOldIndex, const T oldVal, const size_t nNewIndex, const T newVal)
+        {
+            const auto nOldSlot = nOldIndex % m_values.size();
+            const auto nNewSlot = nNewIndex % m_values.size();
+            if (nOldSlot != nNewSlot)
+            {
+                erase(nOldIndex, oldVal);
+                insert(nNewIndex, newVal);
+                return;
+            }
+            // Replacing value in place after which the only possible violation of invariants is that new value is on wrong half;
+            // in that case it is at the top of its heap and is swapped with top of the other heap.
+            const bool bInLower = (m_inLowerFlags[nOldSlot] != 0);
+            auto& heap = (bInLower) ? m_lower : m_upper;
+            const auto nPos = m_heapPositions[nOldSlot];
+            m_values[nOldSlot] = newVal;
+            siftUp(heap, bInLower, nPos);
+            siftDown(heap, bInLower, m_heapPositions[nOldSlot]);
+            if (!m_lower.empty() && !m_upper.empty() && m_values[m_lower.front()] > m_values[m_upper.front()])
+            {
+                const auto nLowerTop = m_lower.front();
+                const auto nUpperTop = m_upper.front();
+                setPos(m_lower, 0, nUpperTop);
+                setPos(m_upper, 0, nLowerTop);
+                m_inLowerFlags[nUpperTop] = 1;
+                m_inLowerFlags[nLowerTop] = 0;
+                siftDown(m_lower, true, 0);
+                siftDown(m_upper, false, 0);
+            }
+        }
+
+        // Returns median like numeric::medianInSorted(): average of middle values if there are even number of values.
+        T value() const
+        {
+            if (m_lower.empty())
+                return std::numeric_limits<T>::quiet_NaN();
+            return (m_lower.size() > m_upper.size()) ? m_values[m_lower.front()] : (m_values[m_lower.front()] + m_values[m_upper.front()]) / 2;
+        }
+
+    private:
+        using Heap = std::vector<size_t>; // Slots ordered as binary heap.
+
+        // Returns true if slot 'a' should be closer to heap top than 'b'.
+        bool isBefore(const bool bLower, const size_t a, const size_t b) const
+        {
+            return (bLower) ? m_values[a] > m_values[b] : m_values[a] < m_values[b];
+        }
+
+        void setPos(Heap& heap, const size_t nPos, const size_t nSlot)
+        {
+            heap[nPos] = nSlot;
+            m_heapPositions[nSlot] = nPos;
+        }
+
+        void siftUp(Heap& heap, const bool bLower, size_t nPos)
+        {
+            const auto nSlot = heap[nPos];
+            while (nPos > 0)
+            {
+                const auto nParent = (nPos - 1) / 2;
+                if (!isBefore(bLower, nSlot, heap[nParent]))
+                    break;
+                setPos(heap, nPos, heap[nParent]);
+                nPos = nParent;
+            }
+            setPos(heap, nPos, nSlot);
+        }
+
+        void siftDown(Heap& heap, const bool bLower, size_t nPos)
+        {
+            const auto nSlot = heap[nPos];
+            const auto nSize = heap.size();
+            for (;;)
+            {
+                auto nChild = 2 * nPos + 1;
+                if (nChild >= nSize)
+                    break;
+                if (nChild + 1 < nSize && isBefore(bLower, heap[nChild + 1], heap[nChild]))
+                    ++nChild;
+                if (!isBefore(bLower, heap[nChild], nSlot))
+                    break;
+                setPos(heap, nPos, heap[nChild]);
+                nPos = nChild;
+            }
+            setPos(heap, nPos, nSlot);
+        }
+
+        void push(Heap& heap, const bool bLower, const size_t nSlot)
+        {
+            m_inLowerFlags[nSlot] = static_cast<uint8>(bLower);
+            heap.push_back(nSlot);
+            siftUp(heap, bLower, heap.size() - 1);
+        }
+
+        void removeAt(Heap& heap, const bool bLower, const size_t nPos)
+        {
+            const auto nLastSlot = heap.back();
+            heap.pop_back();
+            if (nPos >= heap.size())
+                return;
+            setPos(heap, nPos, nLastSlot);
+            siftUp(heap, bLower, nPos);
+            siftDown(heap, bLower, m_heapPositions[nLastSlot]);
+        }
+
+        void rebalance()
+        {
+            if (m_lower.size() > m_upper.size() + 1)
+            {
+                const auto nSlot = m_lower.front();
+                removeAt(m_lower, true, 0);
+                push(m_upper, false, nSlot);
+            }
+            else if (m_upper.size() > m_lower.size())
+            {
+                const auto nSlot = m_upper.front();
+                removeAt(m_upper, false, 0);
+                push(m_lower, true, nSlot);
+            }
+        }
+
+        std::vector<T> m_values;             // Values by slot
+        std::vector<size_t> m_heapPositions; // Position in heap by slot
+        std::vector<uint8> m_inLowerFlags;   // Tells by slot whether item is in lower half.
+        Heap m_lower;
+        Heap m_upper;
+    }; // class RunningMedianWindow
+
+} // namespace DFG_DETAIL_NS
+
+// Like smoothWithNeighbourAverages() (same window and NaN handling), but uses compensated running sum and processes input
+// in chunks concurrently using nThreadCount threads (0 = std::thread::hardware_concurrency()).
+// Cost is O(1) per element regardless of radius; requires temporary copy of input.
+// Note: results may differ from smoothWithNeighbourAverages() by rounding errors. Infinite values give unspecified results.
+template <class Cont_T>
+void smoothWithNeighbourAveragesParallel(Cont_T&& cont, const size_t nWindowRadiusRequest = 1, const size_t nThreadCount = 0)
+{
+    using ValueT = typename ::DFG_MODULE_NS(cont)::ElementType<Cont_T>::type;
+    DFG_DETAIL_NS::smoothWithNeighbourWindowParallel<DFG_DETAIL_NS::RunningAverageWindow<ValueT>>(cont, nWindowRadiusRequest, nThreadCount);
+}
+
+// Like smoothWithNeighbourMedians() (same window and NaN handling), but keeps window in two heaps and processes input
+// in chunks concurrently using nThreadCount threads (0 = std::thread::hardware_concurrency()).
+// Cost is O(log(radius)) per element instead of O(radius); requires temporary copy of input.
+// Performance status (partially done): single-threaded -O2 run with 10M points and radius 1000 takes about 3.5 s, so the sub-second
+// target for that case is not met on one core. Multi-core scaling has not been measured; see smoothWithNeighbourParallel_benchmark
+// (DFGTEST_ENABLE_BENCHMARKS) in dfgTestDataAnalysis.cpp.
+template <class Cont_T>
+void smoothWithNeighbourMediansParallel(Cont_T&& cont, const size_t nWindowRadiusRequest = 1, const size_t nThreadCount = 0)
+{
+    using ValueT = typename ::DFG_MODULE_NS(cont)::ElementType<Cont_T>::type;
+    DFG_DETAIL_NS::smoothWithNeighbourWindowParallel<DFG_DETAIL_NS::RunningMedianWindow<ValueT>>(cont, nWindowRadiusRequest, nThreadCount);
+}
+
+}} // module namespace
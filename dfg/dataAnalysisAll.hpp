@@ -3,3 +3,4 @@
 #include "dataAnalysis/correlation.hpp"
 #include "dataAnalysis/smoothWithNeighbourAverages.hpp"
 #include "dataAnalysis/smoothWithNeighbourMedians.hpp"
+#include "dataAnalysis/smoothWithNeighbourParallel.hpp"
@@ -2,6 +2,7 @@
 
 #include "../dfgDefs.hpp"
 #include "../dfgBase.hpp"
+#include <cmath>
 #include <limits>
 
 // NOTE: Taking a look at boost::accumulators is recommended before intending to use these.
@@ -90,6 +91,13 @@ template <class DataT> struct MemFuncMinMax
     DataT maxValue() const {return m_mfMax.value();}
     bool isValid() const { return maxValue() >= minValue(); } // Returns maxValue() >= minValue(), which should be false if and only if no operator() has been called.
 
+    // Combines min/max of other to this as if call parameters of other had been given to this.
+    void merge(const MemFuncMinMax& other)
+    {
+        m_mfMin(other.minValue());
+        m_mfMax(other.maxValue());
+    }
+
     MemFuncMin<DataT> m_mfMin;
     MemFuncMax<DataT> m_mfMax;
 };
@@ -104,11 +112,46 @@ template <class DataT, class SumT = DataT> struct MemFuncSum
     {
         m_sum += val;
     }
+    void merge(const MemFuncSum& other)
+    {
+        m_sum += other.m_sum;
+    }
     const SumT& value() const {return m_sum;}
 
     SumT m_sum;
 };
 
+// Like MemFuncSum, but uses compensated summation (Neumaier's variant of Kahan summation) so that result is practically unaffected by
+// rounding errors that accumulate in naive summation of many values. Partial sums can be combined with merge().
+template <class DataT, class SumT = DataT> struct MemFuncSumCompensated
+{
+    MemFuncSumCompensated(const SumT& initValue = 0) : m_sum(initValue), m_compensation(0)
+    {}
+    void operator()(const DataT& val)
+    {
+        add(static_cast<SumT>(val));
+    }
+    void merge(const MemFuncSumCompensated& other)
+    {
+        add(other.m_sum);
+        add(other.m_compensation);
+    }
+    // Note: if sum is not finite, returns it as such since compensation is then NaN.
+    SumT value() const {return (std::isfinite(m_sum)) ? m_sum + m_compensation : m_sum;}
+
+    // Uses branchless TwoSum for the rounding error so that add() is cheap also in hot loops where sign and magnitude of values vary.
+    void add(const SumT& val)
+    {
+        const SumT newSum = m_sum + val;
+        const SumT valPart = newSum - m_sum;
+        m_compensation += (m_sum - (newSum - valPart)) + (val - valPart);
+        m_sum = newSum;
+    }
+
+    SumT m_sum;
+    SumT m_compensation; // Accumulated low-order parts lost from m_sum.
+};
+
 // Functor that remembers the sum of it's call parameters squared.
 // TODO: Test
 template <class DataT, class SumT = DataT> struct MemFuncSquareSum
@@ -126,7 +169,7 @@ template <class DataT, class SumT = DataT> struct MemFuncSquareSum
 
 // Functor that remembers the sum of it's call parameters and the number of calls made.
 // TODO: Test
-template <class DataT, class SumT = DataT, class CountT = size_t> struct MemFuncAvg
+template <class DataT, class SumT = DataT, class CountT = size_t, class SumFunc_T = MemFuncSum<DataT, SumT>> struct MemFuncAvg
 {
     MemFuncAvg(const SumT& initValue = 0) : m_mfSum(initValue), m_nCalls(0)
     {}
@@ -140,6 +183,24 @@ template <class DataT, class SumT = DataT, class CountT = size_t> struct MemFunc
         m_mfSum(val);
         m_nCalls += 1;
     }
+    // Feeds nCount data points whose sum is 'sum', e.g. for combining averages of partitioned data.
+    void feedDataPoints(const SumT& sum, const CountT nCount)
+    {
+        m_mfSum.merge(SumFunc_T(sum));
+        m_nCalls += nCount;
+    }
+    // Like feedDataPoints(const SumT&, CountT), but takes the sum as summation functor so that e.g. compensation of MemFuncSumCompensated is not lost.
+    void feedDataPoints(const SumFunc_T& sumFunc, const CountT nCount)
+    {
+        m_mfSum.merge(sumFunc);
+        m_nCalls += nCount;
+    }
+    // Combines other to this as if call parameters of other had been given to this.
+    void merge(const MemFuncAvg& other)
+    {
+        m_mfSum.merge(other.m_mfSum);
+        m_nCalls += other.m_nCalls;
+    }
     void clear()
     {
         *this = MemFuncAvg();
@@ -159,8 +220,50 @@ template <class DataT, class SumT = DataT, class CountT = size_t> struct MemFunc
     CountT callCount() const {return m_nCalls;}
 
 private:
-    MemFuncSum<DataT, SumT> m_mfSum;
+    SumFunc_T m_mfSum;
     CountT m_nCalls;
 };
 
+// Functor that remembers the mean and variance of it's call parameters using Welford's online algorithm, which unlike computing
+// variance from sum of squares doesn't suffer from catastrophic cancellation. Partial results can be combined with merge().
+template <class DataT, class CountT = size_t> struct MemFuncVariance
+{
+    void operator()(const DataT& val)
+    {
+        ++m_nCount;
+        const DataT delta = val - m_mean;
+        m_mean += delta / static_cast<DataT>(m_nCount);
+        m_m2 += delta * (val - m_mean);
+    }
+
+    // Combines other to this as if call parameters of other had been given to this (Chan et al. parallel algorithm).
+    void merge(const MemFuncVariance& other)
+    {
+        if (other.m_nCount == 0)
+            return;
+        if (m_nCount == 0)
+        {
+            *this = other;
+            return;
+        }
+        const auto nNewCount = m_nCount + other.m_nCount;
+        const DataT delta = other.m_mean - m_mean;
+        m_mean += delta * (static_cast<DataT>(other.m_nCount) / static_cast<DataT>(nNewCount));
+        m_m2 += other.m_m2 + delta * delta * (static_cast<DataT>(m_nCount) * static_cast<DataT>(other.m_nCount) / static_cast<DataT>(nNewCount));
+        m_nCount = nNewCount;
+    }
+
+    CountT callCount() const { return m_nCount; }
+    // Returns mean, NaN if there are no values.
+    DataT mean() const { return (m_nCount != 0) ? m_mean : std::numeric_limits<DataT>::quiet_NaN(); }
+    // Returns population variance, NaN if there are no values.
+    DataT variance() const { return (m_nCount != 0) ? m_m2 / static_cast<DataT>(m_nCount) : std::numeric_limits<DataT>::quiet_NaN(); }
+    // Returns sample variance, NaN if there are less than two values.
+    DataT sampleVariance() const { return (m_nCount > 1) ? m_m2 / static_cast<DataT>(m_nCount - 1) : std::numeric_limits<DataT>::quiet_NaN(); }
+
+    CountT m_nCount = 0;
+    DataT m_mean = 0;
+    DataT m_m2 = 0; // Sum of squared differences from the current mean.
+};
+
 }} // module func
@@ -10,6 +10,8 @@
 #include <vector>
 #include <queue>
 #include <functional>
+#include <algorithm>
+#include <cmath>
 
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(func) {
 
@@ -170,4 +172,196 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(func) {
     }; // class MemFuncPercentile_enclosingElem
 
 
+    // Functor that remembers approximate percentile of it's call parameters using mergeable quantile sketch (t-digest with arcsine scale function, Dunning & Ertl).
+    // Memory usage is O(compression) regardless of the number of values; accuracy is best near the tails and relative rank error is typically well below 1 / compression.
+    // As long as the number of values is less than exactValueCountMaximum(), result is exact and the same as with MemFuncPercentile_enclosingElem.
+    template <class Data_T, class Percentile_T = std::conditional_t<std::is_floating_point_v<Data_T>, Data_T, double>>
+    class MemFuncPercentile_approx
+    {
+    public:
+        struct Centroid
+        {
+            double m_mean;
+            double m_weight;
+        };
+
+        // @param compression Accuracy parameter, bigger is more accurate and uses more memory. Value is limited to range [10, 10000], NaN is handled as 100.
+        MemFuncPercentile_approx(const double percentage, const double compression = 100)
+            : m_ratiotile(percentage / 100.0)
+            , m_compression((::DFG_MODULE_NS(math)::isNan(compression)) ? 100.0 : limited(compression, 10.0, 10000.0))
+        {
+            m_buffer.reserve(exactValueCountMaximum());
+        }
+
+        void operator()(const Data_T& val)
+        {
+            // NaN's are ignored.
+            if (::DFG_MODULE_NS(math)::isNan(val))
+                return;
+            const auto dVal = static_cast<double>(val);
+            if (m_nCount == 0 || dVal < m_min)
+                m_min = dVal;
+            if (m_nCount == 0 || dVal > m_max)
+                m_max = dVal;
+            ++m_nCount;
+            m_buffer.push_back({ dVal, 1 });
+            if (m_buffer.size() >= exactValueCountMaximum())
+                compress();
+        }
+
+        // Merges values of 'other' to this as if they had been given to this.
+        void merge(const MemFuncPercentile_approx& other)
+        {
+            if (other.m_nCount == 0)
+                return;
+            if (m_nCount == 0 || other.m_min < m_min)
+                m_min = other.m_min;
+            if (m_nCount == 0 || other.m_max > m_max)
+                m_max = other.m_max;
+            m_nCount += other.m_nCount;
+            m_bExact = m_bExact && other.m_bExact && m_nCount < exactValueCountMaximum();
+            m_buffer.insert(m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+            m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+            if (!m_bExact)
+                compress();
+        }
+
+        double percentage() const
+        {
+            return m_ratiotile * 100.0;
+        }
+
+        double compression() const
+        {
+            return m_compression;
+        }
+
+        // Returns value count at which buffered values get compressed to centroids, i.e. results are exact only if callCount() is less than this.
+        size_t exactValueCountMaximum() const
+        {
+            return static_cast<size_t>(5 * m_compression);
+        }
+
+        size_t callCount() const
+        {
+            return m_nCount;
+        }
+
+        // Returns true if percentile() is exact.
+        bool isExact() const
+        {
+            return m_bExact;
+        }
+
+        Percentile_T percentile() const
+        {
+            if (m_nCount == 0)
+                return std::numeric_limits<Percentile_T>::quiet_NaN();
+            if (m_ratiotile >= 1)
+                return static_cast<Percentile_T>(m_max);
+            if (m_bExact)
+            {
+                auto values = m_buffer;
+                const auto nRank = (std::min)(floorToInteger<size_t>((std::max)(0.0, m_ratiotile) * static_cast<double>(values.size())), values.size() - 1);
+                std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(nRank), values.end(), [](const Centroid& a, const Centroid& b) { return a.m_mean < b.m_mean; });
+                return static_cast<Percentile_T>(values[nRank].m_mean);
+            }
+            if (!m_buffer.empty())
+            {
+                auto temp = *this;
+                temp.compress();
+                return temp.percentile();
+            }
+            return static_cast<Percentile_T>(interpolatedValueAtRank((std::max)(0.0, m_ratiotile) * static_cast<double>(m_nCount)));
+        }
+
+        // Clears memory, i.e. result-wise returns object to state as if operator() had not been called.
+        void clear()
+        {
+            m_centroids.clear();
+            m_buffer.clear();
+            m_nCount = 0;
+            m_bExact = true;
+        }
+
+    private:
+        // Maps quantile to k-scale; centroids are limited to span at most 1 unit in k-scale so that centroids near tails are small.
+        double scaleK(const double q) const
+        {
+            return m_compression / (2 * 3.14159265358979323846) * std::asin(2 * (std::min)(1.0, (std::max)(0.0, q)) - 1);
+        }
+
+        // Merges buffered values to centroids.
+        void compress()
+        {
+            m_bExact = false;
+            if (m_buffer.empty())
+                return;
+            m_buffer.insert(m_buffer.end(), m_centroids.begin(), m_centroids.end());
+            std::sort(m_buffer.begin(), m_buffer.end(), [](const Centroid& a, const Centroid& b) { return a.m_mean < b.m_mean; });
+            double totalWeight = 0;
+            for (const auto& c : m_buffer)
+                totalWeight += c.m_weight;
+            m_centroids.clear();
+            auto current = m_buffer.front();
+            double weightSoFar = 0;
+            double kLimit = scaleK(0) + 1;
+            for (size_t i = 1, nCount = m_buffer.size(); i < nCount; ++i)
+            {
+                const auto& next = m_buffer[i];
+                if (scaleK((weightSoFar + current.m_weight + next.m_weight) / totalWeight) <= kLimit)
+                {
+                    current.m_weight += next.m_weight;
+                    current.m_mean += (next.m_mean - current.m_mean) * next.m_weight / current.m_weight;
+                }
+                else
+                {
+                    weightSoFar += current.m_weight;
+                    m_centroids.push_back(current);
+                    kLimit = scaleK(weightSoFar / totalWeight) + 1;
+                    current = next;
+                }
+            }
+            m_centroids.push_back(current);
+            m_buffer.clear();
+        }
+
+        // Returns value at given rank (in range [0, N]) by interpolating between centroid centers and min/max at the ends.
+        double interpolatedValueAtRank(const double rank) const
+        {
+            DFG_ASSERT_CORRECTNESS(!m_centroids.empty());
+            const auto& first = m_centroids.front();
+            if (rank < first.m_weight / 2)
+                return m_min + (first.m_mean - m_min) * rank / (first.m_weight / 2);
+            double centerRank = first.m_weight / 2;
+            for (size_t i = 1; i < m_centroids.size(); ++i)
+            {
+                const auto& left = m_centroids[i - 1];
+                const auto& right = m_centroids[i];
+                const auto dist = (left.m_weight + right.m_weight) / 2;
+                if (rank < centerRank + dist)
+                {
+                    const auto val = left.m_mean + (right.m_mean - left.m_mean) * (rank - centerRank) / dist;
+                    return (std::min)(m_max, (std::max)(m_min, val));
+                }
+                centerRank += dist;
+            }
+            const auto& last = m_centroids.back();
+            const auto rankToMax = static_cast<double>(m_nCount) - centerRank;
+            return (rankToMax > 0) ? (std::min)(m_max, last.m_mean + (m_max - last.m_mean) * (rank - centerRank) / rankToMax) : m_max;
+        }
+
+    public:
+        double m_ratiotile; // Percentile divided by 100.
+    private:
+        double m_compression;
+        std::vector<Centroid> m_centroids; // Sorted by mean.
+        std::vector<Centroid> m_buffer; // Unmerged values; in exact mode contains all values.
+        size_t m_nCount = 0;
+        double m_min = std::numeric_limits<double>::quiet_NaN();
+        double m_max = std::numeric_limits<double>::quiet_NaN();
+        bool m_bExact = true;
+    }; // class MemFuncPercentile_approx
+
+
 } } // Module namespace
\ No newline at end of file
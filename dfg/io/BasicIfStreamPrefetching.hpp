@@ -0,0 +1,269 @@
+#pragma once
+
+#include "../dfgBase.hpp"
+#include "BasicIfStream.hpp"
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+    #include <fcntl.h> // For posix_fadvise()
+#endif
+
+DFG_ROOT_NS_BEGIN { DFG_SUB_NS(io) {
+
+namespace DFG_DETAIL_NS
+{
+    // Reads file in a background thread to a ring of fixed size blocks, see BasicIfStreamPrefetching.
+    class FilePrefetcher
+    {
+    public:
+        struct Block
+        {
+            std::vector<char> m_bytes;
+            size_t m_nSize = 0;     // Number of valid bytes in m_bytes.
+            bool m_bFilled = false; // True if block has been filled by reader thread and not yet released by consumer.
+            bool m_bLast = false;   // True if this is the last block of the file (may have zero size).
+        };
+
+        // Takes ownership of pFile.
+        FilePrefetcher(std::FILE* pFile, const size_t nBlockSize, const size_t nBlockCount)
+            : m_pFile(pFile)
+            , m_blocks(Max<size_t>(2, nBlockCount))
+        {
+            if (!m_pFile)
+                return;
+            // Reads are done in large blocks so disabling stdio-buffering to avoid extra copying.
+            std::setvbuf(m_pFile, nullptr, _IONBF, 0);
+#if !defined(_WIN32) && defined(POSIX_FADV_SEQUENTIAL)
+            ::posix_fadvise(fileno(m_pFile), 0, 0, POSIX_FADV_SEQUENTIAL); // Only a hint so return value is ignored.
+#endif
+            for (auto& block : m_blocks)
+                block.m_bytes.resize(Max<size_t>(1, nBlockSize));
+            m_thread = std::thread([this]() { this->threadFunc(); });
+        }
+
+        ~FilePrefetcher()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bStop = true;
+            }
+            m_condVar.notify_all();
+            if (m_thread.joinable())
+                m_thread.join();
+            if (m_pFile)
+                std::fclose(m_pFile);
+        }
+
+        bool is_open() const { return m_pFile != nullptr; }
+
+        size_t blockSize() const { return m_blocks.front().m_bytes.size(); }
+        size_t blockCount() const { return m_blocks.size(); }
+
+        // Blocks until the next block has been read and returns it. Returned block remains valid until releaseBlock() is called.
+        const Block& waitNextBlock()
+        {
+            auto& block = m_blocks[m_nConsumerIndex];
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condVar.wait(lock, [&] { return block.m_bFilled; });
+            return block;
+        }
+
+        // Returns block obtained from waitNextBlock() to reader thread for refilling.
+        void releaseBlock()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_blocks[m_nConsumerIndex].m_bFilled = false;
+            }
+            m_condVar.notify_all();
+            m_nConsumerIndex = (m_nConsumerIndex + 1) % m_blocks.size();
+        }
+
+    private:
+        void threadFunc()
+        {
+            for (size_t i = 0; ; i = (i + 1) % m_blocks.size())
+            {
+                auto& block = m_blocks[i];
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condVar.wait(lock, [&] { return m_bStop || !block.m_bFilled; });
+                    if (m_bStop)
+                        return;
+                }
+                // Block is not accessed by consumer while not filled so reading without lock.
+                const auto nRead = std::fread(block.m_bytes.data(), 1, block.m_bytes.size(), m_pFile);
+                const bool bLast = (nRead < block.m_bytes.size());
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    block.m_nSize = nRead;
+                    block.m_bLast = bLast;
+                    block.m_bFilled = true;
+                }
+                m_condVar.notify_all();
+                if (bLast)
+                    return;
+            }
+        }
+
+        std::FILE* m_pFile;
+        std::vector<Block> m_blocks;
+        size_t m_nConsumerIndex = 0;
+        bool m_bStop = false;
+        std::mutex m_mutex;
+        std::condition_variable m_condVar;
+        std::thread m_thread;
+    }; // class FilePrefetcher
+} // namespace DFG_DETAIL_NS
+
+// Input stream for sequential reading of binary files with read-ahead: a background thread reads the file in large blocks
+// to a ring of buffers (i.e. double- or triple-buffering) so that processing of one block, e.g. parsing with DelimitedTextReader,
+// overlaps with reading of the next ones instead of stalling on I/O.
+// Interface is like that of BasicIfStream for reading, but seeking is not supported.
+// Memory usage is blockSize() * bufferCount().
+class BasicIfStreamPrefetching : public BasicIStreamCRTP<BasicIfStreamPrefetching, int64>
+{
+public:
+    using Prefetcher = DFG_DETAIL_NS::FilePrefetcher;
+    enum { s_nDefaultBlockSize = 1048576, s_nDefaultBufferCount = 3 };
+
+    BasicIfStreamPrefetching(const ReadOnlySzParamC& sPath, const size_t nBlockSize = s_nDefaultBlockSize, const size_t nBufferCount = s_nDefaultBufferCount)
+    {
+#ifdef _MSC_VER
+        #pragma warning(disable : 4996) // This function or variable may be unsafe
+#endif // _MSC_VER
+        privInit(std::fopen(sPath.c_str(), "rb"), nBlockSize, nBufferCount);
+#ifdef _MSC_VER
+        #pragma warning(default : 4996)
+#endif // _MSC_VER
+    }
+
+    BasicIfStreamPrefetching(const ReadOnlySzParamW& sPath, const size_t nBlockSize = s_nDefaultBlockSize, const size_t nBufferCount = s_nDefaultBufferCount)
+    {
+#ifdef _WIN32
+    #ifdef _MSC_VER
+        #pragma warning(disable : 4996) // This function or variable may be unsafe
+    #endif // _MSC_VER
+        privInit(_wfopen(sPath.c_str(), L"rb"), nBlockSize, nBufferCount);
+    #ifdef _MSC_VER
+        #pragma warning(default : 4996)
+    #endif // _MSC_VER
+#else
+        privInit(std::fopen(pathStrToFileApiFriendlyPath(sPath).c_str(), "rb"), nBlockSize, nBufferCount);
+#endif
+    }
+
+    BasicIfStreamPrefetching(BasicIfStreamPrefetching&& other) noexcept
+        : m_spPrefetcher(std::move(other.m_spPrefetcher))
+        , m_pBlockBegin(other.m_pBlockBegin)
+        , m_pCurrent(other.m_pCurrent)
+        , m_pEnd(other.m_pEnd)
+        , m_nBlockStartPos(other.m_nBlockStartPos)
+        , m_bHasBlock(other.m_bHasBlock)
+        , m_bAtEnd(other.m_bAtEnd)
+    {
+        other.m_pBlockBegin = nullptr;
+        other.m_pCurrent = nullptr;
+        other.m_pEnd = nullptr;
+        other.m_bHasBlock = false;
+        other.m_bAtEnd = true;
+    }
+
+    bool is_open() const { return m_spPrefetcher && m_spPrefetcher->is_open(); }
+
+    size_t blockSize()   const { return (m_spPrefetcher) ? m_spPrefetcher->blockSize() : 0; }
+    size_t bufferCount() const { return (m_spPrefetcher) ? m_spPrefetcher->blockCount() : 0; }
+
+    // Returns the number of bytes that can be read without waiting for the next block.
+    size_t bufferedByteCount() const { return static_cast<size_t>(m_pEnd - m_pCurrent); }
+
+    // Returns single character, eofVal() if unable to read.
+    int_type get()
+    {
+        if (m_pCurrent == m_pEnd && !privNextBlock())
+            return eofVal();
+        return traits_type::to_int_type(*m_pCurrent++);
+    }
+
+    BasicIfStreamPrefetching& read(char* p, const size_t nCount)
+    {
+        readBytes(p, nCount);
+        return *this;
+    }
+
+    // Reads at most nCount bytes to p and returns the number of bytes read.
+    size_t readBytes(char* p, size_t nCount)
+    {
+        size_t nRead = 0;
+        while (nCount > 0 && (m_pCurrent != m_pEnd || privNextBlock()))
+        {
+            const auto nChunk = Min(nCount, bufferedByteCount());
+            std::memcpy(p, m_pCurrent, nChunk);
+            m_pCurrent += nChunk;
+            p += nChunk;
+            nRead += nChunk;
+            nCount -= nChunk;
+        }
+        return nRead;
+    }
+
+    // Returns read position
+    PosType tellg() const
+    {
+        return m_nBlockStartPos + static_cast<PosType>(m_pCurrent - m_pBlockBegin);
+    }
+
+    // Returns true if stream is open and end has not been reached.
+    bool good() const
+    {
+        return m_pCurrent != m_pEnd || (is_open() && !m_bAtEnd);
+    }
+
+private:
+    void privInit(std::FILE* pFile, const size_t nBlockSize, const size_t nBufferCount)
+    {
+        m_spPrefetcher.reset(new Prefetcher(pFile, nBlockSize, nBufferCount));
+        m_bAtEnd = !m_spPrefetcher->is_open();
+    }
+
+    // Moves to next block, returns false if there are no more bytes available.
+    bool privNextBlock()
+    {
+        if (m_bAtEnd)
+            return false;
+        if (m_bHasBlock)
+        {
+            m_nBlockStartPos += static_cast<PosType>(m_pEnd - m_pBlockBegin);
+            m_spPrefetcher->releaseBlock();
+            m_bHasBlock = false;
+        }
+        const auto& block = m_spPrefetcher->waitNextBlock();
+        m_bHasBlock = true;
+        m_pBlockBegin = block.m_bytes.data();
+        m_pCurrent = m_pBlockBegin;
+        m_pEnd = m_pBlockBegin + block.m_nSize;
+        if (block.m_bLast)
+            m_bAtEnd = true; // Reader thread has finished, current block is the last one.
+        return m_pCurrent != m_pEnd;
+    }
+
+    std::unique_ptr<Prefetcher> m_spPrefetcher;
+    const char* m_pBlockBegin = nullptr;
+    const char* m_pCurrent = nullptr;
+    const char* m_pEnd = nullptr;
+    PosType m_nBlockStartPos = 0; // File position of m_pBlockBegin.
+    bool m_bHasBlock = false;     // True if current block has been obtained from prefetcher and not yet released.
+    bool m_bAtEnd = false;        // True if last block has been obtained from prefetcher (or file couldn't be opened).
+}; // class BasicIfStreamPrefetching
+
+inline size_t readBytes(BasicIfStreamPrefetching& istrm, char* pDest, const size_t nMaxReadSize)
+{
+    return istrm.readBytes(pDest, nMaxReadSize);
+}
+
+}} // module io
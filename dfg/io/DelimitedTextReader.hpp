@@ -14,6 +14,7 @@
 #include "../cont/elementType.hpp"
 #include "../build/inlineTools.hpp"
 #include "../preprocessor/compilerInfoMsvc.hpp"
+#include "detail/structuralCharScan.hpp"
 
 #include <iterator>
 
@@ -162,6 +163,7 @@ public:
     enum CsvFormatFlags
     {
         CsvFormatFlagNoRnTranslation = 0x1,
+        CsvFormatFlagVectorizedScan  = 0x2, // When set, reading BasicImStream to StringView-buffers finds separators, end-of-lines and (with generic reader) enclosing chars using vectorized (SIMD) block scan (scalar fallback if SIMD is not available).
         CsvFormatFlagsDefault = 0
     };
 
@@ -177,10 +179,13 @@ public:
         static const int s_flags = Flags_T;
 
         static const bool s_hasCompileTimeSeparatorChar = true;
+        static const bool s_hasVectorizedStructuralScan = (s_flags & CsvFormatFlagVectorizedScan) != 0;
 
         DFG_STATIC_ASSERT(s_enc != s_nMetaCharAutoDetect, "Compile-time enclosing char can't be auto detectable.");
         DFG_STATIC_ASSERT(s_eol != s_nMetaCharAutoDetect, "Compile-time end-of-line char can't be auto detectable.");
         DFG_STATIC_ASSERT(s_sep != s_nMetaCharAutoDetect, "Compile-time separator char can't be auto detectable.");
+        DFG_STATIC_ASSERT(!s_hasVectorizedStructuralScan || (s_sep >= 0 && s_sep < 256 && s_eol >= 0 && s_eol < 256), "Vectorized scan requires separator and end-of-line to be single byte chars.");
+        DFG_STATIC_ASSERT(!s_hasVectorizedStructuralScan || s_enc == s_nMetaCharNone || (s_enc >= 0 && s_enc < 256 && s_enc != s_sep && s_enc != s_eol), "Vectorized scan requires enclosing char to be single byte char different from separator and end-of-line.");
 
         FormatDefinitionSingleCharsCompileTime()
         {}
@@ -231,6 +236,7 @@ public:
         typedef std::bitset<lastReadFlag + 1> FlagContainer;
 
         static const bool s_hasCompileTimeSeparatorChar = false;
+        static const bool s_hasVectorizedStructuralScan = false;
 
         DFG_CONSTEXPR FormatDefinitionSingleChars(int cEnc, int cEol, int cSep) :
             m_cEnc(cEnc),
@@ -945,9 +951,117 @@ public:
             }
         }
 
+        // Whole stream reading for untranslated in-memory stream with StringViewCBufferWithEnclosedCellSupport when format definition has CsvFormatFlagVectorizedScan:
+        // cell ends are found with enclosure-aware block scan (see DFG_DETAIL_NS::forEachCsvCellEnd()) instead of reading cells char by char.
+        // Produces the same cells as readRow()-based reading, past-enclosed chars are ignored.
+        template <class Reader_T, class CellHandler_T>
+        static void readVectorizedWithEnclosedCells(Reader_T& reader, CellHandler_T&& cellHandler)
+        {
+            BasicImStream& strm = reader.getStream();
+            auto& cellData = reader.getCellBuffer();
+            StringViewCBufferWithEnclosedCellSupport& buffer = cellData.getBuffer();
+            const auto& formatDef = cellData.getFormatDefInfo();
+            const auto cEnc = static_cast<char>(formatDef.getEnc());
+            const auto cSep = static_cast<char>(formatDef.getSep());
+            const auto cEol = static_cast<char>(formatDef.getEol());
+            const bool bRnTranslation = formatDef.isRnTranslationEnabled() && formatDef.getEol() == '\n';
+            const auto pFirst = strm.currentPtr();
+            const auto pEnd = strm.endPtr();
+            auto pCellStart = pFirst;
+            size_t nRow = 0;
+            size_t nCol = 0;
+            const char* pLastHandledCellEnd = nullptr;
+            bool bSkipRestOfLine = false;
+            bool bTerminated = false;
+
+            // Sets buffer to content of cell [pCellStart, pCellEnd[.
+            const auto setCellContent = [&](const char* const pCellEnd, const bool bEndsToEol)
+            {
+                buffer.clear();
+                if (pCellStart != pCellEnd && *pCellStart == cEnc)
+                {
+                    // Enclosed cell: content ends to ending enclosing char (or to cell end if there's none), chars after it are past-enclosed and ignored.
+                    const auto pContentBegin = pCellStart + 1;
+                    auto pContentEnd = pCellEnd;
+                    for (auto p = std::find(pContentBegin, pCellEnd, cEnc); p != pCellEnd; p = std::find(p + 2, pCellEnd, cEnc))
+                    {
+                        if (p + 1 == pCellEnd || *(p + 1) != cEnc)
+                        {
+                            pContentEnd = p;
+                            break;
+                        }
+                        buffer.m_bNeedTemporaryBuffer = true; // Double enclosing char.
+                        if (p + 2 == pCellEnd)
+                            break;
+                    }
+                    buffer.reset(pContentBegin, pContentEnd - pContentBegin);
+                    buffer.onEnclosedCellRead(cEnc);
+                }
+                else
+                {
+                    buffer.reset(pCellStart, pCellEnd - pCellStart);
+                    if (bEndsToEol && bRnTranslation && pCellEnd != pCellStart && *(pCellEnd - 1) == '\r')
+                        buffer.pop_back(); // pop \r
+                }
+            };
+
+            // Calls cell handler and handles its return value.
+            const auto handleCell = [&](const char* const pCellEnd, const bool bEndsToEol)
+            {
+                cellHandler(nRow, nCol, cellData);
+                const auto readStatus = cellData.getReadStatus();
+                if (readStatus == cellHrvSkipRestOfLine || readStatus == cellHrvSkipRestOfLineAndTerminate)
+                    bSkipRestOfLine = !bEndsToEol;
+                bTerminated = (readStatus == cellHrvTerminateRead || readStatus == cellHrvSkipRestOfLineAndTerminate);
+                pLastHandledCellEnd = pCellEnd;
+            };
+
+            const auto onCellEnd = [&](const char* const p, const bool bEol) -> bool
+            {
+                if (!bSkipRestOfLine)
+                {
+                    setCellContent(p, bEol);
+                    handleCell(p, bEol);
+                }
+                pCellStart = p + 1;
+                if (bEol)
+                {
+                    ++nRow;
+                    nCol = 0;
+                    bSkipRestOfLine = false;
+                    cellData.setReadStatus(cellHrvContinue);
+                }
+                else
+                    ++nCol;
+                return !bTerminated;
+            };
+
+            DFG_DETAIL_NS::forEachCsvCellEnd(pFirst, pEnd, cEnc, cSep, cEol, DFG_DETAIL_NS::CsvCellScanState::cellStart, onCellEnd);
+
+            // Last cell ending to end of stream: like in readRow(), handler is not called for empty cell on empty last line
+            // but is called e.g. for the second cell of "a,", in which case it gets called even if handler of the first cell requested skipping or termination.
+            setCellContent(pEnd, false);
+            const bool bAfterHandledTrailingSeparator = (pLastHandledCellEnd != nullptr && pLastHandledCellEnd + 1 == pEnd && *pLastHandledCellEnd == cSep);
+            if (bAfterHandledTrailingSeparator || (!bTerminated && !bSkipRestOfLine && (nCol != 0 || !buffer.empty())))
+                handleCell(pEnd, false);
+            strm.seekToEnd();
+        }
+
         template <class Reader_T, class CellHandler_T>
         static DFG_FORCEINLINE void read(Reader_T& reader, CellHandler_T&& cellHandler)
         {
+            if constexpr (FormatDef::s_hasVectorizedStructuralScan && DFG_DETAIL_NS::IsStreamStringViewCCompatible<typename Reader_T::StreamT>::value
+                && std::is_same<StringViewCBufferWithEnclosedCellSupport, typename Reader_T::CellBuffer::Buffer>::value
+                && std::is_same<GenericParsingImplementations, typename Reader_T::CellParsingImplementations>::value)
+            {
+                const auto& formatDef = reader.getFormatDefInfo();
+                if (formatDef.getEnc() >= 0 && formatDef.getEnc() < 256 && !formatDef.testFlag(rfSkipLeadingWhitespaces))
+                {
+                    readVectorizedWithEnclosedCells(reader, std::forward<CellHandler_T>(cellHandler));
+                    return;
+                }
+            }
+
             size_t nRow = 0;
             auto cellHandlerWrapper = [&](size_t nCol, decltype(reader.getCellBuffer())& cellData)
             {
@@ -1088,6 +1202,8 @@ public:
         template <class T> static DFG_FORCEINLINE void onPastEnclosedCellCharacter(CellBuffer&, const T&)   { DFG_ASSERT_CORRECTNESS(false); }
 
         // Specialization for whole stream reading when handling untranslated stream with StringViewCBuffer (i.e. can use StringView to source bytes).
+        // If format definition has CsvFormatFlagVectorizedScan, separator and eol positions are searched in 64-byte blocks with SIMD instructions
+        // instead of checking every char individually.
         // TODO: test
         template <class Reader_T, class CellHandler_T>
         static DFG_FORCEINLINE void read(Reader_T& reader, CellHandler_T&& cellHandler, std::true_type)
@@ -1098,14 +1214,12 @@ public:
             size_t nRow = 0;
             size_t nCol = 0;
             const auto pFirst = strm.currentPtr();
-            auto p = pFirst;
             const auto pEnd = strm.endPtr();
-            auto pCellStart = p;
-            for (; p != pEnd; ++p)
-            {
-                if (bufferCharToInternal(*p) != formatDef.getSep() && bufferCharToInternal(*p) != formatDef.getEol())
-                    continue;
+            auto pCellStart = pFirst;
 
+            // Handles cell ending to separator or eol at p.
+            const auto onStructuralChar = [&](const char* const p)
+            {
                 buffer.reset(pCellStart, p - pCellStart);
 
                 // \r\n handling.
@@ -1121,13 +1235,28 @@ public:
                 }
                 else
                     nCol++;
+            };
+
+            if constexpr (FormatDef::s_hasVectorizedStructuralScan)
+            {
+                const std::array<char, 2> structuralChars = { static_cast<char>(formatDef.getSep()), static_cast<char>(formatDef.getEol()) };
+                DFG_DETAIL_NS::forEachStructuralChar(pFirst, pEnd, structuralChars, onStructuralChar);
             }
+            else
+            {
+                for (auto p = pFirst; p != pEnd; ++p)
+                {
+                    if (bufferCharToInternal(*p) == formatDef.getSep() || bufferCharToInternal(*p) == formatDef.getEol())
+                        onStructuralChar(p);
+                }
+            }
+
             // Call handler if any of the following conditions are true:
             //    -buffer is not empty (cell ends to eof)
             //    -last char is separator (interpret that "a," is two cells)
-            if (pCellStart != p || (pEnd != pFirst && (bufferCharToInternal(*(pEnd - 1)) == formatDef.getSep())))
+            if (pCellStart != pEnd || (pEnd != pFirst && (bufferCharToInternal(*(pEnd - 1)) == formatDef.getSep())))
             {
-                buffer.reset(pCellStart, p - pCellStart);
+                buffer.reset(pCellStart, pEnd - pCellStart);
                 cellHandler(nRow, nCol, reader.getCellBuffer());
             }
             strm.seekToEnd();
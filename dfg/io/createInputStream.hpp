@@ -2,6 +2,7 @@
 
 #include "../dfgDefs.hpp"
 #include "BasicIfStream.hpp"
+#include "BasicIfStreamPrefetching.hpp"
 #include "../ReadOnlySzParam.hpp"
 
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(io) {
@@ -28,4 +29,20 @@ inline DFG_MODULE_NS(io)::DFG_CLASS_NAME(BasicIfStream) createInputStreamBinaryF
     return createInputStreamBinaryFile<wchar_t>(sPath);
 }
 
+// Returns input binary stream from given path that reads file ahead in a background thread, see BasicIfStreamPrefetching.
+// Stream can only be read sequentially.
+inline BasicIfStreamPrefetching createInputStreamBinaryFilePrefetching(const ReadOnlySzParamC& sPath,
+                                                                       const size_t nBlockSize = BasicIfStreamPrefetching::s_nDefaultBlockSize,
+                                                                       const size_t nBufferCount = BasicIfStreamPrefetching::s_nDefaultBufferCount)
+{
+    return BasicIfStreamPrefetching(sPath, nBlockSize, nBufferCount);
+}
+
+inline BasicIfStreamPrefetching createInputStreamBinaryFilePrefetching(const ReadOnlySzParamW& sPath,
+                                                                       const size_t nBlockSize = BasicIfStreamPrefetching::s_nDefaultBlockSize,
+                                                                       const size_t nBufferCount = BasicIfStreamPrefetching::s_nDefaultBufferCount)
+{
+    return BasicIfStreamPrefetching(sPath, nBlockSize, nBufferCount);
+}
+
 } } // module io
@@ -0,0 +1,302 @@
+#pragma once
+
+#include "../../dfgDefs.hpp"
+#include "../../dfgBaseTypedefs.hpp"
+#include "../../build/inlineTools.hpp"
+#include "../../dfgAssert.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+// Vectorized helper for finding structural characters (e.g. separator, enclosing char and end-of-line) from contiguous char range.
+// SSE2 is used on x86/x64 when available and AVX2 if compiler has been told that it can be used (e.g. -mavx2 or /arch:AVX2).
+// Vectorization can be disabled by defining DFG_IO_ENABLE_SIMD_STRUCTURAL_SCAN as 0 before including this file, in which case only scalar implementation is used.
+
+#ifndef DFG_IO_ENABLE_SIMD_STRUCTURAL_SCAN
+    #define DFG_IO_ENABLE_SIMD_STRUCTURAL_SCAN 1
+#endif
+
+#if DFG_IO_ENABLE_SIMD_STRUCTURAL_SCAN == 1 && (defined(__SSE2__) || defined(_M_X64))
+    #define DFG_IO_STRUCTURAL_SCAN_SSE2 1
+    #include <emmintrin.h>
+    #if defined(__AVX2__)
+        #define DFG_IO_STRUCTURAL_SCAN_AVX2 1
+        #include <immintrin.h>
+    #else
+        #define DFG_IO_STRUCTURAL_SCAN_AVX2 0
+    #endif
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#else
+    #define DFG_IO_STRUCTURAL_SCAN_SSE2 0
+    #define DFG_IO_STRUCTURAL_SCAN_AVX2 0
+#endif
+
+DFG_ROOT_NS_BEGIN { DFG_SUB_NS(io) { namespace DFG_DETAIL_NS {
+
+    // Size of block (in bytes) for which structural char bitmask is generated at once.
+    constexpr size_t gnStructuralScanBlockSize = 64;
+
+    // Returns true if vectorized implementation is available in this build.
+    constexpr bool isSimdStructuralScanAvailable()
+    {
+        return DFG_IO_STRUCTURAL_SCAN_SSE2 == 1;
+    }
+
+#if DFG_IO_STRUCTURAL_SCAN_SSE2 == 1
+    // Returns index of lowest set bit, behaviour is undefined if nMask == 0.
+    DFG_FORCEINLINE uint32 structuralScanLowestSetBitIndex(const uint64 nMask)
+    {
+    #if defined(_MSC_VER)
+        unsigned long nIndex = 0;
+        _BitScanForward64(&nIndex, nMask);
+        return static_cast<uint32>(nIndex);
+    #else
+        return static_cast<uint32>(__builtin_ctzll(nMask));
+    #endif
+    }
+
+    // Returns bitmask of 64-byte block starting from p so that bit i is set iff p[i] is any of the needle chars.
+    template <size_t N_T>
+    DFG_FORCEINLINE uint64 structuralCharBlockMask(const char* const p, const std::array<char, N_T>& needles)
+    {
+    #if DFG_IO_STRUCTURAL_SCAN_AVX2 == 1
+        uint64 nMask = 0;
+        for (size_t nPart = 0; nPart < 2; ++nPart)
+        {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * nPart));
+            __m256i matches = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(needles[0]));
+            for (size_t i = 1; i < N_T; ++i)
+                matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(needles[i])));
+            nMask |= static_cast<uint64>(static_cast<uint32>(_mm256_movemask_epi8(matches))) << (32 * nPart);
+        }
+        return nMask;
+    #else // Case: SSE2
+        uint64 nMask = 0;
+        for (size_t nPart = 0; nPart < 4; ++nPart)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * nPart));
+            __m128i matches = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(needles[0]));
+            for (size_t i = 1; i < N_T; ++i)
+                matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(needles[i])));
+            nMask |= static_cast<uint64>(static_cast<uint32>(_mm_movemask_epi8(matches))) << (16 * nPart);
+        }
+        return nMask;
+    #endif
+    }
+#endif // DFG_IO_STRUCTURAL_SCAN_SSE2
+
+    // Calls func(p) for every position p in range [pBegin, pEnd[ in increasing order for which *p equals any of the needle chars.
+    // func may return void or bool; if it returns false, scanning is stopped.
+    // Returns pointer from which scanning was stopped: pEnd if whole range was scanned.
+    // If bVectorized is false, uses scalar implementation regardless of whether vectorized version is available.
+    template <size_t N_T, class Func_T>
+    const char* forEachStructuralChar(const char* pBegin, const char* const pEnd, const std::array<char, N_T>& needles, Func_T&& func, const bool bVectorized = true)
+    {
+        static_assert(N_T >= 1, "There must be at least one needle char");
+        const auto callFunc = [&](const char* p) -> bool
+        {
+            if constexpr (std::is_same_v<decltype(func(p)), void>)
+            {
+                func(p);
+                return true;
+            }
+            else
+                return func(p);
+        };
+        auto p = pBegin;
+#if DFG_IO_STRUCTURAL_SCAN_SSE2 == 1
+        if (bVectorized)
+        {
+            for (; static_cast<size_t>(pEnd - p) >= gnStructuralScanBlockSize; p += gnStructuralScanBlockSize)
+            {
+                for (auto nMask = structuralCharBlockMask(p, needles); nMask != 0; nMask &= (nMask - 1))
+                {
+                    const auto pHit = p + structuralScanLowestSetBitIndex(nMask);
+                    if (!callFunc(pHit))
+                        return pHit;
+                }
+            }
+        }
+#else
+        DFG_UNUSED(bVectorized);
+#endif
+        // Scalar handling for tail or for the whole range if vectorization is not available.
+        for (; p != pEnd; ++p)
+        {
+            for (size_t i = 0; i < N_T; ++i)
+            {
+                if (*p == needles[i])
+                {
+                    if (!callFunc(p))
+                        return p;
+                    break;
+                }
+            }
+        }
+        return pEnd;
+    }
+
+    // State of enclosure-aware cell boundary scan, see forEachCsvCellEnd().
+    enum class CsvCellScanState
+    {
+        cellStart,      // At the beginning of cell (=beginning of input or after cell ending separator or eol).
+        naked,          // In cell that does not start with enclosing char.
+        enclosed,       // In enclosed cell.
+        enclosedQuote,  // After enclosing char in enclosed cell: either ending enclosing char or first of double enclosing.
+        pastEnclosed    // After ending enclosing char but before separator or eol.
+    };
+
+    // Returns state following non-structural char.
+    constexpr CsvCellScanState csvCellScanStateAfterOtherChar(const CsvCellScanState state)
+    {
+        return (state == CsvCellScanState::cellStart) ? CsvCellScanState::naked : ((state == CsvCellScanState::enclosedQuote) ? CsvCellScanState::pastEnclosed : state);
+    }
+
+    // Returns bitmask where bit i is set iff odd number of bits are set in range [0, i] of nMask, i.e. (inclusive) prefix xor.
+    DFG_FORCEINLINE uint64 prefixXor(uint64 nMask)
+    {
+        nMask ^= nMask << 1;
+        nMask ^= nMask << 2;
+        nMask ^= nMask << 4;
+        nMask ^= nMask << 8;
+        nMask ^= nMask << 16;
+        nMask ^= nMask << 32;
+        return nMask;
+    }
+
+    // Enclosure-aware version of forEachStructuralChar(): calls func(p, bEol) for every separator and eol in range [pBegin, pEnd[ that ends a cell,
+    // i.e. that is not inside enclosed cell. bEol is true iff *p is eol. Scanning starts from given state and state after the scanned range is returned.
+    // func may return void or bool; if it returns false, scanning is stopped and state after *p is returned.
+    // Semantics are those of DelimitedTextReader::readCell() without whitespace trimming: enclosing char starts enclosed cell only if it's the first char of a cell,
+    // double enclosing char inside enclosed cell is content and everything between ending enclosing char and separator/eol is past-enclosed content.
+    //
+    // Vectorized implementation handles input in 64-byte blocks: bitmasks of enclosing chars, separators and eols are generated and in-enclosed-cell mask is computed
+    // as prefix xor (parity) of the enclosing char mask so that cell ending separators and eols are found without checking chars one by one.
+    // The parity is correct only if enclosing chars are in regular positions (at cell start, ending enclosing followed by separator/eol and double enclosing chars inside enclosed cells);
+    // blocks where this does not hold (e.g. enclosing char inside naked cell or past-enclosed content) are handled by running state machine over structural chars of the block.
+    // If bVectorized is false, uses scalar implementation regardless of whether vectorized version is available.
+    template <class Func_T>
+    CsvCellScanState forEachCsvCellEnd(const char* pBegin, const char* const pEnd, const char cEnc, const char cSep, const char cEol, CsvCellScanState state, Func_T&& func, const bool bVectorized = true)
+    {
+        DFG_ASSERT_CORRECTNESS(cEnc != cSep && cEnc != cEol && cSep != cEol);
+        const auto callFunc = [&](const char* p, const bool bEol) -> bool
+        {
+            if constexpr (std::is_same_v<decltype(func(p, bEol)), void>)
+            {
+                func(p, bEol);
+                return true;
+            }
+            else
+                return func(p, bEol);
+        };
+
+        // Position from which there are chars not yet accounted in state, all of them non-structural.
+        auto pPending = pBegin;
+        bool bStopped = false;
+
+        // State machine step for structural char at p.
+        const auto onStructuralChar = [&](const char* p) -> bool
+        {
+            if (p != pPending)
+                state = csvCellScanStateAfterOtherChar(state);
+            pPending = p + 1;
+            if (*p == cEnc)
+            {
+                if (state == CsvCellScanState::cellStart || state == CsvCellScanState::enclosedQuote)
+                    state = CsvCellScanState::enclosed;
+                else if (state == CsvCellScanState::enclosed)
+                    state = CsvCellScanState::enclosedQuote;
+                return true;
+            }
+            if (state == CsvCellScanState::enclosed)
+                return true;
+            state = CsvCellScanState::cellStart;
+            bStopped = !callFunc(p, *p == cEol);
+            return !bStopped;
+        };
+
+        const std::array<char, 3> structuralChars = { cEnc, cSep, cEol };
+        auto p = pBegin;
+#if DFG_IO_STRUCTURAL_SCAN_SSE2 == 1
+        if (bVectorized)
+        {
+            const uint64 nHighBit = uint64(1) << (gnStructuralScanBlockSize - 1);
+            for (; static_cast<size_t>(pEnd - p) >= gnStructuralScanBlockSize; p += gnStructuralScanBlockSize)
+            {
+                if (pPending != p)
+                {
+                    state = csvCellScanStateAfterOtherChar(state);
+                    pPending = p;
+                }
+                const auto nEncMask = structuralCharBlockMask(p, std::array<char, 1>{ cEnc });
+                const auto nSepMask = structuralCharBlockMask(p, std::array<char, 1>{ cSep });
+                const auto nEolMask = structuralCharBlockMask(p, std::array<char, 1>{ cEol });
+                const auto nSepOrEolMask = nSepMask | nEolMask;
+                if (nEncMask == 0 && state != CsvCellScanState::enclosedQuote && state != CsvCellScanState::pastEnclosed)
+                {
+                    // Fast path for blocks without enclosing chars.
+                    if (state == CsvCellScanState::enclosed)
+                        continue;
+                    for (auto nMask = nSepOrEolMask; nMask != 0; nMask &= (nMask - 1))
+                    {
+                        const auto pHit = p + structuralScanLowestSetBitIndex(nMask);
+                        if (!onStructuralChar(pHit))
+                            return state;
+                    }
+                    continue;
+                }
+                if (state == CsvCellScanState::cellStart || state == CsvCellScanState::naked || state == CsvCellScanState::enclosed)
+                {
+                    const uint64 nCarry = (state == CsvCellScanState::enclosed) ? 1 : 0;
+                    const auto nInsideAfter = prefixXor(nEncMask) ^ (0 - nCarry); // Bit i: inside enclosed cell after char i.
+                    const auto nInsideBefore = (nInsideAfter << 1) | nCarry;      // Bit i: inside enclosed cell before char i.
+                    const auto nCellEndMask = nSepOrEolMask & ~nInsideBefore;
+                    const auto nOpeningMask = nEncMask & ~nInsideBefore;
+                    const auto nClosingMask = nEncMask & nInsideBefore;
+                    const uint64 nCellStartMask = (nCellEndMask << 1) | ((state == CsvCellScanState::cellStart) ? 1 : 0); // Bit i: char i is first char of cell.
+                    const auto nBadOpenings = nOpeningMask & ~(nCellStartMask | (nClosingMask << 1));
+                    const auto nBadClosings = (nClosingMask & ~((nEncMask | nSepOrEolMask) >> 1)) | (nClosingMask & nHighBit);
+                    if ((nBadOpenings | nBadClosings) == 0)
+                    {
+                        // Parity is valid for the whole block.
+                        for (auto nMask = nCellEndMask; nMask != 0; nMask &= (nMask - 1))
+                        {
+                            const auto pHit = p + structuralScanLowestSetBitIndex(nMask);
+                            state = CsvCellScanState::cellStart;
+                            pPending = pHit + 1;
+                            if (!callFunc(pHit, *pHit == cEol))
+                                return state;
+                        }
+                        if ((nInsideAfter & nHighBit) != 0)
+                            state = CsvCellScanState::enclosed;
+                        else if ((nSepOrEolMask & nHighBit) != 0)
+                            state = CsvCellScanState::cellStart;
+                        else
+                            state = CsvCellScanState::naked;
+                        pPending = p + gnStructuralScanBlockSize;
+                        continue;
+                    }
+                }
+                // Irregular block: running state machine over structural chars.
+                for (auto nMask = nEncMask | nSepOrEolMask; nMask != 0; nMask &= (nMask - 1))
+                {
+                    if (!onStructuralChar(p + structuralScanLowestSetBitIndex(nMask)))
+                        return state;
+                }
+            }
+        }
+#else
+        DFG_UNUSED(bVectorized);
+#endif
+        // Scalar handling for tail or for the whole range if vectorization is not available.
+        forEachStructuralChar(p, pEnd, structuralChars, onStructuralChar, false);
+        if (bStopped)
+            return state;
+        if (pPending != pEnd)
+            state = csvCellScanStateAfterOtherChar(state);
+        return state;
+    }
+
+} }} // module namespace
@@ -2,6 +2,7 @@
 
 #include "io.hpp"
 #include "io/BasicIfStream.hpp"
+#include "io/BasicIfStreamPrefetching.hpp"
 #include "io/BasicImStream.hpp"
 #include "io/BasicIStream.hpp"
 #include "io/BasicIStreamCRTP.hpp"
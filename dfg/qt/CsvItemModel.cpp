@@ -1,7 +1,10 @@
 #include "CsvItemModel.hpp"
 #include "qtIncludeHelpers.hpp"
 #include "PropertyHelper.hpp"
+#include "connectHelper.hpp"
 #include "../cont/tableCsv.hpp"
+#include "../cont/tableCsvChunkedReader.hpp"
+#include "../cont/tableCsvLazy.hpp"
 
 DFG_BEGIN_INCLUDE_QT_HEADERS
 #include <QUndoStack>
@@ -16,6 +19,7 @@ DFG_BEGIN_INCLUDE_QT_HEADERS
 #include <QJsonParseError>
 #include <QReadWriteLock>
 #include <QTextStream>
+#include <QTimer>
 #include <QStringListModel>
 
 #include <QItemSelection>
@@ -28,6 +32,11 @@ DFG_BEGIN_INCLUDE_QT_HEADERS
 DFG_END_INCLUDE_QT_HEADERS
 
 #include <set>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include "../dfgBase.hpp"
 #include "../io.hpp"
 #include "../str/string.hpp"
@@ -37,6 +46,7 @@ DFG_END_INCLUDE_QT_HEADERS
 #include "../cont/CsvConfig.hpp"
 #include "../cont/SetVector.hpp"
 #include "../str/strTo.hpp"
+#include "../str/strToBatch.hpp"
 #include "../os.hpp"
 #include "../os/OutputFile.hpp"
 #include "../cont/MapVector.hpp"
@@ -64,7 +74,8 @@ namespace
         CsvItemModelPropertyId_defaultFormatEnclosingChar,
         CsvItemModelPropertyId_defaultFormatEndOfLine,
         CsvItemModelPropertyId_defaultReadThreadBlockSizeMinimum,
-        CsvItemModelPropertyId_defaultReadThreadCountMaximum
+        CsvItemModelPropertyId_defaultReadThreadCountMaximum,
+        CsvItemModelPropertyId_displayStringCacheMaxSize // Maximum number of cells whose display string is cached, 0 disables caching.
     };
 
     template <CsvItemModelPropertyId Id_T>
@@ -120,6 +131,12 @@ namespace
                                   uint32,
                                   []() { return 0; }); // 0 means "let TableCsv decide"
 
+    DFG_QT_DEFINE_OBJECT_PROPERTY("CsvItemModel_displayStringCacheMaxSize",
+                                  CsvItemModel,
+                                  CsvItemModelPropertyId_displayStringCacheMaxSize,
+                                  uint32,
+                                  []() { return 100000; });
+
     template <CsvItemModelPropertyId ID>
     auto getCsvItemModelProperty(const CsvItemModel* pModel) -> typename DFG_QT_OBJECT_PROPERTY_CLASS_NAME(CsvItemModel)<ID>::PropertyType
     {
@@ -227,6 +244,10 @@ void CsvItemModel::SaveOptions::initFromItemModelPtr(const CsvItemModel* pItemMo
                 this->enclosingChar(defaultSaveOptions(pItemModel).enclosingChar());
             this->enclosementBehaviour(::DFG_MODULE_NS(io)::EnclosementBehaviour::EbEncloseIfNeeded);
         }
+
+        const auto sWriteThreadCount = loadConfig.getProperty(CsvOptionProperty_writeThreadCountMaximum, "");
+        if (!sWriteThreadCount.empty())
+            this->setPropertyT<PropertyId::writeOpt_threadCount>(::DFG_MODULE_NS(str)::strTo<uint32>(sWriteThreadCount));
     }
 }
 
@@ -248,6 +269,8 @@ void CsvItemModel::LoadOptions::setDefaultProperties(const CsvItemModel* pCsvIte
 
     const auto sDefaultReadThreadBlockSizeMinimum = toStrC(getCsvItemModelProperty<CsvItemModelPropertyId_defaultReadThreadBlockSizeMinimum>(pCsvItemModel));
     this->setPropertyT<PropertyId::readOpt_threadBlockSizeMinimum>(strTo<uint64>(this->getProperty(CsvOptionProperty_readThreadBlockSizeMinimum, sDefaultReadThreadBlockSizeMinimum)));
+
+    this->setPropertyT<PropertyId::readOpt_memoryMappedCellStorage>(this->getProperty(CsvOptionProperty_readMemoryMappedCellStorage, "0") == "1");
 }
 
 auto CsvItemModel::LoadOptions::constructFromConfig(const CsvConfig& config, const CsvItemModel* pCsvItemModel) -> LoadOptions
@@ -330,9 +353,459 @@ void CsvItemModel::ColInfo::CompleterDeleter::operator()(QCompleter* p) const
         p->deleteLater(); // Can't delete directly due to thread affinity (i.e. might get deleted from wrong thread triggering Qt asserts).
 }
 
+namespace
+{
+    // Bounded LRU cache of display strings (QString converted from UTF-8 cell content) for CsvItemModel::data() so that repeated requests
+    // for the same cells, e.g. on every repaint, resize to contents and tooltip, don't convert UTF-8 to UTF-16 every time.
+    // Can also convert strings in advance in a background thread, see requestPrefetch().
+    // Interface is thread safe.
+    class CsvItemModelDisplayStringCache
+    {
+    public:
+        using Index = CsvItemModel::Index;
+
+        CsvItemModelDisplayStringCache(const size_t nMaxSize)
+            : m_nMaxSize(nMaxSize)
+        {}
+
+        ~CsvItemModelDisplayStringCache()
+        {
+            stopPrefetchThread();
+        }
+
+        // If cell (nRow, nCol) is in cache, sets it to rStr, marks it most recently used and returns true. Otherwise returns false.
+        bool find(const Index nRow, const Index nCol, QString& rStr)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto iter = m_mapKeyToEntry.find(key(nRow, nCol));
+            if (iter == m_mapKeyToEntry.end())
+                return false;
+            m_entries.splice(m_entries.begin(), m_entries, iter->second);
+            rStr = iter->second->second;
+            return true;
+        }
+
+        // Returns current generation, which is to be passed to insert() of string converted after this call.
+        uint64 generation() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_nGeneration;
+        }
+
+        // Inserts string to cache unless cache has been invalidated after nGeneration was queried, in which case str might be stale.
+        void insert(const Index nRow, const Index nCol, QString str, const uint64 nGeneration)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (nGeneration != m_nGeneration || m_nMaxSize == 0)
+                return;
+            const auto nKey = key(nRow, nCol);
+            auto iter = m_mapKeyToEntry.find(nKey);
+            if (iter != m_mapKeyToEntry.end())
+            {
+                iter->second->second = std::move(str);
+                m_entries.splice(m_entries.begin(), m_entries, iter->second);
+                return;
+            }
+            if (m_entries.size() >= m_nMaxSize)
+            {
+                // Evicting least recently used, reusing list node.
+                m_mapKeyToEntry.erase(m_entries.back().first);
+                m_entries.splice(m_entries.begin(), m_entries, std::prev(m_entries.end()));
+                m_entries.front() = Entry(nKey, std::move(str));
+            }
+            else
+                m_entries.emplace_front(nKey, std::move(str));
+            m_mapKeyToEntry[nKey] = m_entries.begin();
+        }
+
+        void invalidate(const Index nRow, const Index nCol)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_nGeneration;
+            auto iter = m_mapKeyToEntry.find(key(nRow, nCol));
+            if (iter == m_mapKeyToEntry.end())
+                return;
+            m_entries.erase(iter->second);
+            m_mapKeyToEntry.erase(iter);
+        }
+
+        void invalidateAll()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_nGeneration;
+            m_entries.clear();
+            m_mapKeyToEntry.clear();
+        }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        // Requests strings of given cells to be converted in background thread, replacing possible earlier request that hasn't been started yet.
+        // Background thread reads model under its read lock and skips the request if lock is not available.
+        void requestPrefetch(const CsvItemModel& rModel, std::vector<Index> rows, std::vector<Index> columns)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_nMaxSize == 0 || m_bStopPrefetch)
+                    return;
+                m_pPrefetchModel = &rModel;
+                m_prefetchRows = std::move(rows);
+                m_prefetchColumns = std::move(columns);
+                m_bPrefetchPending = true;
+                m_bPrefetchCancelled = false;
+                if (!m_prefetchThread.joinable())
+                    m_prefetchThread = std::thread([this]() { this->prefetchThreadFunc(); });
+            }
+            m_prefetchCondVar.notify_all();
+        }
+
+        // Drops pending request and makes ongoing prefetch stop at the next row.
+        void cancelPrefetch()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_bPrefetchPending = false;
+            m_bPrefetchCancelled = true;
+            m_prefetchRows.clear();
+            m_prefetchColumns.clear();
+        }
+
+        // Stops background thread, must be called before model given to requestPrefetch() gets destroyed.
+        void stopPrefetchThread()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bStopPrefetch = true;
+            }
+            m_prefetchCondVar.notify_all();
+            if (m_prefetchThread.joinable())
+                m_prefetchThread.join();
+        }
+
+    private:
+        static uint64 key(const Index nRow, const Index nCol)
+        {
+            return (uint64(static_cast<uint32>(nRow)) << 32) | static_cast<uint32>(nCol);
+        }
+
+        void prefetchThreadFunc()
+        {
+            std::vector<Index> rows;
+            std::vector<Index> columns;
+            for (;;)
+            {
+                const CsvItemModel* pModel = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_prefetchCondVar.wait(lock, [&] { return m_bStopPrefetch || m_bPrefetchPending; });
+                    if (m_bStopPrefetch)
+                        return;
+                    m_bPrefetchPending = false;
+                    pModel = m_pPrefetchModel;
+                    rows.swap(m_prefetchRows);
+                    columns.swap(m_prefetchColumns);
+                }
+                const auto nGeneration = generation();
+                for (const auto r : rows)
+                {
+                    if (isPrefetchInterrupted())
+                        break;
+                    // Read lock is held only for one row at a time so that edits (which use try-lock) are blocked only momentarily.
+                    auto lockReleaser = pModel->tryLockForRead();
+                    if (!lockReleaser.isLocked())
+                        break; // Model is being edited, skipping rest of the prefetch.
+                    for (const auto c : columns)
+                    {
+                        if (!pModel->isValidRow(r) || !pModel->isValidColumn(c) || isCached(r, c))
+                            continue;
+                        const auto sv = pModel->rawStringViewAt(r, c);
+                        if (!sv.empty())
+                            insert(r, c, viewToQString(sv), nGeneration);
+                    }
+                }
+            }
+        }
+
+        // Returns true if newer request is pending, prefetch has been cancelled or thread is being stopped.
+        bool isPrefetchInterrupted() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_bPrefetchPending || m_bPrefetchCancelled || m_bStopPrefetch;
+        }
+
+        bool isCached(const Index nRow, const Index nCol) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_mapKeyToEntry.find(key(nRow, nCol)) != m_mapKeyToEntry.end();
+        }
+
+        using Entry = std::pair<uint64, QString>;
+        std::list<Entry> m_entries; // Most recently used first.
+        std::unordered_map<uint64, std::list<Entry>::iterator> m_mapKeyToEntry;
+        const size_t m_nMaxSize;
+        uint64 m_nGeneration = 0; // Incremented on every invalidation.
+        mutable std::mutex m_mutex;
+
+        // Prefetch members, guarded by m_mutex
+        const CsvItemModel* m_pPrefetchModel = nullptr;
+        std::vector<Index> m_prefetchRows;
+        std::vector<Index> m_prefetchColumns;
+        bool m_bPrefetchPending = false;
+        bool m_bPrefetchCancelled = false;
+        bool m_bStopPrefetch = false;
+        std::condition_variable m_prefetchCondVar;
+        std::thread m_prefetchThread;
+    }; // class CsvItemModelDisplayStringCache
+
+    // Per-column index of CsvItemModel::NumericSummary of fixed size row blocks for CsvItemModel::columnNumericSummary().
+    // Blocks are computed on demand and invalidated individually on cell edits, structural changes invalidate everything.
+    // Interface is thread safe.
+    class CsvItemModelNumericSummaryIndex
+    {
+    public:
+        using Index = CsvItemModel::Index;
+        using NumericSummary = CsvItemModel::NumericSummary;
+        static constexpr Index s_nBlockSize = 4096;
+
+        bool summary(const CsvItemModel& rModel, const Index nCol, const Index nFirstRow, const Index nLastRow, NumericSummary& rSummary, const std::function<bool()>& isCancelled)
+        {
+            const auto nFirstBlock = (nFirstRow + s_nBlockSize - 1) / s_nBlockSize;
+            const auto nEndBlock = (nLastRow + 1) / s_nBlockSize; // Exclusive
+            if (nFirstBlock >= nEndBlock)
+            {
+                summarizeRows(rModel, nCol, nFirstRow, nLastRow, rSummary);
+                return true;
+            }
+            summarizeRows(rModel, nCol, nFirstRow, nFirstBlock * s_nBlockSize - 1, rSummary);
+            for (Index nBlock = nFirstBlock; nBlock < nEndBlock; ++nBlock)
+            {
+                if (isCancelled && isCancelled())
+                    return false;
+                NumericSummary blockSummary;
+                if (!findBlock(nCol, nBlock, blockSummary))
+                {
+                    const auto nGeneration = generation();
+                    summarizeRows(rModel, nCol, nBlock * s_nBlockSize, (nBlock + 1) * s_nBlockSize - 1, blockSummary);
+                    insertBlock(nCol, nBlock, blockSummary, nGeneration);
+                }
+                rSummary.merge(blockSummary);
+            }
+            summarizeRows(rModel, nCol, nEndBlock * s_nBlockSize, nLastRow, rSummary);
+            return true;
+        }
+
+        void invalidate(const Index nFirstRow, const Index nLastRow, const Index nFirstCol, const Index nLastCol)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_nGeneration;
+            const auto nEndCol = Min(nLastCol + 1, saturateCast<Index>(m_columns.size()));
+            for (Index c = Max(0, nFirstCol); c < nEndCol; ++c)
+            {
+                auto& blocks = m_columns[c];
+                const auto nEndBlock = Min(nLastRow / s_nBlockSize + 1, saturateCast<Index>(blocks.size()));
+                for (Index nBlock = Max(0, nFirstRow) / s_nBlockSize; nBlock < nEndBlock; ++nBlock)
+                    blocks[nBlock].m_bValid = false;
+            }
+        }
+
+        void invalidateAll()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_nGeneration;
+            m_columns.clear();
+        }
+
+    private:
+        struct Block
+        {
+            NumericSummary m_summary;
+            bool m_bValid = false;
+        };
+
+        static void summarizeRows(const CsvItemModel& rModel, const Index nCol, const Index nFirstRow, const Index nLastRow, NumericSummary& rSummary)
+        {
+            for (Index r = nFirstRow; r <= nLastRow; ++r)
+            {
+                double val;
+                if (CsvItemModel::cellStringToSummaryValue(rModel.rawStringViewAt(r, nCol), val))
+                    rSummary.addValue(val);
+                else
+                    ++rSummary.m_nExcludedCount;
+            }
+        }
+
+        uint64 generation() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_nGeneration;
+        }
+
+        bool findBlock(const Index nCol, const Index nBlock, NumericSummary& rSummary) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!isValidIndex(m_columns, nCol) || !isValidIndex(m_columns[nCol], nBlock) || !m_columns[nCol][nBlock].m_bValid)
+                return false;
+            rSummary = m_columns[nCol][nBlock].m_summary;
+            return true;
+        }
+
+        // Stores block summary unless index has been invalidated after nGeneration was queried, in which case summary might be stale.
+        void insertBlock(const Index nCol, const Index nBlock, const NumericSummary& summary, const uint64 nGeneration)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (nGeneration != m_nGeneration)
+                return;
+            if (!isValidIndex(m_columns, nCol))
+                m_columns.resize(static_cast<size_t>(nCol) + 1);
+            auto& blocks = m_columns[nCol];
+            if (!isValidIndex(blocks, nBlock))
+                blocks.resize(static_cast<size_t>(nBlock) + 1);
+            blocks[nBlock].m_summary = summary;
+            blocks[nBlock].m_bValid = true;
+        }
+
+        std::vector<std::vector<Block>> m_columns;
+        uint64 m_nGeneration = 0; // Incremented on every invalidation.
+        mutable std::mutex m_mutex;
+    }; // class CsvItemModelNumericSummaryIndex
+
+    // Reads csv-file in chunks in a worker thread for CsvItemModel::openFileProgressive(). Worker hands over one chunk at a time
+    // and waits until consumer (=GUI thread) has taken it with consumePendingChunk(), so at most one chunk is in memory in addition to model table.
+    class CsvItemModelProgressiveLoader
+    {
+    public:
+        using Index = CsvItemModel::Index;
+        using ChunkReader = ::DFG_MODULE_NS(cont)::TableCsvChunkedReader<char, Index>;
+        using ChunkTable = ChunkReader::TableCsvT;
+        using NotifyFunc = std::function<void()>;
+
+        // Starts reading in worker thread. onChunkAvailable is called from worker thread when chunk other than the first one is available,
+        // onFinished when reading has ended.
+        CsvItemModelProgressiveLoader(std::string sReadPath, CsvFormatDefinition formatDef, const Index nInitialRowCount, const Index nBatchRowCount, NotifyFunc onChunkAvailable, NotifyFunc onFinished)
+        {
+            m_thread = std::thread([=]()
+            {
+                // Header is on row 0 so first chunk has one row more than what is shown initially.
+                ChunkReader reader(saturateAdd<Index>(Max<Index>(1, nInitialRowCount), 1));
+                const bool bCompleted = reader.readFromFile(sReadPath, formatDef, [&](const ChunkTable& chunk, const Index nFirstRow)
+                {
+                    if (nFirstRow == 0)
+                        reader.setRowsPerChunk(nBatchRowCount);
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    if (m_bCancelled)
+                        return false;
+                    m_pPendingChunk = &chunk;
+                    m_nPendingChunkFirstRow = nFirstRow;
+                    m_condVar.notify_all();
+                    if (nFirstRow != 0) // First chunk is waited synchronously by waitFirstChunk() so no need to notify.
+                        onChunkAvailable();
+                    m_condVar.wait(lock, [&] { return m_bCancelled || m_pPendingChunk == nullptr; });
+                    return !m_bCancelled;
+                });
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_bCompleted = bCompleted;
+                    m_sErrorMsg = reader.readFormat().getReadStat<::DFG_MODULE_NS(cont)::TableCsvReadStat::errorInfo>().value(::DFG_MODULE_NS(cont)::TableCsvErrorInfoFields::errorMsg).rawStorage();
+                    m_readFormat = reader.readFormat();
+                    m_bFinished = true;
+                }
+                m_condVar.notify_all();
+                onFinished();
+            });
+        }
+
+        ~CsvItemModelProgressiveLoader()
+        {
+            cancelAndJoin();
+        }
+
+        // Blocks until first chunk is available or reading has ended and consumes the chunk (if any) like consumePendingChunk().
+        template <class Func_T>
+        void waitFirstChunk(Func_T&& func)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condVar.wait(lock, [&] { return m_bFinished || m_pPendingChunk != nullptr; });
+            }
+            consumePendingChunk(std::forward<Func_T>(func));
+        }
+
+        // If there's pending chunk, calls func(pChunk, nFirstRow) and releases chunk to worker. Worker is not accessing chunk while it is pending,
+        // so func is called without holding the mutex.
+        template <class Func_T>
+        void consumePendingChunk(Func_T&& func)
+        {
+            const ChunkTable* pChunk = nullptr;
+            Index nFirstRow = 0;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                pChunk = m_pPendingChunk;
+                nFirstRow = m_nPendingChunkFirstRow;
+            }
+            if (!pChunk)
+                return;
+            func(pChunk, nFirstRow);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pPendingChunk = nullptr;
+            }
+            m_condVar.notify_all();
+        }
+
+        bool hasPendingChunk() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_pPendingChunk != nullptr;
+        }
+
+        void cancelAndJoin()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bCancelled = true;
+            }
+            m_condVar.notify_all();
+            if (m_thread.joinable())
+                m_thread.join();
+        }
+
+        // Following functions return information about finished read, precondition: cancelAndJoin() has been called.
+        // Returns true if whole file was read without errors.
+        bool isCompleted() const { return m_bCompleted; }
+        // Returns true if setCancelledByUser() was called before reading had completed.
+        bool isCancelledByUser() const { return m_bCancelledByUser && !m_bCompleted; }
+
+        void setCancelledByUser() { m_bCancelledByUser = true; }
+        const std::string& errorMessage() const { return m_sErrorMsg; }
+        // Returns format of the read, reflects the whole file only if isCompleted() is true.
+        const ::DFG_MODULE_NS(cont)::TableCsvReadWriteOptions& readFormat() const { return m_readFormat; }
+        double elapsedWallSeconds() const { return m_timer.elapsedWallSeconds(); }
+
+    private:
+        ::DFG_MODULE_NS(time)::TimerCpu m_timer;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condVar;
+        // Members below are guarded by m_mutex until worker has been joined.
+        const ChunkTable* m_pPendingChunk = nullptr;
+        Index m_nPendingChunkFirstRow = 0;
+        bool m_bCancelled = false;
+        bool m_bFinished = false;
+        bool m_bCompleted = false;
+        std::string m_sErrorMsg;
+        ::DFG_MODULE_NS(cont)::TableCsvReadWriteOptions m_readFormat;
+        bool m_bCancelledByUser = false; // Accessed only from consumer thread.
+        std::thread m_thread;
+    }; // class CsvItemModelProgressiveLoader
+} // unnamed namespace
+
 DFG_OPAQUE_PTR_DEFINE(CsvItemModel)
 {
     std::shared_ptr<QReadWriteLock> m_spReadWriteLock;
+    std::unique_ptr<CsvItemModelDisplayStringCache> m_spDisplayStringCache; // Created on first read, null if caching is disabled.
+    std::unique_ptr<CsvItemModelProgressiveLoader> m_spProgressiveLoader; // Non-null while progressive load is active.
+    mutable CsvItemModelNumericSummaryIndex m_numericSummaryIndex; // Block summaries for columnNumericSummary().
     ::DFG_MODULE_NS(cont)::SetVector<IndexPairInteger> m_readOnlyCells;
     QStringList m_rowNames; // Stores row labels similar to column names. Intended only for allowing transpose
                             // to be round-trippable, there is no logics to make this work with row
@@ -355,10 +828,133 @@ CsvItemModel::CsvItemModel() :
         qRegisterMetaType<QVector<int>>("QVector<int>"); // For dataChanged() (https://bugreports.qt.io/browse/QTBUG-46517)
     }
     DFG_OPAQUE_REF().m_spReadWriteLock = std::make_shared<QReadWriteLock>(QReadWriteLock::Recursive);
+
+    // Invalidating display string cache on changes. Changes made with _noDataChangedSig-functions are handled in those functions.
+    const auto invalidateAll = [this]() { this->privInvalidateCellCaches(); };
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex& topLeft, const QModelIndex& bottomRight)
+        {
+            this->privInvalidateCellCaches(topLeft.row(), bottomRight.row(), topLeft.column(), bottomRight.column());
+        }));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::rowsInserted, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::rowsRemoved, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::rowsMoved, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::columnsInserted, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::columnsRemoved, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::columnsMoved, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::layoutChanged, this, invalidateAll));
+    DFG_QT_VERIFY_CONNECT(connect(this, &QAbstractItemModel::modelReset, this, invalidateAll));
 }
 
 CsvItemModel::~CsvItemModel()
 {
+    // Stopping worker threads before members they may be using get destroyed.
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (pOpaq && pOpaq->m_spProgressiveLoader)
+        pOpaq->m_spProgressiveLoader->cancelAndJoin();
+    if (pOpaq && pOpaq->m_spDisplayStringCache)
+        pOpaq->m_spDisplayStringCache->stopPrefetchThread();
+}
+
+void CsvItemModel::privInvalidateCellCaches()
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq)
+        return;
+    if (pOpaq->m_spDisplayStringCache)
+        pOpaq->m_spDisplayStringCache->invalidateAll();
+    pOpaq->m_numericSummaryIndex.invalidateAll();
+}
+
+void CsvItemModel::privInvalidateCellCaches(const Index nRow, const Index nCol)
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq)
+        return;
+    if (pOpaq->m_spDisplayStringCache)
+        pOpaq->m_spDisplayStringCache->invalidate(nRow, nCol);
+    pOpaq->m_numericSummaryIndex.invalidate(nRow, nRow, nCol, nCol);
+}
+
+void CsvItemModel::privInvalidateCellCaches(const Index nFirstRow, const Index nLastRow, const Index nFirstCol, const Index nLastCol)
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq)
+        return;
+    pOpaq->m_numericSummaryIndex.invalidate(nFirstRow, nLastRow, nFirstCol, nLastCol);
+    if (!pOpaq->m_spDisplayStringCache)
+        return;
+    const auto nCellCount = static_cast<int64>(nLastRow - nFirstRow + 1) * (nLastCol - nFirstCol + 1);
+    if (nCellCount > 1000)
+    {
+        pOpaq->m_spDisplayStringCache->invalidateAll();
+        return;
+    }
+    for (Index r = nFirstRow; r <= nLastRow; ++r)
+        for (Index c = nFirstCol; c <= nLastCol; ++c)
+            pOpaq->m_spDisplayStringCache->invalidate(r, c);
+}
+
+bool CsvItemModel::cellStringToSummaryValue(const StringViewUtf8& sv, double& rVal)
+{
+    if (sv.empty())
+        return false;
+    const char* p = toCharPtr_raw(sv.beginRaw());
+    if (::DFG_MODULE_NS(str)::DFG_DETAIL_NS::tryStrToDoubleFast(p, p + sv.size(), rVal))
+        return true;
+    QString s = viewToQString(sv);
+    s.replace(',', '.');
+    bool bOk = false;
+    rVal = s.toDouble(&bOk);
+    return bOk;
+}
+
+void CsvItemModel::NumericSummary::merge(const NumericSummary& other)
+{
+    m_nIncludedCount += other.m_nIncludedCount;
+    m_nExcludedCount += other.m_nExcludedCount;
+    m_sumMf.merge(other.m_sumMf);
+    m_min = Min(m_min, other.m_min);
+    m_max = Max(m_max, other.m_max);
+}
+
+void CsvItemModel::NumericSummary::addValue(const double val)
+{
+    ++m_nIncludedCount;
+    m_sumMf(val);
+    m_min = Min(m_min, val);
+    m_max = Max(m_max, val);
+}
+
+bool CsvItemModel::columnNumericSummary(const Index nCol, Index nFirstRow, Index nLastRow, NumericSummary& rSummary, std::function<bool()> isCancelled) const
+{
+    if (!isValidColumn(nCol))
+        return true;
+    nFirstRow = Max(0, nFirstRow);
+    nLastRow = Min(nLastRow, rowCount() - 1);
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq || nFirstRow > nLastRow)
+        return true;
+    return pOpaq->m_numericSummaryIndex.summary(*this, nCol, nFirstRow, nLastRow, rSummary, isCancelled);
+}
+
+void CsvItemModel::prefetchDisplayStrings(std::vector<Index> rows, std::vector<Index> columns) const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (pOpaq && pOpaq->m_spDisplayStringCache)
+        pOpaq->m_spDisplayStringCache->requestPrefetch(*this, std::move(rows), std::move(columns));
+}
+
+void CsvItemModel::cancelDisplayStringPrefetch() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (pOpaq && pOpaq->m_spDisplayStringCache)
+        pOpaq->m_spDisplayStringCache->cancelPrefetch();
+}
+
+size_t CsvItemModel::displayStringCacheSize() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (pOpaq && pOpaq->m_spDisplayStringCache) ? pOpaq->m_spDisplayStringCache->size() : 0;
 }
 
 auto CsvItemModel::getReadWriteLock() -> std::shared_ptr<QReadWriteLock>
@@ -607,9 +1203,8 @@ bool CsvItemModel::exportAsSQLiteFile(const QString& sPath, const SaveOptions& o
     {
         for (int c = 0; c < nColCount; ++c)
         {
-            auto tpsz = table()(r, c);
-            auto sv = StringViewUtf8(tpsz);
-            insertStatement.bindValue(c, tpsz ? QVariant(viewToQString(sv)) : QVariant());
+            const auto sv = rawStringViewAt(r, c);
+            insertStatement.bindValue(c, sv.dataRaw() ? QVariant(viewToQString(sv)) : QVariant());
         }
         if (insertStatement.exec())
             ++nPendingInserts;
@@ -731,7 +1326,24 @@ bool CsvItemModel::saveImpl(Stream_T& strm, const SaveOptions& options)
     mainTableSaveOptions.bomWriting(false); // BOM has already been handled.
     mainTableSaveOptions.textEncoding(encoding);
     CsvWritePolicy<decltype(strm)> writePolicy(mainTableSaveOptions);
-    table().writeToStream(strm, writePolicy);
+    if (mainTableSaveOptions.getPropertyT<SaveOptions::PropertyId::writeOpt_threadCount>(1) != 1)
+    {
+        // Multithreaded write: every write thread has its own policy and invalid content rows are collected from them after the write.
+        using BlockPolicy = CsvWritePolicy<CsvItemModel::OpaqueTypeDefs::DataTable::WriteBlockStream>;
+        table().writeToStreamMultiThreaded(strm, mainTableSaveOptions, [&]() { return BlockPolicy(mainTableSaveOptions); }, [&](const BlockPolicy& blockPolicy)
+        {
+            auto& dest = writePolicy.m_colToInvalidContentRowList;
+            const auto& src = blockPolicy.m_colToInvalidContentRowList;
+            if (dest.size() < src.size())
+                dest.resize(src.size());
+            for (size_t c = 0; c < src.size(); ++c)
+                dest[c].insert(dest[c].end(), src[c].begin(), src[c].end());
+        });
+        for (auto& rows : writePolicy.m_colToInvalidContentRowList)
+            std::sort(rows.begin(), rows.end()); // Blocks may finish in any order.
+    }
+    else
+        table().writeToStream(strm, writePolicy);
     if (!writePolicy.m_colToInvalidContentRowList.empty())
     {
         size_t nInvalidCount = 0;
@@ -763,6 +1375,7 @@ bool CsvItemModel::setItem_noDataChangedSig(const Index nRow, const Index nCol,
 {
     const auto bRv = table().addString(sv, nRow, nCol);
     DFG_ASSERT(bRv); // Triggering ASSERT means that string couldn't be added to table.
+    privInvalidateCellCaches(nRow, nCol);
     return bRv;
 }
 
@@ -774,6 +1387,7 @@ bool CsvItemModel::setItem_noDataChangedSig(const Index nRow, const Index nCol,
 bool CsvItemModel::clearItem_noDataChangedSig(const Index nRow, const Index nCol)
 {
     table().clearCell(nRow, nCol);
+    privInvalidateCellCaches(nRow, nCol);
     return true;
 }
 
@@ -825,6 +1439,7 @@ void CsvItemModel::clear()
 
     DFG_OPAQUE_REF().m_readOnlyCells.clear();
     DFG_OPAQUE_REF().m_rowNames.clear();
+    privInvalidateCellCaches();
 }
 
 bool CsvItemModel::openStream(QTextStream& strm)
@@ -857,10 +1472,19 @@ bool CsvItemModel::readData(const LoadOptions& options, std::function<bool()> ta
 {
     ::DFG_MODULE_NS(time)::TimerCpu readTimer;
 
+    cancelProgressiveLoad();
+
     beginResetModel();
     m_bResetting = true;
     clear();
 
+    {
+        auto& rOpaq = DFG_OPAQUE_REF();
+        const auto nDisplayStringCacheMaxSize = getCsvItemModelProperty<CsvItemModelPropertyId_displayStringCacheMaxSize>(this);
+        if (!rOpaq.m_spDisplayStringCache && nDisplayStringCacheMaxSize > 0)
+            rOpaq.m_spDisplayStringCache = std::make_unique<CsvItemModelDisplayStringCache>(nDisplayStringCacheMaxSize);
+    }
+
     // Actual read happens here
     const auto bTableFillerRv = tableFiller();
 
@@ -943,6 +1567,10 @@ bool CsvItemModel::readData(const LoadOptions& options, std::function<bool()> ta
     if (m_nRowCount >= 1)
         m_nRowCount--;
 
+    // Building numeric caches only after header removal since removing rows releases them.
+    if (options.getProperty(CsvOptionProperty_readNumericColumnCaches, "0") == "1")
+        table().forEachFwdColumnIndex([&](const Index nCol) { table().typedColumnCache<double>(nCol); });
+
     initCompletionFeature();
 
     m_bModified = false;
@@ -1451,6 +2079,150 @@ bool CsvItemModel::openFile(QString sDbFilePath, LoadOptions loadOptions)
     }
 }
 
+bool CsvItemModel::openFileProgressive(QString sPath, LoadOptions loadOptions, const Index nInitialRowCount, const Index nBatchRowCount)
+{
+    if (sPath.isEmpty())
+        return false;
+
+    // Filtered reads are not supported in progressive mode, using ordinary open for them.
+    if (loadOptions.isFilteredRead())
+        return openFile(std::move(sPath), std::move(loadOptions));
+
+    const QFileInfo fileInfo(sPath);
+
+    m_messagesFromLatestOpen.clear();
+
+    if (!fileInfo.isFile())
+    {
+        m_messagesFromLatestOpen << tr("Path is not a file");
+        return false;
+    }
+    if (!::DFG_MODULE_NS(os)::isPathFileAvailable(qStringToFileApi8Bit(sPath), DFG_MODULE_NS(os)::FileModeRead))
+    {
+        m_messagesFromLatestOpen << tr("File is not readable");
+        return false;
+    }
+
+    sPath = fileInfo.absoluteFilePath();
+    setCompleterHandlingFromInputSize(loadOptions, static_cast<uint64>(fileInfo.size()));
+    // If encoding is not given and there is no BOM in file, trying to read as UTF8
+    if (loadOptions.textEncoding() == ::DFG_MODULE_NS(io)::encodingUnknown &&
+        ::DFG_MODULE_NS(io)::checkBOMFromFile(qStringToFileApi8Bit(sPath)) == ::DFG_MODULE_NS(io)::encodingUnknown)
+        loadOptions.textEncoding(::DFG_MODULE_NS(io)::encodingUTF8);
+
+    return readData(loadOptions, [&]()
+    {
+        // Worker thread notifies about chunks and finishing through event loop so that model is modified only in GUI thread.
+        auto& rOpaq = DFG_OPAQUE_REF();
+        rOpaq.m_spProgressiveLoader = std::make_unique<CsvItemModelProgressiveLoader>(qStringToFileApi8Bit(sPath), loadOptions, nInitialRowCount, nBatchRowCount,
+            [this]() { QMetaObject::invokeMethod(this, [this]() { this->privConsumeProgressiveChunk(); }, Qt::QueuedConnection); },
+            [this]() { QMetaObject::invokeMethod(this, [this]() { this->privFinishProgressiveLoad(); }, Qt::QueuedConnection); });
+        // First chunk (which includes header) is read synchronously so that model has columns and initial rows when returning.
+        rOpaq.m_spProgressiveLoader->waitFirstChunk([&](const CsvItemModelProgressiveLoader::ChunkTable* pChunk, Dummy)
+        {
+            pChunk->forEachNonNullCell([&](const Index r, const Index c, const SzPtrUtf8R psz)
+            {
+                table().setElement(r, c, psz);
+            });
+        });
+        // Chunk reader provides the final read format only after the whole file has been read (see privFinishProgressiveLoad()),
+        // until then using load options with auto-detected items resolved from the beginning of the file so that saving has proper format also
+        // during and after cancelled load.
+        {
+            auto& rReadFormat = table().m_readFormat;
+            rReadFormat = loadOptions;
+            if (::DFG_MODULE_NS(io)::DelimitedTextReader::isMetaChar(rReadFormat.separatorChar()))
+                rReadFormat.separatorChar(peekCsvFormatFromFile(sPath).separatorChar());
+            if (rReadFormat.textEncoding() == ::DFG_MODULE_NS(io)::encodingUnknown)
+                rReadFormat.textEncoding(::DFG_MODULE_NS(io)::checkBOMFromFile(qStringToFileApi8Bit(sPath)));
+            table().saveFormat(rReadFormat);
+        }
+        setFilePathWithoutSignalEmit(std::move(sPath));
+        return true;
+    });
+}
+
+bool CsvItemModel::isProgressiveLoadActive() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return pOpaq && pOpaq->m_spProgressiveLoader;
+}
+
+void CsvItemModel::cancelProgressiveLoad()
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq || !pOpaq->m_spProgressiveLoader)
+        return;
+    pOpaq->m_spProgressiveLoader->setCancelledByUser();
+    privFinishProgressiveLoad();
+}
+
+void CsvItemModel::privConsumeProgressiveChunk()
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    auto pLoader = (pOpaq) ? pOpaq->m_spProgressiveLoader.get() : nullptr;
+    if (!pLoader || !pLoader->hasPendingChunk())
+        return;
+    auto lockReleaser = tryLockForEdit();
+    if (!lockReleaser.isLocked())
+    {
+        // Some operation is using the model, trying again a bit later.
+        QTimer::singleShot(50, this, [this]() { this->privConsumeProgressiveChunk(); });
+        return;
+    }
+    pLoader->consumePendingChunk([&](const CsvItemModelProgressiveLoader::ChunkTable* pChunk, const Index nFirstRow)
+    {
+        const Index nFirstModelRow = nFirstRow - 1; // Header row is not stored in table.
+        const auto nChunkColCount = pChunk->colCountByMaxColIndex();
+        if (nChunkColCount > getColumnCount())
+        {
+            const auto nOldColCount = getColumnCount();
+            beginInsertColumns(QModelIndex(), nOldColCount, nChunkColCount - 1);
+            insertColumnsImpl(nOldColCount, nChunkColCount - nOldColCount);
+            endInsertColumns();
+        }
+        const auto nNewRowCount = Max(m_nRowCount, nFirstModelRow + pChunk->rowCountByMaxRowIndex());
+        const bool bHasNewRows = (nNewRowCount > m_nRowCount);
+        if (bHasNewRows)
+            beginInsertRows(QModelIndex(), m_nRowCount, nNewRowCount - 1);
+        pChunk->forEachNonNullCell([&](const Index r, const Index c, const SzPtrUtf8R psz)
+        {
+            table().setElement(nFirstModelRow + r, c, psz);
+        });
+        m_nRowCount = nNewRowCount;
+        if (bHasNewRows)
+            endInsertRows();
+    });
+}
+
+void CsvItemModel::privFinishProgressiveLoad()
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq || !pOpaq->m_spProgressiveLoader)
+        return;
+    auto& rLoader = *pOpaq->m_spProgressiveLoader;
+    rLoader.cancelAndJoin();
+    const bool bCompleted = rLoader.isCompleted();
+    if (!rLoader.errorMessage().empty())
+        m_messagesFromLatestOpen << QString::fromUtf8(rLoader.errorMessage().c_str());
+    if (bCompleted)
+    {
+        table().m_readFormat = rLoader.readFormat();
+        table().saveFormat(table().m_readFormat);
+    }
+    // Completers were initialized by readData() from the first chunk only.
+    initCompletionFeature();
+    if (rLoader.isCancelledByUser())
+    {
+        // Like in openFile(), not keeping path of partly read file so that saving won't by default overwrite the original file.
+        m_sTitle = tr("%1 (cancelled open)").arg(QFileInfo(m_sFilePath).fileName());
+        setFilePathWithSignalEmit(QString());
+    }
+    m_readTimeInSeconds = static_cast<decltype(m_readTimeInSeconds)>(rLoader.elapsedWallSeconds());
+    pOpaq->m_spProgressiveLoader.reset();
+    Q_EMIT sigProgressiveLoadFinished(bCompleted);
+}
+
 bool CsvItemModel::readDataFromSqlite(const QString& sDbFilePath, const QString& sQuery, LoadOptions& loadOptions)
 {
     if (!QFileInfo::exists(sDbFilePath))
@@ -1575,7 +2347,7 @@ auto CsvItemModel::rawStringPtrAt(const QModelIndex& index) const -> SzPtrUtf8R
 
 auto CsvItemModel::rawStringViewAt(const int nRow, const int nCol) const -> StringViewUtf8
 {
-    return StringViewUtf8(table()(nRow, nCol));
+    return table().viewAt(nRow, nCol);
 }
 
 auto CsvItemModel::rawStringViewAt(const QModelIndex& index) const -> StringViewUtf8
@@ -1592,8 +2364,14 @@ double CsvItemModel::cellDataAsDouble(const QModelIndex& modelIndex, ::DFG_MODUL
 
 double CsvItemModel::cellDataAsDouble(const Index nRow, const Index nCol, ::DFG_MODULE_NS(charts)::ChartDataType* pInterpretedInputDataType, double returnValueOnConversionFailure) const
 {
-    auto sv = rawStringPtrAt(nRow, nCol);
-    return cellDataAsDouble(sv, nRow, nCol, pInterpretedInputDataType, returnValueOnConversionFailure);
+    // Not using rawStringPtrAt() since for memory mapped cells it would store terminated copy of every cell converted.
+    std::string sBuffer;
+    double rv = returnValueOnConversionFailure;
+    table().withTerminatedContentAt(nRow, nCol, sBuffer, [&](const SzPtrUtf8R psz)
+    {
+        rv = cellDataAsDouble(psz, nRow, nCol, pInterpretedInputDataType, returnValueOnConversionFailure);
+    });
+    return rv;
 }
 
 double CsvItemModel::cellDataAsDouble(StringViewSzUtf8 sv, const Index nRow, const Index nCol, ::DFG_MODULE_NS(charts)::ChartDataType* pInterpretedInputDataType, double returnValueOnConversionFailure) const
@@ -1621,11 +2399,23 @@ QVariant CsvItemModel::data(const QModelIndex& index, int role /*= Qt::DisplayRo
 
     if ((role == Qt::DisplayRole || role == Qt::EditRole || role == Qt::ToolTipRole))
     {
-        const SzPtrUtf8R p = table()(nRow, nCol);
+        const auto sv = rawStringViewAt(nRow, nCol);
         // Note: also checking for empty string as fromUtf8() does allocation if given an empty string (at least 5.13.1 and earlier).
         // Note: At least ctrl+arrow behaviour in TableView is dependent on the distinction between returning QString("") and QVariant().
         //       As of 2019-12-08, implementation requires empty cells to be QVariant() instead of QVariant(QString(""))
-        return (p && !::DFG_MODULE_NS(str)::isEmptyStr(p)) ? QString::fromUtf8(p.c_str()) : QVariant();
+        if (sv.empty())
+            return QVariant();
+        auto pOpaq = DFG_OPAQUE_PTR();
+        auto pCache = (pOpaq) ? pOpaq->m_spDisplayStringCache.get() : nullptr;
+        if (!pCache)
+            return viewToQString(sv);
+        QString s;
+        if (pCache->find(nRow, nCol, s))
+            return s;
+        const auto nGeneration = pCache->generation();
+        s = viewToQString(sv);
+        pCache->insert(nRow, nCol, s, nGeneration);
+        return s;
     }
     else if (role == Qt::BackgroundRole && !m_highlighters.empty())
     {
@@ -1758,6 +2548,8 @@ bool CsvItemModel::isReadOnlyColumn(Index c) const
 bool CsvItemModel::isCellEditable(const Index nRow, const Index nCol) const
 {
     auto pOpaq = DFG_OPAQUE_PTR();
+    if (pOpaq && pOpaq->m_spProgressiveLoader)
+        return false; // Not editable until progressive load has finished.
     return !isReadOnlyColumn(nCol) && (!pOpaq || pOpaq->m_readOnlyCells.empty() || !pOpaq->m_readOnlyCells.hasKey(cellRowColumnPairToIndexPairInteger(nRow, nCol)));
 }
 
@@ -2165,10 +2957,10 @@ void CsvItemModel::rowToString(const int nRow, QString& str, const QChar cDelim,
         if (!bFirstItem) // To make sure that there won't be a delim in front of first item.
             str.push_back(cDelim);
         bFirstItem = false;
-        SzPtrUtf8R p = table()(nRow, nCol);
-        if (!p)
+        const auto sv = rawStringViewAt(nRow, nCol);
+        if (!sv.dataRaw())
             continue;
-        dataCellToString(QString::fromUtf8(p.c_str()), str, cDelim);
+        dataCellToString(viewToQString(sv), str, cDelim);
     }
 }
 
@@ -2306,7 +3098,7 @@ QModelIndex CsvItemModel::findNextHighlighterMatch(QModelIndex seedIndex, // See
 
     const auto isMatchWith = [&](const QModelIndex& index)
     {
-        return matcher.isMatchWith(table()(index.row(), index.column()));
+        return matcher.isMatchWith(rawStringViewAt(index.row(), index.column()));
     };
 
    if (searchIndex == seedIndex)
@@ -2615,7 +3407,7 @@ namespace DFG_DETAIL_NS
 
     auto CsvItemModelTable::viewAt(const Index nRow, const Index nCol) const -> StringViewUtf8
     {
-        return StringViewUtf8((*this)(nRow, nCol));
+        return impl().viewAt(nRow, nCol);
     }
 
     void CsvItemModelTable::setElement(Index nRow, Index nCol, StringViewUtf8 sv)
@@ -2650,9 +3442,111 @@ namespace DFG_DETAIL_NS
         return impl().cellCountNonEmpty();
     }
 
+    auto CsvItemModelTable::numericColumnCacheIfAvailable(const Index nCol) const -> const NumericColumnCache*
+    {
+        return impl().typedColumnCacheIfAvailable<double>(nCol);
+    }
+
 } // namespace DFG_DETAIL_NS
 
 
+//////////////////////////////////////////////////////////////////////////
+//
+// class CsvLazyReadOnlyItemModel
+//
+//////////////////////////////////////////////////////////////////////////
+
+DFG_OPAQUE_PTR_DEFINE(CsvLazyReadOnlyItemModel)
+{
+    using LazyTable = ::DFG_MODULE_NS(cont)::TableCsvLazy<char, int>;
+    mutable LazyTable m_table; // Mutable since accessing content parses rows on demand.
+    QString m_sFilePath;
+};
+
+CsvLazyReadOnlyItemModel::CsvLazyReadOnlyItemModel(QObject* pParent)
+    : BaseClass(pParent)
+{
+}
+
+CsvLazyReadOnlyItemModel::~CsvLazyReadOnlyItemModel() = default;
+
+bool CsvLazyReadOnlyItemModel::openFile(const QString& sPath)
+{
+    return openFile(sPath, CsvItemModel::getLoadOptionsForFile(sPath, nullptr));
+}
+
+bool CsvLazyReadOnlyItemModel::openFile(const QString& sPath, const LoadOptions& loadOptions)
+{
+    beginResetModel();
+    auto& rOpaq = DFG_OPAQUE_REF();
+    const auto bOpened = rOpaq.m_table.open(qStringToFileApi8Bit(sPath), loadOptions);
+    rOpaq.m_sFilePath = (bOpened) ? sPath : QString();
+    endResetModel();
+    return bOpened;
+}
+
+QString CsvLazyReadOnlyItemModel::getFilePath() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (pOpaq) ? pOpaq->m_sFilePath : QString();
+}
+
+void CsvLazyReadOnlyItemModel::setMaxLoadedChunkCount(const size_t nMaxCount)
+{
+    DFG_OPAQUE_REF().m_table.setMaxLoadedChunkCount(nMaxCount);
+}
+
+size_t CsvLazyReadOnlyItemModel::loadedChunkCount() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (pOpaq) ? pOpaq->m_table.loadedChunkCount() : 0;
+}
+
+int CsvLazyReadOnlyItemModel::rowCount(const QModelIndex& parent) const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (parent.isValid() || !pOpaq)
+        return 0;
+    return Max(0, pOpaq->m_table.rowCountByMaxRowIndex() - 1); // First row is header.
+}
+
+int CsvLazyReadOnlyItemModel::columnCount(const QModelIndex& parent) const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (!parent.isValid() && pOpaq) ? pOpaq->m_table.colCountByMaxColIndex() : 0;
+}
+
+QString CsvLazyReadOnlyItemModel::privFileCellText(const int nRow, const int nCol) const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq)
+        return QString();
+    const auto psz = pOpaq->m_table(nRow, nCol);
+    return (psz) ? QString::fromUtf8(psz.c_str()) : QString();
+}
+
+QVariant CsvLazyReadOnlyItemModel::data(const QModelIndex& index, const int role) const
+{
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::ToolTipRole))
+        return QVariant();
+    return privFileCellText(index.row() + 1, index.column());
+}
+
+QVariant CsvLazyReadOnlyItemModel::headerData(const int section, const Qt::Orientation orientation, const int role) const
+{
+    if (role != Qt::DisplayRole)
+        return QVariant();
+    if (orientation == Qt::Vertical)
+        return QString::number(section + CsvItemModel::internalRowToVisibleShift());
+    const auto sHeaderName = privFileCellText(0, section);
+    return (!sHeaderName.isEmpty()) ? sHeaderName : QString::number(section + CsvItemModel::internalColumnToVisibleShift());
+}
+
+Qt::ItemFlags CsvLazyReadOnlyItemModel::flags(const QModelIndex& index) const
+{
+    return (index.isValid()) ? (Qt::ItemIsEnabled | Qt::ItemIsSelectable) : Qt::NoItemFlags;
+}
+
 #if DFG_CSV_ITEM_MODEL_ENABLE_DRAG_AND_DROP_TESTS
 static const QString sMimeTypeStr = "text/csv";
 
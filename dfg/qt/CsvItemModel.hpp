@@ -15,6 +15,7 @@
 #include "../cont/SortedSequence.hpp"
 #include "../Span.hpp"
 #include "../cont/MapToStringViews.hpp"
+#include "../func/memFunc.hpp"
 
 DFG_BEGIN_INCLUDE_QT_HEADERS
 #include <QAbstractTableModel>
@@ -31,6 +32,7 @@ DFG_END_INCLUDE_QT_HEADERS
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(cont)
 {
     class CsvConfig;
+    namespace DFG_DETAIL_NS { template <class Value_T> class TableTypedColumnCache; }
 } }
 
 DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(io)
@@ -81,6 +83,10 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
     const char CsvOptionProperty_chartPanelWidth[]          = "chartPanelWidth"; // Chart panel width to use with the associated document; see TableEditor_chartPanelWidth for format documentation.
     const char CsvOptionProperty_readThreadBlockSizeMinimum[] = "readThreadBlockSizeMinimum"; // Sets TableCsvReadWriteOptions::PropertyId::readOpt_threadBlockSizeMinimum
     const char CsvOptionProperty_readThreadCountMaximum[]   = "readThreadCountMaximum"; // Sets TableCsvReadWriteOptions::PropertyId::readOpt_threadCount
+    const char CsvOptionProperty_readMemoryMappedCellStorage[] = "readMemoryMappedCellStorage"; // Sets TableCsvReadWriteOptions::PropertyId::readOpt_memoryMappedCellStorage (0/1, default 0).
+                                                                                     // File stays mapped while the model refers to it, which e.g. on Windows prevents overwriting it.
+    const char CsvOptionProperty_readNumericColumnCaches[] = "readNumericColumnCaches"; // If "1", double-caches are built for all columns when reading (0/1, default 0), see CsvItemModelTable::numericColumnCacheIfAvailable().
+    const char CsvOptionProperty_writeThreadCountMaximum[]  = "writeThreadCountMaximum"; // Sets TableCsvReadWriteOptions::PropertyId::writeOpt_threadCount when saving, 0 = autodetermine.
     const char CsvOptionProperty_windowHeight[]             = "windowHeight";    // Window height to request for use with the associated document, ignored if windowMaximized is true; see TableEditor_chartPanelWidth for format documentation.
     const char CsvOptionProperty_windowWidth[]              = "windowWidth";     // Window width to request for use with the associated document, ignored if windowMaximized is true; see TableEditor_chartPanelWidth for format documentation.
     const char CsvOptionProperty_windowPosX[]               = "windowPosX";      // Window x position to request for use with the associated document, ignored if windowMaximized is true.
@@ -175,6 +181,11 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
 
             LinearIndex cellCountNonEmpty() const;
 
+            using NumericColumnCache = ::DFG_MODULE_NS(cont)::DFG_DETAIL_NS::TableTypedColumnCache<double>;
+            // Returns numeric cache of column nCol if it was built on read (see CsvOptionProperty_readNumericColumnCaches) and column
+            // hasn't been edited since, nullptr otherwise. Cached value of a cell is valid iff cell content converts to double with strTo().
+            const NumericColumnCache* numericColumnCacheIfAvailable(Index nCol) const;
+
             class TableRef;
 
                   TableRef& impl();
@@ -551,6 +562,13 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         bool openFromSqlite(const QString& sDbFilePath, const QString& sQuery);
         bool openFromSqlite(const QString& sDbFilePath, const QString& sQuery, LoadOptions& loadOptions);
         bool openFile(QString sDbFilePath, LoadOptions loadOptions);
+        // Opens csv-file progressively: returns after first nInitialRowCount rows have been read and reads the rest in a worker thread
+        // adding rows to model in batches of nBatchRowCount rows. Cells are not editable until loading has finished,
+        // completion is signalled with sigProgressiveLoadFinished(). Filtered reads are done like with openFile().
+        bool openFileProgressive(QString sPath, LoadOptions loadOptions, Index nInitialRowCount = 1000, Index nBatchRowCount = 100000);
+        bool isProgressiveLoadActive() const;
+        // Stops active progressive load keeping rows read so far; does nothing if there is no active progressive load.
+        void cancelProgressiveLoad();
         bool importFiles(const QStringList& paths);
         bool openStream(QTextStream& strm);
         bool openStream(QTextStream& strm, const LoadOptions& loadOptions);
@@ -627,6 +645,47 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         StringViewUtf8 rawStringViewAt(const int nRow, const int nCol) const;
         StringViewUtf8 rawStringViewAt(const QModelIndex& index) const;
 
+        // Requests display strings (i.e. data() for DisplayRole) of given cells to be converted to display string cache in a background thread,
+        // e.g. for visible part of a view, replacing possible earlier request that hasn't been started yet. Cache size is controlled by
+        // property CsvItemModel_displayStringCacheMaxSize.
+        void prefetchDisplayStrings(std::vector<Index> rows, std::vector<Index> columns) const;
+
+        // Cancels pending and ongoing display string prefetch, e.g. when cell editor is opened so that prefetch won't make the edit fail to get edit lock.
+        void cancelDisplayStringPrefetch() const;
+
+        // Returns the number of cells in display string cache.
+        size_t displayStringCacheSize() const;
+
+        // Summary of numeric interpretation of a set of cells, see columnNumericSummary().
+        class NumericSummary
+        {
+        public:
+            void merge(const NumericSummary& other);
+
+            // Adds a cell with numeric interpretation 'val'.
+            void addValue(double val);
+
+            // Returns sum of included values. Summation is compensated like in selection analyzer so that result doesn't depend on whether it was computed from block summaries or cell by cell.
+            double sum() const { return m_sumMf.value(); }
+
+            size_t m_nIncludedCount = 0; // Number of cells that have numeric interpretation.
+            size_t m_nExcludedCount = 0; // Number of cells that don't have numeric interpretation, includes empty cells.
+            ::DFG_MODULE_NS(func)::MemFuncSumCompensated<double> m_sumMf;
+            double m_min = std::numeric_limits<double>::infinity();
+            double m_max = -std::numeric_limits<double>::infinity();
+        };
+
+        // Numeric interpretation of cell content used in selection details and columnNumericSummary(): QString::toDouble() of display string with ','
+        // replaced by '.', e.g. "1,5" is 1.5 and empty string has no numeric interpretation. Returns false if sv has no numeric interpretation.
+        static bool cellStringToSummaryValue(const StringViewUtf8& sv, double& rVal);
+
+        // Adds summary of rows [nFirstRow, nLastRow] in column nCol to rSummary, see cellStringToSummaryValue() for numeric interpretation of cells.
+        // Summaries of whole row blocks come from a per-column block index that is built on first use and whose blocks are invalidated on edits,
+        // so that e.g. repeated queries for a whole column of a huge table need to parse only edited blocks and partial blocks at range ends.
+        // Caller should hold read lock like with data(); function itself is thread safe.
+        // Returns false if isCancelled returned true (checked between blocks), in which case rSummary has partial result.
+        bool columnNumericSummary(Index nCol, Index nFirstRow, Index nLastRow, NumericSummary& rSummary, std::function<bool()> isCancelled = nullptr) const;
+
         double cellDataAsDouble(const QModelIndex& modelIndex, ::DFG_MODULE_NS(charts)::ChartDataType* pInterpretedInputDataType = nullptr, double returnValueOnConversionFailure = std::numeric_limits<double>::quiet_NaN()) const;
         double cellDataAsDouble(Index nRow, Index nCol, ::DFG_MODULE_NS(charts)::ChartDataType* pInterpretedInputDataType = nullptr, double returnValueOnConversionFailure = std::numeric_limits<double>::quiet_NaN()) const;
         // Overload for case where string has already been fetched. Precondition: rawStringViewAt(nRow, nCol) == sv
@@ -792,6 +851,8 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         void sigOnNewSourceOpened();
         void sigSourcePathChanged();
         void sigOnSaveToFileCompleted(bool, double);
+        // Emitted when progressive load started with openFileProgressive() has ended, bCompleted is true if whole file was read successfully.
+        void sigProgressiveLoadFinished(bool bCompleted);
         // Emitted when the way how content is interpreted as numbers has changed (e.g. column type or custom string-to-double parser has changed)
         // Parameter is currently not used.
         void sigColumnNumberDataInterpretationChanged(::DFG_MODULE_NS(qt)::CsvItemModel::Index nCol, ::DFG_MODULE_NS(qt)::CsvItemModel::ColumnNumberDataInterpretationChangedParam);
@@ -831,6 +892,14 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         // Note: this is different from setting cell to empty string.
         bool clearItem_noDataChangedSig(Index nRow, Index nCol);
 
+        // Invalidates cell content derived caches, i.e. display string cache and numeric summary index.
+        void privInvalidateCellCaches();
+        void privInvalidateCellCaches(Index nRow, Index nCol);
+        void privInvalidateCellCaches(Index nFirstRow, Index nLastRow, Index nFirstCol, Index nLastCol);
+
+        void privConsumeProgressiveChunk();
+        void privFinishProgressiveLoad();
+
     public:
         QUndoStack* m_pUndoStack;
         DataTable m_table;
@@ -883,4 +952,40 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         }
     }; // CsvItemModelStringMatcher
 
+    // Read-only model for viewing csv-files that are too big to be opened as editable CsvItemModel.
+    // Content is parsed on demand by TableCsvLazy that keeps only a bounded number of parsed row chunks in memory so
+    // opening is fast and memory usage stays bounded regardless of file size. First row of the file is used as header.
+    // Encoding must be one where ASCII-bytes are valid content, e.g. UTF-8 or Latin-1.
+    class CsvLazyReadOnlyItemModel : public QAbstractTableModel
+    {
+    public:
+        using BaseClass = QAbstractTableModel;
+        using LoadOptions = CsvItemModel::LoadOptions;
+
+        CsvLazyReadOnlyItemModel(QObject* pParent = nullptr);
+        ~CsvLazyReadOnlyItemModel() override;
+
+        // Opens file for viewing, returns true if successful.
+        bool openFile(const QString& sPath);
+        bool openFile(const QString& sPath, const LoadOptions& loadOptions);
+
+        QString getFilePath() const;
+
+        // Sets maximum number of parsed row chunks kept in memory, see TableCsvLazy::setMaxLoadedChunkCount().
+        void setMaxLoadedChunkCount(size_t nMaxCount);
+        size_t loadedChunkCount() const;
+
+        int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+        int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+        QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+        Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    private:
+        // Returns content of cell in file indexing, i.e. header is at row 0.
+        QString privFileCellText(int nRow, int nCol) const;
+
+        DFG_OPAQUE_PTR_DECLARE();
+    }; // class CsvLazyReadOnlyItemModel
+
 } } // module namespace
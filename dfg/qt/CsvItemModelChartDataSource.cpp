@@ -1,6 +1,7 @@
 #include "CsvItemModelChartDataSource.hpp"
 #include "connectHelper.hpp"
 #include "../cont/valueArray.hpp"
+#include "../cont/table.hpp"
 #include "detail//CsvItemModel/chartDoubleAccesser.hpp"
 
 DFG_BEGIN_INCLUDE_QT_HEADERS
@@ -88,6 +89,10 @@ void ::DFG_MODULE_NS(qt)::CsvItemModelChartDataSource::forEachElement_byColumn(c
 
     const auto colType = m_columnTypes[c];
 
+    // When column has no special type, using numeric cache if model has built one: for cells that it has valid value for, the value is
+    // identical to stringToDouble() below so parsing can be skipped.
+    const auto pNumericCache = (colType == ChartDataType::unknown) ? rTable.numericColumnCacheIfAvailable(nColCellIndex) : nullptr;
+
     using ValueVector = ::DFG_MODULE_NS(cont)::ValueVector<double>;
     using StringViewVector = ::DFG_MODULE_NS(cont)::Vector<StringViewUtf8>;
     ValueVector rows;
@@ -132,8 +137,10 @@ void ::DFG_MODULE_NS(qt)::CsvItemModelChartDataSource::forEachElement_byColumn(c
             rows.push_back(static_cast<double>(CsvItemModel::internalRowIndexToVisible(r)));
         if (queryDetails.areNumbersRequested())
         {
+            if (pNumericCache && pNumericCache->isValid(static_cast<size_t>(r)))
+                vals.push_back(pNumericCache->value(static_cast<size_t>(r)));
             // When colType is unknown (double) and it has no comma, parsing string directly as double...
-            if (colType == ChartDataType::unknown && std::strchr(psz.c_str(), ',') == nullptr)
+            else if (colType == ChartDataType::unknown && std::strchr(psz.c_str(), ',') == nullptr)
                 vals.push_back(stringToDouble(StringViewSzC(psz.c_str())));
             else // ...otherwise getting it through model access with datetime etc. parsing capabilities.
                 vals.push_back(ModelDoubleAccesser(r, nColCellIndex, rCsvModel, m_columnTypes, c)(psz));
@@ -241,7 +248,9 @@ void ::DFG_MODULE_NS(qt)::CsvItemModelChartDataSource::onModelChanged_tableConte
         DFG_OPAQUE_REF().m_anChangeCounter++;
         const auto nLeftCol = static_cast<DataSourceIndex>(topLeft.column());
         const auto nRightCol = static_cast<DataSourceIndex>(bottomRight.column());
-        emitSigChanged(DataSourceChangedParam::fromInvalidColumnRange(nLeftCol, nRightCol));
+        const auto nTopRow = static_cast<DataSourceIndex>(CsvItemModel::internalRowIndexToVisible(topLeft.row()));
+        const auto nBottomRow = static_cast<DataSourceIndex>(CsvItemModel::internalRowIndexToVisible(bottomRight.row()));
+        emitSigChanged(DataSourceChangedParam::fromInvalidCellRange(nLeftCol, nRightCol, nTopRow, nBottomRow));
     }
     else // Case: don't know what changed, treating as generic change.
         onModelChanged_generic();
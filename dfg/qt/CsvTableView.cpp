@@ -32,8 +32,10 @@
 #include "detail/CsvTableView/actionWidgets/RegexFormatWidget.hpp"
 #include "detail/CsvTableView/UndoViewWidget.hpp"
 #include <chrono>
+#include <array>
 #include <bitset>
 #include <cctype> // For std::isdigit
+#include <mutex>
 #include <thread>
 
 #include "../logging.hpp"
@@ -48,6 +50,7 @@ DFG_BEGIN_INCLUDE_QT_HEADERS
 #include <QDesktopServices>
 #include <QDialogButtonBox>
 #include <QCheckBox>
+#include <QCollator>
 #include <QCompleter>
 #include <QDate>
 #include <QDateTime>
@@ -81,19 +84,13 @@ DFG_END_INCLUDE_QT_HEADERS
 #include <map>
 #include <optional>
 #include "../alg.hpp"
+#include "../alg/sortMultiple.hpp"
+#include "../concurrency/ThreadList.hpp"
 #include "../cont/SortedSequence.hpp"
 #include "../math.hpp"
 #include "../str/stringLiteralCharToValue.hpp"
 #include "../io/DelimitedTextWriter.hpp"
 
-#if (DFG_BUILD_OPT_USE_BOOST == 1)
-    DFG_BEGIN_INCLUDE_WITH_DISABLED_WARNINGS
-        #include <boost/accumulators/framework/accumulator_set.hpp>
-        #include <boost/accumulators/statistics/variance.hpp>
-        #include <boost/accumulators/statistics/stats.hpp>
-    DFG_END_INCLUDE_WITH_DISABLED_WARNINGS
-#endif // DFG_BUILD_OPT_USE_BOOST
-
 #define DFG_CSVTABLEVIEW_PROPERTY_PREFIX "CsvTableView_"
 
 DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
@@ -198,11 +195,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
         "median",
         "min",
         "max",
-        #if defined(BOOST_VERSION)
             "variance",
             "stddev_population",
             "stddev_sample",
-        #endif // BOOST_VERSION
         "is_sorted_num"
     };
 
@@ -216,11 +211,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
         QT_TR_NOOP("Median"),
         QT_TR_NOOP("Min"),
         QT_TR_NOOP("Max"),
-        #if defined(BOOST_VERSION)
             QT_TR_NOOP("Variance"),
             QT_TR_NOOP("Standard deviation (population)"),
             QT_TR_NOOP("Standard deviation (sample)"),
-        #endif // BOOST_VERSION
         QT_TR_NOOP("Is sorted (numerically)")
     };
 
@@ -234,11 +227,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
         QT_TR_NOOP("Median"),
         QT_TR_NOOP("Min"),
         QT_TR_NOOP("Max"),
-        #if defined(BOOST_VERSION)
             QT_TR_NOOP("Variance"),
             QT_TR_NOOP("StdDev (pop)"),
             QT_TR_NOOP("StdDev (smp)"),
-        #endif // BOOST_VERSION
         QT_TR_NOOP("Is sorted (num)")
     };
 
@@ -256,11 +247,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
             median,
             minimum,
             maximum,
-#if defined(BOOST_VERSION)
             variance,
             stddev_population,
             stddev_sample,
-#endif // BOOST_VERSION
             isSortedNum,
             detailCount
         }; // enum Detail
@@ -277,11 +266,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
             FlagContainer flags;
             flags.set();
             flags[static_cast<int>(BuiltInDetail::median)] = false;
-#if defined(BOOST_VERSION)
             flags[static_cast<int>(BuiltInDetail::variance)] = false;
             flags[static_cast<int>(BuiltInDetail::stddev_population)] = false;
             flags[static_cast<int>(BuiltInDetail::stddev_sample)] = false;
-#endif // BOOST_VERSION
             flags[static_cast<int>(BuiltInDetail::isSortedNum)] = false;
             return flags;
         }
@@ -293,45 +280,126 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
             bool bOk;
             const double val = str.toDouble(&bOk);
             if (bOk)
+                handleValue(val);
+            else
+                ++m_nExcluded;
+        }
+
+        // Handles value of a cell that has numeric interpretation.
+        void handleValue(const double val)
+        {
+            m_avgMf(val);
+            m_minMaxMf(val);
+            if (isEnabled(BuiltInDetail::variance) || isEnabled(BuiltInDetail::stddev_population) || isEnabled(BuiltInDetail::stddev_sample))
+                m_varianceMf(val);
+            if (m_bPartial)
             {
-                m_avgMf(val);
-                m_minMaxMf(val);
-                if (isEnabled(BuiltInDetail::median))
-                    m_medianMf(val);
-#if defined(BOOST_VERSION)
-                if (isEnabled(BuiltInDetail::variance) || isEnabled(BuiltInDetail::stddev_population) || isEnabled(BuiltInDetail::stddev_sample))
-                    m_varianceMf(val);
-#endif // BOOST_VERSION
-                if (isEnabled(BuiltInDetail::isSortedNum) && m_nSortedUntil + 1 >= m_avgMf.callCount())
+                for (const auto& spCollector : m_partialCollectors)
                 {
-                    if (::DFG_MODULE_NS(math)::isNan(val) ||  // Ignoring NaNs
-                        m_avgMf.callCount() == 1 ||
-                        val == m_previousNumber ||
-                        m_sortDirection == 0 ||
-                        (m_sortDirection == 1 && val >= m_previousNumber) ||
-                        (m_sortDirection == -1 && val <= m_previousNumber))
-                    {
-                        ++m_nSortedUntil;
-                        if (m_sortDirection == 0)
-                        {
-                            if (val > m_previousNumber)
-                                m_sortDirection = 1;
-                            else if (val < m_previousNumber)
-                                m_sortDirection = -1;
-                        }
-                    }
+                    if (spCollector)
+                        spCollector->update(val);
                 }
-                m_previousNumber = val;
+                if (m_bNeedsValueSequence)
+                    m_values.push_back(val);
+            }
+            else
+                handleValueInSequence(val);
+        }
 
-                for (auto pCollector : m_activeNonBuiltInCollectors)
+        // Handles details that need every value in selection order, i.e. those that don't have a mergeable partial state.
+        // If pMergedCollectors is given, non-built-in collectors whose counterpart in it is non-null have already received the value through mergePartial() and are skipped.
+        void handleValueInSequence(const double val, const std::vector<std::shared_ptr<SelectionDetailCollector>>* pMergedCollectors = nullptr)
+        {
+            ++m_nSequenceLength;
+            if (isEnabled(BuiltInDetail::median))
+                m_medianMf(val);
+            if (isEnabled(BuiltInDetail::isSortedNum) && m_nSortedUntil + 1 >= m_nSequenceLength)
+            {
+                if (::DFG_MODULE_NS(math)::isNan(val) ||  // Ignoring NaNs
+                    m_nSequenceLength == 1 ||
+                    val == m_previousNumber ||
+                    m_sortDirection == 0 ||
+                    (m_sortDirection == 1 && val >= m_previousNumber) ||
+                    (m_sortDirection == -1 && val <= m_previousNumber))
                 {
-                    if (!pCollector)
-                        continue;
-                    pCollector->update(val);
+                    ++m_nSortedUntil;
+                    if (m_sortDirection == 0)
+                    {
+                        if (val > m_previousNumber)
+                            m_sortDirection = 1;
+                        else if (val < m_previousNumber)
+                            m_sortDirection = -1;
+                    }
                 }
             }
-            else
-                ++m_nExcluded;
+            m_previousNumber = val;
+
+            for (size_t i = 0; i < m_activeNonBuiltInCollectors.size(); ++i)
+            {
+                auto pCollector = m_activeNonBuiltInCollectors[i];
+                if (!pCollector || (pMergedCollectors && isValidIndex(*pMergedCollectors, i) && (*pMergedCollectors)[i]))
+                    continue;
+                pCollector->update(val);
+            }
+        }
+
+        // Returns collector for evaluating part of a selection, possibly concurrently with other parts, to be merged to this with mergePartial().
+        // Partial collector computes mergeable details (count, sum, min, max, variance and non-built-in collectors that support partial evaluation)
+        // and otherwise only stores values in selection order.
+        BasicSelectionDetailCollector createPartial() const
+        {
+            BasicSelectionDetailCollector partial;
+            partial.m_enableFlags = m_enableFlags;
+            partial.m_bPartial = true;
+            bool bHasNonMergeableCollectors = false;
+            for (auto pCollector : m_activeNonBuiltInCollectors)
+            {
+                auto spPartial = (pCollector) ? pCollector->createPartial() : nullptr;
+                bHasNonMergeableCollectors = bHasNonMergeableCollectors || (pCollector && !spPartial);
+                partial.m_partialCollectors.push_back(std::move(spPartial));
+            }
+            partial.m_bNeedsValueSequence = bHasNonMergeableCollectors || isEnabled(BuiltInDetail::median) || isEnabled(BuiltInDetail::isSortedNum);
+            return partial;
+        }
+
+        // Merges partial collector created with createPartial(). For correct results of order dependent details, partials must be merged in selection order.
+        void mergePartial(const BasicSelectionDetailCollector& partial)
+        {
+            DFG_ASSERT_CORRECTNESS(partial.m_bPartial && !m_bPartial);
+            m_avgMf.merge(partial.m_avgMf);
+            m_minMaxMf.merge(partial.m_minMaxMf);
+            m_varianceMf.merge(partial.m_varianceMf);
+            m_nExcluded += partial.m_nExcluded;
+            for (size_t i = 0; i < partial.m_partialCollectors.size() && i < m_activeNonBuiltInCollectors.size(); ++i)
+            {
+                if (partial.m_partialCollectors[i] && m_activeNonBuiltInCollectors[i])
+                    m_activeNonBuiltInCollectors[i]->mergePartial(*partial.m_partialCollectors[i]);
+            }
+            for (const auto val : partial.m_values)
+                handleValueInSequence(val, &partial.m_partialCollectors);
+        }
+
+        // Returns true if all enabled details can be computed from CsvItemModel::NumericSummary, i.e. without seeing individual values.
+        bool isComputableFromNumericSummary() const
+        {
+            if (!m_activeNonBuiltInCollectors.empty() || isEnabled(BuiltInDetail::median) || isEnabled(BuiltInDetail::isSortedNum))
+                return false;
+            if (isEnabled(BuiltInDetail::variance) || isEnabled(BuiltInDetail::stddev_population) || isEnabled(BuiltInDetail::stddev_sample))
+                return false;
+            return true;
+        }
+
+        // Handles cells summarized in 'summary'. Precondition: isComputableFromNumericSummary()
+        void handleNumericSummary(const CsvItemModel::NumericSummary& summary)
+        {
+            DFG_ASSERT_CORRECTNESS(isComputableFromNumericSummary());
+            m_avgMf.feedDataPoints(summary.m_sumMf, summary.m_nIncludedCount);
+            if (summary.m_nIncludedCount > 0)
+            {
+                m_minMaxMf(summary.m_min);
+                m_minMaxMf(summary.m_max);
+            }
+            m_nExcluded += summary.m_nExcludedCount;
         }
 
         template <size_t N>
@@ -373,11 +441,9 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
                 case BuiltInDetail::median           : return floatToQString(m_medianMf.median(), toStrParam);
                 case BuiltInDetail::minimum          : return floatToQString(m_minMaxMf.minValue(), toStrParam);
                 case BuiltInDetail::maximum          : return floatToQString(m_minMaxMf.maxValue(), toStrParam);
-#if defined(BOOST_VERSION)
-                case BuiltInDetail::variance         : return floatToQString(boost::accumulators::variance(m_varianceMf), toStrParam);
-                case BuiltInDetail::stddev_population: return floatToQString(std::sqrt(boost::accumulators::variance(m_varianceMf)), toStrParam);
-                case BuiltInDetail::stddev_sample    : return floatToQString(std::sqrt(double(m_avgMf.callCount()) / double(m_avgMf.callCount() - 1) * boost::accumulators::variance(m_varianceMf)), toStrParam);
-#endif
+                case BuiltInDetail::variance         : return floatToQString(m_varianceMf.variance(), toStrParam);
+                case BuiltInDetail::stddev_population: return floatToQString(std::sqrt(m_varianceMf.variance()), toStrParam);
+                case BuiltInDetail::stddev_sample    : return floatToQString(std::sqrt(m_varianceMf.sampleVariance()), toStrParam);
                 case BuiltInDetail::isSortedNum      : return privMakeIsSortedValueString(selection);
                 default: DFG_ASSERT_IMPLEMENTED(false); return QString();
             }
@@ -449,16 +515,19 @@ DFG_ROOT_NS_BEGIN { DFG_SUB_NS(qt) { namespace DFG_DETAIL_NS
         void loadDetailHandlers(CsvTableViewBasicSelectionAnalyzerPanel::CollectorContainerPtr spCollectors);
 
         ::DFG_MODULE_NS(func)::MemFuncMinMax<double> m_minMaxMf;
-        ::DFG_MODULE_NS(func)::MemFuncAvg<double> m_avgMf;
+        ::DFG_MODULE_NS(func)::MemFuncAvg<double, double, size_t, ::DFG_MODULE_NS(func)::MemFuncSumCompensated<double>> m_avgMf;
         ::DFG_MODULE_NS(func)::MemFuncMedian<double> m_medianMf;
-#if defined(BOOST_VERSION)
-        boost::accumulators::accumulator_set<double, boost::accumulators::stats<boost::accumulators::tag::variance(boost::accumulators::lazy)>> m_varianceMf;
-#endif
+        ::DFG_MODULE_NS(func)::MemFuncVariance<double> m_varianceMf;
         FlagContainer m_enableFlags;
         size_t m_nExcluded = 0;
+        size_t m_nSequenceLength = 0; // Number of values given to handleValueInSequence().
         double m_previousNumber = std::numeric_limits<double>::quiet_NaN();
         uint32 m_nSortedUntil = 0; // Stores the number of sorted cells from first.
         int m_sortDirection = 0; // 1 = ascending, -1 = descending, 0 = either.
+        bool m_bPartial = false; // True if this is a partial collector created with createPartial().
+        bool m_bNeedsValueSequence = false; // Used only in partial collector: if true, values are stored to m_values.
+        std::vector<double> m_values; // Used only in partial collector: values in selection order for details that are not mergeable.
+        std::vector<std::shared_ptr<SelectionDetailCollector>> m_partialCollectors; // Used only in partial collector: partial states of m_activeNonBuiltInCollectors of the parent, null for those that are not mergeable.
         CsvTableViewBasicSelectionAnalyzerPanel::CollectorContainerPtr m_spCollectors;
         std::vector<SelectionDetailCollector*> m_activeNonBuiltInCollectors;
     }; // BasicSelectionDetailCollector
@@ -550,7 +619,11 @@ namespace
         CsvTableViewPropertyId_editMode,
         CsvTableViewPropertyId_weekDayNames,
         CsvTableViewPropertyId_actionInputPreviewLimit,
-        CsvTableViewPropertyId_formulaEvaluatorResultDecimalPrecision
+        CsvTableViewPropertyId_formulaEvaluatorResultDecimalPrecision,
+        CsvTableViewPropertyId_sortThreadCountMaximum,
+        CsvTableViewPropertyId_filterThreadCountMaximum,
+        CsvTableViewPropertyId_progressiveOpenFileSizeMinimumMb,
+        CsvTableViewPropertyId_findThreadCountMaximum
     };
 
     DFG_QT_DEFINE_OBJECT_PROPERTY_CLASS(CsvTableView)
@@ -597,6 +670,10 @@ namespace
     DFG_QT_DEFINE_OBJECT_PROPERTY_QSTRING(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "weekDayNames", CsvTableView, CsvTableViewPropertyId_weekDayNames, QString, []() { return QString("mo,tu,we,th,fr,sa,su"); });
     DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "actionInputPreviewLimit", CsvTableView, CsvTableViewPropertyId_actionInputPreviewLimit, int, []() { return 50; });
     DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "formulaEvaluatorResultDecimalPrecision", CsvTableView, CsvTableViewPropertyId_formulaEvaluatorResultDecimalPrecision, int, []() { return -1; });
+    DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "sortThreadCountMaximum", CsvTableView, CsvTableViewPropertyId_sortThreadCountMaximum, int, []() { return 0; });
+    DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "filterThreadCountMaximum", CsvTableView, CsvTableViewPropertyId_filterThreadCountMaximum, int, []() { return 0; });
+    DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "progressiveOpenFileSizeMinimumMb", CsvTableView, CsvTableViewPropertyId_progressiveOpenFileSizeMinimumMb, int, []() { return -1; });
+    DFG_QT_DEFINE_OBJECT_PROPERTY(DFG_CSVTABLEVIEW_PROPERTY_PREFIX "findThreadCountMaximum", CsvTableView, CsvTableViewPropertyId_findThreadCountMaximum, int, []() { return 0; });
 
     // Default row height seems to be 30, which looks somewhat wasteful so make it smaller.
     // Also row height affects the number of rows that can be shown in the table as discussed in https://stackoverflow.com/questions/78958330/how-do-i-enable-hundreds-of-millions-of-rows-in-qts-qabstracttablemodel
@@ -642,6 +719,13 @@ namespace
         return (dlg.exec() == QDialog::Accepted) ? dlg.query() : QString();
     }
 
+    // Defined later in this file together with other concurrent table helpers.
+    template <class Func_T>
+    void forEachRowRangeConcurrently(int nRowCount, size_t nThreadCount, Func_T&& func, int nMinRangeSize = 1024);
+
+    bool findMatchingCells(const CsvItemModel& rModel, const StringMatchDefinition& matchDef, const int nCol, std::vector<CsvItemModel::IndexPairInteger>& rHits, const size_t nThreadCount,
+                           QWidget* pProgressParent, const std::vector<CsvItemModel::IndexPairInteger>* pCandidates = nullptr);
+
     struct CsvTableViewFlag
     {
         enum
@@ -801,11 +885,28 @@ public:
     QPalette m_readWriteModePalette;
     QVariantMap m_previousChangeRadixArgs;
     QString m_sInitialScrollPosition;
+    std::array<int, 4> m_displayStringPrefetchViewport = { -1, -1, -1, -1 }; // Visible view (first row, last row, first column, last column) of latest display string prefetch request.
     QObjectStorage<QCheckBox> m_spFilterCheckBoxCaseSensitive;
     QObjectStorage<QCheckBox> m_spFilterCheckBoxWholeStringMatch;
     QObjectStorage<QCheckBox> m_spFilterCheckBoxColumnMatchByAnd;
     QObjectStorage<QCheckBox> m_spFilterCheckBoxNegate;
     mutable Logger m_logger;
+
+    // Cells matching m_optFindHitsMatchDef in column m_nFindHitsColumn (-1 = any) as CsvItemModel::IndexPairInteger in row-major order.
+    // Valid only if m_bFindHitsValid is true; invalidated on any content or structure change in csvModel().
+    std::vector<CsvItemModel::IndexPairInteger> m_findHits;
+    std::optional<StringMatchDefinition> m_optFindHitsMatchDef;
+    int m_nFindHitsColumn = -1;
+    bool m_bFindHitsValid = false;
+    size_t m_nLatestFindHitPos = 0; // Position of m_latestFoundIndex in m_findHits if it's there.
+    std::vector<QMetaObject::Connection> m_findHitsInvalidationConnections;
+
+    void invalidateFindHits()
+    {
+        m_bFindHitsValid = false;
+        m_findHits.clear();
+        m_findHits.shrink_to_fit();
+    }
 };
 
 const char CsvTableView::s_szCsvSaveOption_saveAsShown[] = "CsvTableView_saveAsShown";
@@ -920,6 +1021,9 @@ void CsvTableView::addOpenSaveActions()
         if (pMenu)
         {
             DFG_TEMP_ADD_VIEW_ACTION(*pMenu, tr("Open file with options..."), noShortCut, ActionFlags::unknown, openFromFileWithOptions);
+            DFG_TEMP_ADD_VIEW_ACTION(*pMenu, tr("Open file read-only..."), noShortCut, ActionFlags::unknown, openFromFileReadOnlyLazy)
+                .setToolTip(tr("Opens file to a separate read-only window that reads rows only when they are shown.\n"
+                 "This allows viewing files that are too big to be opened as editable. File encoding must be UTF-8 or Latin-1 compatible."));
             DFG_TEMP_ADD_VIEW_ACTION(*pMenu, tr("Reload from file"),          noShortCut, ActionFlags::unknown, reloadFromFileFromScratch);
             DFG_TEMP_ADD_VIEW_ACTION(*pMenu, tr("Reload from file (reuse previous load settings)"), noShortCut, ActionFlags::unknown, reloadFromFileWithPreviousLoadOptions)
                 .setToolTip(tr("This reload style e.g. reuses previously used settings if file was opened with 'Open file with options'.\n"
@@ -1410,6 +1514,48 @@ void CsvTableView::mousePressEvent(QMouseEvent* event)
 void CsvTableView::paintEvent(QPaintEvent* event)
 {
     BaseClass::paintEvent(event);
+    privPrefetchDisplayStringsAroundViewport();
+}
+
+void CsvTableView::privPrefetchDisplayStringsAroundViewport()
+{
+    auto pViewModel = model();
+    auto pCsvModel = csvModel();
+    auto pViewport = viewport();
+    if (!pViewModel || !pCsvModel || !pViewport || pViewModel->rowCount() <= 0 || pViewModel->columnCount() <= 0)
+        return;
+    if (state() == QAbstractItemView::EditingState)
+        return; // Not prefetching while editor is open, see CsvTableViewDelegate::createEditor().
+    const auto nViewRowCount = pViewModel->rowCount();
+    const auto nViewColCount = pViewModel->columnCount();
+    const auto nFirstRow = (std::max)(0, rowAt(0));
+    const auto nLastRow = (rowAt(pViewport->height() - 1) >= 0) ? rowAt(pViewport->height() - 1) : nViewRowCount - 1;
+    const auto nFirstCol = (std::max)(0, columnAt(0));
+    const auto nLastCol = (columnAt(pViewport->width() - 1) >= 0) ? columnAt(pViewport->width() - 1) : nViewColCount - 1;
+    const std::array<int, 4> viewport = { nFirstRow, nLastRow, nFirstCol, nLastCol };
+    auto& rPrevious = DFG_OPAQUE_REF().m_displayStringPrefetchViewport;
+    if (viewport == rPrevious)
+        return; // Already requested, e.g. repaint due to hover.
+    rPrevious = viewport;
+
+    // Requesting visible area with one page of margin on every side so that the next scroll step finds its strings already converted.
+    const auto nRowMargin = nLastRow - nFirstRow + 1;
+    const auto nColMargin = nLastCol - nFirstCol + 1;
+    std::vector<int> rows;
+    std::vector<int> columns;
+    for (int r = (std::max)(0, nFirstRow - nRowMargin), nEnd = (std::min)(nViewRowCount - 1, nLastRow + nRowMargin); r <= nEnd; ++r)
+    {
+        const auto dataIndex = mapToDataModel(pViewModel->index(r, nFirstCol));
+        if (dataIndex.isValid())
+            rows.push_back(dataIndex.row());
+    }
+    for (int c = (std::max)(0, nFirstCol - nColMargin), nEnd = (std::min)(nViewColCount - 1, nLastCol + nColMargin); c <= nEnd; ++c)
+    {
+        const auto dataIndex = mapToDataModel(pViewModel->index(nFirstRow, c));
+        if (dataIndex.isValid())
+            columns.push_back(dataIndex.column());
+    }
+    pCsvModel->prefetchDisplayStrings(std::move(rows), std::move(columns));
 }
 
 void CsvTableView::setModel(QAbstractItemModel* pModel)
@@ -1434,6 +1580,28 @@ void CsvTableView::setModel(QAbstractItemModel* pModel)
         // From Qt documentation: "Note: Qt::UniqueConnections do not work for lambdas, non-member functions and functors; they only apply to connecting to member functions"
         DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvModel::sigOnNewSourceOpened, this, &ThisClass::onNewSourceOpened, Qt::UniqueConnection));
     }
+    // Cached find hits are invalidated on any content or structure change.
+    {
+        auto& rOpaq = DFG_OPAQUE_REF();
+        for (const auto& connection : rOpaq.m_findHitsInvalidationConnections)
+            QObject::disconnect(connection);
+        rOpaq.m_findHitsInvalidationConnections.clear();
+        rOpaq.invalidateFindHits();
+        if (pCsvModel)
+        {
+            const auto invalidate = [this]() { DFG_OPAQUE_REF().invalidateFindHits(); };
+            auto& conns = rOpaq.m_findHitsInvalidationConnections;
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::dataChanged, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::rowsInserted, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::rowsRemoved, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::rowsMoved, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::columnsInserted, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::columnsRemoved, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::columnsMoved, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::layoutChanged, this, invalidate));
+            conns.push_back(connect(pCsvModel, &QAbstractItemModel::modelReset, this, invalidate));
+        }
+    }
     if (pModel)
     {
         DFG_QT_VERIFY_CONNECT(connect(pModel, &QAbstractItemModel::dataChanged, this, &ThisClass::onViewModelDataChanged, Qt::UniqueConnection));
@@ -2680,8 +2848,18 @@ bool CsvTableView::openFile(const QString& sPath, const DFG_ROOT_NS::CsvFormatDe
 
     clearUndoStack(); // Clearing undo stack before modal operation since doing it during read caused "ASSERT failure in QCoreApplication::sendEvent: "Cannot send events to objects owned by a different thread."
 
+    // Big csv-files can be opened progressively: initial rows are read here and rest in background after which view is usable immediately.
+    const auto nProgressiveOpenSizeMinimumMb = getCsvTableViewProperty<CsvTableViewPropertyId_progressiveOpenFileSizeMinimumMb>(this);
+    const bool bOpenProgressively = !bOpenAsSqlite
+                                    && nProgressiveOpenSizeMinimumMb >= 0
+                                    && fileSizeDouble >= 1e6 * nProgressiveOpenSizeMinimumMb
+                                    && !CsvItemModel::LoadOptions(formatDef).isFilteredRead();
+
     bool bSuccess = false;
-    doModalOperation(tr("Reading file of size %1\n%2%3").arg(formattedDataSize(QFileInfo(sPath).size()), sPath, sAdditionalInfo), ProgressWidget::IsCancellable::yes, "CsvTableViewFileLoader", [&](ProgressWidget* pProgressWidget)
+    if (bOpenProgressively)
+        bSuccess = pModel->openFileProgressive(sPath, CsvItemModel::LoadOptions(formatDef));
+    else
+        doModalOperation(tr("Reading file of size %1\n%2%3").arg(formattedDataSize(QFileInfo(sPath).size()), sPath, sAdditionalInfo), ProgressWidget::IsCancellable::yes, "CsvTableViewFileLoader", [&](ProgressWidget* pProgressWidget)
         {
             CsvItemModel::LoadOptions loadOptions(formatDef);
             bool bHasProgress = false;
@@ -2807,6 +2985,25 @@ bool CsvTableView::openFile(const QString& sPath, const DFG_ROOT_NS::CsvFormatDe
         if (!sInfoPart.isEmpty())
             QMessageBox::information(this, tr("Open messages"), tr("Opening file\n%1\ngenerated the following messages:\n%2").arg(sPath, sInfoPart));
         onNewSourceOpened();
+        if (pModel->isProgressiveLoadActive())
+        {
+            // Keeping view in read-only mode until the whole file has been read.
+            const bool bWasReadOnly = isReadOnlyMode();
+            setReadOnlyMode(true);
+            auto spConnection = std::make_shared<QMetaObject::Connection>();
+            *spConnection = connect(pModel, &CsvItemModel::sigProgressiveLoadFinished, this, [=](const bool bCompleted)
+            {
+                disconnect(*spConnection);
+                setReadOnlyMode(bWasReadOnly);
+                if (bCompleted)
+                    showStatusInfoTip(tr("Finished reading file, row count: %1").arg(pModel->rowCount()));
+                else
+                {
+                    const QString sInfoPart = (!pModel->m_messagesFromLatestOpen.isEmpty()) ? tr("\n%1").arg(pModel->m_messagesFromLatestOpen.join('\n')) : QString();
+                    showStatusInfoTip(tr("Reading file was not completed, row count: %1%2").arg(pModel->rowCount()).arg(sInfoPart));
+                }
+            });
+        }
     }
     else
     {
@@ -2895,6 +3092,34 @@ bool CsvTableView::openFromFileWithOptions()
     return openFile(sPath, loadOptions);
 }
 
+bool CsvTableView::openFromFileReadOnlyLazy()
+{
+    const auto sPath = getFilePathFromFileDialog();
+    if (sPath.isEmpty())
+        return false;
+    std::unique_ptr<CsvLazyReadOnlyItemModel> spModel(new CsvLazyReadOnlyItemModel);
+    if (!spModel->openFile(sPath, CsvItemModel::getLoadOptionsForFile(sPath, csvModel())))
+    {
+        QMessageBox::information(this, tr("Open failed"), tr("Failed to open file\n%1\nfor read-only viewing. Note that file encoding must be UTF-8 or Latin-1 compatible.").arg(sPath));
+        return false;
+    }
+
+    auto pContainerWidget = new QDialog(this);
+    pContainerWidget->setAttribute(Qt::WA_DeleteOnClose, true);
+    pContainerWidget->setWindowTitle(tr("%1 (read-only)").arg(sPath));
+    removeContextHelpButtonFromDialog(pContainerWidget);
+    delete pContainerWidget->layout();
+    auto pLayout = new QHBoxLayout(pContainerWidget);
+    auto pView = new QTableView(pContainerWidget);
+    spModel->setParent(pView);
+    pView->setModel(spModel.release()); // Deleted through childhood of view.
+    pLayout->addWidget(pView);
+
+    pContainerWidget->resize(this->size());
+    pContainerWidget->show();
+    return true;
+}
+
 bool CsvTableView::reloadFromFileFromScratch()
 {
     return reloadFromFileImpl(false);
@@ -3109,8 +3334,10 @@ size_t CsvTableView::replace(const QVariantMap& params)
     auto pCsvModel = csvModel();
     if (!pCsvModel)
         return 0;
-    const auto sFindText = qStringToStringUtf8(params["find"].toString());
-    const auto sReplaceText = qStringToStringUtf8(params["replace"].toString());
+    const auto sFindText = params["find"].toString();
+    if (sFindText.isEmpty())
+        return 0;
+    const bool bWholeTable = (params.value("scope").toString() == QLatin1String("all"));
 
     auto lockReleaser = tryLockForEdit();
     if (!lockReleaser.isLocked())
@@ -3118,42 +3345,30 @@ size_t CsvTableView::replace(const QVariantMap& params)
         privShowExecutionBlockedNotification("Replace");
         return 0;
     }
-    size_t nEditCount = 0;
-    const auto selection = storeSelection();
-
-    doModalOperation(tr("Executing Find & Replace..."), ProgressWidget::IsCancellable::yes, "find_replace", [&](ProgressWidget* pProgressDialog)
-    {
-        const auto bOldModifiedStatus = pCsvModel->isModified();
-        pCsvModel->batchEditNoUndo([&](CsvItemModel::DataTable& table)
-        {
-            StringUtf8 sTemp;
-            forEachCsvModelIndexInSelection([&](const QModelIndex& index, bool& rbContinue)
-            {
-                if (!pCsvModel->isCellEditable(index))
-                    return;
-                auto tpsz = table(index.row(), index.column());
-                if (!tpsz || std::strstr(tpsz.c_str(), sFindText.c_str().c_str()) == nullptr)
-                    return;
-                if (pProgressDialog && pProgressDialog->isCancelled())
-                {
-                    rbContinue = false;
-                    return;
-                }
-                sTemp = tpsz;
-                ::DFG_MODULE_NS(str)::replaceSubStrsInplace(sTemp.rawStorage(), sFindText.rawStorage(), sReplaceText.rawStorage());
-                ++nEditCount;
-                table.setElement(index.row(), index.column(), sTemp);
-            });
-        });
-        pCsvModel->setModifiedStatus(bOldModifiedStatus || nEditCount > 0);
-    }); // Modal operation end
-
-    restoreSelection(selection);
 
+    // Finding cells to edit concurrently with the same engine as used in find, after which replace is done with a single batch edit and undo entry.
+    std::vector<CsvModel::IndexPairInteger> cells;
+    const auto nThreadCount = static_cast<size_t>((std::max)(0, getCsvTableViewProperty<CsvTableViewPropertyId_findThreadCountMaximum>(this)));
+    if (!findMatchingCells(*pCsvModel, StringMatchDefinition(sFindText, Qt::CaseSensitive, PatternMatcher::FixedString), -1, cells, nThreadCount, this))
+        return 0;
+    // Checking selection per found cell instead of going through selection since selection may have huge number of cells (e.g. select all).
+    const auto pSelectionModel = (bWholeTable) ? nullptr : selectionModel();
+    if (!bWholeTable && !pSelectionModel)
+        cells.clear();
+    cells.erase(std::remove_if(cells.begin(), cells.end(), [&](const CsvModel::IndexPairInteger nKey)
+        {
+            const auto nRow = static_cast<int>(nKey >> 32);
+            const auto nCol = static_cast<int>(nKey & 0xFFFFFFFF);
+            return !pCsvModel->isCellEditable(nRow, nCol) || (pSelectionModel && !pSelectionModel->isSelected(mapToViewModel(pCsvModel->index(nRow, nCol))));
+        }), cells.end());
+
+    const size_t nEditCount = cells.size();
     QString sToolTipMsg;
     if (nEditCount > 0)
     {
-        clearUndoStack(); // If something was edited outside undostack, undoing previous actions might not work correctly anymore so clearing the undostack.
+        const auto selection = storeSelection();
+        executeAction<CsvTableViewActionReplace>(this, params, cells);
+        restoreSelection(selection);
         sToolTipMsg = tr("Replace edited %1 cell(s)").arg(nEditCount);
     }
     else
@@ -4458,33 +4673,95 @@ void CsvTableView::onFind(const bool forward)
         return;
     }
 
-    const auto findSeed = [&]() -> QModelIndex
-        {
-            if (m_latestFoundIndex.isValid())
-                return m_latestFoundIndex;
-            else if (getFindColumnIndex() >= 0)
+    // Matching cells are searched once (concurrently) to a sorted hit list, after which next/previous is a matter of stepping in the list.
+    if (!privUpdateFindHits())
+        return;
+    auto& rOpaq = DFG_OPAQUE_REF();
+    const auto& hits = rOpaq.m_findHits;
+    if (hits.empty())
+    {
+        forgetLatestFindPosition();
+        return;
+    }
+    const auto nHitCount = hits.size();
+    auto& nPos = rOpaq.m_nLatestFindHitPos;
+
+    if (m_latestFoundIndex.isValid() && nPos < nHitCount && hits[nPos] == CsvModel::cellRowColumnPairToIndexPairInteger(m_latestFoundIndex.row(), m_latestFoundIndex.column()))
+        nPos = (forward) ? (nPos + 1) % nHitCount : (nPos + nHitCount - 1) % nHitCount;
+    else
+    {
+        const auto findSeed = [&]() -> QModelIndex
             {
-                const auto current = currentIndex();
-                if (current.isValid())
-                    return pBaseModel->index(current.row(), getFindColumnIndex());
+                if (m_latestFoundIndex.isValid())
+                    return m_latestFoundIndex;
+                else if (getFindColumnIndex() >= 0)
+                {
+                    const auto current = currentIndex();
+                    if (current.isValid())
+                        return pBaseModel->index(mapToDataModel(current).row(), getFindColumnIndex());
+                    else
+                        return QModelIndex(); // Might need to improve this e.g. to use cell from top left corner of visible rect.
+                }
                 else
-                    return pBaseModel->index(0, getFindColumnIndex()); // Might need to improve this e.g. to return cell from top left corner of visible rect.
+                    return mapToDataModel(currentIndex());
+            }();
+
+        if (findSeed.isValid())
+        {
+            // Seed itself is not a candidate, i.e. taking first hit after (or before) it with wrap-around.
+            const auto nSeedKey = CsvModel::cellRowColumnPairToIndexPairInteger(findSeed.row(), findSeed.column());
+            if (forward)
+            {
+                const auto iter = std::upper_bound(hits.begin(), hits.end(), nSeedKey);
+                nPos = (iter != hits.end()) ? static_cast<size_t>(iter - hits.begin()) : 0;
             }
             else
-                return currentIndex();
-        }();
+            {
+                const auto iter = std::lower_bound(hits.begin(), hits.end(), nSeedKey);
+                nPos = (iter != hits.begin()) ? static_cast<size_t>(iter - hits.begin()) - 1 : nHitCount - 1;
+            }
+        }
+        else
+            nPos = (forward) ? 0 : nHitCount - 1;
+    }
 
     // TODO: this doesn't work correctly with proxy filtering: finds cells also from filter-hidden cells.
-    const auto found = pBaseModel->findNextHighlighterMatch(findSeed, (forward) ? CsvModel::FindDirectionForward : CsvModel::FindDirectionBackward);
+    const auto nFoundKey = hits[nPos];
+    m_latestFoundIndex = pBaseModel->index(static_cast<int>(nFoundKey >> 32), static_cast<int>(nFoundKey & 0xFFFFFFFF));
+    scrollTo(mapToViewModel(m_latestFoundIndex));
+    setCurrentIndex(mapToViewModel(m_latestFoundIndex));
+}
 
-    if (found.isValid())
-    {
-        m_latestFoundIndex = found;
-        scrollTo(mapToViewModel(m_latestFoundIndex));
-        setCurrentIndex(mapToViewModel(m_latestFoundIndex));
-    }
-    else
-        forgetLatestFindPosition();
+bool CsvTableView::privUpdateFindHits()
+{
+    auto pCsvModel = csvModel();
+    if (!pCsvModel || !m_matchDef.hasMatchString() || getFindColumnIndex() >= pCsvModel->getColumnCount())
+        return false;
+    auto& rOpaq = DFG_OPAQUE_REF();
+    const auto nCol = getFindColumnIndex();
+    const bool bHaveHitsForColumn = rOpaq.m_bFindHitsValid && rOpaq.m_optFindHitsMatchDef.has_value() && rOpaq.m_nFindHitsColumn == nCol;
+    const bool bNarrowing = bHaveHitsForColumn && m_matchDef.isKnownToBeNarrowingOf(*rOpaq.m_optFindHitsMatchDef);
+    if (bNarrowing && rOpaq.m_optFindHitsMatchDef->isKnownToBeNarrowingOf(m_matchDef))
+        return true; // Existing hits are for identical find definition.
+
+    // If new definition is narrower than the previous one (e.g. when typing more characters to find panel), only previous hits need to be checked.
+    std::vector<CsvModel::IndexPairInteger> newHits;
+    const auto nThreadCount = static_cast<size_t>((std::max)(0, getCsvTableViewProperty<CsvTableViewPropertyId_findThreadCountMaximum>(this)));
+    if (!findMatchingCells(*pCsvModel, m_matchDef, nCol, newHits, nThreadCount, this, (bNarrowing) ? &rOpaq.m_findHits : nullptr))
+        return false;
+    rOpaq.m_findHits = std::move(newHits);
+    rOpaq.m_optFindHitsMatchDef = m_matchDef;
+    rOpaq.m_nFindHitsColumn = nCol;
+    rOpaq.m_bFindHitsValid = true;
+    rOpaq.m_nLatestFindHitPos = 0;
+    return true;
+}
+
+auto CsvTableView::countFindMatches() -> std::optional<size_t>
+{
+    if (!privUpdateFindHits())
+        return std::nullopt;
+    return DFG_OPAQUE_REF().m_findHits.size();
 }
 
 void CsvTableView::onFindNext()
@@ -4509,9 +4786,13 @@ public:
         auto spLayout = std::unique_ptr<QFormLayout>(new QFormLayout);
         m_spFindEdit.reset(new QLineEdit(this));
         m_spReplaceEdit.reset(new QLineEdit(this));
-        spLayout->addRow(tr("Note:"), new QLabel(tr("Applies to selection only, is case sensitive and no undo available"), this));
+        m_spWholeTableCheckBox.reset(new QCheckBox(tr("Whole table"), this));
+        m_spWholeTableCheckBox->setToolTip(tr("If checked, replace applies to the whole table instead of selection"));
+        m_spWholeTableCheckBox->setChecked(!pParent || !pParent->isSelectionNonEmpty());
+        spLayout->addRow(tr("Note:"), new QLabel(tr("Find is case sensitive"), this));
         spLayout->addRow(tr("Find"), m_spFindEdit.get());
         spLayout->addRow(tr("Replace"), m_spReplaceEdit.get());
+        spLayout->addRow(tr("Scope"), m_spWholeTableCheckBox.get());
 
         auto& rButtonBox = *(new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel));
         DFG_QT_VERIFY_CONNECT(connect(&rButtonBox, &QDialogButtonBox::accepted, this, &QDialog::accept));
@@ -4531,6 +4812,8 @@ public:
         QVariantMap params;
         params["find"] = m_spFindEdit->text();
         params["replace"] = m_spReplaceEdit->text();
+        if (m_spWholeTableCheckBox->isChecked())
+            params["scope"] = "all";
         m_spTableView->replace(params);
 
         BaseClass::accept();
@@ -4538,6 +4821,7 @@ public:
 
     QObjectStorage<QLineEdit> m_spFindEdit;
     QObjectStorage<QLineEdit> m_spReplaceEdit;
+    QObjectStorage<QCheckBox> m_spWholeTableCheckBox;
     QPointer<CsvTableView> m_spTableView;
 };
 
@@ -4554,11 +4838,6 @@ bool CsvTableView::isSelectionNonEmpty() const
 
 void CsvTableView::onReplace()
 {
-    if (!isSelectionNonEmpty())
-    {
-        QToolTip::showText(QCursor::pos(), tr("Replace requires selection"));
-        return;
-    }
     ReplaceDialog dlg(this);
     dlg.exec();
 }
@@ -4843,6 +5122,7 @@ DFG_OPAQUE_PTR_DEFINE(CsvTableViewBasicSelectionAnalyzerPanel)
     }
 
     std::atomic_int m_nDefaultNumericPrecision { -1 };
+    std::atomic_int m_nThreadCountMaximum { 0 };
 }; // CsvTableViewBasicSelectionAnalyzerPanel opaque class 
 
 CsvTableViewBasicSelectionAnalyzerPanel::CsvTableViewBasicSelectionAnalyzerPanel(QWidget *pParent) :
@@ -4885,6 +5165,10 @@ CsvTableViewBasicSelectionAnalyzerPanel::CsvTableViewBasicSelectionAnalyzerPanel
                 auto pAct = pMenu->addAction(tr("Set default numeric precision..."));
                 DFG_QT_VERIFY_CONNECT(connect(pAct, &QAction::triggered, this, &CsvTableViewBasicSelectionAnalyzerPanel::onQueryDefaultNumericPrecision));
             }
+            {
+                auto pAct = pMenu->addAction(tr("Set thread count..."));
+                DFG_QT_VERIFY_CONNECT(connect(pAct, &QAction::triggered, this, &CsvTableViewBasicSelectionAnalyzerPanel::onQueryThreadCountMaximum));
+            }
         }
 
         addSectionEntryToMenu(pMenu, "Built-in");
@@ -5037,6 +5321,11 @@ void CsvTableViewBasicSelectionAnalyzerPanel::onAddCustomCollector()
         "Percentile (using MemFuncPercentile_enclosingElem):"
         "<ul>"
             "<li><b>%7:</b> percentage (range [0, 100]).</li>"
+        "</ul>"
+        "Approximate percentile (using MemFuncPercentile_approx, uses constant amount of memory, exact for small selections):"
+        "<ul>"
+            "<li><b>%7:</b> percentage (range [0, 100]).</li>"
+            "<li><b>%8:</b> accuracy, bigger is more accurate. Typical values are from 50 to 500 and relative rank error is usually well below 1 / %8. Can be omitted, default is %9</li>"
         "</ul>")
         .arg(SelectionDetailCollector_formula::s_propertyName_formula,
              SelectionDetailCollector_formula::s_propertyName_initialValue,
@@ -5044,7 +5333,9 @@ void CsvTableViewBasicSelectionAnalyzerPanel::onAddCustomCollector()
              SelectionDetailCollector::s_propertyName_uiNameLong,
              SelectionDetailCollector::s_propertyName_description,
              SelectionDetailCollector::s_propertyName_resultPrecision,
-             SelectionDetailCollector_percentile::s_propertyName_percentage);
+             SelectionDetailCollector_percentile::s_propertyName_percentage,
+             SelectionDetailCollector_percentile_approx::s_propertyName_compression)
+        .arg(SelectionDetailCollector_percentile_approx::s_defaultCompression);
 
     const QString sExampleSquareSum = tr(R"({ "%4": "SquareSum", "%1": "acc + value^2", "%2": "0", "%3": "Calculates sum of squares" })")
         .arg(SelectionDetailCollector_formula::s_propertyName_formula,
@@ -5054,7 +5345,10 @@ void CsvTableViewBasicSelectionAnalyzerPanel::onAddCustomCollector()
     const QString sExamplePercentile = tr(R"({ "%1": "10", "%2": "10th percentile" })")
         .arg(SelectionDetailCollector_percentile::s_propertyName_percentage, SelectionDetailCollector::s_propertyName_description);
 
-    const QString sExamples = tr("# Examples:\n#    %1\n#    %2\n\n").arg(sExampleSquareSum, sExamplePercentile);
+    const QString sExamplePercentileApprox = tr(R"({ "%1": "99", "%2": "200" })")
+        .arg(SelectionDetailCollector_percentile::s_propertyName_percentage, SelectionDetailCollector_percentile_approx::s_propertyName_compression);
+
+    const QString sExamples = tr("# Examples:\n#    %1\n#    %2\n#    %3\n\n").arg(sExampleSquareSum, sExamplePercentile, sExamplePercentileApprox);
         
     QString sJson = tr("%7# Below is a template for formula accumulator\n{\n  \"%1\": \"\",\n  \"%2\": \"\",\n  \"%3\": \"\",\n  \"%4\": \"\",\n  \"%5\": \"\",\n  \"%6\": \"\"\n}")
                     .arg(SelectionDetailCollector_formula::s_propertyName_formula,
@@ -5103,10 +5397,11 @@ void CsvTableViewBasicSelectionAnalyzerPanel::onAddCustomCollector()
             inputs[SelectionDetailCollector::s_propertyName_type] = QString("accumulator");
         else if (inputs.contains(SelectionDetailCollector_percentile::s_propertyName_percentage))
         {
-            inputs[SelectionDetailCollector::s_propertyName_type] = QString("percentile");
-            // If there's no short name, using default name "percentile_<percentage>.
+            const bool bApprox = inputs.contains(SelectionDetailCollector_percentile_approx::s_propertyName_compression);
+            inputs[SelectionDetailCollector::s_propertyName_type] = (bApprox) ? QString("percentile_approx") : QString("percentile");
+            // If there's no short name, using default name "percentile_<percentage>" or "percentile_approx_<percentage>".
             if (!inputs.contains(SelectionDetailCollector::s_propertyName_uiNameShort))
-                inputs[SelectionDetailCollector::s_propertyName_uiNameShort] = QString("percentile_%1").arg(inputs[SelectionDetailCollector_percentile::s_propertyName_percentage].toString());
+                inputs[SelectionDetailCollector::s_propertyName_uiNameShort] = QString("%1_%2").arg(inputs[SelectionDetailCollector::s_propertyName_type].toString(), inputs[SelectionDetailCollector_percentile::s_propertyName_percentage].toString());
         }
     }
 
@@ -5144,6 +5439,16 @@ void CsvTableViewBasicSelectionAnalyzerPanel::onQueryDefaultNumericPrecision()
     setDefaultNumericPrecision(nNew);
 }
 
+void CsvTableViewBasicSelectionAnalyzerPanel::onQueryThreadCountMaximum()
+{
+    const auto nOld = threadCountMaximum();
+    bool bOk = false;
+    const auto nNew = QInputDialog::getInt(this, tr("Thread count"), tr("Maximum number of threads used when evaluating large selections\n(0 = number of hardware threads)"), nOld, 0, 1024, 1, &bOk);
+    if (!bOk)
+        return;
+    setThreadCountMaximum(nNew);
+}
+
 double CsvTableViewBasicSelectionAnalyzerPanel::getMaxTimeInSeconds() const
 {
     bool bOk = false;
@@ -5167,7 +5472,7 @@ bool CsvTableViewBasicSelectionAnalyzerPanel::addDetail(const QVariantMap& items
 {
     // Expected fields
     //      id             : identifier of the detail, must be unique.
-    //      [type]         : Type of collector, either empty for built-in ones, "accumulator" or "percentile".
+    //      [type]         : Type of collector, either empty for built-in ones, "accumulator", "percentile" or "percentile_approx".
     //      [initial_value]: Initial value for collector if it needs one
     //                          -Needed by: accumulator
     //      [formula]      : Formula used to compute values if collector needs one
@@ -5218,7 +5523,7 @@ bool CsvTableViewBasicSelectionAnalyzerPanel::addDetail(const QVariantMap& items
 
         pExisting->updateCheckBoxToolTip();
     }
-    else if (sType == QLatin1String("accumulator") || sType == QLatin1String("percentile"))
+    else if (sType == QLatin1String("accumulator") || sType == QLatin1String("percentile") || sType == QLatin1String("percentile_approx"))
     {
         auto pExisting = collectors.find(id);
         if (pExisting)
@@ -5263,6 +5568,22 @@ bool CsvTableViewBasicSelectionAnalyzerPanel::addDetail(const QVariantMap& items
                 spNewCollector->setProperty(SelectionDetailCollector_percentile::s_propertyName_percentage, sPercentage);
             }
         }
+        else if (sType == QLatin1String("percentile_approx"))
+        {
+            bool bOkToDouble;
+            const auto sPercentage = items.value(SelectionDetailCollector_percentile::s_propertyName_percentage).toString();
+            const auto percentage = sPercentage.toDouble(&bOkToDouble);
+            const auto sCompression = items.value(SelectionDetailCollector_percentile_approx::s_propertyName_compression).toString();
+            bool bOkCompression = true;
+            const auto compression = (sCompression.isEmpty()) ? SelectionDetailCollector_percentile_approx::s_defaultCompression : sCompression.toDouble(&bOkCompression);
+            if (bOkToDouble && bOkCompression)
+            {
+                spNewCollector = std::make_shared<SelectionDetailCollector_percentile_approx>(id, percentage, compression);
+                spNewCollector->setProperty(SelectionDetailCollector_percentile::s_propertyName_percentage, sPercentage);
+                if (!sCompression.isEmpty())
+                    spNewCollector->setProperty(SelectionDetailCollector_percentile_approx::s_propertyName_compression, sCompression);
+            }
+        }
 
         if (!spNewCollector)
             return false;
@@ -5351,6 +5672,17 @@ int CsvTableViewBasicSelectionAnalyzerPanel::defaultNumericPrecision() const
     return (pOpaq) ? pOpaq->m_nDefaultNumericPrecision.load() : -1;
 }
 
+void CsvTableViewBasicSelectionAnalyzerPanel::setThreadCountMaximum(const int nThreadCount)
+{
+    DFG_OPAQUE_REF().m_nThreadCountMaximum = limited(nThreadCount, 0, 1024);
+}
+
+int CsvTableViewBasicSelectionAnalyzerPanel::threadCountMaximum() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (pOpaq) ? pOpaq->m_nThreadCountMaximum.load() : 0;
+}
+
 auto CsvTableViewBasicSelectionAnalyzerPanel::collectors() const -> CollectorContainerPtr
 {
     auto pOpaq = DFG_OPAQUE_PTR();
@@ -6540,23 +6872,126 @@ void CsvTableViewBasicSelectionAnalyzer::analyzeImpl(const QItemSelection select
 
         const auto nNumericPrecision = uiPanel->defaultNumericPrecision();
 
+        // Returns true if evaluation should be terminated, in which case also sets completionStatus.
+        const auto isTerminated = [&]()
+        {
+            const auto bHasMaxTimePassed = operationTimer.elapsedWallSeconds() >= maxTime;
+            if (!bHasMaxTimePassed && !uiPanel->isStopRequested() && !m_abNewSelectionPending && m_abIsEnabled.load(std::memory_order_relaxed))
+                return false;
+            if (bHasMaxTimePassed)
+                completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByTimeLimit;
+            else if (m_abNewSelectionPending)
+                completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByNewSelection;
+            else if (!m_abIsEnabled)
+                completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByDisabling;
+            else
+                completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByUserRequest;
+            return true;
+        };
+
+        // When all enabled details can be computed from numeric summaries and selection ranges are ranges also in data model,
+        // combining column block summaries from model instead of visiting every cell; e.g. with whole column selections this avoids
+        // re-parsing the whole column on every selection change.
+        const bool bUseNumericSummaries = collector.isComputableFromNumericSummary() && !pCtvView->isItemIndexMappingNeeded();
+
+        // Otherwise large selections are split to chunks that are evaluated concurrently to partial collectors, which are then merged in selection order.
+        int64 nSelectionCellCount = 0;
+        for (const auto& sr : selection)
+            nSelectionCellCount += static_cast<int64>(sr.width()) * sr.height();
+        const auto nThreadCountMaximum = uiPanel->threadCountMaximum();
+        const bool bEvaluateConcurrently = !bUseNumericSummaries && nThreadCountMaximum != 1 && nSelectionCellCount >= 100000;
+        if (bEvaluateConcurrently)
+        {
+            struct Chunk
+            {
+                int m_nRange;
+                int m_nDataCol;
+                int m_nFirstRow; // First view row in range.
+                int m_nEndRow;   // One past last view row in range.
+            };
+            const int nChunkRowCount = 16384;
+            const bool bMappingNeeded = pCtvView->isItemIndexMappingNeeded();
+            std::vector<Chunk> chunks;
+            std::vector<std::vector<int>> viewToDataRows(static_cast<size_t>(selection.size())); // Used only if mapping is needed, indexed by view row - range top.
+            for (int nRange = 0; nRange < selection.size() && !isTerminated(); ++nRange)
+            {
+                const auto& sr = selection[nRange];
+                if (bMappingNeeded)
+                {
+                    auto& dataRows = viewToDataRows[static_cast<size_t>(nRange)];
+                    dataRows.resize(static_cast<size_t>(sr.height()));
+                    for (int r = sr.top(); r <= sr.bottom(); ++r)
+                        dataRows[static_cast<size_t>(r - sr.top())] = pCtvView->mapRowColToDataModel(r, sr.left()).first;
+                }
+                for (int c = sr.left(); c <= sr.right(); ++c)
+                {
+                    const auto nDataCol = pCtvView->mapRowColToDataModel(sr.top(), c).second;
+                    for (int r = sr.top(); r <= sr.bottom(); r += nChunkRowCount)
+                        chunks.push_back({ nRange, nDataCol, r, (std::min)(r + nChunkRowCount, sr.bottom() + 1) });
+                }
+            }
+
+            std::vector<::DFG_MODULE_NS(qt)::DFG_DETAIL_NS::BasicSelectionDetailCollector> partials;
+            partials.reserve(chunks.size());
+            for (size_t i = 0; i < chunks.size(); ++i)
+                partials.push_back(collector.createPartial());
+
+            std::mutex mutexTermination; // isTerminated() updates completionStatus so calls from worker threads are serialized.
+            const auto isTerminatedConcurrent = [&]()
+            {
+                std::lock_guard<std::mutex> lock(mutexTermination);
+                return completionStatus != CompletionStatus_started || isTerminated();
+            };
+            if (completionStatus == CompletionStatus_started)
+            {
+                forEachRowRangeConcurrently(static_cast<int>(chunks.size()), static_cast<size_t>(nThreadCountMaximum), [&](const int nBegin, const int nEnd)
+                {
+                    for (int i = nBegin; i < nEnd; ++i)
+                    {
+                        if (isTerminatedConcurrent())
+                            return;
+                        const auto& chunk = chunks[static_cast<size_t>(i)];
+                        const auto nTop = selection[chunk.m_nRange].top();
+                        const auto& dataRows = viewToDataRows[static_cast<size_t>(chunk.m_nRange)];
+                        auto& partial = partials[static_cast<size_t>(i)];
+                        double val;
+                        for (int r = chunk.m_nFirstRow; r < chunk.m_nEndRow; ++r)
+                        {
+                            const auto nDataRow = (bMappingNeeded) ? dataRows[static_cast<size_t>(r - nTop)] : r;
+                            if (CsvItemModel::cellStringToSummaryValue(pModel->rawStringViewAt(nDataRow, chunk.m_nDataCol), val))
+                                partial.handleValue(val);
+                            else
+                                ++partial.m_nExcluded;
+                        }
+                    }
+                }, 1);
+            }
+            if (completionStatus == CompletionStatus_started && !isTerminated())
+            {
+                for (const auto& partial : partials)
+                    collector.mergePartial(partial);
+            }
+        }
+
         // For each selection
-        for(auto iter = selection.cbegin(); iter != selection.cend(); ++iter)
+        for(auto iter = selection.cbegin(); iter != selection.cend() && completionStatus == CompletionStatus_started && !bEvaluateConcurrently; ++iter)
         {
+            if (bUseNumericSummaries)
+            {
+                for (int c = iter->left(); c <= iter->right(); ++c)
+                {
+                    CsvItemModel::NumericSummary summary;
+                    if (isTerminated() || !pModel->columnNumericSummary(c, iter->top(), iter->bottom(), summary, isTerminated))
+                        break;
+                    collector.handleNumericSummary(summary);
+                }
+                continue;
+            }
             // For each cell in selection
             pCtvView->forEachCsvModelIndexInSelectionRange(*iter, CsvTableView::ForEachOrder::inOrderFirstRows, [&](const QModelIndex& index, bool& rbContinue)
             {
-                const auto bHasMaxTimePassed = operationTimer.elapsedWallSeconds() >= maxTime;
-                if (bHasMaxTimePassed || uiPanel->isStopRequested() || m_abNewSelectionPending || !m_abIsEnabled.load(std::memory_order_relaxed))
+                if (isTerminated())
                 {
-                    if (bHasMaxTimePassed)
-                        completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByTimeLimit;
-                    else if (m_abNewSelectionPending)
-                        completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByNewSelection;
-                    else if (!m_abIsEnabled)
-                        completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByDisabling;
-                    else
-                        completionStatus = ::DFG_MODULE_NS(qt)::CsvTableViewSelectionAnalyzer::CompletionStatus_terminatedByUserRequest;
                     rbContinue = false;
                     return;
                 }
@@ -6916,9 +7351,382 @@ bool ProgressWidget::isCancelled() const
 //
 /////////////////////////////////////////////////////////////////////////////////////
 
+namespace
+{
+    // Calls func(nBegin, nEnd) for consecutive row ranges covering [0, nRowCount[ using at most nThreadCount threads (0 = hardware concurrency).
+    // Ranges are not made smaller than nMinRangeSize.
+    template <class Func_T>
+    void forEachRowRangeConcurrently(const int nRowCount, size_t nThreadCount, Func_T&& func, const int nMinRangeSize)
+    {
+        if (nThreadCount == 0)
+            nThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        nThreadCount = (std::max)(size_t(1), (std::min)(nThreadCount, static_cast<size_t>(nRowCount / (std::max)(1, nMinRangeSize))));
+        const auto rangeBegin = [&](const size_t i) { return static_cast<int>(i * static_cast<size_t>(nRowCount) / nThreadCount); };
+        ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+        for (size_t i = 1; i < nThreadCount; ++i)
+            threads.push_back(std::thread([&, i]() { func(rangeBegin(i), rangeBegin(i + 1)); }));
+        func(0, rangeBegin(1));
+    }
+
+    // Sort keys of a single column for all rows of CsvItemModel, so that sorting doesn't need to do string-to-number conversions
+    // or QString creation in every comparison. Ordering is the same as in CsvTableViewSortFilterProxyModel::lessThan() fallback:
+    //      -number and datetime columns: by cellDataAsDouble() with non-numbers being -inf (NaN is handled like -inf).
+    //      -text columns: as in QSortFilterProxyModel, empty cells (=invalid QVariant) are after all non-empty.
+    class CsvTableViewColumnSortKeys
+    {
+    public:
+        CsvTableViewColumnSortKeys(const CsvItemModel& rModel, const int nCol, const bool bReverse, const Qt::CaseSensitivity caseSensitivity, const bool bLocaleAware)
+            : m_rModel(rModel)
+            , m_nCol(nCol)
+            , m_nDirection((bReverse) ? -1 : 1)
+            , m_caseSensitivity(caseSensitivity)
+            , m_bLocaleAware(bLocaleAware)
+        {
+            const auto colType = rModel.getColType(nCol);
+            m_bNumeric = (colType == CsvItemModel::ColType::number || colType == CsvItemModel::ColType::datetime);
+            const auto nRowCount = static_cast<size_t>(rModel.rowCount());
+            if (m_bNumeric)
+                m_numbers.resize(nRowCount);
+            else if (m_bLocaleAware)
+                m_collatorKeys.resize(nRowCount);
+            else
+                m_strings.resize(nRowCount);
+        }
+
+        // Fills keys of rows [nBegin, nEnd[. Can be called concurrently for non-overlapping ranges.
+        void extract(const int nBegin, const int nEnd)
+        {
+            if (m_bNumeric)
+            {
+                for (int r = nBegin; r < nEnd; ++r)
+                {
+                    const auto val = m_rModel.cellDataAsDouble(r, m_nCol, nullptr, -1 * std::numeric_limits<double>::infinity());
+                    m_numbers[static_cast<size_t>(r)] = (std::isnan(val)) ? -1 * std::numeric_limits<double>::infinity() : val;
+                }
+                return;
+            }
+            std::optional<QCollator> optCollator; // QCollator is not thread safe so using one per range.
+            if (m_bLocaleAware)
+            {
+                optCollator.emplace();
+                optCollator->setCaseSensitivity(m_caseSensitivity);
+            }
+            for (int r = nBegin; r < nEnd; ++r)
+            {
+                const auto sv = m_rModel.rawStringViewAt(r, m_nCol);
+                if (sv.empty())
+                    continue; // Empty cells are left as null QString or nullopt.
+                const auto s = viewToQString(sv);
+                if (optCollator)
+                    m_collatorKeys[static_cast<size_t>(r)] = optCollator->sortKey(s);
+                else
+                    m_strings[static_cast<size_t>(r)] = s;
+            }
+        }
+
+        // Returns negative, zero or positive if row a should be before, is equal to, or should be after row b.
+        int compare(const int a, const int b) const
+        {
+            const auto ia = static_cast<size_t>(a);
+            const auto ib = static_cast<size_t>(b);
+            int rv = 0;
+            if (m_bNumeric)
+                rv = (m_numbers[ia] < m_numbers[ib]) ? -1 : ((m_numbers[ib] < m_numbers[ia]) ? 1 : 0);
+            else if (m_bLocaleAware)
+                rv = compareWithEmptyLast(!m_collatorKeys[ia].has_value(), !m_collatorKeys[ib].has_value(), [&]() { return m_collatorKeys[ia]->compare(*m_collatorKeys[ib]); });
+            else
+                rv = compareWithEmptyLast(m_strings[ia].isNull(), m_strings[ib].isNull(), [&]() { return m_strings[ia].compare(m_strings[ib], m_caseSensitivity); });
+            return m_nDirection * rv;
+        }
+
+        bool isNumeric() const { return m_bNumeric; }
+
+    private:
+        template <class Func_T>
+        static int compareWithEmptyLast(const bool bEmptyA, const bool bEmptyB, Func_T&& func)
+        {
+            if (bEmptyA || bEmptyB)
+                return static_cast<int>(bEmptyA) - static_cast<int>(bEmptyB);
+            return func();
+        }
+
+        const CsvItemModel& m_rModel;
+        int m_nCol;
+        int m_nDirection; // 1 for normal order, -1 for reversed.
+        Qt::CaseSensitivity m_caseSensitivity;
+        bool m_bLocaleAware;
+        bool m_bNumeric;
+        std::vector<double> m_numbers;                              // Used for number and datetime columns.
+        std::vector<QString> m_strings;                             // Used for text columns when not locale aware.
+        std::vector<std::optional<QCollatorSortKey>> m_collatorKeys; // Used for text columns when locale aware.
+    }; // class CsvTableViewColumnSortKeys
+
+    // Bitmap telling which rows are accepted by row filter. Bits are stored in 64-bit words so that words can be written concurrently.
+    class CsvTableViewRowBitmap
+    {
+    public:
+        static constexpr int s_nRowsPerWord = 64;
+
+        void reset(const int nRowCount)
+        {
+            m_nRowCount = nRowCount;
+            m_words.assign(static_cast<size_t>((nRowCount + s_nRowsPerWord - 1) / s_nRowsPerWord), 0);
+        }
+
+        int rowCount() const { return m_nRowCount; }
+        int wordCount() const { return static_cast<int>(m_words.size()); }
+
+        bool test(const int nRow) const
+        {
+            return (m_words[static_cast<size_t>(nRow / s_nRowsPerWord)] >> (nRow % s_nRowsPerWord)) & 1;
+        }
+
+        void set(const int nRow)
+        {
+            m_words[static_cast<size_t>(nRow / s_nRowsPerWord)] |= uint64(1) << (nRow % s_nRowsPerWord);
+        }
+
+        size_t countSetBits() const
+        {
+            size_t n = 0;
+            for (const auto w : m_words)
+                n += std::bitset<64>(w).count();
+            return n;
+        }
+
+        std::vector<uint64> m_words;
+        int m_nRowCount = 0;
+    }; // class CsvTableViewRowBitmap
+
+    bool isRowAcceptedByMatchers(const MultiMatchDefinition<CsvItemModelStringMatcher>& matchers, const CsvItemModel& rModel, const int nRow, const int nColCount)
+    {
+        return matchers.isMatchByCallback([&](const CsvItemModelStringMatcher& matcher)
+            {
+                for (int c = 0; c < nColCount; ++c) if (matcher.isApplyColumn(c))
+                {
+                    if (matcher.isMatchWith(nRow, c, rModel.rawStringViewAt(nRow, c)))
+                        return true;
+                }
+                return false;
+            });
+    }
+
+    // Evaluates matchers for every row of rModel concurrently and stores results to rBitmap.
+    // If evaluation involves lots of cells, it is done as modal operation with cancellable progress dialog parented to pProgressParent.
+    // If pCandidates is given, only rows set in it are evaluated and others are considered as not accepted; this can be used when it is known
+    // that the new filter is narrower than the one that produced *pCandidates, see MultiMatchDefinition::isKnownToBeNarrowingOf().
+    // Returns false if evaluation was cancelled, in which case rBitmap content is unspecified.
+    bool evaluateRowFilter(const CsvItemModel& rModel, const MultiMatchDefinition<CsvItemModelStringMatcher>& matchers, CsvTableViewRowBitmap& rBitmap, const size_t nThreadCount, QWidget* pProgressParent,
+                           const CsvTableViewRowBitmap* pCandidates = nullptr)
+    {
+        const auto nRowCount = rModel.rowCount();
+        const auto nColCount = rModel.columnCount();
+        rBitmap.reset(nRowCount);
+
+        std::atomic<bool> abCancelled{ false };
+        const auto evaluate = [&](ProgressWidget* pProgressWidget)
+        {
+            if (pProgressWidget)
+            {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+                DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setRange", Qt::QueuedConnection, Q_ARG(int, 0), Q_ARG(int, 100)));
+#else
+                DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setRange", Qt::QueuedConnection, QGenericReturnArgument(), Q_ARG(int, 0), Q_ARG(int, 100)));
+#endif
+            }
+            std::atomic<int> anProcessedWordCount{ 0 };
+            std::atomic<int> anLastReportedPercentage{ 0 };
+            forEachRowRangeConcurrently(rBitmap.wordCount(), nThreadCount, [&](const int nWordBegin, const int nWordEnd)
+            {
+                for (int w = nWordBegin; w < nWordEnd; ++w)
+                {
+                    if (pProgressWidget && pProgressWidget->isCancelled())
+                        abCancelled = true;
+                    if (abCancelled.load(std::memory_order_relaxed))
+                        return;
+                    const auto nRowBegin = w * CsvTableViewRowBitmap::s_nRowsPerWord;
+                    const auto nRowEnd = (std::min)(nRowCount, nRowBegin + CsvTableViewRowBitmap::s_nRowsPerWord);
+                    // With candidates, words without any candidate rows are skipped altogether.
+                    if (!pCandidates || pCandidates->m_words[static_cast<size_t>(w)] != 0)
+                    {
+                        for (int r = nRowBegin; r < nRowEnd; ++r)
+                        {
+                            if ((!pCandidates || pCandidates->test(r)) && isRowAcceptedByMatchers(matchers, rModel, r, nColCount))
+                                rBitmap.set(r);
+                        }
+                    }
+                    const auto nPercentage = static_cast<int>(100.0 * (anProcessedWordCount.fetch_add(1, std::memory_order_relaxed) + 1) / rBitmap.wordCount());
+                    // Reporting progress on every percentage change; invokeMethod() since progress widget lives in another thread.
+                    if (pProgressWidget && anLastReportedPercentage.exchange(nPercentage, std::memory_order_relaxed) != nPercentage)
+                    {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+                        DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setValue", Qt::QueuedConnection, Q_ARG(int, nPercentage)));
+#else
+                        DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setValue", Qt::QueuedConnection, QGenericReturnArgument(), Q_ARG(int, nPercentage)));
+#endif
+                    }
+                }
+            }, 16);
+        };
+
+        const double nEvaluatedRowCount = (pCandidates) ? static_cast<double>(pCandidates->countSetBits()) : static_cast<double>(nRowCount);
+        const double nCellCount = nEvaluatedRowCount * static_cast<double>(nColCount);
+        if (nCellCount > 1e6)
+            doModalOperation(pProgressParent, QObject::tr("Filtering %1 rows").arg(nRowCount), ProgressWidget::IsCancellable::yes, "CsvTableViewRowFilter", evaluate);
+        else
+            evaluate(nullptr);
+        return !abCancelled;
+    }
+
+    // Finds cells of rModel that match matchDef concurrently and stores them to rHits as CsvItemModel::cellRowColumnPairToIndexPairInteger() values in row-major order.
+    // If nCol is non-negative, only cells in that column are searched.
+    // If pCandidates is given, only cells in it are checked; this can be used when it is known that matchDef is narrower than the one that produced *pCandidates.
+    // If search involves lots of cells and pProgressParent is not null, it is done as modal operation with cancellable progress dialog parented to pProgressParent.
+    // Returns false if search was cancelled, in which case rHits content is unspecified.
+    bool findMatchingCells(const CsvItemModel& rModel, const StringMatchDefinition& matchDef, const int nCol, std::vector<CsvItemModel::IndexPairInteger>& rHits, const size_t nThreadCount,
+                           QWidget* pProgressParent, const std::vector<CsvItemModel::IndexPairInteger>* pCandidates)
+    {
+        using IndexPairInteger = CsvItemModel::IndexPairInteger;
+        const int nRowsPerBlock = 1024;
+        const size_t nCandidatesPerBlock = 4096;
+        const auto nRowCount = rModel.rowCount();
+        const auto nColCount = rModel.columnCount();
+        const auto nColBegin = (nCol >= 0) ? nCol : 0;
+        const auto nColEnd = (nCol >= 0) ? (std::min)(nCol + 1, nColCount) : nColCount;
+        const auto nBlockCount = (pCandidates) ? static_cast<int>((pCandidates->size() + nCandidatesPerBlock - 1) / nCandidatesPerBlock)
+                                               : (nRowCount + nRowsPerBlock - 1) / nRowsPerBlock;
+        rHits.clear();
+
+        // Every block stores its hits separately so that blocks can be searched concurrently and results concatenated in order.
+        std::vector<std::vector<IndexPairInteger>> blockHits(static_cast<size_t>(nBlockCount));
+        std::atomic<bool> abCancelled{ false };
+
+        const auto searchRowBlock = [&](const int nBlock, std::vector<IndexPairInteger>& rDest)
+        {
+            const auto nRowBegin = nBlock * nRowsPerBlock;
+            const auto nRowEnd = (std::min)(nRowCount, nRowBegin + nRowsPerBlock);
+            // Going through block column by column for better memory locality, row-major order is restored by sorting.
+            for (int c = nColBegin; c < nColEnd; ++c)
+            {
+                for (int r = nRowBegin; r < nRowEnd; ++r)
+                {
+                    if (matchDef.isMatchWith(rModel.rawStringViewAt(r, c)))
+                        rDest.push_back(CsvItemModel::cellRowColumnPairToIndexPairInteger(r, c));
+                }
+            }
+            if (nColEnd - nColBegin > 1)
+                std::sort(rDest.begin(), rDest.end());
+        };
+
+        const auto searchCandidateBlock = [&](const int nBlock, std::vector<IndexPairInteger>& rDest)
+        {
+            const auto nBegin = static_cast<size_t>(nBlock) * nCandidatesPerBlock;
+            const auto nEnd = (std::min)(pCandidates->size(), nBegin + nCandidatesPerBlock);
+            for (size_t i = nBegin; i < nEnd; ++i)
+            {
+                const auto nKey = (*pCandidates)[i];
+                if (matchDef.isMatchWith(rModel.rawStringViewAt(static_cast<int>(nKey >> 32), static_cast<int>(nKey & 0xFFFFFFFF))))
+                    rDest.push_back(nKey);
+            }
+        };
+
+        const auto search = [&](ProgressWidget* pProgressWidget)
+        {
+            if (pProgressWidget)
+            {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+                DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setRange", Qt::QueuedConnection, Q_ARG(int, 0), Q_ARG(int, 100)));
+#else
+                DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setRange", Qt::QueuedConnection, QGenericReturnArgument(), Q_ARG(int, 0), Q_ARG(int, 100)));
+#endif
+            }
+            std::atomic<int> anProcessedBlockCount{ 0 };
+            std::atomic<int> anLastReportedPercentage{ 0 };
+            forEachRowRangeConcurrently(nBlockCount, nThreadCount, [&](const int nBlockBegin, const int nBlockEnd)
+            {
+                for (int b = nBlockBegin; b < nBlockEnd; ++b)
+                {
+                    if (pProgressWidget && pProgressWidget->isCancelled())
+                        abCancelled = true;
+                    if (abCancelled.load(std::memory_order_relaxed))
+                        return;
+                    if (pCandidates)
+                        searchCandidateBlock(b, blockHits[static_cast<size_t>(b)]);
+                    else
+                        searchRowBlock(b, blockHits[static_cast<size_t>(b)]);
+                    const auto nPercentage = static_cast<int>(100.0 * (anProcessedBlockCount.fetch_add(1, std::memory_order_relaxed) + 1) / nBlockCount);
+                    if (pProgressWidget && anLastReportedPercentage.exchange(nPercentage, std::memory_order_relaxed) != nPercentage)
+                    {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 9, 0)
+                        DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setValue", Qt::QueuedConnection, Q_ARG(int, nPercentage)));
+#else
+                        DFG_VERIFY(QMetaObject::invokeMethod(pProgressWidget, "setValue", Qt::QueuedConnection, QGenericReturnArgument(), Q_ARG(int, nPercentage)));
+#endif
+                    }
+                }
+            }, 4);
+        };
+
+        const double nCellCount = (pCandidates) ? static_cast<double>(pCandidates->size()) : static_cast<double>(nRowCount) * static_cast<double>(nColEnd - nColBegin);
+        if (nCellCount > 1e6 && pProgressParent)
+            doModalOperation(pProgressParent, QObject::tr("Finding matches from %1 cells").arg(nCellCount, 0, 'f', 0), ProgressWidget::IsCancellable::yes, "CsvTableViewFind", search);
+        else
+            search(nullptr);
+        if (abCancelled)
+            return false;
+
+        size_t nTotalHitCount = 0;
+        for (const auto& hits : blockHits)
+            nTotalHitCount += hits.size();
+        rHits.reserve(nTotalHitCount);
+        for (auto& hits : blockHits)
+        {
+            rHits.insert(rHits.end(), hits.begin(), hits.end());
+            hits.clear();
+            hits.shrink_to_fit();
+        }
+        return true;
+    }
+} // unnamed namespace
+
 DFG_OPAQUE_PTR_DEFINE(CsvTableViewSortFilterProxyModel)
 {
     MultiMatchDefinition<CsvItemModelStringMatcher> m_matchers;
+
+    // Sort rank cache: if valid (m_nSortRankColumn != -1), rows that are equal in all sort columns have the same rank and
+    // lessThan(a, b) is m_sortRanks[a] < m_sortRanks[b] (with row index as tie breaker if m_bSortRankTieBreakByRow is true).
+    std::vector<int> m_sortRanks;
+    int m_nSortRankColumn = -1;
+    bool m_bSortRankTieBreakByRow = false;
+    Qt::CaseSensitivity m_sortRankCaseSensitivity = Qt::CaseInsensitive;
+    bool m_bSortRankLocaleAware = false;
+    std::vector<std::pair<int, Qt::SortOrder>> m_secondarySortColumns; // Sort columns after primary column.
+    std::vector<QMetaObject::Connection> m_sourceModelConnections;
+
+    // Result of evaluating m_matchers for all rows, valid only if m_bRowFilterBitmapValid is true.
+    CsvTableViewRowBitmap m_rowFilterBitmap;
+    bool m_bRowFilterBitmapValid = false;
+
+    void invalidateRowFilterBitmap()
+    {
+        m_bRowFilterBitmapValid = false;
+        m_rowFilterBitmap.reset(0);
+    }
+
+    void invalidateSortRanks()
+    {
+        m_sortRanks.clear();
+        m_sortRanks.shrink_to_fit();
+        m_nSortRankColumn = -1;
+    }
+
+    bool isSortRankCacheValidFor(const CsvTableViewSortFilterProxyModel& rProxy, const int nColumn) const
+    {
+        return m_nSortRankColumn == nColumn && nColumn != -1
+            && m_sortRankCaseSensitivity == rProxy.sortCaseSensitivity()
+            && m_bSortRankLocaleAware == rProxy.isSortLocaleAware()
+            && rProxy.sortRole() == Qt::DisplayRole;
+    }
 };
 
 CsvTableViewSortFilterProxyModel::CsvTableViewSortFilterProxyModel(QWidget* pNonNullCsvTableViewParent)
@@ -6963,8 +7771,151 @@ bool CsvTableViewSortFilterProxyModel::isItemIndexMappingNeeded() const
     return (!pSourceModel || pSourceModel->columnCount() != this->columnCount());
 }
 
+void CsvTableViewSortFilterProxyModel::setSourceModel(QAbstractItemModel* pSourceModel)
+{
+    auto& rOpaq = DFG_OPAQUE_REF();
+    for (const auto& connection : rOpaq.m_sourceModelConnections)
+        QObject::disconnect(connection);
+    rOpaq.m_sourceModelConnections.clear();
+    rOpaq.invalidateSortRanks();
+    rOpaq.invalidateRowFilterBitmap();
+    if (pSourceModel)
+    {
+        // Connecting before base class so that caches get invalidated before base class handlers, which may resort or refilter, get called.
+        const auto invalidate = [this]()
+        {
+            auto& rOpaq = DFG_OPAQUE_REF();
+            rOpaq.invalidateSortRanks();
+            rOpaq.invalidateRowFilterBitmap();
+        };
+        auto& conns = rOpaq.m_sourceModelConnections;
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::dataChanged, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::rowsInserted, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::rowsRemoved, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::rowsMoved, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::columnsInserted, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::columnsRemoved, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::columnsMoved, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::layoutChanged, this, invalidate));
+        conns.push_back(connect(pSourceModel, &QAbstractItemModel::modelReset, this, invalidate));
+    }
+    BaseClass::setSourceModel(pSourceModel);
+}
+
+void CsvTableViewSortFilterProxyModel::sort(const int column, const Qt::SortOrder order)
+{
+    auto& rOpaq = DFG_OPAQUE_REF();
+    if (!rOpaq.m_secondarySortColumns.empty())
+    {
+        rOpaq.m_secondarySortColumns.clear();
+        rOpaq.invalidateSortRanks(); // Ranks were computed using secondary columns.
+    }
+    privSort(column, order);
+}
+
+void CsvTableViewSortFilterProxyModel::sortByColumns(const std::vector<std::pair<int, Qt::SortOrder>>& columns)
+{
+    if (columns.empty())
+    {
+        sort(-1);
+        return;
+    }
+    auto& rOpaq = DFG_OPAQUE_REF();
+    rOpaq.invalidateSortRanks();
+    rOpaq.m_secondarySortColumns.assign(columns.begin() + 1, columns.end());
+    privSort(columns.front().first, columns.front().second);
+}
+
+void CsvTableViewSortFilterProxyModel::privSort(const int nColumn, const Qt::SortOrder order)
+{
+    auto& rOpaq = DFG_OPAQUE_REF();
+    const bool bSameAsCurrent = (nColumn == this->sortColumn() && order == this->sortOrder());
+    if (bSameAsCurrent && rOpaq.m_secondarySortColumns.empty() && rOpaq.isSortRankCacheValidFor(*this, nColumn))
+    {
+        BaseClass::sort(nColumn, order); // Ranks are up-to-date, nothing to precompute.
+        return;
+    }
+    privUpdateSortRanks(nColumn, order);
+    // Base class sort() does nothing if column and order are the same as current so in that case resetting sort first to make new ranks effective.
+    if (bSameAsCurrent && this->dynamicSortFilter())
+        BaseClass::sort(-1);
+    BaseClass::sort(nColumn, order);
+}
+
+void CsvTableViewSortFilterProxyModel::privUpdateSortRanks(const int nColumn, const Qt::SortOrder order)
+{
+    auto& rOpaq = DFG_OPAQUE_REF();
+    rOpaq.invalidateSortRanks();
+    const auto pCsvModel = qobject_cast<const CsvItemModel*>(this->sourceModel());
+    if (!pCsvModel || !pCsvModel->isValidColumn(nColumn) || this->sortRole() != Qt::DisplayRole)
+        return;
+
+    const auto caseSensitivity = this->sortCaseSensitivity();
+    const bool bLocaleAware = this->isSortLocaleAware();
+    std::vector<CsvTableViewColumnSortKeys> keys;
+    keys.emplace_back(*pCsvModel, nColumn, false, caseSensitivity, bLocaleAware);
+    for (const auto& item : rOpaq.m_secondarySortColumns)
+    {
+        // Base class reverses the whole order in case of descending sort so secondary order is relative to primary order.
+        if (pCsvModel->isValidColumn(item.first))
+            keys.emplace_back(*pCsvModel, item.first, item.second != order, caseSensitivity, bLocaleAware);
+    }
+
+    const auto nRowCount = pCsvModel->rowCount();
+    auto pView = getTableView();
+    const auto nThreadCount = static_cast<size_t>((std::max)(0, (pView) ? getCsvTableViewProperty<CsvTableViewPropertyId_sortThreadCountMaximum>(pView) : 0));
+    forEachRowRangeConcurrently(nRowCount, nThreadCount, [&](const int nBegin, const int nEnd)
+    {
+        for (auto& key : keys)
+            key.extract(nBegin, nEnd);
+    });
+
+    const auto compareRows = [&](const int a, const int b)
+    {
+        for (const auto& key : keys)
+        {
+            const auto rv = key.compare(a, b);
+            if (rv != 0)
+                return rv;
+        }
+        return 0;
+    };
+
+    const auto sortedRows = ::DFG_MODULE_NS(alg)::computeSortIndexesBySizeAndPredParallel<int>(static_cast<size_t>(nRowCount), [&](const int a, const int b) { return compareRows(a, b) < 0; }, nThreadCount);
+
+    // Converting sorted permutation to ranks giving equal rows the same rank.
+    rOpaq.m_sortRanks.resize(sortedRows.size());
+    int nRank = 0;
+    for (size_t i = 0; i < sortedRows.size(); ++i)
+    {
+        if (i > 0 && compareRows(sortedRows[i - 1], sortedRows[i]) != 0)
+            ++nRank;
+        rOpaq.m_sortRanks[static_cast<size_t>(sortedRows[i])] = nRank;
+    }
+    rOpaq.m_nSortRankColumn = nColumn;
+    rOpaq.m_bSortRankTieBreakByRow = keys.front().isNumeric(); // Numerically equal values are sorted by data model row index like in lessThan().
+    rOpaq.m_sortRankCaseSensitivity = caseSensitivity;
+    rOpaq.m_bSortRankLocaleAware = bLocaleAware;
+}
+
 bool CsvTableViewSortFilterProxyModel::lessThan(const QModelIndex& sourceLeft, const QModelIndex& sourceRight) const
 {
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (pOpaq && pOpaq->isSortRankCacheValidFor(*this, sourceLeft.column()))
+    {
+        const auto& ranks = pOpaq->m_sortRanks;
+        const auto nLeft = sourceLeft.row();
+        const auto nRight = sourceRight.row();
+        if (isValidIndex(ranks, nLeft) && isValidIndex(ranks, nRight))
+        {
+            const auto nLeftRank = ranks[static_cast<size_t>(nLeft)];
+            const auto nRightRank = ranks[static_cast<size_t>(nRight)];
+            if (nLeftRank != nRightRank)
+                return nLeftRank < nRightRank;
+            return pOpaq->m_bSortRankTieBreakByRow && nLeft < nRight;
+        }
+    }
+
     auto pView = getTableView();
     auto pCsvModel = (pView) ? pView->csvModel() : nullptr;
 
@@ -7013,36 +7964,56 @@ bool CsvTableViewSortFilterProxyModel::filterAcceptsRow(const int sourceRow, con
     const auto pSourceModel = (pOpaq && !pOpaq->m_matchers.empty()) ? qobject_cast<const CsvItemModel*>(this->sourceModel()) : nullptr;
     if (pSourceModel)
     {
-        const auto nColCount = pSourceModel->columnCount();
-        return pOpaq->m_matchers.isMatchByCallback([=](const CsvItemModelStringMatcher& matcher)
-            {
-                for (int c = 0; c < nColCount; ++c) if (matcher.isApplyColumn(c))
-                {
-                    if (matcher.isMatchWith(sourceRow, c, pSourceModel->rawStringViewAt(sourceRow, c)))
-                        return true;
-                }
-                return false;
-            });
+        const auto& bitmap = pOpaq->m_rowFilterBitmap;
+        if (pOpaq->m_bRowFilterBitmapValid && bitmap.rowCount() == pSourceModel->rowCount() && sourceRow >= 0 && sourceRow < bitmap.rowCount())
+            return bitmap.test(sourceRow);
+        return isRowAcceptedByMatchers(pOpaq->m_matchers, *pSourceModel, sourceRow, pSourceModel->columnCount());
     }
     else
         return BaseClass::filterAcceptsRow(sourceRow, sourceParent);
 }
 
-void CsvTableViewSortFilterProxyModel::setFilterFromNewLineSeparatedJsonList(const QByteArray& sJson)
+bool CsvTableViewSortFilterProxyModel::setFilterFromNewLineSeparatedJsonList(const QByteArray& sJson)
 {
-    DFG_OPAQUE_REF().m_matchers = MultiMatchDefinition<CsvItemModelStringMatcher>::fromJson(SzPtrUtf8(sJson.data()));
+    auto matchers = MultiMatchDefinition<CsvItemModelStringMatcher>::fromJson(SzPtrUtf8(sJson.data()));
     // In CsvItemModelStringMatcher row 1 means first non-header row, while here corresponding row is row 0 -> shifting apply rows.
     // Column doesn't need to be adjusted since there's no header and thus no 0 index difference.
-    DFG_OPAQUE_REF().m_matchers.forEachWhile([](CsvItemModelStringMatcher& matcher)
+    matchers.forEachWhile([](CsvItemModelStringMatcher& matcher)
         {
             matcher.m_rows.shift_raw(-CsvItemModel::internalRowToVisibleShift());
             return true;
         });
+
+    auto& rOpaq = DFG_OPAQUE_REF();
+
+    // Evaluating filter for all rows concurrently so that filterAcceptsRow() calls from base class are simple bitmap lookups.
+    CsvTableViewRowBitmap bitmap;
+    const auto pCsvModel = qobject_cast<const CsvItemModel*>(this->sourceModel());
+    const bool bHasBitmap = (pCsvModel && !matchers.empty());
+    if (bHasBitmap)
+    {
+        auto pView = getTableView();
+        const auto nThreadCount = static_cast<size_t>((std::max)(0, (pView) ? getCsvTableViewProperty<CsvTableViewPropertyId_filterThreadCountMaximum>(pView) : 0));
+        // If new filter is known to be narrowing of the current one (e.g. user typed more characters to filter text),
+        // only rows accepted by the current filter need to be evaluated.
+        const bool bCanUsePreviousResult = !rOpaq.m_matchers.empty()
+                                           && rOpaq.m_bRowFilterBitmapValid
+                                           && rOpaq.m_rowFilterBitmap.rowCount() == pCsvModel->rowCount()
+                                           && matchers.isKnownToBeNarrowingOf(rOpaq.m_matchers);
+        const auto pCandidates = (bCanUsePreviousResult) ? &rOpaq.m_rowFilterBitmap : nullptr;
+        if (!evaluateRowFilter(*pCsvModel, matchers, bitmap, nThreadCount, qobject_cast<QWidget*>(this->parent()), pCandidates))
+            return false; // Cancelled, keeping existing filter.
+    }
+
+    rOpaq.m_matchers = std::move(matchers);
+    rOpaq.m_rowFilterBitmap = std::move(bitmap);
+    rOpaq.m_bRowFilterBitmapValid = bHasBitmap;
 #if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
     this->invalidateRowsFilter();
 #else // Case: Qt version < 6.0
     this->invalidateFilter();
 #endif
+    return true;
 }
 
 std::optional<QString> CsvTableViewSortFilterProxyModel::getColumnFilterText(const ColumnIndex_data nCol) const
@@ -120,7 +120,10 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         CsvTableViewSortFilterProxyModel(QWidget* pNonNullCsvTableViewParent);
         ~CsvTableViewSortFilterProxyModel();
 
-        void setFilterFromNewLineSeparatedJsonList(const QByteArray& sJson);
+        // Sets filter from list of new line separated json-definitions. Filter is evaluated for all rows concurrently (see CsvTableView_filterThreadCountMaximum)
+        // and for large tables with a cancellable progress dialog.
+        // Returns false if evaluation was cancelled, in which case the previous filter remains in effect.
+        bool setFilterFromNewLineSeparatedJsonList(const QByteArray& sJson);
 
         const CsvTableView* getTableView() const;
 
@@ -134,11 +137,27 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
 
         QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
+        // Sorts by given column. Before handing over to QSortFilterProxyModel, computes sort keys (numbers for number/datetime columns, strings or collation keys for text)
+        // for every row once and ranks rows by sorting a row permutation concurrently so that lessThan() becomes a simple integer comparison.
+        void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+        // Sorts by multiple columns: first item defines primary sort column and order, following items are used for ordering rows that are equal in all preceding columns.
+        // Note: ordering by secondary columns is in effect until next sort(); if proxy resorts internally (e.g. on data change with dynamic sort filter), only primary column is used.
+        void sortByColumns(const std::vector<std::pair<int, Qt::SortOrder>>& columns);
+
+        void setSourceModel(QAbstractItemModel* pSourceModel) override;
+
     protected:
         bool filterAcceptsColumn(int sourceRow, const QModelIndex& sourceParent) const override;
         bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
         bool lessThan(const QModelIndex& sourceLeft, const QModelIndex& sourceRight) const override;
 
+    private:
+        // Computes sort ranks for rows by given primary column and sort columns in opaque member, see sort().
+        void privUpdateSortRanks(int nColumn, Qt::SortOrder order);
+        void privSort(int nColumn, Qt::SortOrder order);
+
+    protected:
         DFG_OPAQUE_PTR_DECLARE();
     }; // class CsvTableViewSortFilterProxyModel
 
@@ -246,6 +265,12 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
 
         int defaultNumericPrecision() const;
 
+        // Sets maximum number of threads used when evaluating large selections, 0 = number of hardware threads.
+        // Can be called while evaluation is ongoing.
+        void setThreadCountMaximum(int nThreadCount);
+
+        int threadCountMaximum() const;
+
         // Can be called while evaluation is ongoing
         CollectorContainerPtr collectors() const;
 
@@ -262,6 +287,7 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         void onEnableAllDetails();
         void onDisableAllDetails();
         void onQueryDefaultNumericPrecision();
+        void onQueryThreadCountMaximum();
 
     private:
         QObjectStorage<QLineEdit>      m_spValueDisplay;
@@ -487,6 +513,10 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         // Forgets latest find position so that next begins from memoryless situation.
         void forgetLatestFindPosition();
 
+        // Returns the number of cells matching the current find definition (see setFindText()), or std::nullopt if not available, e.g. if search was cancelled.
+        // Matching cells are searched concurrently and cached so that e.g. find next/previous don't need to search again until content changes.
+        std::optional<size_t> countFindMatches();
+
         std::unique_ptr<QMenu> createResizeColumnsMenu();
 
         // Calls given function for every CsvModel index in selection. 'func' is given two arguments: const QModelIndex& index, bool& bContinue
@@ -652,6 +682,8 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         bool createNewTableFromClipboard();
         bool openFromFile();
         bool openFromFileWithOptions();
+        // Opens file to a separate read-only window that parses rows on demand, for viewing files too big to be opened as editable.
+        bool openFromFileReadOnlyLazy();
         bool reloadFromFileFromScratch();
         bool reloadFromFileWithPreviousLoadOptions();
         bool mergeFilesToCurrent();
@@ -672,6 +704,7 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         bool cut();
         void undo();
         void redo();
+        // Replaces "find" with "replace" in selected cells, or in the whole table if "scope" is "all". Find is case sensitive and replace is a single undoable operation.
         size_t replace(const QVariantMap& params); // Returns the number of cells edited.
 
         bool deleteCurrentColumn();
@@ -800,6 +833,12 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
 
         void stopAnalyzerThreads();
 
+        // Requests CsvItemModel to prefetch display strings of visible cells and their surroundings if visible area has changed since previous call.
+        void privPrefetchDisplayStringsAroundViewport();
+
+        // Updates cached list of cells matching find definition if needed. Returns false if list is not available, e.g. if search was cancelled.
+        bool privUpdateFindHits();
+
         void addAllActions();
         void addOpenSaveActions();
         void addDimensionEditActions();
@@ -347,6 +347,26 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
         DFG_DETAIL_NS::CellMemory m_cellMemoryRedo; // Note: effectively stores just indexes.
     }; // class CsvTableViewActionFill
 
+    // Replaces substring in given cells as a single undoable operation.
+    class CsvTableViewActionReplace : public UndoCommand
+    {
+    public:
+        // params: "find" and "replace" as in CsvTableView::replace()
+        // cells: cells as CsvItemModel::IndexPairInteger; cells that don't contain find string are not edited.
+        CsvTableViewActionReplace(CsvTableView* pView, const QVariantMap& params, const std::vector<CsvItemModel::IndexPairInteger>& cells);
+
+        void undo();
+        void redo();
+
+        size_t editedCellCount() const { return m_nCellCount; }
+
+    private:
+        QPointer<CsvTableView> m_spView;
+        size_t m_nCellCount = 0;
+        DFG_DETAIL_NS::CellMemory m_cellMemoryUndo;
+        DFG_DETAIL_NS::CellMemory m_cellMemoryRedo;
+    }; // class CsvTableViewActionReplace
+
     class CsvTableViewActionPaste : public UndoCommand
     {
     public:
@@ -184,6 +184,9 @@ DFG_OPAQUE_PTR_DEFINE(DFG_MODULE_NS(qt)::CsvTableViewChartDataSource)
     ::DFG_MODULE_NS(cont)::ViewableSharedPtrViewer<GraphDataSource::ColumnDataTypeMap> m_viewerMapColToDataType;
     bool m_bCachingAllowed = true;
     std::atomic<uint64> m_anChangeCounter{ 0 };
+    // Changes since last sigChanged(): nullopt if none, default DataSourceChangedParam if unspecified change.
+    std::optional<DataSourceChangedParam> m_pendingChange;
+    std::optional<QItemSelection> m_lastSignaledSelection; // Selection for which sigChanged() was last emitted.
 };
 
 ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::CsvTableViewChartDataSource(CsvTableView* view)
@@ -206,8 +209,8 @@ DFG_OPAQUE_PTR_DEFINE(DFG_MODULE_NS(qt)::CsvTableViewChartDataSource)
     auto pCsvModel = m_spView->csvModel();
     if (pCsvModel)
     {
-        // Simply reset cache on any changes to CsvModel
-        DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvItemModel::dataChanged, this, &CsvTableViewChartDataSource::resetCache));
+        // Content edits update cache in place, other changes to CsvModel simply reset cache.
+        DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvItemModel::dataChanged, this, &CsvTableViewChartDataSource::onModelDataChanged));
         DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvItemModel::sigOnNewSourceOpened, this, &CsvTableViewChartDataSource::resetCache));
         DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvItemModel::columnsInserted, this, &CsvTableViewChartDataSource::resetCache));
         DFG_QT_VERIFY_CONNECT(connect(pCsvModel, &CsvItemModel::columnsRemoved, this, &CsvTableViewChartDataSource::resetCache));
@@ -490,8 +493,17 @@ void ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::setChartDefinitionViewer(
 
 void ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::onSelectionAnalysisCompleted()
 {
-    DFG_OPAQUE_REF().m_anChangeCounter++;
-    emitSigChanged();
+    auto& rOpaq = DFG_OPAQUE_REF();
+    rOpaq.m_anChangeCounter++;
+    // If selection is the same as in previous signal and only content edits have happened since, signaling only the edited range
+    // so that receivers can keep data of unaffected columns.
+    auto spSelectionView = privGetSelectionView();
+    DataSourceChangedParam param;
+    if (spSelectionView && rOpaq.m_pendingChange && rOpaq.m_lastSignaledSelection == static_cast<const QItemSelection&>(*spSelectionView))
+        param = *rOpaq.m_pendingChange;
+    rOpaq.m_pendingChange.reset();
+    rOpaq.m_lastSignaledSelection = (spSelectionView) ? std::optional<QItemSelection>(*spSelectionView) : std::nullopt;
+    emitSigChanged(param);
 }
 
 bool ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::isSafeToQueryDataFromThreadImpl(const QThread*) const
@@ -504,8 +516,89 @@ auto ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::snapshotIdImpl() const ->
     return DFG_OPAQUE_PTR() ? GraphDataSourceSnapshotId(DFG_OPAQUE_PTR()->m_anChangeCounter) : std::optional<GraphDataSourceSnapshotId>();
 }
 
+void ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+    auto pCsvModel = (m_spView) ? m_spView->csvModel() : nullptr;
+    if (!pCsvModel || !topLeft.isValid() || !bottomRight.isValid() || (!roles.empty() && !roles.contains(Qt::EditRole)))
+    {
+        resetCache();
+        return;
+    }
+    auto& rOpaq = DFG_OPAQUE_REF();
+    rOpaq.m_anChangeCounter++;
+
+    const auto nTopRow = topLeft.row();
+    const auto nBottomRow = bottomRight.row();
+
+    // Updating edited rows in number cache instead of wiping it: e.g. single cell edit in 10M row table only
+    // needs to convert edited cell instead of 10M cells.
+    auto spCacheView = rOpaq.m_cacheViewer.view();
+    if (spCacheView)
+    {
+        std::unique_ptr<DataSourceNumberCache> newCache(new DataSourceNumberCache(*spCacheView));
+        for (auto c = topLeft.column(); c <= bottomRight.column(); ++c)
+        {
+            const ColumnIndex_data nColData(c);
+            if (!spCacheView->hasColumn(nColData))
+                continue;
+            const auto existingSpan = spCacheView->getSpanFromColumn(nColData);
+            if (!isValidIndex(existingSpan, nBottomRow))
+            {
+                newCache->m_mapColToNumbers.erase(nColData.value());
+                newCache->m_mapColToDataTypes.erase(nColData.valueAsUint());
+                continue;
+            }
+            auto spColumnCache = newCache->makeNewColumnCacheObject(saturateCast<CsvItemModel::Index>(existingSpan.size()));
+            if (!spColumnCache)
+            {
+                newCache->m_mapColToNumbers.erase(nColData.value());
+                newCache->m_mapColToDataTypes.erase(nColData.valueAsUint());
+                continue;
+            }
+            spColumnCache->assign(existingSpan);
+            const auto nColView = m_spView->columnIndexDataToView(nColData);
+            // Note: type can only expand here, i.e. if edit removed the only value that made column e.g. a datetime-column, cached type is not narrowed.
+            GraphDataSource::ColumnDataTypeMap mapColToDataType;
+            mapColToDataType[nColView.valueAsUint()] = spCacheView->getColumnDataType(nColData);
+            for (auto r = nTopRow; r <= nBottomRow; ++r)
+            {
+                const auto pszData = pCsvModel->rawStringPtrAt(r, nColData.value());
+                (*spColumnCache)[static_cast<size_t>(r)] = cellStringToDoubleImpl(*pCsvModel, RowIndex_data(r), nColData, pszData, nColView, mapColToDataType);
+            }
+            newCache->setColumnCache(nColData, std::move(spColumnCache), mapColToDataType.valueCopyOr(nColView.valueAsUint(), ChartDataType::unknown));
+        }
+        rOpaq.m_cache.reset(std::move(newCache));
+    }
+
+    // Recording changed range in chart column indexes (i.e. view indexes) for next sigChanged().
+    std::optional<DataSourceIndex> nFirstViewCol;
+    DataSourceIndex nLastViewCol = 0;
+    for (auto c = topLeft.column(); c <= bottomRight.column(); ++c)
+    {
+        const auto nColView = m_spView->columnIndexDataToView(ColumnIndex_data(c));
+        if (nColView.value() < 0)
+            continue;
+        const auto nCol = static_cast<DataSourceIndex>(nColView.value());
+        nFirstViewCol = (nFirstViewCol) ? (std::min)(*nFirstViewCol, nCol) : nCol;
+        nLastViewCol = (std::max)(nLastViewCol, nCol);
+    }
+    if (!nFirstViewCol) // Edited columns are not visible -> nothing to signal.
+        return;
+    // Row range can be given only if view rows map directly to data rows; otherwise signaling whole columns as changed.
+    auto param = (!m_spView->isRowIndexMappingNeeded())
+        ? DataSourceChangedParam::fromInvalidCellRange(*nFirstViewCol, nLastViewCol,
+                                                       static_cast<DataSourceIndex>(CsvItemModel::internalRowIndexToVisible(nTopRow)),
+                                                       static_cast<DataSourceIndex>(CsvItemModel::internalRowIndexToVisible(nBottomRow)))
+        : DataSourceChangedParam::fromInvalidColumnRange(*nFirstViewCol, nLastViewCol);
+    if (rOpaq.m_pendingChange)
+        rOpaq.m_pendingChange->unite(param);
+    else
+        rOpaq.m_pendingChange = param;
+}
+
 void ::DFG_MODULE_NS(qt)::CsvTableViewChartDataSource::resetCache()
 {
     DFG_OPAQUE_REF().m_anChangeCounter++;
+    DFG_OPAQUE_REF().m_pendingChange = DataSourceChangedParam(); // Unspecified change
     DFG_OPAQUE_REF().m_cache.reset(); // TODO: make less coarse-grained; this bluntly wipes out all caches without retaining any of the allocated memory, which often could be reused for future caching.
 }
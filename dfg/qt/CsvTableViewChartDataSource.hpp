@@ -100,6 +100,7 @@ private:
 
 public slots:
     void onSelectionAnalysisCompleted();
+    void onModelDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
     void resetCache();
 
 public:
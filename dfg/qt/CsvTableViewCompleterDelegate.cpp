@@ -116,6 +116,11 @@ QWidget* CsvTableViewDelegate::createEditor(QWidget* parent, const QStyleOptionV
 
     auto spTableView = m_spTableView;
 
+    // Display string prefetch reads model under read lock, cancelling it so that it won't block committing the edit in setModelData().
+    auto pCsvModel = (spTableView) ? spTableView->csvModel() : nullptr;
+    if (pCsvModel)
+        pCsvModel->cancelDisplayStringPrefetch();
+
     // If cell has no newlines, using LineEditCtrl...
     if (sText.indexOf('\n') == -1 && sText.indexOf(QChar::SpecialCharacter::LineSeparator) == -1)
     {
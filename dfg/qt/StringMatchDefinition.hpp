@@ -125,24 +125,40 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
             return m_bNegate;
         }
 
+        // Returns true if it is known that every string matched by this is also matched by 'other', e.g. when this is a substring match
+        // whose match string contains the match string of 'other'. Detection is conservative: false may be returned even if this is a narrowing of 'other'.
+        bool isKnownToBeNarrowingOf(const StringMatchDefinition& other) const
+        {
+            if (m_matchString == other.m_matchString && m_caseSensitivity == other.m_caseSensitivity && m_patternSyntax == other.m_patternSyntax && m_bNegate == other.m_bNegate)
+                return true; // Identical definitions
+            if (m_bNegate || other.m_bNegate || !isPlainSubStringMatch() || !other.isPlainSubStringMatch() || !other.hasMatchString())
+                return false;
+            if (other.m_caseSensitivity == Qt::CaseSensitive && m_caseSensitivity != Qt::CaseSensitive)
+                return false;
+            return m_matchString.contains(other.m_matchString, other.m_caseSensitivity);
+        }
+
     private:
         bool applyNegateIfNeeded(const bool b) const
         {
             return (m_bNegate) ? !b : b;
         }
 
+        // Returns true if matching is plain substring search regardless of case sensitivity.
+        bool isPlainSubStringMatch() const
+        {
+            const auto isSpecialWildcardChar = [](const QChar& c) { return c == '*' || c == '?' || c == '[' || c == ']'; };
+            return (m_patternSyntax == PatternMatcher::FixedString)
+                   ||
+                   (m_patternSyntax == PatternMatcher::Wildcard && !std::any_of(m_matchString.cbegin(), m_matchString.cend(), isSpecialWildcardChar));
+        }
+
         void initCache()
         {
             m_regExp = PatternMatcher(m_matchString, m_caseSensitivity, m_patternSyntax);
 
-            const auto isSpecialWildcardChar = [](const QChar& c) { return c == '*' || c == '?' || c == '[' || c == ']'; };
-
             // TODO: handle other pattern syntaxes as well (e.g. RegExp without special characters could be done with substring matching).
-            const bool bCanDoSubStringMatching = m_caseSensitivity == Qt::CaseSensitive &&
-                                        ((m_patternSyntax == PatternMatcher::FixedString)
-                                        ||
-                                        (m_patternSyntax == PatternMatcher::Wildcard &&
-                                         !std::any_of(m_matchString.cbegin(), m_matchString.cend(), isSpecialWildcardChar)));
+            const bool bCanDoSubStringMatching = m_caseSensitivity == Qt::CaseSensitive && isPlainSubStringMatch();
             if (bCanDoSubStringMatching)
             {
                 const auto utf8Bytes = m_matchString.toUtf8();
@@ -200,6 +216,12 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
             return !m_rows.hasValue(nRow) || !m_columns.hasValue(nCol) || BaseClass::isMatchWith(sv);
         }
 
+        // Like StringMatchDefinition::isKnownToBeNarrowingOf(), but also requires rows and columns to be identical.
+        bool isKnownToBeNarrowingOf(const TableStringMatchDefinition& other) const
+        {
+            return m_rows == other.m_rows && m_columns == other.m_columns && BaseClass::isKnownToBeNarrowingOf(other);
+        }
+
         // Defines rows on which to apply filter.
         IntervalSet m_rows = IntervalSet::makeSingleInterval(1, maxValueOfType<int>());
         // Defines columns on which to apply filter.
@@ -275,6 +297,25 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt)
 
         bool empty() const { return m_matchers.empty(); }
 
+        // Returns true if it is known that everything matched by this is also matched by 'other'; detection is conservative, see MatchDefinition::isKnownToBeNarrowingOf().
+        // This is the case e.g. when a term is added to an and_group or when a substring match string gets longer, which allows
+        // re-evaluating only items that matched with 'other'.
+        bool isKnownToBeNarrowingOf(const MultiMatchDefinition& other) const
+        {
+            // Every AND-set in this must be narrower than some AND-set in other, which is the case if every item in the other AND-set
+            // has a narrowing item in this AND-set.
+            return std::all_of(m_matchers.begin(), m_matchers.end(), [&](const auto& kv)
+            {
+                return std::any_of(other.m_matchers.begin(), other.m_matchers.end(), [&](const auto& otherKv)
+                {
+                    return std::all_of(otherKv.second.begin(), otherKv.second.end(), [&](const MatchDefinition& otherMatcher)
+                    {
+                        return std::any_of(kv.second.begin(), kv.second.end(), [&](const MatchDefinition& matcher) { return matcher.isKnownToBeNarrowingOf(otherMatcher); });
+                    });
+                });
+            });
+        }
+
         MatchDefinitionStorage m_matchers; // Each mapped item defines a set of AND'ed items and the match result is obtained by OR'ing each AND-set.
     }; // class TableStringMatchDefinition
 
@@ -299,8 +299,15 @@ namespace DFG_DETAIL_NS {
                 l->addWidget(m_pColumnSelector, 0, nColumn++);
             }
 
+            // Match count, shown only if set by setMatchCount().
+            {
+                m_spMatchCountLabel.reset(new QLabel(this));
+                m_spMatchCountLabel->setToolTip(tr("Number of matching cells at the time of latest search"));
+                m_spMatchCountLabel->setHidden(true);
+                l->addWidget(m_spMatchCountLabel.get(), 0, nColumn++);
+            }
+
             // TODO: highlighting details (color)
-            // TODO: match count
         }
 
         Qt::CaseSensitivity getCaseSensitivity() const
@@ -351,12 +358,23 @@ namespace DFG_DETAIL_NS {
 
         int getColumnIndex() const { return (m_pColumnSelector) ? m_pColumnSelector->value() : -1; }
 
+        // Shows given match count, hides match count if optCount is empty.
+        void setMatchCount(const std::optional<size_t> optCount)
+        {
+            if (!m_spMatchCountLabel)
+                return;
+            if (optCount)
+                m_spMatchCountLabel->setText(tr("%1 match(es)").arg(*optCount));
+            m_spMatchCountLabel->setHidden(!optCount.has_value());
+        }
+
         HighlightTextEdit* m_pTextEdit;
         QObjectStorage<QLabel> m_spColumnLabel;
         QSpinBox* m_pColumnSelector;
         QCheckBox* m_pCaseSensitivityCheckBox;
         QComboBox* m_pMatchSyntaxCombobox;
         QObjectStorage<QToolButton> m_spJsonInsertButton;
+        QObjectStorage<QLabel> m_spMatchCountLabel;
     }; // class FindPanelWidget
 
     void FindPanelWidget::forEachConfigProperty(std::function<void(CsvTableView::PropertyFetcher)> func) const
@@ -1530,6 +1548,8 @@ void TableEditor::onHighlightTextChanged(const QString& text)
     StringMatchDefinition matchDef(text, m_spFindPanel->getCaseSensitivity(), m_spFindPanel->getPatternSyntax());
     m_spTableView->setFindText(matchDef, CsvItemModel::visibleColumnIndexToInternal(m_spFindPanel->m_pColumnSelector->value()));
     m_spTableView->onFindNext();
+    // Matches have been searched by onFindNext() so getting count is cheap.
+    m_spFindPanel->setMatchCount((text.isEmpty()) ? std::nullopt : m_spTableView->countFindMatches());
 }
 
 void TableEditor::setFilterJson(const QString& sJson)
@@ -1642,7 +1662,8 @@ void TableEditor::onFilterTextChanged(const QString& text)
                 .arg(nErrorOffset)
                 .arg(errContext));
         });
-        pProxy->setFilterFromNewLineSeparatedJsonList(utf8);
+        if (!pProxy->setFilterFromNewLineSeparatedJsonList(utf8))
+            m_spFilterPanel->setSyntaxIndicator_bad(tr("Filtering was cancelled, previous filter is still in effect"));
     }
     else if (m_spFilterPanel->m_pColumnSelector)
     {
@@ -258,6 +258,62 @@ void SelectionDetailCollector_percentile::resetImpl()
     DFG_OPAQUE_REF().m_memFunc.clear();
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+// 
+// SelectionDetailCollector_percentile_approx
+//
+/////////////////////////////////////////////////////////////////////////////////////
+
+DFG_OPAQUE_PTR_DEFINE(SelectionDetailCollector_percentile_approx)
+{
+public:
+    ::DFG_MODULE_NS(func)::MemFuncPercentile_approx<double> m_memFunc{ 0 };
+}; // Opaque class of SelectionDetailCollector_percentile_approx
+
+const char SelectionDetailCollector_percentile_approx::s_propertyName_compression[] = "compression";
+
+SelectionDetailCollector_percentile_approx::SelectionDetailCollector_percentile_approx(StringUtf8 sId, const double percentage, const double compression)
+    : BaseClass(std::move(sId))
+{
+    DFG_OPAQUE_REF().m_memFunc = ::DFG_MODULE_NS(func)::MemFuncPercentile_approx<double>(percentage, compression);
+    this->m_bNeedsUpdate = true;
+}
+
+SelectionDetailCollector_percentile_approx::~SelectionDetailCollector_percentile_approx() = default;
+
+double SelectionDetailCollector_percentile_approx::valueImpl() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    return (pOpaq) ? pOpaq->m_memFunc.percentile() : std::numeric_limits<double>::quiet_NaN();
+}
+
+void SelectionDetailCollector_percentile_approx::updateImpl(const double val)
+{
+    DFG_OPAQUE_REF().m_memFunc(val);
+}
+
+void SelectionDetailCollector_percentile_approx::resetImpl()
+{
+    DFG_OPAQUE_REF().m_memFunc.clear();
+}
+
+std::shared_ptr<SelectionDetailCollector> SelectionDetailCollector_percentile_approx::createPartialImpl() const
+{
+    auto pOpaq = DFG_OPAQUE_PTR();
+    if (!pOpaq)
+        return nullptr;
+    return std::make_shared<SelectionDetailCollector_percentile_approx>(StringUtf8(id()), pOpaq->m_memFunc.percentage(), pOpaq->m_memFunc.compression());
+}
+
+void SelectionDetailCollector_percentile_approx::mergePartialImpl(const SelectionDetailCollector& partial)
+{
+    auto pOther = dynamic_cast<const SelectionDetailCollector_percentile_approx*>(&partial);
+    auto pOtherOpaq = (pOther) ? pOther->m_opaqueMember.get() : nullptr;
+    DFG_ASSERT_CORRECTNESS(pOther != nullptr);
+    if (pOtherOpaq)
+        DFG_OPAQUE_REF().m_memFunc.merge(pOtherOpaq->m_memFunc);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 // 
 // SelectionDetailCollectorContainer
@@ -68,12 +68,19 @@ public:
     // Resets collector clearing memory from previous collection around.
     void reset() { if (m_bNeedsUpdate) resetImpl(); }
 
+    // Returns collector with the same settings but no values, or null if collector doesn't support partial evaluation. Partial collector can be updated
+    // with part of the values (e.g. in another thread) and then merged to this with mergePartial(); result does not depend on how values are split to partials.
+    std::shared_ptr<SelectionDetailCollector> createPartial() const { return (m_bNeedsUpdate) ? createPartialImpl() : nullptr; }
+    void mergePartial(const SelectionDetailCollector& partial) { if (m_bNeedsUpdate) mergePartialImpl(partial); }
+
     QString exportDefinitionToJson(const bool bIncludeId = false, const bool bSingleLine = false) const;
 
 private:
     virtual double valueImpl() const { return std::numeric_limits<double>::quiet_NaN(); }
     virtual void updateImpl(double val) { DFG_UNUSED(val); }
     virtual void resetImpl() {}
+    virtual std::shared_ptr<SelectionDetailCollector> createPartialImpl() const { return nullptr; }
+    virtual void mergePartialImpl(const SelectionDetailCollector& partial) { DFG_UNUSED(partial); }
 
 protected:
     bool m_bNeedsUpdate = false;
@@ -120,6 +127,29 @@ private:
     DFG_OPAQUE_PTR_DECLARE();
 }; // Class SelectionDetailCollector_formula
 
+// Selection detail collector for approximate percentile; uses constant amount of memory regardless of selection size.
+class SelectionDetailCollector_percentile_approx : public SelectionDetailCollector
+{
+public:
+    using BaseClass = SelectionDetailCollector;
+
+    static const char s_propertyName_compression[];
+
+    static constexpr double s_defaultCompression = 100;
+
+    SelectionDetailCollector_percentile_approx(StringUtf8 sId, double percentage, double compression = s_defaultCompression);
+    ~SelectionDetailCollector_percentile_approx();
+
+private:
+    double valueImpl() const override;
+    void updateImpl(double val) override;
+    void resetImpl() override;
+    std::shared_ptr<SelectionDetailCollector> createPartialImpl() const override;
+    void mergePartialImpl(const SelectionDetailCollector& partial) override;
+
+    DFG_OPAQUE_PTR_DECLARE();
+}; // Class SelectionDetailCollector_percentile_approx
+
 // Stores SelectionDetailCollectors
 class SelectionDetailCollectorContainer : public std::vector<std::shared_ptr<SelectionDetailCollector>>
 {
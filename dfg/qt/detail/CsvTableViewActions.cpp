@@ -228,6 +228,79 @@ void CsvTableViewActionFill::redo()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////
+///
+/// CsvTableViewActionReplace
+///
+////////////////////////////////////////////////////////////////////////////
+
+CsvTableViewActionReplace::CsvTableViewActionReplace(CsvTableView* pView, const QVariantMap& params, const std::vector<CsvItemModel::IndexPairInteger>& cells)
+    : m_spView(pView)
+{
+    auto pModel = (pView) ? pView->csvModel() : nullptr;
+    if (!pModel)
+        return;
+    const auto sFind = qStringToStringUtf8(params.value("find").toString());
+    const auto sReplace = qStringToStringUtf8(params.value("replace").toString());
+    if (sFind.rawStorage().empty())
+        return;
+    StringUtf8 sTemp;
+    for (const auto nKey : cells)
+    {
+        const auto nRow = static_cast<int>(nKey >> 32);
+        const auto nCol = static_cast<int>(nKey & 0xFFFFFFFF);
+        const auto sv = pModel->rawStringViewAt(nRow, nCol);
+        sTemp.rawStorage().assign(sv.beginRaw(), sv.endRaw());
+        if (::DFG_MODULE_NS(str)::replaceSubStrsInplace(sTemp.rawStorage(), sFind.rawStorage(), sReplace.rawStorage()) == 0)
+            continue;
+        m_cellMemoryUndo.setElement(nRow, nCol, sv);
+        m_cellMemoryRedo.setElement(nRow, nCol, sTemp);
+        ++m_nCellCount;
+    }
+    setText(pView->tr("Replace '%1' with '%2', %3 cell(s)").arg(params.value("find").toString(), params.value("replace").toString()).arg(m_nCellCount));
+}
+
+void CsvTableViewActionReplace::undo()
+{
+    auto pModel = (m_spView) ? m_spView->csvModel() : nullptr;
+    if (!pModel || m_nCellCount == 0)
+        return;
+    bool bIsCancelled = false;
+    m_spView->doModalOperation(m_spView->tr("Undo of replace in progress..."), ProgressWidget::IsCancellable::yes, "undo_action_replace", [&](ProgressWidget* pWidget)
+        {
+            DFG_DETAIL_NS::restoreCells(m_cellMemoryUndo, *pModel, SzPtrUtf8R(nullptr), [&]()
+                {
+                    if (pWidget)
+                        bIsCancelled = pWidget->isCancelled();
+                    return bIsCancelled;
+                });
+        });
+    m_spView->invalidateSortFilterProxyModel();
+    if (bIsCancelled)
+        QTimer::singleShot(0, m_spView.data(), &CsvTableView::redo); // Redoing so that cancelled undo is as if not having undoed at all, see CsvTableViewActionFill::undo()
+}
+
+void CsvTableViewActionReplace::redo()
+{
+    auto pModel = (m_spView) ? m_spView->csvModel() : nullptr;
+    if (!pModel || m_nCellCount == 0)
+        return;
+    // All edits are done with a single batch edit instead of editing cells one by one.
+    bool bIsCancelled = false;
+    m_spView->doModalOperation(m_spView->tr("Replace in progress..."), ProgressWidget::IsCancellable::yes, "redo_action_replace", [&](ProgressWidget* pWidget)
+        {
+            DFG_DETAIL_NS::restoreCells(m_cellMemoryRedo, *pModel, SzPtrUtf8R(nullptr), [&]()
+                {
+                    if (pWidget)
+                        bIsCancelled = pWidget->isCancelled();
+                    return bIsCancelled;
+                });
+        });
+    m_spView->invalidateSortFilterProxyModel();
+    if (bIsCancelled)
+        QTimer::singleShot(0, m_spView.data(), &CsvTableView::undo); // See CsvTableViewActionFill::redo()
+}
+
 ////////////////////////////////////////////////////////////////////////////
 ///
 /// CsvTableViewActionEvaluateSelectionAsFormula
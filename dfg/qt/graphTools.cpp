@@ -25,6 +25,8 @@
 
 #include "../time/timerCpu.hpp"
 
+#include "../concurrency/ThreadList.hpp"
+
 #include "../io.hpp"
 #include "../io/BasicImStream.hpp"
 #include "../io/DelimitedTextReader.hpp"
@@ -38,6 +40,8 @@
 #include "detail/GraphDefinitionWidget.hpp"
 
 #include <atomic>
+#include <map>
+#include <mutex>
 #include <regex>
 
 DFG_BEGIN_INCLUDE_QT_HEADERS
@@ -72,9 +76,11 @@ DFG_END_INCLUDE_QT_HEADERS
 // 2023-01: Notes about caching (using single column xy-graph as an example):
 //      1. DataSource itself can cache data (e.g. CsvTableViewChartDataSource)
 //      2. TableSelectionCacheItem may cache (row, column)-storages for every column
-//      3. prepareDataForXy: releaseOrCopy() either copies storage of TableSelectionCacheItem or gets them by move.
+//      3. prepareDataForXy: reads columns of TableSelectionCacheItem through reference-counted views and writes (x, y) pairs to new storage.
+//         -When entry has incremental operations, XyPreparationHistory of ChartDataPreparator additionally keeps a copy of (x, y) and of the
+//          operation output so that next refresh needs to apply operations only around changed rows.
 //      4. refreshXy: setValues() copies datas to (QCustomPlot) storage
-//          -If data was copied in part 3, it gets destroyed as temporary.
+//          -Storage created in part 3 gets destroyed as temporary.
 // 
 // So by the time data gets shown in graph:
 //      -Worst case
@@ -82,16 +88,23 @@ DFG_END_INCLUDE_QT_HEADERS
 //          -In temporary peak usage, in 4 places (in addition to ones mentioned above, also the temporary storage created in step 3)
 //      -Best case:
 //          -Only in graph object
-//          -In temporary peak usage in 2 place (extra usage from temporary storage in step 3).
-//          -This case can occur e.g. in NumberGeneratorDataSource, which has no cache in itself and step 3 can use storage in step 2.
+//          -In temporary peak usage in 2 places: during step 3 the columns in step 2 (kept alive by views) and the new (x, y) storage,
+//           during step 4 storage from step 3 and graph object.
+//          -This case can occur e.g. in NumberGeneratorDataSource, which has no cache in itself and whose columns are efficientlyFetchable()
+//           so they are dropped from TableSelectionCacheItem once the entry has taken views to them.
+//          -Note: step 3 never filters cached columns in place, not even efficiently fetchable ones, so peak usage includes a full x/y copy
+//           on top of the cached columns. This is what allows entries to share columns and be prepared concurrently.
 //      -Typical:
 //          -Data is in 2 places: sourceCache/TableSelectionCacheItem and graph object.
 //              -Compared to worst case, reasonable data source is expected to set metadata efficientlyFetchable() == true so that there won't be overlapping
 //               cache both in data source and TableSelectionCacheItem.
-//          -In temporary peak usage in 3 places (extra usage from temporary storage in step 3.
+//          -In temporary peak usage in 3 places (extra usage from temporary storage in step 3).
 // 
 // Can duplicate caching or temporary storages be improved?
-//      -More intelligent releaseOrCopy() could avoid some temporary peaks, but it's hard to know if cached data could be reused.
+//      -Columns are shared between all entries using the same source (and snapshot) so e.g. multiple entries using the same x-column
+//       don't each store a copy of it. Columns marked efficientlyFetchable() are dropped from cache after use.
+//      -The extra x/y copy in step 3 could be avoided for efficiently fetchable columns by filtering in place when the entry holds
+//       the only view to the column, but that would need mutable access through views and is not done.
 //      -Getting rid of the temporary storage would benefit all cases, but data type differences are on the way:
 //          -QCustomPlot uses storage QVector<QCPGraphData> that is layout-wise essentially QVector<std::pair<double, double>>.
 //           In order to be able to move the temporary data in step 3 to xy-graph object directly, classes like dfg::charts::XySeries 
@@ -502,21 +515,33 @@ DataSourceChangedParam DataSourceChangedParam::fromInvalidColumnRange(DataSource
     return param;
 }
 
+DataSourceChangedParam DataSourceChangedParam::fromInvalidCellRange(DataSourceIndex nLeft, DataSourceIndex nRight, DataSourceIndex nTop, DataSourceIndex nBottom)
+{
+    auto param = fromInvalidColumnRange(nLeft, nRight);
+    param.m_nFirstInvalidRow = nTop;
+    param.m_nLastInvalidRow = nBottom;
+    return param;
+}
+
+// Signal param format is "<first column>,<last column>" optionally followed by ",<first row>,<last row>"
 DataSourceChangedParam DataSourceChangedParam::fromSignalParam(const SignalParamT& sigParam)
 {
     DataSourceChangedParam param;
     const auto parts = sigParam.split(",");
-    if (parts.size() == 2)
+    if (parts.size() == 2 || parts.size() == 4)
     {
-        bool bOk1 = false;
-        bool bOk2 = false;
-        const auto nLeft = parts[0].toInt(&bOk1);
-        const auto nRight = parts[1].toInt(&bOk2);
-        if (bOk1 && bOk2)
+        DataSourceIndex vals[4] = { 1, 0, 1, 0 };
+        for (int i = 0; i < parts.size(); ++i)
         {
-            param.m_nFirstInvalidColumn = nLeft;
-            param.m_nLastInvalidColumn = nRight;
+            bool bOk = false;
+            vals[i] = static_cast<DataSourceIndex>(parts[i].toULongLong(&bOk));
+            if (!bOk)
+                return DataSourceChangedParam();
         }
+        param.m_nFirstInvalidColumn = vals[0];
+        param.m_nLastInvalidColumn = vals[1];
+        param.m_nFirstInvalidRow = vals[2];
+        param.m_nLastInvalidRow = vals[3];
     }
     return param;
 }
@@ -529,9 +554,40 @@ auto DataSourceChangedParam::getInvalidatedColumnRange() const ->std::optional<s
         return std::nullopt;
 }
 
+auto DataSourceChangedParam::getInvalidatedRowRange() const ->std::optional<std::pair<DataSourceIndex, DataSourceIndex>>
+{
+    if (getInvalidatedColumnRange() && this->m_nFirstInvalidRow <= this->m_nLastInvalidRow)
+        return std::make_pair(this->m_nFirstInvalidRow, this->m_nLastInvalidRow);
+    else
+        return std::nullopt;
+}
+
+void DataSourceChangedParam::unite(const DataSourceChangedParam& other)
+{
+    const auto colRange = getInvalidatedColumnRange();
+    const auto otherColRange = other.getInvalidatedColumnRange();
+    if (!colRange || !otherColRange) // If either one is an unspecified change, result is unspecified change.
+    {
+        *this = DataSourceChangedParam();
+        return;
+    }
+    const auto rowRange = getInvalidatedRowRange();
+    const auto otherRowRange = other.getInvalidatedRowRange();
+    *this = fromInvalidColumnRange((std::min)(colRange->first, otherColRange->first), (std::max)(colRange->second, otherColRange->second));
+    if (rowRange && otherRowRange)
+    {
+        this->m_nFirstInvalidRow = (std::min)(rowRange->first, otherRowRange->first);
+        this->m_nLastInvalidRow = (std::max)(rowRange->second, otherRowRange->second);
+    }
+}
+
 auto DataSourceChangedParam::toSignalParam() const -> SignalParamT
 {
-    return QString("%1,%2").arg(this->m_nFirstInvalidColumn).arg(this->m_nLastInvalidColumn);
+    const auto rowRange = getInvalidatedRowRange();
+    if (rowRange)
+        return QString("%1,%2,%3,%4").arg(this->m_nFirstInvalidColumn).arg(this->m_nLastInvalidColumn).arg(rowRange->first).arg(rowRange->second);
+    else
+        return QString("%1,%2").arg(this->m_nFirstInvalidColumn).arg(this->m_nLastInvalidColumn);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -689,6 +745,12 @@ public:
 
     void applyOperations(::DFG_MODULE_NS(charts)::ChartOperationPipeData& pipeData) const;
 
+    // Returns operations of this entry in application order with thread count hint set.
+    ::DFG_MODULE_NS(charts)::ChartEntryOperationList operationList() const;
+
+    // Sets thread count hint given to operations in applyOperations(), see ChartEntryOperation::setThreadCountHint().
+    void setOperationThreadCountHint(size_t nThreadCount) { m_nOperationThreadCountHint = nThreadCount; }
+
     static QString tr(const char* psz);
 
     // Implements logging of notifications related to 'this' entry.
@@ -710,6 +772,7 @@ private:
     int m_nContainerIndex = -1;
     QJsonDocument m_items;
     ::DFG_MODULE_NS(cont)::MapVectorSoA<StringUtf8, Operation> m_operationMap;
+    size_t m_nOperationThreadCountHint = 0;
 }; // class GraphDefinitionEntry
 
 auto GraphDefinitionEntry::fromText(const QString& sJson, const int nIndex) -> GraphDefinitionEntry
@@ -842,6 +905,7 @@ void GraphDefinitionEntry::applyOperations(::DFG_MODULE_NS(charts)::ChartOperati
     for (const auto& kv : this->m_operationMap)
     {
         auto opCopy = kv.second;
+        opCopy.setThreadCountHint(m_nOperationThreadCountHint);
         if (isLoggingAllowedForLevel(LogLevel::debug))
             log(LogLevel::debug, tr("Running operation %1: %2").arg(viewToQString(kv.first), viewToQString(opCopy.m_sDefinition)));
         opCopy(pipeData);
@@ -853,6 +917,18 @@ void GraphDefinitionEntry::applyOperations(::DFG_MODULE_NS(charts)::ChartOperati
     }
 }
 
+auto GraphDefinitionEntry::operationList() const -> ::DFG_MODULE_NS(charts)::ChartEntryOperationList
+{
+    ::DFG_MODULE_NS(charts)::ChartEntryOperationList operations;
+    operations.reserve(this->m_operationMap.size());
+    for (const auto& kv : this->m_operationMap)
+    {
+        operations.push_back(kv.second);
+        operations.back().setThreadCountHint(m_nOperationThreadCountHint);
+    }
+    return operations;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //
@@ -870,8 +946,12 @@ public:
     using ValueVectorD        = ::DFG_MODULE_NS(charts)::ValueVectorD;
     using RowToValueMap       = ::DFG_MODULE_NS(cont)::MapVectorSoA<double, double, ValueVectorD, ValueVectorD>;
     using RowToStringMap      = ::DFG_MODULE_NS(cont)::MapVectorSoA<double, StringT, ValueVectorD>;
-    using ColumnToValuesMap   = ::DFG_MODULE_NS(cont)::MapVectorSoA<IndexT, RowToValueMap>; // Note: with this implementation, the same rows can often get cached multiple times.
-    using ColumnToStringsMap  = ::DFG_MODULE_NS(cont)::MapVectorSoA<IndexT, RowToStringMap>;
+    // Column datas are reference-counted so that users can hold views to them regardless of what happens to the cache item afterwards
+    // (e.g. column gets invalidated or cache item recreated due to changed source).
+    using RowToValueMapView   = std::shared_ptr<const RowToValueMap>;
+    using RowToStringMapView  = std::shared_ptr<const RowToStringMap>;
+    using ColumnToValuesMap   = ::DFG_MODULE_NS(cont)::MapVectorSoA<IndexT, std::shared_ptr<RowToValueMap>>;
+    using ColumnToStringsMap  = ::DFG_MODULE_NS(cont)::MapVectorSoA<IndexT, std::shared_ptr<RowToStringMap>>;
     using DataPipeForTableCache = GraphDataSourceDataPipe_MapVectorSoADoubleValueVector;
 
     std::vector<std::reference_wrapper<const RowToValueMap>> columnDatas() const;
@@ -879,6 +959,9 @@ public:
     const RowToValueMap* columnDataByIndex(IndexT nColumnIndex);
     const RowToStringMap* columnStringsByIndex(IndexT nColumnIndex);
 
+    RowToValueMapView columnDataViewByIndex(IndexT nColumnIndex);
+    RowToStringMapView columnStringsViewByIndex(IndexT nColumnIndex);
+
     IndexT columnCount() const;
 
     IndexT firstColumnIndex() const; // GraphDataSource::invalidIndex() if not defined
@@ -888,7 +971,12 @@ public:
 
     bool isValid() const { return m_bIsValid; }
 
-    RowToValueMap releaseOrCopy(const RowToValueMap* pId);
+    // Returns true if cached columns may be from given source snapshot, false if they are known to be from some other snapshot.
+    bool isCompatibleWithSnapshot(const std::optional<GraphDataSourceSnapshotId>& snapshotId) const { return !m_sourceSnapshotId.has_value() || m_sourceSnapshotId == snapshotId; }
+
+    // If source has informed that column is efficiently fetchable, removes it from cache: for such columns cache item acts merely
+    // as a proxy interface for querying the data and memory gets released once the last view to it is gone.
+    void removeColumnIfEfficientlyFetchable(IndexT nColumnIndex);
 
     bool hasColumnIndex(const IndexT nCol) const;
 
@@ -923,13 +1011,14 @@ public:
     GraphDataSource::ColumnMetaDataMap m_columnMetaDatas;
     bool m_bIsValid = false;
     QPointer<GraphDataSource> m_spSource;
+    std::optional<GraphDataSourceSnapshotId> m_sourceSnapshotId; // Snapshot ID of source when cached columns were fetched, if source provides snapshot ID's.
 }; // TableSelectionCacheItem
 
 auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnDatas() const -> std::vector<std::reference_wrapper<const RowToValueMap>>
 {
     std::vector<std::reference_wrapper<const RowToValueMap>> datas;
     for (const auto& d : m_colToValuesMap)
-        datas.push_back(d.second);
+        datas.push_back(*d.second);
     return datas;
 }
 
@@ -946,13 +1035,25 @@ auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnRange() const -> decltype
 auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnDataByIndex(IndexT nColumnIndex) -> const RowToValueMap*
 {
     auto iter = m_colToValuesMap.find(nColumnIndex);
-    return (iter != m_colToValuesMap.end()) ? &iter->second : nullptr;
+    return (iter != m_colToValuesMap.end()) ? iter->second.get() : nullptr;
 }
 
 auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnStringsByIndex(IndexT nColumnIndex) -> const RowToStringMap*
 {
     auto iter = m_colToStringsMap.find(nColumnIndex);
-    return (iter != m_colToStringsMap.end()) ? &iter->second : nullptr;
+    return (iter != m_colToStringsMap.end()) ? iter->second.get() : nullptr;
+}
+
+auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnDataViewByIndex(IndexT nColumnIndex) -> RowToValueMapView
+{
+    auto iter = m_colToValuesMap.find(nColumnIndex);
+    return (iter != m_colToValuesMap.end()) ? iter->second : nullptr;
+}
+
+auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnStringsViewByIndex(IndexT nColumnIndex) -> RowToStringMapView
+{
+    auto iter = m_colToStringsMap.find(nColumnIndex);
+    return (iter != m_colToStringsMap.end()) ? iter->second : nullptr;
 }
 
 auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::firstColumnIndex() const -> IndexT
@@ -983,6 +1084,9 @@ void DFG_MODULE_NS(qt)::TableSelectionCacheItem::onDataSourceChanged(DataSourceC
             this->m_colToValuesMap.erase(i);
             this->m_columnMetaDatas.erase(i);
         }
+        // Remaining columns are unaffected by the change so they are valid also in the new snapshot of the source.
+        if (m_sourceSnapshotId.has_value() && m_spSource)
+            m_sourceSnapshotId = m_spSource->snapshotId();
     }
     else // Case: unknown changes happened to source, marking whole cache invalid so that it gets recreated.
         this->m_bIsValid = false;
@@ -1047,18 +1151,24 @@ bool DFG_MODULE_NS(qt)::TableSelectionCacheItem::storeColumnFromSourceImpl(Map_T
         DFG_QT_CHART_CONSOLE_WARNING(tr("Internal error: cache item source changed, was '%1', now using '%2'").arg(m_spSource->uniqueId(), source.uniqueId()));
         m_spSource->disconnect(this); // Disconnects signals from old source to 'this'
         mapIndexToStorage.clear();
+        m_sourceSnapshotId.reset();
     }
     if (m_spSource != &source)
     {
         m_spSource = &source;
         DFG_QT_VERIFY_CONNECT(QObject::connect(&source, &GraphDataSource::sigChanged, this, &TableSelectionCacheItem::onDataSourceChanged));
     }
+    // Note: snapshot ID is read before fetching so if source changes during the fetch, ID is older than data and cache item simply gets recreated on next use.
+    if (!m_sourceSnapshotId.has_value())
+        m_sourceSnapshotId = source.snapshotId();
+    using ColumnStorage = typename Map_T::mapped_type::element_type;
     auto insertRv = mapIndexToStorage.insert(nColumn, typename Map_T::mapped_type());
-    if (!insertRv.second)
+    if (!insertRv.second && insertRv.first->second)
         return true; // Column was already present; since currently caching stores whole column, it should already have everything ready so nothing left to do.
 
-    insertRv.first->second.setSorting(false); // Disabling sorting while adding
-    auto& destValues = insertRv.first->second;
+    insertRv.first->second = std::make_shared<ColumnStorage>();
+    auto& destValues = *insertRv.first->second;
+    destValues.setSorting(false); // Disabling sorting while adding
     std::optional<ColumnMetaData> columnMetaData;
     const auto bDirectFetchDone = DFG_DETAIL_NS::handleStoreColumnDirectFetch(*this, destValues, source, nColumn, queryDetails);
     if (!bDirectFetchDone)
@@ -1133,38 +1243,20 @@ bool DFG_MODULE_NS(qt)::TableSelectionCacheItem::storeColumnFromSource_strings(G
     return storeColumnFromSourceImpl(m_colToStringsMap, source, nColumn, DataQueryDetails(DataQueryDetails::DataMaskRowsAndStrings), inserter);
 }
 
-auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::releaseOrCopy(const RowToValueMap* pId) -> RowToValueMap
+void DFG_MODULE_NS(qt)::TableSelectionCacheItem::removeColumnIfEfficientlyFetchable(const IndexT nColumnIndex)
 {
-    auto iter = std::find_if(m_colToValuesMap.begin(), m_colToValuesMap.end(), [=](const auto& v)
-    {
-        return &v.second == pId;
-    });
-    if (iter != m_colToValuesMap.end())
-    {
-        const auto iterMetaData = this->m_columnMetaDatas.find(iter->first);
-        if (iterMetaData != this->m_columnMetaDatas.end() && iterMetaData->second.efficientlyFetchable())
-        {
-            // If source has informed that column is efficiently fetchable (e.g. cheap to regenerate or cached already in source), always releasing the content.
-            // This effetively means that TableSelectionCacheItem does not cache this column and acts merely as a proxy interface for querying the data.
-            this->m_bIsValid = false; // Data gets moved out so marking this cache item invalid.
-            return std::move(iter->second);
-        }
-        else 
-        {
-            // Copying data: even if it was known that no one would use this cache entry in some particular update round,
-            //               if it was released, some future chart entry might use this and after release would need to requery the data.
-            return iter->second;
-        }
-    }
-    else
-        return RowToValueMap();
+    // Note: other columns are kept as even if it was known that no one would use them in some particular update round,
+    //       some future chart entry might use them and after removal would need to requery the data.
+    const auto iterMetaData = this->m_columnMetaDatas.find(nColumnIndex);
+    if (iterMetaData != this->m_columnMetaDatas.end() && iterMetaData->second.efficientlyFetchable())
+        this->m_colToValuesMap.erase(nColumnIndex);
 }
 
 auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnToIndex(const RowToValueMap* pColumn) const -> IndexT
 {
     auto iter = std::find_if(m_colToValuesMap.begin(), m_colToValuesMap.end(), [=](const auto& v)
     {
-        return &v.second == pColumn;
+        return v.second.get() == pColumn;
     });
     return (iter != m_colToValuesMap.end()) ? iter->first : GraphDataSource::invalidIndex();
 }
@@ -1193,8 +1285,9 @@ auto DFG_MODULE_NS(qt)::TableSelectionCacheItem::columnName(const DataSourceInde
 
 bool DFG_MODULE_NS(qt)::TableSelectionCacheItem::isVolatileCache() const
 {
+    // Cache is not volatile if source either signals changes or provides snapshot ID's with which stale columns get detected.
     auto pSource = m_spSource.data();
-    return (!pSource || !pSource->hasChangeSignaling());
+    return (!pSource || (!pSource->hasChangeSignaling() && !m_sourceSnapshotId.has_value()));
 }
 
 void DFG_MODULE_NS(qt)::TableSelectionCacheItem::storeMetaData(const DataSourceIndex nColumn, const std::optional<ColumnMetaData>& metaData)
@@ -1227,6 +1320,12 @@ void DFG_MODULE_NS(qt)::TableSelectionCacheItem::storeMetaData(const DataSourceI
  *              -Two xySeries with only difference being panel in which they are drawn shall have identical cacheKey so they can be constructed from the same cache-data.
  *              -Two xySeries otherwise identical, but other has x_rows-filter
  *                  -This is implementation dependent: if caching stores the whole column in any case, then cacheKey can be identical, otherwise not.
+ *      c. Within cache item, column data is stored per column index and is reference-counted:
+ *          -Entries hold views (shared pointers) to column data so e.g. ten xySeries using the same x-column share a single copy of it.
+ *          -Columns are stored unfiltered so row filters (e.g. x_rows) are applied by entries when reading from views.
+ *          -Cache item is effectively keyed by (source, snapshot ID): if source provides snapshot ID's, cache item is recreated when ID has changed since columns were fetched.
+ *      d. Fetching into a cache item (which queries the source) is serialized per cacheKey with lockCacheItemForFetch(), after which
+ *         entries filter and process their views concurrently.
  */
 class ChartDataCache
 {
@@ -1278,22 +1377,60 @@ public:
      */
     TableSelectionOptional getTableSelectionData_createIfMissing(GraphDataSource& source, const GraphDefinitionEntry& defEntry);
 
+    // Returns lock that serializes fetching into cache item of (source, defEntry): while holding it, caller may fetch columns and take views to them.
+    // Views can be used without the lock so entries sharing a cache item fetch one at a time but process their data concurrently.
+    std::unique_lock<std::mutex> lockCacheItemForFetch(const GraphDataSource& source, const AbstractChartControlItem& defEntry);
+
+    // Sets thread to which new cache items are moved, nullptr means that items stay in creating thread.
+    // Used when cache is accessed from short-lived worker threads: cache items are QObjects and must live in a thread that has an event loop.
+    void setCacheItemThread(QThread* pThread);
+
 private:
     // Helper function to get cache item for (source, defEntry), new cache item is created if missing or invalid.
+    // Can be called concurrently as long as callers hold lock from lockCacheItemForFetch().
     CacheItemKeyValuePair& getCacheItemKeyValuePair_createIfMissing(const GraphDataSource& source, const GraphDefinitionEntry& defEntry);
 
 public:
     CacheKeyToTableSelectionaMap m_tableSelectionDatas;
+    QPointer<QThread> m_spCacheItemThread;
+    std::mutex m_mutexTableSelectionDatas; // Guards structure of m_tableSelectionDatas and m_fetchMutexes while data is being prepared concurrently.
+    std::map<CacheEntryKey, std::unique_ptr<std::mutex>> m_fetchMutexes;
 }; // ChartDataCache
 
+auto DFG_MODULE_NS(qt)::ChartDataCache::lockCacheItemForFetch(const GraphDataSource& source, const AbstractChartControlItem& defEntry) -> std::unique_lock<std::mutex>
+{
+    std::mutex* pFetchMutex = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutexTableSelectionDatas);
+        auto& spMutex = m_fetchMutexes[cacheKey(source, defEntry)];
+        if (!spMutex)
+            spMutex = std::make_unique<std::mutex>();
+        pFetchMutex = spMutex.get();
+    }
+    return std::unique_lock<std::mutex>(*pFetchMutex);
+}
+
+void DFG_MODULE_NS(qt)::ChartDataCache::setCacheItemThread(QThread* pThread)
+{
+    m_spCacheItemThread = pThread;
+}
+
 auto DFG_MODULE_NS(qt)::ChartDataCache::getCacheItemKeyValuePair_createIfMissing(const GraphDataSource& source, const GraphDefinitionEntry& defEntry) -> CacheItemKeyValuePair&
 {
+    const auto createCacheItem = [&]()
+    {
+        auto spItem = std::make_unique<TableSelectionCacheItem>();
+        if (m_spCacheItemThread && m_spCacheItemThread != QThread::currentThread())
+            spItem->moveToThread(m_spCacheItemThread); // Note: moving from current thread to another is allowed, i.e. this can be called from worker threads.
+        return spItem;
+    };
     auto key = this->cacheKey(source, defEntry);
+    std::lock_guard<std::mutex> lock(m_mutexTableSelectionDatas);
     auto iter = m_tableSelectionDatas.find(key);
     if (iter == m_tableSelectionDatas.end())
-        iter = m_tableSelectionDatas.insert(std::make_pair(key, std::make_unique<TableSelectionCacheItem>())).first;
-    else if (iter->second && !iter->second->isValid())
-        iter->second = std::make_unique<TableSelectionCacheItem>(); // Cache item existed, but was invalid -> creating a new one.
+        iter = m_tableSelectionDatas.insert(std::make_pair(key, createCacheItem())).first;
+    else if (iter->second && (!iter->second->isValid() || !iter->second->isCompatibleWithSnapshot(source.snapshotId())))
+        iter->second = createCacheItem(); // Cache item existed, but was invalid or from older source snapshot -> creating a new one. Views to old columns remain valid.
     return *iter;
 }
 
@@ -1407,7 +1544,7 @@ void DFG_MODULE_NS(qt)::ChartDataCache::removeInvalidCaches()
     ::DFG_MODULE_NS(cont)::eraseIf(m_tableSelectionDatas, [](decltype(*m_tableSelectionDatas.begin())& pairItem)
     {
         auto& opt = pairItem.second;
-        return !opt || opt->isVolatileCache() || !opt->isValid();
+        return !opt || opt->isVolatileCache() || !opt->isValid() || (opt->m_spSource && !opt->isCompatibleWithSnapshot(opt->m_spSource->snapshotId()));
     });
 }
 
@@ -1868,6 +2005,28 @@ public:
     bool m_bYisRowIndex = false;
 }; // class ChartData
 
+// Stores input and output of the latest xy-preparation of an entry so that the next preparation can recompute only the rows
+// near changed input, see ChartEntryOperationList::updateOutputIncrementally().
+class DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::XyPreparationHistory
+{
+public:
+    using ValueVectorD = ::DFG_MODULE_NS(charts)::ValueVectorD;
+
+    void clear()
+    {
+        m_bValid = false;
+        m_inputX = ValueVectorD();
+        m_inputY = ValueVectorD();
+        m_output = ChartData();
+    }
+
+    std::mutex m_mutex; // Guards this object if there are multiple identical entries prepared concurrently.
+    bool m_bValid = false;
+    ValueVectorD m_inputX; // (x, y) before operations.
+    ValueVectorD m_inputY;
+    ChartData m_output; // Result of operations for (m_inputX, m_inputY).
+}; // class XyPreparationHistory
+
 // ChartRefreshParam
 DFG_OPAQUE_PTR_DEFINE(DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::ChartRefreshParam)
 {
@@ -1884,6 +2043,8 @@ public:
 DFG_OPAQUE_PTR_DEFINE(DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::ChartDataPreparator)
 {
     std::atomic_bool m_terminateFlag;
+    // Preparation history of xy-entries keyed by source id and entry definition; entries not present in latest preparation are dropped.
+    std::map<QString, std::shared_ptr<GraphControlAndDisplayWidget::XyPreparationHistory>> m_xyHistory;
 };
 
 ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::ChartDataPreparator::ChartDataPreparator() = default;
@@ -1893,31 +2054,123 @@ void ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::ChartDataPreparator::pre
 {
     // This is the place where chart data is prepared (generated) for sources that allow
     // generation from worker thread.
-    DFG_OPAQUE_REF().m_terminateFlag = false;
+    // Entries are prepared concurrently: entries using the same cache item (i.e. same source) fetch into it one at a time
+    // (see ChartDataCache::lockCacheItemForFetch()), but filtering, operations and binning of every entry run in parallel.
+    auto& terminateFlag = DFG_OPAQUE_REF().m_terminateFlag;
+    terminateFlag = false;
     if (spParam)
     {
         const auto& chartDefinition = spParam->chartDefinition();
         const auto pCurrentThread = QThread::currentThread();
         const auto totalForEachCount = saturateCast<int>(chartDefinition.getForEachEntryCount());
-        int progressCounter = 0;
+        std::atomic_int progressCounter{ 0 };
+        const auto onEntryHandled = [&]()
+        {
+            const auto nReadyCount = ++progressCounter;
+            Q_EMIT sigOnEntryPrepared(EntryPreparedParam(nReadyCount, totalForEachCount));
+        };
+
+        struct EntryTask
+        {
+            GraphDataSource* m_pSource = nullptr;
+            GraphDefinitionEntry m_entry;
+            std::shared_ptr<XyPreparationHistory> m_spHistory;
+        };
+        std::vector<EntryTask> tasks;
+        auto& xyHistory = DFG_OPAQUE_REF().m_xyHistory;
+        decltype(DFG_OPAQUE_REF().m_xyHistory) newXyHistory;
+
+        // Resolving sources. On-demand sources are created here as it modifies source container.
+        auto& spCache = spParam->cache();
+        if (!spCache)
+            spCache.reset(new ChartDataCache);
+        auto& sources = spParam->dataSources();
         chartDefinition.forEachEntry([&](const GraphDefinitionEntry& entry)
         {
-            if (DFG_OPAQUE_REF().m_terminateFlag)
-                return;
+            GraphDataSource* pSource = nullptr;
             if (entry.isEnabled())
             {
-                auto& sources = spParam->dataSources();
                 const auto sSourceId = entry.sourceId(chartDefinition.m_defaultSourceId);
                 auto iterSource = sources.findById(sSourceId);
                 if (iterSource == sources.end())
                     iterSource = tryCreateOnDemandDataSource(sSourceId, sources);
                 if (iterSource != sources.end() && sources.iterToRef(iterSource).isSafeToQueryDataFromThread(pCurrentThread))
-                    spParam->storePreparedData(entry, GraphControlAndDisplayWidget::prepareData(spParam->cache(), sources.iterToRef(iterSource), entry));
+                    pSource = &sources.iterToRef(iterSource);
+            }
+            if (!pSource)
+            {
+                onEntryHandled();
+                return;
+            }
+            tasks.push_back(EntryTask());
+            tasks.back().m_pSource = pSource;
+            tasks.back().m_entry = entry;
+            if (entry.isType(ChartObjectChartTypeStr_xy) || entry.isType(ChartObjectChartTypeStr_txy))
+            {
+                const auto sKey = sSourceId + QChar('\n') + entry.toText();
+                auto& spHistory = newXyHistory[sKey];
+                if (!spHistory)
+                {
+                    auto iterOld = xyHistory.find(sKey);
+                    spHistory = (iterOld != xyHistory.end()) ? std::move(iterOld->second) : std::make_shared<XyPreparationHistory>();
+                }
+                tasks.back().m_spHistory = spHistory;
             }
-            ++progressCounter;
-            Q_EMIT sigOnEntryPrepared(EntryPreparedParam(progressCounter, totalForEachCount));
         });
-        if (DFG_OPAQUE_REF().m_terminateFlag)
+        xyHistory = std::move(newXyHistory);
+
+        // When entries are prepared in a thread pool, operations are limited to one thread each so that
+        // e.g. smoothing doesn't start hardware_concurrency() threads from every worker.
+        const auto nThreadCount = (std::min)(tasks.size(), static_cast<size_t>((std::max)(1u, std::thread::hardware_concurrency())));
+        if (nThreadCount > 1)
+        {
+            for (auto& task : tasks)
+                task.m_entry.setOperationThreadCountHint(1);
+        }
+
+        std::mutex mutexPreparedData;
+        const auto prepareTask = [&](const EntryTask& task)
+        {
+            if (terminateFlag)
+                return;
+            auto chartData = GraphControlAndDisplayWidget::prepareData(spCache, *task.m_pSource, task.m_entry, task.m_spHistory.get());
+            {
+                std::lock_guard<std::mutex> lock(mutexPreparedData);
+                spParam->storePreparedData(task.m_entry, std::move(chartData));
+            }
+            onEntryHandled();
+        };
+
+        // Preparing entries in thread pool, calling thread takes part as well. Entries whose source can't be queried from worker thread are left for calling thread.
+        std::atomic<size_t> nNextTask{ 0 };
+        std::vector<size_t> deferredTasks;
+        std::mutex mutexDeferredTasks;
+        const auto worker = [&]()
+        {
+            const auto pWorkerThread = QThread::currentThread();
+            for (size_t i = nNextTask++; i < tasks.size(); i = nNextTask++)
+            {
+                if (pWorkerThread != pCurrentThread && !tasks[i].m_pSource->isSafeToQueryDataFromThread(pWorkerThread))
+                {
+                    std::lock_guard<std::mutex> lock(mutexDeferredTasks);
+                    deferredTasks.push_back(i);
+                    continue;
+                }
+                prepareTask(tasks[i]);
+            }
+        };
+        spCache->setCacheItemThread(pCurrentThread);
+        {
+            ::DFG_MODULE_NS(concurrency)::ThreadList threads;
+            for (size_t i = 1; i < nThreadCount; ++i)
+                threads.push_back(std::thread(worker));
+            worker();
+        } // Threads are joined here.
+        for (const auto i : deferredTasks)
+            prepareTask(tasks[i]);
+        spCache->setCacheItemThread(nullptr);
+
+        if (terminateFlag)
             spParam->setTerminatedFlag(true);
     }
     Q_EMIT sigPreparationFinished(std::move(spParam));
@@ -2592,14 +2845,14 @@ DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(qt) { namespace
 } } } // dfg:::qt::<unnamed>
 
 
-auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareData(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry) -> ChartData
+auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareData(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry, XyPreparationHistory* pHistory) -> ChartData
 {
     const auto sEntryType = defEntry.graphTypeStr();
     // Note: this duplicates type selection logic from onChartDataPreparationReady()
     try
     {
         if (sEntryType == ChartObjectChartTypeStr_xy || sEntryType == ChartObjectChartTypeStr_txy || sEntryType == ChartObjectChartTypeStr_txys)
-            return prepareDataForXy(spCache, source, defEntry);
+            return prepareDataForXy(spCache, source, defEntry, pHistory);
         else if (sEntryType == ChartObjectChartTypeStr_histogram)
             return prepareDataForHistogram(spCache, source, defEntry);
         else if (sEntryType == ChartObjectChartTypeStr_bars)
@@ -2616,12 +2869,14 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareData(std::shared_pt
     }
 }
 
-auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry) -> ChartData
+auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry, XyPreparationHistory* pHistory) -> ChartData
 {
     using namespace ::DFG_MODULE_NS(charts);
     if (!spCache)
         spCache.reset(new ChartDataCache);
 
+    auto fetchLock = spCache->lockCacheItemForFetch(source, defEntry);
+
     std::array<DataSourceIndex, 3> columnIndexes;
     std::array<bool, 3> rowFlags;
     auto optData = spCache->getTableSelectionData_createIfMissing(source, defEntry, columnIndexes, rowFlags);
@@ -2637,21 +2892,41 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shar
     const bool bYisRowIndex = rowFlags[1];
     const bool bZisRowIndex = rowFlags[2];
 
-    auto pXdata = tableData.columnDataByIndex(columnIndexes[0]);
-    auto pYdata = tableData.columnDataByIndex(columnIndexes[1]);
-    auto pZdata = (bNeedMetaStrings) ? tableData.columnStringsByIndex(columnIndexes[2]) : nullptr;
+    // Cached columns are shared with other entries using the same source and are only read here through views.
+    const auto spXdata = tableData.columnDataViewByIndex(columnIndexes[0]);
+    const auto spYdata = tableData.columnDataViewByIndex(columnIndexes[1]);
+    const auto spZdata = (bNeedMetaStrings) ? tableData.columnStringsViewByIndex(columnIndexes[2]) : nullptr;
+    const auto pZdata = spZdata.get();
 
-    if (!pXdata || !pYdata || (bNeedMetaStrings && !pZdata && !bZisRowIndex))
+    if (!spXdata || !spYdata || (bNeedMetaStrings && !pZdata && !bZisRowIndex))
         return ChartData();
 
+    ChartData rv;
+    rv.m_bXisRowIndex = bXisRowIndex;
+    rv.m_bYisRowIndex = bYisRowIndex;
+    rv.m_columnDataTypes.push_back(tableData.columnDataType(columnIndexes[0]));
+    rv.m_columnDataTypes.push_back(tableData.columnDataType(columnIndexes[1]));
+    rv.m_columnDataTypes.push_back(ChartDataType::unknown);
+    rv.m_columnNames.push_back(tableData.columnName(columnIndexes[0]));
+    rv.m_columnNames.push_back(tableData.columnName(columnIndexes[1]));
+    rv.m_columnNames.push_back(bZisRowIndex ? tr("<row index>") : tableData.columnName(columnIndexes[2]));
+
+    // Views keep column data alive so columns can be dropped from cache already here.
+    tableData.removeColumnIfEfficientlyFetchable(columnIndexes[0]);
+    tableData.removeColumnIfEfficientlyFetchable(columnIndexes[1]);
+    fetchLock.unlock(); // Rest uses only views and entry's own data so it can run concurrently with other entries of the same cache item.
+
     DFG_MODULE_NS(func)::MemFuncMinMax<double> minMaxX;
     DFG_MODULE_NS(func)::MemFuncMinMax<double> minMaxY;
 
-    // xValueMap is also used as final (x,y) table passed to series.
-    // releaseOrCopy() will return either moved data or copy of it.
-    // Note: if pXdata == pYdata, possible releasing of pXdata affects yData as well.
-    auto xValueMap = tableData.releaseOrCopy(pXdata);
-    xValueMap.setSorting(false);
+    const auto& xValueMap = *spXdata;
+    const auto& yValueMap = *spYdata;
+
+    // Final (x,y) table passed to series.
+    TableSelectionCacheItem::RowToValueMap xyValueMap;
+    xyValueMap.setSorting(false);
+    xyValueMap.m_keyStorage.reserve(Min(xValueMap.size(), yValueMap.size()));
+    xyValueMap.m_valueStorage.reserve(Min(xValueMap.size(), yValueMap.size()));
 
     using IntervalSet = ::DFG_MODULE_NS(cont)::IntervalSet<int>;
     IntervalSet xRows;
@@ -2662,13 +2937,11 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shar
             defEntry.log(GraphDefinitionEntry::LogLevel::debug, tr("x_rows-entry defines %1 row(s)").arg(xRows.sizeOfSet()));
     }
 
-    const auto& yValueMap = (pXdata != pYdata) ? *pYdata : xValueMap;
     auto xIter = xValueMap.cbegin();
     auto yIter = yValueMap.cbegin();
     const TableSelectionCacheItem::RowToStringMap dummyZmap;
     auto zIter = (pZdata) ? pZdata->cbegin() : dummyZmap.cbegin();
     decltype(TableSelectionCacheItem::RowToStringMap::m_valueStorage) zStrings; // Filled with final strings if needed.
-    DataSourceIndex nSizeAfterRowFilter = 0;
     for (; xIter != xValueMap.cend() && yIter != yValueMap.cend() && (!pZdata || zIter != pZdata->cend());)
     {
         const auto xRow = xIter->first;
@@ -2700,7 +2973,7 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shar
             }
         }
         // Getting means that all needed iterator are pointing to the same row. ->
-        // storing (x,y) values to start of xValueMap if not filtered out.
+        // storing (x,y) values to xyValueMap if not filtered out.
         // If strings are needed, storing them to zStrings
         DFG_ASSERT_CORRECTNESS(xRow == yRow && (!pZdata || xRow == zRow));
         DFG_ASSERT_UB(::DFG_MODULE_NS(math)::isFloatConvertibleTo<int>(xRow));
@@ -2711,15 +2984,14 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shar
 
             if (!::DFG_MODULE_NS(math)::isNan(x)) // Accepting point only if x is non-NaN
             {
-                xValueMap.m_keyStorage[nSizeAfterRowFilter] = x;
-                xValueMap.m_valueStorage[nSizeAfterRowFilter] = y;
+                xyValueMap.m_keyStorage.push_back(x);
+                xyValueMap.m_valueStorage.push_back(y);
                 minMaxX(x);
                 minMaxY(y);
                 if (pZdata)
                     zStrings.push_back(zIter->second);
                 else if (bNeedMetaStrings && bZisRowIndex)
                     zStrings.push_back(StringUtf8::fromRawString(::DFG_MODULE_NS(str)::toStrC(xRow)));
-                nSizeAfterRowFilter++;
             }
         }
         ++xIter;
@@ -2728,25 +3000,47 @@ auto DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForXy(std::shar
             ++zIter;
     }
 
-    xValueMap.m_keyStorage.resize(nSizeAfterRowFilter);
-    xValueMap.m_valueStorage.resize(nSizeAfterRowFilter);
-    DFG_ASSERT_CORRECTNESS(!pZdata || nSizeAfterRowFilter == zStrings.size());
+    DFG_ASSERT_CORRECTNESS(!pZdata || xyValueMap.size() == zStrings.size());
+
+    // Applying operations. If the chain is incremental and previous result is available, recomputing only rows around changed input.
+    // Meta strings (txys) are not supported by incremental update.
+    auto operations = (pHistory && !bNeedMetaStrings) ? defEntry.operationList() : ChartEntryOperationList();
+    std::unique_lock<std::mutex> historyLock;
+    if (!operations.empty() && operations.isIncrementallyUpdatable())
+        historyLock = std::unique_lock<std::mutex>(pHistory->m_mutex);
+    else
+        pHistory = nullptr;
+    if (pHistory && pHistory->m_bValid)
+    {
+        ChartOperationPipeData updatedData = pHistory->m_output;
+        if (operations.updateOutputIncrementally(pHistory->m_inputX, pHistory->m_inputY, xyValueMap.m_keyStorage, xyValueMap.m_valueStorage, updatedData))
+        {
+            if (defEntry.isLoggingAllowedForLevel(GraphDefinitionEntry::LogLevel::debug))
+                defEntry.log(GraphDefinitionEntry::LogLevel::debug, tr("Operations applied incrementally to changed rows"));
+            pHistory->m_inputX = std::move(xyValueMap.m_keyStorage);
+            pHistory->m_inputY = std::move(xyValueMap.m_valueStorage);
+            pHistory->m_output.copyOrMoveDataFrom(updatedData);
+            static_cast<ChartOperationPipeData&>(rv) = pHistory->m_output;
+            return rv;
+        }
+    }
+    if (pHistory)
+    {
+        pHistory->clear();
+        pHistory->m_inputX = xyValueMap.m_keyStorage;
+        pHistory->m_inputY = xyValueMap.m_valueStorage;
+    }
 
-    // Applying operations
     ::DFG_MODULE_NS(charts)::ChartOperationPipeData operationData;
-    operationData.setDataRefs(&xValueMap.m_keyStorage, &xValueMap.m_valueStorage, ChartOperationPipeData::DataVectorRef((bNeedMetaStrings) ? &zStrings : nullptr));
+    operationData.setDataRefs(&xyValueMap.m_keyStorage, &xyValueMap.m_valueStorage, ChartOperationPipeData::DataVectorRef((bNeedMetaStrings) ? &zStrings : nullptr));
     defEntry.applyOperations(operationData);
 
-    ChartData rv;
     rv.copyOrMoveDataFrom(operationData);
-    rv.m_bXisRowIndex = bXisRowIndex;
-    rv.m_bYisRowIndex = bYisRowIndex;
-    rv.m_columnDataTypes.push_back(tableData.columnDataType(pXdata));
-    rv.m_columnDataTypes.push_back(tableData.columnDataType(pYdata));
-    rv.m_columnDataTypes.push_back(ChartDataType::unknown);
-    rv.m_columnNames.push_back(tableData.columnName(pXdata));
-    rv.m_columnNames.push_back(tableData.columnName(pYdata));
-    rv.m_columnNames.push_back(bZisRowIndex ? tr("<row index>") : tableData.columnName(columnIndexes[2]));
+    if (pHistory)
+    {
+        static_cast<ChartOperationPipeData&>(pHistory->m_output) = rv;
+        pHistory->m_bValid = true;
+    }
     return rv;
 }
 
@@ -2884,13 +3178,15 @@ namespace
 auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForHistogram(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry) -> ChartData
 {
     using namespace ::DFG_MODULE_NS(charts);
+    if (!spCache)
+        spCache.reset(new ChartDataCache);
+
+    auto fetchLock = spCache->lockCacheItemForFetch(source, defEntry);
+
     const auto nColumnCount = source.columnCount();
     if (nColumnCount < 1)
         return ChartData();
 
-    if (!spCache)
-        spCache.reset(new ChartDataCache);
-
     const auto sBinType = defEntry.fieldValueStr(ChartObjectFieldIdStr_binType, [] { return StringUtf8(DFG_UTF8("number")); });
 
     if (sBinType != DFG_UTF8("number") && sBinType != DFG_UTF8("text"))
@@ -2914,13 +3210,17 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForHistogram(
         if (!optTableData || optTableData->columnCount() < 1)
             return ChartData();
 
-        auto pCacheColumn = optTableData->columnDataByIndex(columnIndexes[0]);
+        const auto spCacheColumn = optTableData->columnDataViewByIndex(columnIndexes[0]);
 
-        if (!pCacheColumn)
+        if (!spCacheColumn)
             return ChartData();
 
+        const auto cacheColumnDataType = optTableData->columnDataType(columnIndexes[0]);
+        const auto sColumnName = optTableData->columnName(columnIndexes[0]);
+        fetchLock.unlock();
+
         TableSelectionCacheItem::RowToValueMap singleColumnCopy;
-        const TableSelectionCacheItem::RowToValueMap* pRowToValues = pCacheColumn;
+        const TableSelectionCacheItem::RowToValueMap* pRowToValues = spCacheColumn.get();
 
         if (!handleXrows(defEntry, pRowToValues, singleColumnCopy))
             return ChartData();
@@ -3003,20 +3303,24 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForHistogram(
 
         ChartData rv;
         rv.copyOrMoveDataFrom(operationData);
-        rv.m_columnDataTypes.push_back(optTableData->columnDataType(pCacheColumn));
-        rv.m_columnNames.push_back(optTableData->columnName(pCacheColumn));
+        rv.m_columnDataTypes.push_back(cacheColumnDataType);
+        rv.m_columnNames.push_back(sColumnName);
         return rv;
 
     }
     else // Case text valued
     {
-        auto pStrings = optTableData->columnStringsByIndex(columnIndexes[0]);
-        if (!pStrings || pStrings->empty())
+        const auto spStrings = optTableData->columnStringsViewByIndex(columnIndexes[0]);
+        if (!spStrings || spStrings->empty())
         {
             if (defEntry.isLoggingAllowedForLevel(GraphDefinitionEntry::LogLevel::error))
                 defEntry.log(GraphDefinitionEntry::LogLevel::error, tr("no data found for histogram"));
             return ChartData();
         }
+        const auto sColumnName = optTableData->columnName(columnIndexes[0]);
+        fetchLock.unlock();
+
+        const TableSelectionCacheItem::RowToStringMap* pStrings = spStrings.get();
 
         TableSelectionCacheItem::RowToStringMap stringColumnCopy;
 
@@ -3045,7 +3349,7 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForHistogram(
 
         ChartData rv;
         rv.copyOrMoveDataFrom(operationData);
-        rv.m_columnNames.push_back(optTableData->columnName(columnIndexes[0]));
+        rv.m_columnNames.push_back(sColumnName);
         return rv;
     }
 
@@ -3083,6 +3387,11 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForBars(std::
 {
     using namespace ::DFG_MODULE_NS(charts);
 
+    if (!spCache)
+        spCache.reset(new ChartDataCache);
+
+    auto fetchLock = spCache->lockCacheItemForFetch(source, defEntry);
+
     // Note: this is not a particularly good solution: some source like CsvItemModel source maybe essentially be
     //       temporarily unavailable if they fail to acquire lock for reading. If that happens, columnCount()
     //       return 0 and in this context is indistinguishable from empty source -> kind of "silent" failure
@@ -3091,9 +3400,6 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForBars(std::
     if (nColumnCount < 1)
         return ChartData();
 
-    if (!spCache)
-        spCache.reset(new ChartDataCache);
-
     std::array<DataSourceIndex, 3> columnIndexes;
     std::array<bool, 3> rowFlags;
     auto optTableData = spCache->getTableSelectionData_createIfMissing(source, defEntry, columnIndexes, rowFlags);
@@ -3101,22 +3407,33 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForBars(std::
     if (!optTableData || optTableData->columnCount() < 1)
         return ChartData();
 
-    auto pFirstCol = optTableData->columnStringsByIndex(columnIndexes[0]);
-    auto pSecondCol = optTableData->columnDataByIndex(columnIndexes[1]);
+    const auto spFirstCol = optTableData->columnStringsViewByIndex(columnIndexes[0]);
+    const auto spSecondCol = optTableData->columnDataViewByIndex(columnIndexes[1]);
 
-    std::vector<const TableSelectionCacheItem::RowToValueMap*> extraColumns;
+    std::vector<TableSelectionCacheItem::RowToValueMapView> extraColumnViews;
     // Extra columns
     DFG_DETAIL_NS::forEachExtraColumn(defEntry, [&](const DFG_DETAIL_NS::ExtraColumnInfo& item)
         {
             const auto nCol = item.getColIndex(source);
-            const auto pData = optTableData->columnDataByIndex(nCol);
-            if (pData)
-                extraColumns.push_back(pData);
+            auto spData = optTableData->columnDataViewByIndex(nCol);
+            if (spData)
+                extraColumnViews.push_back(std::move(spData));
         });
 
-    if (!pFirstCol || !pSecondCol)
+    if (!spFirstCol || !spSecondCol)
         return ChartData();
 
+    ChartData rawData;
+    rawData.m_columnNames.push_back(optTableData->columnName(columnIndexes[0]));
+    rawData.m_columnNames.push_back(optTableData->columnName(columnIndexes[1]));
+    fetchLock.unlock();
+
+    const TableSelectionCacheItem::RowToStringMap* pFirstCol = spFirstCol.get();
+    const TableSelectionCacheItem::RowToValueMap* pSecondCol = spSecondCol.get();
+    std::vector<const TableSelectionCacheItem::RowToValueMap*> extraColumns;
+    for (const auto& spExtra : extraColumnViews)
+        extraColumns.push_back(spExtra.get());
+
     TableSelectionCacheItem::RowToStringMap labelColumnCopy;
     TableSelectionCacheItem::RowToValueMap valueColumnCopy;
     std::vector<TableSelectionCacheItem::RowToValueMap> extraColumnCopies(extraColumns.size());
@@ -3141,10 +3458,7 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForBars(std::
 
     defEntry.applyOperations(operationData);
 
-    ChartData rawData;
     rawData.copyOrMoveDataFrom(operationData);
-    rawData.m_columnNames.push_back(optTableData->columnName(columnIndexes[0]));
-    rawData.m_columnNames.push_back(optTableData->columnName(columnIndexes[1]));
     return rawData;
 }
 
@@ -3190,14 +3504,15 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForStatistica
     const GraphDefinitionEntry& defEntry) -> ChartData
 {
     using namespace ::DFG_MODULE_NS(charts);
+    if (!spCache)
+        spCache.reset(new ChartDataCache);
+
+    auto fetchLock = spCache->lockCacheItemForFetch(source, defEntry);
+
     const auto nColumnCount = source.columnCount();
     if (nColumnCount < 1)
         return ChartData();
 
-    if (!spCache)
-        spCache.reset(new ChartDataCache);
-
-    
     auto optTableData = spCache->getTableSelectionData_createIfMissing(source, defEntry);
 
     if (!optTableData || optTableData->columnCount() < 1)
@@ -3241,24 +3556,32 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForStatistica
         }
     }
 
+    std::vector<TableSelectionCacheItem::RowToValueMapView> dataColumnViews(yCols.size());
     std::vector<const TableSelectionCacheItem::RowToValueMap*> dataColumns(yCols.size());
     std::vector<TableSelectionCacheItem::RowToValueMap> xRowFilterCopyStorage(yCols.size());
+    ChartData rv;
 
     for (TableSelectionCacheItem::IndexT i = 0; i < yCols.size(); ++i)
     {
-        auto pRowToValueMap = optTableData->columnDataByIndex(yCols[i]);
-        if (!pRowToValueMap)
+        dataColumnViews[i] = optTableData->columnDataViewByIndex(yCols[i]);
+        if (!dataColumnViews[i])
         {
             if (defEntry.isLoggingAllowedForLevel(LogLevel::error))
                 defEntry.log(LogLevel::error, tr("Unable to find column with index '%1'").arg(yCols[i] + 1));
             return ChartData();
         }
-        dataColumns[i] = pRowToValueMap;
+        dataColumns[i] = dataColumnViews[i].get();
+        rv.m_columnDataTypes.push_back(optTableData->columnDataType(yCols[i]));
+        rv.m_columnNames.push_back(optTableData->columnName(yCols[i]));
+    }
+    fetchLock.unlock();
+
+    for (size_t i = 0; i < dataColumns.size(); ++i)
+    {
         if (!handleXrows(defEntry, dataColumns[i], xRowFilterCopyStorage[i]))
             return ChartData();
     }
 
-    ChartData rv;
     // Applying operations. Data is fed in column pairs so that operations that support only (x, y) pairs
     // work. x-column gets row indexes.
     for (size_t i = 0; i < dataColumns.size(); ++i)
@@ -3271,9 +3594,6 @@ auto ::DFG_MODULE_NS(qt)::GraphControlAndDisplayWidget::prepareDataForStatistica
         auto pValues = operationData.valuesByIndex(1);
         if (pValues)
             *rv.editableValuesByIndex(i) = std::move(*pValues);
-
-        rv.m_columnDataTypes.push_back(optTableData->columnDataType(yCols[i]));
-        rv.m_columnNames.push_back(optTableData->columnName(yCols[i]));
     }
     rv.setValueVectorsAsData();
     return rv;
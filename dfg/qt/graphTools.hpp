@@ -357,6 +357,7 @@ class GraphDataSourceSnapshotIdMap : public ::DFG_MODULE_NS(cont)::MapVectorSoA<
 
 // Parameter for GraphDataSource::sigChanged() describing what has changed, can be used to optimize cache invalidation so that don't
 // need to e.g. invalidate all columns if only one column changes.
+// Row range, if present, is expressed in the same units as row values that the source provides in SourceDataSpan.
 // The actual signal paramater type is QString to avoid issues with qRegisterMetaType().
 class DataSourceChangedParam
 {
@@ -364,14 +365,23 @@ public:
     using SignalParamT = QString;
 
     static DataSourceChangedParam fromInvalidColumnRange(DataSourceIndex nLeft, DataSourceIndex nRight);
+    // Like fromInvalidColumnRange(), but also tells that only rows [nTop, nBottom] have changed in the given columns.
+    static DataSourceChangedParam fromInvalidCellRange(DataSourceIndex nLeft, DataSourceIndex nRight, DataSourceIndex nTop, DataSourceIndex nBottom);
     static DataSourceChangedParam fromSignalParam(const SignalParamT& param);
 
     std::optional<std::pair<DataSourceIndex, DataSourceIndex>> getInvalidatedColumnRange() const;
+    // Returns invalidated row range, std::nullopt if not known (i.e. all rows in invalidated columns should be considered changed)
+    std::optional<std::pair<DataSourceIndex, DataSourceIndex>> getInvalidatedRowRange() const;
+
+    // Merges changes described by 'other' into this so that resulting param covers both.
+    void unite(const DataSourceChangedParam& other);
 
     SignalParamT toSignalParam() const;
 
     DataSourceIndex m_nFirstInvalidColumn = 1;
     DataSourceIndex m_nLastInvalidColumn = 0;
+    DataSourceIndex m_nFirstInvalidRow = 1;
+    DataSourceIndex m_nLastInvalidRow = 0;
 };
 
 
@@ -663,6 +673,7 @@ private:
 public:
     class ChartData;
     class ChartDataPreparator;
+    class XyPreparationHistory;
 
 private:
     class RefreshContext;
@@ -674,8 +685,9 @@ private:
     void handlePanelProperties(ChartCanvas& rChart, const GraphDefinitionEntry& defEntry);
 
 private:
-    static ChartData prepareData(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry);
-    static ChartData prepareDataForXy(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry);
+    // If pHistory is given, xy-data is updated incrementally from previous result when possible, see XyPreparationHistory.
+    static ChartData prepareData(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry, XyPreparationHistory* pHistory = nullptr);
+    static ChartData prepareDataForXy(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry, XyPreparationHistory* pHistory = nullptr);
     static ChartData prepareDataForHistogram(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry);
     static ChartData prepareDataForBars(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry);
     static ChartData prepareDataForStatisticalBox(std::shared_ptr<ChartDataCache>& spCache, GraphDataSource& source, const GraphDefinitionEntry& defEntry);
@@ -751,6 +763,8 @@ public:
 }; // Class GraphControlAndDisplayWidget
 
 
+// Prepares chart data for entries of a chart definition. Lives in a dedicated thread and distributes entries to a thread pool:
+// entries sharing a cache item fetch into it one at a time, but otherwise all entries are prepared concurrently.
 class GraphControlAndDisplayWidget::ChartDataPreparator : public QObject
 {
     Q_OBJECT
@@ -48,6 +48,14 @@ static void fillQcpPlottable(ChartObject_T & rChartObject, const ::DFG_MODULE_NS
 
 static void fillQcpPlottable(QCPAbstractPlottable * pPlottable, ::DFG_MODULE_NS(charts)::ChartOperationPipeData & pipeData);
 
+template <class ChartObject_T, class DataContainer_T>
+static void setQcpPlottableData(ChartObject_T& rChartObject, QSharedPointer<DataContainer_T> spData);
+
+static void setQcpPlottableData(QCPGraph& rGraph, QSharedPointer<QCPGraphDataContainer> spData);
+
+// Returns full data of graph, i.e. not the downsampled data that is drawn when using level-of-detail.
+static QSharedPointer<QCPGraphDataContainer> fullGraphData(const QCPGraph& graph);
+
 template <class Func_T>
 void forEachQCustomPlotLineStyle(const QCPGraph*, Func_T && func);
 
@@ -240,6 +248,114 @@ void ChartObjectQCustomPlot::setFillColourImpl(ChartObjectStringView svFillColou
         });
 }
 
+/////////////////////////////////////////////////////////////////////////////////////
+//
+// CustomPlotGraphWithLevelOfDetail
+//
+/////////////////////////////////////////////////////////////////////////////////////
+
+void CustomPlotGraphWithLevelOfDetail::setFullData(QSharedPointer<QCPGraphDataContainer> spData)
+{
+    m_nSampledPixelCount = -1;
+    if (!spData || spData->size() < s_nLevelOfDetailMinSize)
+    {
+        m_spFullData.reset();
+        m_pyramid.clear();
+        BaseClass::setData(std::move(spData));
+        return;
+    }
+    m_spFullData = std::move(spData);
+    const auto iterBegin = m_spFullData->constBegin();
+    m_pyramid.build(static_cast<size_t>(m_spFullData->size()), [&](const size_t i) { return (iterBegin + static_cast<int>(i))->value; });
+    // Actual points to draw are set in draw().
+    BaseClass::setData(QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer));
+}
+
+QSharedPointer<QCPGraphDataContainer> CustomPlotGraphWithLevelOfDetail::fullData() const
+{
+    return (m_spFullData) ? m_spFullData : data();
+}
+
+void CustomPlotGraphWithLevelOfDetail::restoreFullData()
+{
+    if (!m_spFullData)
+        return;
+    BaseClass::setData(m_spFullData);
+    m_spFullData.reset();
+    m_pyramid.clear();
+    m_nSampledPixelCount = -1;
+}
+
+QCPRange CustomPlotGraphWithLevelOfDetail::getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain) const
+{
+    if (!m_spFullData)
+        return BaseClass::getKeyRange(foundRange, inSignDomain);
+    return m_spFullData->keyRange(foundRange, inSignDomain);
+}
+
+QCPRange CustomPlotGraphWithLevelOfDetail::getValueRange(bool& foundRange, QCP::SignDomain inSignDomain, const QCPRange& inKeyRange) const
+{
+    if (!m_spFullData)
+        return BaseClass::getValueRange(foundRange, inSignDomain, inKeyRange);
+    return m_spFullData->valueRange(foundRange, inSignDomain, inKeyRange);
+}
+
+void CustomPlotGraphWithLevelOfDetail::draw(QCPPainter* painter)
+{
+    if (m_spFullData)
+        updateDownsampledData();
+    BaseClass::draw(painter);
+}
+
+void CustomPlotGraphWithLevelOfDetail::updateDownsampledData()
+{
+    auto pKeyAxis = keyAxis();
+    auto pAxisRect = (pKeyAxis) ? pKeyAxis->axisRect() : nullptr;
+    if (!m_spFullData || !pAxisRect)
+        return;
+
+    // Downsampling keeps only points that define lines at pixel resolution so when drawing points or no lines, drawing full data.
+    if (lineStyle() == lsNone || !scatterStyle().isNone())
+    {
+        if (data() != m_spFullData)
+            BaseClass::setData(m_spFullData);
+        m_nSampledPixelCount = -1;
+        return;
+    }
+
+    const auto keyRange = pKeyAxis->range();
+    const auto scaleType = pKeyAxis->scaleType();
+    const int nPixelCount = (pKeyAxis->orientation() == Qt::Horizontal) ? pAxisRect->width() : pAxisRect->height();
+    if (nPixelCount == m_nSampledPixelCount && keyRange == m_sampledKeyRange && scaleType == m_sampledScaleType)
+        return; // Existing downsampled data is up to date.
+
+    // Visible range with one point beyond both edges so that lines continue to the edges of the axis rect.
+    const auto& rFullData = *m_spFullData;
+    const auto iterDataBegin = rFullData.constBegin();
+    const auto nBegin = static_cast<size_t>(rFullData.findBegin(keyRange.lower, true) - iterDataBegin);
+    const auto nEnd = static_cast<size_t>(rFullData.findEnd(keyRange.upper, true) - iterDataBegin);
+
+    const auto dataAt = [&](const size_t i) -> const QCPGraphData& { return *(iterDataBegin + static_cast<int>(i)); };
+    const auto bucketOf = [&](const size_t i) -> int64
+    {
+        // Bucket is pixel column (or row for vertical key axis); NaN or points far outside the axis rect are simply put to edge buckets.
+        const auto pixel = pKeyAxis->coordToPixel(dataAt(i).key);
+        return (!std::isnan(pixel)) ? static_cast<int64>(std::floor(limited(pixel, -1e9, 1e9))) : int64_min;
+    };
+    QVector<QCPGraphData> sampledData;
+    sampledData.reserve(5 * Max(1, nPixelCount) + 10);
+    m_pyramid.downsample(nBegin, nEnd, static_cast<size_t>(Max(1, nPixelCount)), bucketOf, [&](const size_t i) { return dataAt(i).value; },
+        [&](const size_t i) { sampledData.push_back(dataAt(i)); });
+
+    QSharedPointer<QCPGraphDataContainer> spSampledData(new QCPGraphDataContainer);
+    spSampledData->set(sampledData, true);
+    BaseClass::setData(std::move(spSampledData));
+
+    m_sampledKeyRange = keyRange;
+    m_sampledScaleType = scaleType;
+    m_nSampledPixelCount = nPixelCount;
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 //
 // XySeriesQCustomPlot
@@ -352,6 +468,10 @@ size_t XySeriesQCustomPlot::setMetaDataByFunctor(MetaDataSetterCallback func)
 
 void XySeriesQCustomPlot::resize(const DataSourceIndex nNewSize)
 {
+    // Resizing operates on data() so making sure that it has the full data.
+    auto pLodGraph = dynamic_cast<CustomPlotGraphWithLevelOfDetail*>(m_spQcpObject.data());
+    if (pLodGraph)
+        pLodGraph->restoreFullData();
     if (!resizeImpl(getGraph(), nNewSize, [](Dummy, double x, double y) { return QCPGraphData(x, y); }))
         resizeImpl(getCurve(), nNewSize, [](DataSourceIndex i, double x, double y) { return QCPCurveData(static_cast<double>(i), x, y); });
 }
@@ -751,7 +871,7 @@ auto ChartCanvasQCustomPlot::createXySeries(const XySeriesCreationParam& param)
     QCPCurve* pQcpCurve = nullptr;
     if (type == ChartObjectChartTypeStr_xy)
     {
-        pQcpGraph = p->addGraph(pXaxis, pYaxis);
+        pQcpGraph = new CustomPlotGraphWithLevelOfDetail(pXaxis, pYaxis); // Owned by QCustomPlot
         setTypeToQcpObjectProperty(pQcpGraph, type);
     }
     else if (type == ChartObjectChartTypeStr_txy)
@@ -1917,9 +2037,9 @@ bool ChartCanvasQCustomPlot::toolTipTextForChartObjectAsHtml(const QCPGraph* pGr
     if (!pGraph)
         return false;
 
-    toolTipStream << tr("<br>Graph size: %1").arg(pGraph->dataCount());
+    const auto spData = fullGraphData(*pGraph);
+    toolTipStream << tr("<br>Graph size: %1").arg((spData) ? spData->size() : 0);
 
-    const auto spData = pGraph->data();
     if (!spData)
         return true;
 
@@ -2276,7 +2396,7 @@ auto ChartCanvasQCustomPlot::createOperationPipeData(QCPAbstractPlottable* pPlot
         return ChartOperationPipeData();
     auto pGraph = qobject_cast<QCPGraph*>(pPlottable);
     if (pGraph)
-        return createOperationPipeDataImpl(pGraph->data());
+        return createOperationPipeDataImpl(fullGraphData(*pGraph));
     auto pCurve = qobject_cast<QCPCurve*>(pPlottable);
     if (pCurve)
         return createOperationPipeDataImpl(pCurve->data());
@@ -3016,9 +3136,30 @@ static void fillQcpPlottable(ChartObject_T& rChartObject, ValueCont_T&& data)
     if (!std::is_sorted(data.begin(), data.end(), sortFunc))
         std::sort(data.begin(), data.end(), sortFunc);
     spData->set(data, true); // Note: if data is not sorted beforehand, sorting in set() will effetively cause a redundant copy to be created.
+    setQcpPlottableData(rChartObject, std::move(spData));
+}
+
+template <class ChartObject_T, class DataContainer_T>
+static void setQcpPlottableData(ChartObject_T& rChartObject, QSharedPointer<DataContainer_T> spData)
+{
     rChartObject.setData(std::move(spData));
 }
 
+static void setQcpPlottableData(QCPGraph& rGraph, QSharedPointer<QCPGraphDataContainer> spData)
+{
+    auto pLodGraph = dynamic_cast<CustomPlotGraphWithLevelOfDetail*>(&rGraph);
+    if (pLodGraph)
+        pLodGraph->setFullData(std::move(spData));
+    else
+        rGraph.setData(std::move(spData));
+}
+
+static QSharedPointer<QCPGraphDataContainer> fullGraphData(const QCPGraph& graph)
+{
+    auto pLodGraph = dynamic_cast<const CustomPlotGraphWithLevelOfDetail*>(&graph);
+    return (pLodGraph) ? pLodGraph->fullData() : graph.data();
+}
+
 template <class DataType_T, class ChartObject_T, class Transform_T>
 static void fillQcpPlottable(ChartObject_T& rChartObject, const ::DFG_MODULE_NS(charts)::InputSpan<double>& xVals, const ::DFG_MODULE_NS(charts)::InputSpan<double>& yVals, Transform_T transformer)
 {
@@ -4,6 +4,7 @@
 
 #include "../../charts/commonChartTools.hpp"
 #include "../../charts/operations.hpp"
+#include "../../charts/levelOfDetail.hpp"
 #include "../graphTools.hpp"
 
 DFG_BEGIN_INCLUDE_QT_HEADERS
@@ -52,6 +53,46 @@ public:
     ::DFG_MODULE_NS(cont)::MapToStringViews<double, StringUtf8> m_metaData;
 }; // class CustomPlotCurveWithMetaData
 
+// Extended QCPGraph that for large data draws min/max-per-pixel downsampled points instead of all points.
+//  -Full data is stored separately (fullData()) and data() has the points of the latest draw.
+//  -Downsampled points are taken from LevelOfDetailPyramid in draw() whenever visible key range or pixel size has changed.
+//  -Downsampling is used only when graph has lines but no scatter points; for such graphs lines and steps look the same as with full data.
+class CustomPlotGraphWithLevelOfDetail : public QCPGraph
+{
+public:
+    using BaseClass = QCPGraph;
+    using BaseClass::BaseClass;
+
+    static constexpr int s_nLevelOfDetailMinSize = 100000; // Data smaller than this is drawn as such.
+
+    // Sets full data, spData is expected to be sorted by key.
+    void setFullData(QSharedPointer<QCPGraphDataContainer> spData);
+
+    // Returns full data, which is data() if level-of-detail is not active.
+    QSharedPointer<QCPGraphDataContainer> fullData() const;
+
+    bool isLevelOfDetailActive() const { return !m_spFullData.isNull(); }
+
+    // Sets full data as data() and disables level-of-detail until next setFullData().
+    void restoreFullData();
+
+    // Axis rescaling must see full data, not only the latest downsampled points.
+    QCPRange getKeyRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth) const override;
+    QCPRange getValueRange(bool& foundRange, QCP::SignDomain inSignDomain = QCP::sdBoth, const QCPRange& inKeyRange = QCPRange()) const override;
+
+protected:
+    void draw(QCPPainter* painter) override;
+
+private:
+    void updateDownsampledData();
+
+    QSharedPointer<QCPGraphDataContainer> m_spFullData; // Null if level-of-detail is not active.
+    ::DFG_MODULE_NS(charts)::LevelOfDetailPyramid m_pyramid;
+    QCPRange m_sampledKeyRange;
+    QCPAxis::ScaleType m_sampledScaleType = QCPAxis::stLinear;
+    int m_nSampledPixelCount = -1; // Negative if data() doesn't have downsampled data.
+}; // class CustomPlotGraphWithLevelOfDetail
+
 
 // Defines custom implementation for ChartObject. This is used to avoid repeating virtual overrides in ChartObjects.
 class ChartObjectQCustomPlot : public ::DFG_MODULE_NS(charts)::ChartObject
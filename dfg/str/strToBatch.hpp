@@ -0,0 +1,192 @@
+#pragma once
+
+#include "../dfgDefs.hpp"
+#include "../dfgBaseTypedefs.hpp"
+#include "strTo.hpp"
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+DFG_ROOT_NS_BEGIN{ DFG_SUB_NS(str) {
+
+namespace DFG_DETAIL_NS
+{
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) || defined(_WIN32)
+    #define DFG_STR_STRTOBATCH_SWAR 1
+#else
+    #define DFG_STR_STRTOBATCH_SWAR 0
+#endif
+
+#if DFG_STR_STRTOBATCH_SWAR == 1
+    // Returns true iff all 8 bytes in little-endian word v are ASCII digits.
+    inline bool isEightDigitsSwar(const uint64 v)
+    {
+        return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+    }
+
+    // Converts 8 ASCII digits in little-endian word v to number.
+    // Precondition: isEightDigitsSwar(v)
+    inline uint32 parseEightDigitsSwar(uint64 v)
+    {
+        v -= 0x3030303030303030ull;
+        v = (v * 10) + (v >> 8);
+        v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) + (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >> 32;
+        return static_cast<uint32>(v);
+    }
+#endif // DFG_STR_STRTOBATCH_SWAR
+
+    // Accumulates digits from [p, pEnd[ to nValue and returns pointer to first non-digit. nDigitCount is incremented by the number of digits.
+    // Caller must check nDigitCount to detect overflow, digits are accumulated with wrap-around.
+    inline const char* parseDigits(const char* p, const char* const pEnd, uint64& nValue, size_t& nDigitCount)
+    {
+#if DFG_STR_STRTOBATCH_SWAR == 1
+        while (pEnd - p >= 8)
+        {
+            uint64 v;
+            std::memcpy(&v, p, sizeof(v));
+            if (!isEightDigitsSwar(v))
+                break;
+            nValue = nValue * 100000000u + parseEightDigitsSwar(v);
+            nDigitCount += 8;
+            p += 8;
+        }
+#endif // DFG_STR_STRTOBATCH_SWAR
+        for (; p != pEnd && *p >= '0' && *p <= '9'; ++p, ++nDigitCount)
+            nValue = nValue * 10 + static_cast<uint64>(*p - '0');
+        return p;
+    }
+
+    // Trims spaces from both ends like strTo() does.
+    inline void trimSpaces(const char*& p, const char*& pEnd)
+    {
+        while (p != pEnd && *p == ' ')
+            ++p;
+        while (pEnd != p && *(pEnd - 1) == ' ')
+            --pEnd;
+    }
+
+    // Fast path for plain decimal integers ("-?[0-9]+"), returns false if input is not of that form or it may not fit to int64,
+    // in which case caller should use strTo().
+    inline bool tryStrToInt64Fast(const char* p, const char* pEnd, int64& val)
+    {
+        trimSpaces(p, pEnd);
+        const bool bNegative = (p != pEnd && *p == '-');
+        if (bNegative)
+            ++p;
+        uint64 nValue = 0;
+        size_t nDigitCount = 0;
+        if (parseDigits(p, pEnd, nValue, nDigitCount) != pEnd || nDigitCount == 0 || nDigitCount > 18) // 18 digits always fit to int64.
+            return false;
+        val = (bNegative) ? -static_cast<int64>(nValue) : static_cast<int64>(nValue);
+        return true;
+    }
+
+    // Fast path for plain decimal numbers ("-?[0-9]+(\.[0-9]+)?([eE][+-]?[0-9]+)?") whose value can be computed exactly with one
+    // double operation: mantissa at most 2^53 and power of ten at most 22 (Clinger's fast path). Result is then correctly rounded,
+    // i.e. identical to strTo<double>(). Returns false if input is not handled, in which case caller should use strTo().
+    inline bool tryStrToDoubleFast(const char* p, const char* pEnd, double& val)
+    {
+        static const double powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        trimSpaces(p, pEnd);
+        const bool bNegative = (p != pEnd && *p == '-');
+        if (bNegative)
+            ++p;
+        uint64 nMantissa = 0;
+        size_t nIntDigitCount = 0;
+        p = parseDigits(p, pEnd, nMantissa, nIntDigitCount);
+        if (nIntDigitCount == 0)
+            return false;
+        size_t nFracDigitCount = 0;
+        if (p != pEnd && *p == '.')
+        {
+            p = parseDigits(p + 1, pEnd, nMantissa, nFracDigitCount);
+            if (nFracDigitCount == 0)
+                return false;
+        }
+        if (nIntDigitCount + nFracDigitCount > 19) // Mantissa may have overflown.
+            return false;
+        int64 nExp10 = -static_cast<int64>(nFracDigitCount);
+        if (p != pEnd && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            const bool bNegativeExp = (p != pEnd && *p == '-');
+            if (p != pEnd && (*p == '-' || *p == '+'))
+                ++p;
+            uint64 nExp = 0;
+            size_t nExpDigitCount = 0;
+            p = parseDigits(p, pEnd, nExp, nExpDigitCount);
+            if (nExpDigitCount == 0 || nExpDigitCount > 4)
+                return false;
+            nExp10 += (bNegativeExp) ? -static_cast<int64>(nExp) : static_cast<int64>(nExp);
+        }
+        if (p != pEnd || nMantissa > (uint64(1) << 53) || nExp10 < -22 || nExp10 > 22)
+            return false;
+        double d = static_cast<double>(nMantissa);
+        d = (nExp10 < 0) ? d / powersOfTen[-nExp10] : d * powersOfTen[nExp10];
+        val = (bNegative) ? -d : d;
+        return true;
+    }
+
+    template <class T> inline bool tryStrToFast(const char* p, const char* pEnd, T& val);
+    template <> inline bool tryStrToFast(const char* p, const char* pEnd, double& val) { return tryStrToDoubleFast(p, pEnd, val); }
+    template <> inline bool tryStrToFast(const char* p, const char* pEnd, int64& val)  { return tryStrToInt64Fast(p, pEnd, val); }
+
+    template <class T> inline T strToBatchInvalidValue()
+    {
+        if constexpr (std::numeric_limits<T>::has_quiet_NaN)
+            return std::numeric_limits<T>::quiet_NaN();
+        else
+            return T();
+    }
+} // namespace DFG_DETAIL_NS
+
+// Converts a single string view to T (double or int64) with the same result and success semantics as strTo<T>(), but
+// uses a fast path for plain decimal input. On failure returns NaN for double and 0 for int64.
+// Note: the only double fast path is Clinger's (see tryStrToDoubleFast()), there is no Eisel-Lemire path: input with more than 19 significant digits
+//       or decimal exponent outside [-22, 22] after scaling goes through strTo().
+// Sv_T must have data() and size() and refer to a null terminated string (e.g. views to TableSz cells), since fallback uses strTo().
+template <class T, class Sv_T>
+inline T strToFast(const Sv_T& sv, bool* pOk = nullptr)
+{
+    DFG_STATIC_ASSERT((std::is_same_v<T, double> || std::is_same_v<T, int64>), "strToFast: only double and int64 are supported");
+    const char* p = toCharPtr_raw(sv.data());
+    T val;
+    if (DFG_DETAIL_NS::tryStrToFast(p, p + sv.size(), val))
+    {
+        if (pOk)
+            *pOk = true;
+        return val;
+    }
+    bool bOk = false;
+    val = strTo<T>(p, &bOk);
+    if (pOk)
+        *pOk = bOk;
+    return (bOk) ? val : DFG_DETAIL_NS::strToBatchInvalidValue<T>();
+}
+
+// Converts nCount string views from pInputs to pOutputs, see strToFast() for conversion details.
+// If pValidity is given, it is resized to nCount and (*pValidity)[i] tells whether pInputs[i] was converted successfully.
+// Returns the number of successfully converted items.
+// Intended for converting columns of numeric data, e.g. csv-columns with millions of rows, where per-item overhead of strTo() dominates.
+template <class T, class Sv_T>
+size_t strToBatch(const Sv_T* pInputs, const size_t nCount, T* pOutputs, std::vector<bool>* pValidity = nullptr)
+{
+    if (pValidity)
+        pValidity->assign(nCount, false);
+    size_t nValidCount = 0;
+    for (size_t i = 0; i < nCount; ++i)
+    {
+        bool bOk;
+        pOutputs[i] = strToFast<T>(pInputs[i], &bOk);
+        if (!bOk)
+            continue;
+        ++nValidCount;
+        if (pValidity)
+            (*pValidity)[i] = true;
+    }
+    return nValidCount;
+}
+
+}} // namespace dfg::str
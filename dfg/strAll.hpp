@@ -11,3 +11,4 @@
 #include "str/strCat.hpp"
 #include "str/strLen.hpp"
 #include "str/strTo.hpp"
+#include "str/strToBatch.hpp"
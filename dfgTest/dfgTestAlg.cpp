@@ -515,6 +515,29 @@ TEST(dfgAlg, sortMultiple)
     }
 }
 
+TEST(dfgAlg, computeSortIndexesBySizeAndPredParallel)
+{
+    using namespace DFG_MODULE_NS(alg);
+    auto randEng = DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+    randEng.seed(98765);
+    auto distrEng = DFG_MODULE_NS(rand)::makeDistributionEngineUniform(&randEng, 0, 100); // Narrow range to get lots of equal values.
+    for (const size_t nSize : { 0, 1, 1023, 5000, 20011 })
+    {
+        std::vector<int> vals(nSize);
+        std::generate(vals.begin(), vals.end(), distrEng);
+        const auto pred = [&](const size_t a, const size_t b) { return vals[a] < vals[b]; };
+        // Parallel version is stable so expecting equal values in index order.
+        auto expected = computeSortIndexesBySizeAndPred(nSize, pred);
+        std::sort(expected.begin(), expected.end(), [&](const size_t a, const size_t b) { return (vals[a] != vals[b]) ? vals[a] < vals[b] : a < b; });
+        for (const size_t nThreadCount : { 0, 1, 2, 3, 8 })
+        {
+            EXPECT_EQ(expected, computeSortIndexesBySizeAndPredParallel(nSize, pred, nThreadCount));
+            const auto indexes32 = computeSortIndexesBySizeAndPredParallel<DFG_ROOT_NS::uint32>(nSize, pred, nThreadCount);
+            EXPECT_TRUE(std::equal(expected.begin(), expected.end(), indexes32.begin(), indexes32.end()));
+        }
+    }
+}
+
 TEST(dfgAlg, rank)
 {
     using namespace DFG_MODULE_NS(alg);
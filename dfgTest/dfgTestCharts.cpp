@@ -6,6 +6,7 @@
 #include <dfg/cont/Vector.hpp>
 #include <dfg/cont/SetVector.hpp>
 #include <dfg/alg.hpp>
+#include <dfg/rand.hpp>
 
 namespace
 {
@@ -507,6 +508,25 @@ TEST(dfgCharts, operations_smoothing_indexNb)
         EXPECT_EQ(&valsY, arg.constValuesByIndex(1));
     }
 
+    // Thread count hint: result must not depend on how many threads operation uses.
+    {
+        const ValueVectorD valsX(100000, 0);
+        ValueVectorD valsY(valsX.size());
+        for (size_t i = 0; i < valsY.size(); ++i)
+            valsY[i] = static_cast<double>((i * 37) % 101);
+        auto op = opManager.createOperation(DFG_ASCII("smoothing_indexNb(5, median)"));
+        EXPECT_EQ(0, op.threadCountHint());
+        ValueVectorD valsYsingleThread = valsY;
+        ChartOperationPipeData argSingleThread(&valsX, &valsYsingleThread);
+        op.setThreadCountHint(1);
+        op(argSingleThread);
+        ChartOperationPipeData argMultiThread(&valsX, &valsY);
+        op.setThreadCountHint(4);
+        op(argMultiThread);
+        EXPECT_FALSE(op.hasErrors());
+        EXPECT_EQ(valsYsingleThread, valsY);
+    }
+
     // Testing various invalid arguments
     {
         EXPECT_FALSE(opManager.createOperation(DFG_ASCII("smoothing_indexNb(abc)"))); // Non-number radius
@@ -941,6 +961,158 @@ TEST(dfgCharts, ChartEntryOperationManager)
     EXPECT_TRUE(std::equal(operationSet.cbegin(), operationSet.cend(), opManager.m_knownOperations.beginKey()));
 }
 
+TEST(dfgCharts, ChartEntryOperationList_incrementalUpdate)
+{
+    using namespace ::DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(charts);
+
+    ChartEntryOperationManager opManager;
+    const auto nNonIncremental = ChartEntryOperation::nonIncrementalIndexRadius();
+
+    // Single operations
+    {
+        EXPECT_FALSE(ChartEntryOperation().isIncrementallyUpdatable());
+        EXPECT_EQ(0, opManager.createOperation(DFG_UTF8("passWindow(x, 0, 1)")).indexDependencyRadius());
+        EXPECT_TRUE(opManager.createOperation(DFG_UTF8("passWindow(x, 0, 1)")).mayRemoveRows());
+        EXPECT_TRUE(opManager.createOperation(DFG_UTF8("blockWindow(y, 0, 1)")).mayRemoveRows());
+        EXPECT_TRUE(opManager.createOperation(DFG_UTF8("textFilter(x, a)")).mayRemoveRows());
+        EXPECT_EQ(0, opManager.createOperation(DFG_UTF8("textFilter(x, a)")).indexDependencyRadius());
+        EXPECT_EQ(0, opManager.createOperation(DFG_UTF8("regexFormat(x, a, b)")).indexDependencyRadius());
+        EXPECT_FALSE(opManager.createOperation(DFG_UTF8("regexFormat(x, a, b)")).mayRemoveRows());
+        EXPECT_EQ(0, opManager.createOperation(DFG_UTF8("formula(y, x + 1)")).indexDependencyRadius());
+        EXPECT_EQ(1, opManager.createOperation(DFG_UTF8("smoothing_indexNb()")).indexDependencyRadius());
+        EXPECT_EQ(3, opManager.createOperation(DFG_UTF8("smoothing_indexNb(3, median)")).indexDependencyRadius());
+        EXPECT_FALSE(opManager.createOperation(DFG_UTF8("smoothing_indexNb(3, median)")).mayRemoveRows());
+    }
+
+    // Operation chains
+    {
+        ChartEntryOperationList operations;
+        EXPECT_EQ(0, operations.indexDependencyRadius());
+        operations.push_back(opManager.createOperation(DFG_UTF8("formula(y, x + 1)")));
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(2)")));
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(3)")));
+        EXPECT_EQ(5, operations.indexDependencyRadius());
+        // Filter after smoothing keeps chain incremental...
+        operations.push_back(opManager.createOperation(DFG_UTF8("passWindow(y, 0, 10)")));
+        EXPECT_EQ(5, operations.indexDependencyRadius());
+        EXPECT_TRUE(operations.isIncrementallyUpdatable());
+        // ...but smoothing after filter does not since indexes no longer match input rows.
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(1)")));
+        EXPECT_EQ(nNonIncremental, operations.indexDependencyRadius());
+        EXPECT_FALSE(operations.affectedRowRange(1, 2, 10).has_value());
+    }
+
+    // Chain having non-incremental operation
+    {
+        ChartEntryOperationList operations;
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(2)")));
+        operations.push_back(ChartEntryOperation());
+        EXPECT_FALSE(operations.isIncrementallyUpdatable());
+    }
+
+    // affectedRowRange() and checking that values outside of affected range don't change
+    {
+        ChartEntryOperationList operations;
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(2)")));
+        operations.push_back(opManager.createOperation(DFG_UTF8("smoothing_indexNb(1, median)")));
+        ASSERT_EQ(3, operations.indexDependencyRadius());
+
+        EXPECT_EQ(std::make_pair(size_t(0), size_t(4)), operations.affectedRowRange(0, 1, 50).value());
+        EXPECT_EQ(std::make_pair(size_t(45), size_t(49)), operations.affectedRowRange(48, 49, 50).value());
+        EXPECT_EQ(std::make_pair(size_t(0), size_t(2)), operations.affectedRowRange(0, 0, 3).value());
+        EXPECT_FALSE(operations.affectedRowRange(2, 1, 50).has_value());
+        EXPECT_FALSE(operations.affectedRowRange(0, 0, 0).has_value());
+
+        ValueVectorD x(50);
+        ValueVectorD y(50);
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            x[i] = static_cast<double>(i);
+            y[i] = static_cast<double>((i * 37) % 11);
+        }
+        ValueVectorD yChanged = y;
+        yChanged[20] = 100;
+        yChanged[21] = -50;
+        const ValueVectorD yInput = y; // Copies of input as executeAll() may edit non-const input in place.
+        const ValueVectorD yChangedInput = yChanged;
+        ChartOperationPipeData arg(&x, &y);
+        ChartOperationPipeData argChanged(&x, &yChanged);
+        operations.executeAll(arg);
+        operations.executeAll(argChanged);
+        ASSERT_NE(nullptr, arg.constValuesByIndex(1));
+        ASSERT_NE(nullptr, argChanged.constValuesByIndex(1));
+        const auto& yOut = *arg.constValuesByIndex(1);
+        const auto& yOutChanged = *argChanged.constValuesByIndex(1);
+        const auto affected = operations.affectedRowRange(20, 21, y.size()).value();
+        EXPECT_EQ(std::make_pair(size_t(17), size_t(24)), affected);
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            if (i < affected.first || i > affected.second)
+            {
+                EXPECT_NEAR(yOut[i], yOutChanged[i], 1e-12) << "i = " << i; // Not requiring exact equality since average smoothing uses running sum which may accumulate rounding differences.
+            }
+        }
+        EXPECT_NE(yOut[17], yOutChanged[17]);
+        EXPECT_NE(yOut[24], yOutChanged[24]);
+
+        // updateOutputIncrementally(): updating output of unchanged input to that of changed input should give the same result as full execution.
+        ChartOperationPipeData updated(&x, &yInput); // Const input so that output is stored in internal vectors of 'updated'.
+        operations.executeAll(updated);
+        EXPECT_TRUE(operations.updateOutputIncrementally(x, yInput, x, yChangedInput, updated));
+        ASSERT_NE(nullptr, updated.constValuesByIndex(0));
+        ASSERT_NE(nullptr, updated.constValuesByIndex(1));
+        const auto& xUpdated = *updated.constValuesByIndex(0);
+        const auto& yUpdated = *updated.constValuesByIndex(1);
+        ASSERT_EQ(yOutChanged.size(), yUpdated.size());
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            EXPECT_EQ(x[i], xUpdated[i]);
+            EXPECT_NEAR(yOutChanged[i], yUpdated[i], 1e-12) << "i = " << i;
+        }
+
+        // Change at the edge
+        ValueVectorD yChangedAtEdge = yChangedInput;
+        yChangedAtEdge[49] = 1000;
+        EXPECT_TRUE(operations.updateOutputIncrementally(x, yChangedInput, x, yChangedAtEdge, updated));
+        ChartOperationPipeData argChangedAtEdge(&x, &yChangedAtEdge);
+        operations.executeAll(argChangedAtEdge);
+        const auto& yOutChangedAtEdge = *argChangedAtEdge.constValuesByIndex(1);
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            EXPECT_NEAR(yOutChangedAtEdge[i], yUpdated[i], 1e-12) << "i = " << i;
+        }
+
+        // Unchanged input: output is up-to-date as such.
+        EXPECT_TRUE(operations.updateOutputIncrementally(x, yChangedAtEdge, x, yChangedAtEdge, updated));
+
+        // Size change is not incrementally updatable and must leave output untouched.
+        ValueVectorD xShort(10);
+        ValueVectorD yShort(10);
+        EXPECT_FALSE(operations.updateOutputIncrementally(x, yChangedAtEdge, xShort, yShort, updated));
+        EXPECT_EQ(y.size(), updated.constValuesByIndex(1)->size());
+    }
+
+    // updateOutputIncrementally() with chain having operation that may remove rows
+    {
+        ChartEntryOperationList operations;
+        operations.push_back(opManager.createOperation(DFG_UTF8("passWindow(y, 0, 5)")));
+        ValueVectorD x(5);
+        ValueVectorD y(5);
+        ValueVectorD y2(5);
+        for (size_t i = 0; i < y.size(); ++i)
+        {
+            x[i] = static_cast<double>(i);
+            y[i] = static_cast<double>(i);
+            y2[i] = static_cast<double>(i);
+        }
+        y2[2] = 10;
+        ChartOperationPipeData arg(&x, &y);
+        operations.executeAll(arg);
+        EXPECT_FALSE(operations.updateOutputIncrementally(x, y, x, y2, arg));
+    }
+}
+
 namespace
 {
     class ControlItemMoc : public ::DFG_MODULE_NS(charts)::AbstractChartControlItem
@@ -1063,4 +1235,109 @@ TEST(dfgCharts, ChartOperationPipeData)
     }
 }
 
+TEST(dfgCharts, minMaxPerBucketDownsample)
+{
+    using namespace ::DFG_MODULE_NS(charts);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    //                        bucket: 0        | 1           | 2    | 3
+    const std::vector<double> yVals = { 3, 1, 5, 2, 4, 4, 7, 0, 1, 2, 9, nan, 8, 6 };
+    const std::vector<int> buckets  = { 0, 0, 0, 0, 1, 1, 1, 1, 1, 2, 2, 2,   2, 3 };
+    std::vector<size_t> indexes;
+    const auto nCount = minMaxPerBucketDownsample(0, yVals.size(),
+        [&](const size_t i) { return ::DFG_ROOT_NS::int64(buckets[i]); },
+        [&](const size_t i) { return yVals[i]; },
+        [&](const size_t i) { indexes.push_back(i); });
+    EXPECT_EQ(indexes.size(), nCount);
+    // Bucket 0: first=0, min=1, max=2, last=3
+    // Bucket 1: first=4, max=6, min=7, last=8
+    // Bucket 2: first=9 (also min), max=10, NaN=11, last=12
+    // Bucket 3: single point 13
+    EXPECT_EQ(std::vector<size_t>({ 0, 1, 2, 3, 4, 6, 7, 8, 9, 10, 11, 12, 13 }), indexes);
+
+    // Subrange
+    indexes.clear();
+    minMaxPerBucketDownsample(5, 10,
+        [&](const size_t i) { return ::DFG_ROOT_NS::int64(buckets[i]); },
+        [&](const size_t i) { return yVals[i]; },
+        [&](const size_t i) { indexes.push_back(i); });
+    EXPECT_EQ(std::vector<size_t>({ 5, 6, 7, 8, 9 }), indexes);
+}
+
+TEST(dfgCharts, LevelOfDetailPyramid)
+{
+    using namespace ::DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(charts);
+
+    auto randEng = ::DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+    randEng.seed(12345);
+    std::vector<double> yVals(200000);
+    for (size_t i = 0; i < yVals.size(); ++i)
+    {
+        // Random walk with occasional spikes and NaNs
+        const double prev = (i > 0 && !std::isnan(yVals[i - 1])) ? yVals[i - 1] : 0;
+        const auto r = ::DFG_MODULE_NS(rand)::rand(randEng, 0.0, 1.0);
+        if (r < 0.00005)
+            yVals[i] = std::numeric_limits<double>::quiet_NaN();
+        else if (r < 0.0005)
+            yVals[i] = prev + 1000 * (r - 0.00025);
+        else
+            yVals[i] = prev + ::DFG_MODULE_NS(rand)::rand(randEng, -1.0, 1.0);
+    }
+    const auto yAt = [&](const size_t i) { return yVals[i]; };
+
+    LevelOfDetailPyramid pyramid;
+    pyramid.build(yVals.size(), yAt);
+    EXPECT_EQ(yVals.size(), pyramid.size());
+    EXPECT_EQ(8, pyramid.levelCount()); // Group counts: 12500, 3125, 782, 196, 49, 13, 4
+    EXPECT_EQ(1, LevelOfDetailPyramid::rawPointsPerGroup(0));
+    EXPECT_EQ(16, LevelOfDetailPyramid::rawPointsPerGroup(1));
+    EXPECT_EQ(64, LevelOfDetailPyramid::rawPointsPerGroup(2));
+    for (size_t nLevel = 1; nLevel < pyramid.levelCount(); ++nLevel)
+    {
+        // Every group keeps at most 5 points (first, min, max, last, first NaN).
+        const auto nGroupCount = (yVals.size() + LevelOfDetailPyramid::rawPointsPerGroup(nLevel) - 1) / LevelOfDetailPyramid::rawPointsPerGroup(nLevel);
+        EXPECT_LE(pyramid.levelSize(nLevel), 5 * nGroupCount);
+        EXPECT_LT(pyramid.levelSize(nLevel), pyramid.levelSize(nLevel - 1));
+    }
+
+    // Pyramid must give exactly the same result as downsampling from raw data. Testing with various ranges and bucket widths,
+    // x-values are implicit indexes so bucket is simply scaled index.
+    const std::pair<size_t, size_t> ranges[] = { {0, 200000}, {0, 1}, {1, 17}, {12345, 23456}, {100, 199999}, {65536, 131072}, {199990, 200000} };
+    const size_t bucketCounts[] = { 1, 3, 100, 1000, 1920 };
+    for (const auto& range : ranges)
+    {
+        for (const auto nBucketCount : bucketCounts)
+        {
+            const auto nRangeSize = range.second - range.first;
+            const double scale = double(nBucketCount) / double(nRangeSize);
+            const auto bucketOf = [&](const size_t i) { return static_cast<int64>(std::floor((double(i) - double(range.first)) * scale)); };
+            std::vector<size_t> expected;
+            std::vector<size_t> actual;
+            const auto nExpectedCount = minMaxPerBucketDownsample(range.first, range.second, bucketOf, yAt, [&](const size_t i) { expected.push_back(i); });
+            const auto nActualCount = pyramid.downsample(range.first, range.second, nBucketCount, bucketOf, yAt, [&](const size_t i) { actual.push_back(i); });
+            EXPECT_EQ(expected.size(), nExpectedCount);
+            EXPECT_EQ(actual.size(), nActualCount);
+            EXPECT_EQ(expected, actual) << "range = [" << range.first << ", " << range.second << "), bucket count = " << nBucketCount;
+            EXPECT_LE(actual.size(), 5 * nBucketCount);
+        }
+    }
+
+    // Non-uniform buckets: bucket boundaries are not aligned with group boundaries.
+    {
+        const auto bucketOf = [](const size_t i) { return static_cast<int64>(std::floor(std::sqrt(double(i)))); };
+        std::vector<size_t> expected;
+        std::vector<size_t> actual;
+        minMaxPerBucketDownsample(1000, 150000, bucketOf, yAt, [&](const size_t i) { expected.push_back(i); });
+        pyramid.downsample(1000, 150000, 400, bucketOf, yAt, [&](const size_t i) { actual.push_back(i); });
+        EXPECT_EQ(expected, actual);
+    }
+
+    // Small data: no levels beyond raw.
+    pyramid.build(10, yAt);
+    EXPECT_EQ(1, pyramid.levelCount());
+    std::vector<size_t> actual;
+    pyramid.downsample(0, 10, 2, [](const size_t i) { return static_cast<int64>(i / 5); }, yAt, [&](const size_t i) { actual.push_back(i); });
+    EXPECT_FALSE(actual.empty());
+}
+
 #endif
@@ -1902,6 +1902,18 @@ TEST(dfgCont, IntervalSet_shift_raw)
     }
 }
 
+TEST(dfgCont, IntervalSet_equality)
+{
+    using namespace ::DFG_MODULE_NS(cont);
+    using IntervalSetT = IntervalSet<int>;
+    EXPECT_TRUE(IntervalSetT() == IntervalSetT());
+    EXPECT_TRUE(intervalSetFromString<int>("1:3; 5") == intervalSetFromString<int>("5; 1; 2:3"));
+    EXPECT_TRUE(intervalSetFromString<int>("1:3; 4") == IntervalSetT::makeSingleInterval(1, 4));
+    EXPECT_TRUE(intervalSetFromString<int>("1:3; 5") != intervalSetFromString<int>("1:3; 6"));
+    EXPECT_TRUE(intervalSetFromString<int>("1:3") != intervalSetFromString<int>("1:3; 5"));
+    EXPECT_TRUE(IntervalSetT() != IntervalSetT::makeSingleInterval(0, 0));
+}
+
 namespace
 {
     void testInt32IntervalBounds(std::true_type) // Case: 64-bit size_t
@@ -14,12 +14,15 @@
 #include <dfg/cont/CsvConfig.hpp>
 #include <dfg/cont/MapVector.hpp>
 #include <dfg/cont/tableCsv.hpp>
+#include <dfg/cont/tableCsvChunkedReader.hpp>
+#include <dfg/cont/tableCsvLazy.hpp>
 #include <dfg/cont/TrivialPair.hpp>
 #include <dfg/rand.hpp>
 #include <dfg/typeTraits.hpp>
 #include <dfg/io/BasicOmcByteStream.hpp>
 #include <dfg/io/DelimitedTextWriter.hpp>
 #include <dfg/io/OmcByteStream.hpp>
+#include <dfg/io/OfStream.hpp>
 #include <dfg/iter/szIterator.hpp>
 #include <dfg/cont/contAlg.hpp>
 #include <dfg/io/cstdio.hpp>
@@ -857,6 +860,101 @@ TEST(dfgCont, TableCsv_multiThreadedRead)
     }
 }
 
+TEST(dfgCont, TableCsv_multiThreadedReadEnclosed)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+
+    // Testing block start determination directly: all returned positions must be record starts.
+    {
+        const char szInput[] = "\"a\nb\",c\n\"d\"\"\n\n\",e\nf\"\n\"g\"h\n,\"i\n\"\n\"j,\nk\"\"\"\n";
+        // Records start at: 0, 8, 18, 21, 26, 32
+        const auto bytes = makeRange(szInput, szInput + DFG_COUNTOF_SZ(szInput));
+        for (size_t nBlockCount = 1; nBlockCount < DFG_COUNTOF_SZ(szInput) + 3; ++nBlockCount)
+        {
+            const auto blockStarts = TableT::determineBlockStartPosEnclosingAware(bytes, nBlockCount, '\n', '"', ',');
+            DFGTEST_EXPECT_LT(blockStarts.size(), Max<size_t>(1, nBlockCount));
+            DFGTEST_EXPECT_TRUE(std::is_sorted(blockStarts.begin(), blockStarts.end()));
+            for (const auto nPos : blockStarts)
+            {
+                DFGTEST_EXPECT_TRUE(nPos == 8 || nPos == 18 || nPos == 21 || nPos == 26 || nPos == 32);
+            }
+        }
+    }
+
+    // Comparing multithreaded read to single-threaded read on randomly generated enclosed csv with multiline cells.
+    {
+        auto randEng = ::DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+        randEng.seed(987654);
+        const auto randInt = [&](const int nMin, const int nMax) { return ::DFG_MODULE_NS(rand)::rand(randEng, nMin, nMax); };
+        const char szContentChars[] = "ab \",\n\r";
+        const auto randomContent = [&](const bool bAllowControls)
+        {
+            std::string s;
+            const auto nLength = randInt(0, 6);
+            for (int i = 0; i < nLength; ++i)
+            {
+                const auto c = szContentChars[randInt(0, (bAllowControls) ? static_cast<int>(DFG_COUNTOF_SZ(szContentChars)) - 1 : 2)];
+                s.push_back(c);
+                if (c == '"')
+                    s.push_back('"');
+            }
+            return s;
+        };
+
+        std::string sCsv;
+        for (int r = 0; r < 400; ++r)
+        {
+            const auto nColCount = randInt(1, 5);
+            for (int c = 0; c < nColCount; ++c)
+            {
+                if (c > 0)
+                    sCsv.push_back(',');
+                const auto nCellType = randInt(0, 3);
+                if (nCellType == 0) // Naked cell, may have enclosing chars after first char.
+                    sCsv += "x" + randomContent(false);
+                else if (nCellType == 3) // Enclosed cell with past-enclosed chars
+                    sCsv += "\"" + randomContent(true) + "\"p";
+                else // Enclosed cell
+                    sCsv += "\"" + randomContent(true) + "\"";
+            }
+            sCsv.push_back('\n');
+        }
+
+        const auto readOptionsBase = TableCsvReadWriteOptions::fromReadTemplate_commaQuoteEolNUtf8();
+
+        TableT tSingleThreaded;
+        tSingleThreaded.readFromMemory(sCsv.data(), sCsv.size(), readOptionsBase);
+        DFGTEST_EXPECT_LE(tSingleThreaded.readFormat().getReadStat<TableCsvReadStat::threadCount>(), 1u);
+        DFGTEST_EXPECT_LEFT(400, tSingleThreaded.rowCountByMaxRowIndex());
+
+        for (uint32 nThreadCount = 2; nThreadCount <= 8; ++nThreadCount)
+        {
+            TableCsvReadWriteOptions readOptions = readOptionsBase;
+            readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadCount>(nThreadCount);
+            readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadBlockSizeMinimum>(0); // Reducing block size to allow threaded reading even for small input.
+            TableT tMultiThreaded;
+            tMultiThreaded.readFromMemory(sCsv.data(), sCsv.size(), readOptions);
+            DFGTEST_EXPECT_LEFT(nThreadCount, tMultiThreaded.readFormat().getReadStat<TableCsvReadStat::threadCount>());
+            DFGTEST_EXPECT_LEFT(StringViewAscii(DFG_ASCII("viewc_enclosed")), tMultiThreaded.readFormat().getReadStat<TableCsvReadStat::appenderType>());
+            DFGTEST_EXPECT_TRUE(tSingleThreaded.isContentAndSizesIdenticalWith(tMultiThreaded));
+            DFGTEST_EXPECT_TRUE(tSingleThreaded.readFormat().isFormatMatchingWith(tMultiThreaded.readFormat()));
+        }
+
+        // Separator auto-detection is not compatible with quote-aware splitting -> expecting single-threaded read.
+        {
+            TableCsvReadWriteOptions readOptions = readOptionsBase;
+            readOptions.separatorChar(::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharAutoDetect);
+            readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadCount>(2);
+            readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadBlockSizeMinimum>(0);
+            TableT table;
+            table.readFromMemory(sCsv.data(), sCsv.size(), readOptions);
+            DFGTEST_EXPECT_LE(table.readFormat().getReadStat<TableCsvReadStat::threadCount>(), 1u);
+        }
+    }
+}
+
 TEST(dfgCont, TableCsv_multiThreadedReadPerformance)
 {
 #if DFGTEST_ENABLE_BENCHMARKS == 0
@@ -922,6 +1020,587 @@ TEST(dfgCont, TableCsv_multiThreadedReadPerformance)
 #endif // DFGTEST_ENABLE_BENCHMARKS
 }
 
+TEST(dfgCont, TableCsv_multiThreadedReadMergePerformance)
+{
+#if DFGTEST_ENABLE_BENCHMARKS == 0
+    DFGTEST_MESSAGE("TableCsv_multiThreadedReadMergePerformance skipped due to build settings");
+#else
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+
+    // Generating wide table in memory: with many columns, time spent in block merging becomes significant compared to block reading.
+    const size_t nRowCount = 2000;
+    const size_t nColCount = 2000;
+    std::string sCsv;
+    for (size_t r = 0; r < nRowCount; ++r)
+    {
+        for (size_t c = 0; c < nColCount; ++c)
+        {
+            if (c > 0)
+                sCsv.push_back(',');
+            sCsv += std::to_string(r * c % 1000);
+        }
+        sCsv.push_back('\n');
+    }
+
+    const auto baseFormatDef = CsvFormatDefinition(',', ::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharNone, ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8);
+    for (const uint32 nThreadCount : { 2, 4, 8, 16, 32 })
+    {
+        TableT table;
+        TableCsvReadWriteOptions readOptions = baseFormatDef;
+        readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadCount>(nThreadCount);
+        readOptions.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadBlockSizeMinimum>(0);
+        table.readFromMemory(sCsv.data(), sCsv.size(), readOptions);
+        const auto& readFormat = table.readFormat();
+        DFGTEST_EXPECT_LEFT(nRowCount, table.rowCountByMaxRowIndex());
+        DFGTEST_EXPECT_LEFT(nColCount, table.colCountByMaxColIndex());
+        DFGTEST_MESSAGE("Threads: " << readFormat.getReadStat<TableCsvReadStat::threadCount>()
+                        << ", block reads: " << readFormat.getReadStat<TableCsvReadStat::timeBlockReads>()
+                        << " s, block merge: " << readFormat.getReadStat<TableCsvReadStat::timeBlockMerge>()
+                        << " s, total: " << readFormat.getReadStat<TableCsvReadStat::timeTotal>() << " s");
+    }
+#endif // DFGTEST_ENABLE_BENCHMARKS
+}
+
+TEST(dfgCont, TableCsv_memoryMappedCellStorage)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+    using PropertyId = TableCsvReadWriteOptions::PropertyId;
+
+    const char szPath[] = "testfiles/generated/memoryMappedCellStorage.csv";
+    const char szPathRn[] = "testfiles/generated/memoryMappedCellStorage_rn.csv";
+    // Input has naked, enclosed, multiline, escaped and empty cells, last row has no eol.
+    const std::string sContent = "a,b,\"c\"\"d\",\"e\nf\"\n1,,3,\"\"\n\"g\",h,,\nlast,cell";
+    std::string sContentRn;
+    for (const auto c : sContent)
+    {
+        if (c == '\n')
+            sContentRn.push_back('\r');
+        sContentRn.push_back(c);
+    }
+    DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPath, sContent.data(), sContent.size()));
+    DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPathRn, sContentRn.data(), sContentRn.size()));
+
+    const auto testFile = [&](const char* pszPath, const std::string& sExpectedFileContent, const ::DFG_MODULE_NS(io)::EndOfLineType eolType)
+    {
+        const auto baseOptions = TableCsvReadWriteOptions(',', '"', eolType, ::DFG_MODULE_NS(io)::encodingUTF8);
+        TableT tRegular;
+        tRegular.readFromFile(pszPath, baseOptions);
+        DFGTEST_EXPECT_FALSE(tRegular.hasExternalStorage());
+        DFGTEST_EXPECT_LEFT(4, tRegular.rowCountByMaxRowIndex());
+        DFGTEST_EXPECT_LEFT(4, tRegular.colCountByMaxColIndex());
+
+        for (const uint32 nThreadCount : { 1, 2 })
+        {
+            auto options = baseOptions;
+            options.setPropertyT<PropertyId::readOpt_memoryMappedCellStorage>(true);
+            options.setPropertyT<PropertyId::readOpt_threadCount>(nThreadCount);
+            options.setPropertyT<PropertyId::readOpt_threadBlockSizeMinimum>(0);
+            TableT tMapped;
+            tMapped.readFromFile(pszPath, options);
+            DFGTEST_EXPECT_LEFT((nThreadCount == 1) ? 0u : nThreadCount, tMapped.readFormat().getReadStat<TableCsvReadStat::threadCount>()); // Note: threadCount is not set in single-threaded read.
+            DFGTEST_EXPECT_TRUE(tMapped.hasExternalStorage());
+            // Only the cell with escaped enclosing char and the multiline cell should have been copied.
+            DFGTEST_EXPECT_LEFT(std::strlen("c\"d") + 1 + std::strlen(tRegular(0, 3).c_str()) + 1, tMapped.contentStorageSizeInBytes());
+            // Views should not need terminated copies.
+            for (uint32 r = 0; r < 4; ++r)
+            {
+                for (uint32 c = 0; c < 4; ++c)
+                    DFGTEST_EXPECT_LEFT(tRegular.viewAt(r, c), tMapped.viewAt(r, c));
+            }
+            DFGTEST_EXPECT_LEFT(DFG_UTF8("last"), tMapped.viewAt(3, 0));
+            DFGTEST_EXPECT_LEFT(DFG_UTF8("cell"), tMapped.viewAt(3, 1));
+            DFGTEST_EXPECT_LEFT(tRegular.cellCountNonEmpty(), tMapped.cellCountNonEmpty());
+            DFGTEST_EXPECT_TRUE(tRegular.isContentAndSizesIdenticalWith(tMapped));
+            DFGTEST_EXPECT_STREQ(tRegular(0, 3).c_str(), tMapped(0, 3).c_str());
+            DFGTEST_EXPECT_STREQ("", tMapped(1, 3).c_str());
+            DFGTEST_EXPECT_STREQ("cell", tMapped(3, 1).c_str());
+            // Terminated copies should remain the same on repeated calls.
+            DFGTEST_EXPECT_LEFT(tMapped(0, 1).c_str(), tMapped(0, 1).c_str());
+            // Read loops get temporary terminated content
+            {
+                std::string sBuffer;
+                tMapped.withTerminatedContentAt(3, 0, sBuffer, [&](const SzPtrUtf8R psz) { DFGTEST_EXPECT_STREQ("last", psz.c_str()); });
+                tMapped.withTerminatedContentAt(3, 3, sBuffer, [&](const SzPtrUtf8R psz) { DFGTEST_EXPECT_TRUE(!psz); });
+                for (uint32 c = 0; c < 4; ++c)
+                {
+                    std::vector<std::string> expected, actual;
+                    tRegular.forEachFwdRowInColumn(c, [&](const uint32 r, const SzPtrUtf8R psz) { expected.push_back(std::to_string(r) + ":" + psz.c_str()); });
+                    tMapped.forEachFwdRowInColumn(c, [&](const uint32 r, const SzPtrUtf8R psz) { actual.push_back(std::to_string(r) + ":" + psz.c_str()); });
+                    DFGTEST_EXPECT_LEFT(expected, actual);
+                }
+            }
+
+            // Writing should produce the same output as from regular table.
+            {
+                ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string> ostrmRegular, ostrmMapped, ostrmMappedMt;
+                tRegular.writeToStream(ostrmRegular);
+                tMapped.writeToStream(ostrmMapped);
+                tMapped.writeToStreamMultiThreaded(ostrmMappedMt, tMapped.saveFormat());
+                DFGTEST_EXPECT_LEFT(ostrmRegular.m_internalData, ostrmMapped.m_internalData);
+                DFGTEST_EXPECT_LEFT(ostrmRegular.m_internalData, ostrmMappedMt.m_internalData);
+            }
+
+            // Editing should work as usual
+            tMapped.setElement(0, 0, DFG_UTF8("edited"));
+            DFGTEST_EXPECT_STREQ("edited", tMapped(0, 0).c_str());
+            DFGTEST_EXPECT_STREQ("b", tMapped(0, 1).c_str());
+
+            // Mapping is read-only so file should be unchanged.
+            DFGTEST_EXPECT_LEFT(sExpectedFileContent, ::DFG_MODULE_NS(io)::fileToByteContainer<std::string>(pszPath));
+
+            tMapped.clear();
+            DFGTEST_EXPECT_FALSE(tMapped.hasExternalStorage());
+        }
+    };
+    testFile(szPath, sContent, ::DFG_MODULE_NS(io)::EndOfLineTypeN);
+    testFile(szPathRn, sContentRn, ::DFG_MODULE_NS(io)::EndOfLineTypeRN);
+
+    // Custom cell handler derived from DefaultCellHandler and separator auto-detection
+    {
+        struct CountingCellHandler : public TableT::DefaultCellHandler
+        {
+            using BaseClass = TableT::DefaultCellHandler;
+            CountingCellHandler(TableT& rTable, size_t& rCount) : BaseClass(rTable), m_rCount(rCount) {}
+            static constexpr ::DFG_MODULE_NS(cont)::DFG_DETAIL_NS::ConcurrencySafeCellHandlerNo isConcurrencySafeT() { return ::DFG_MODULE_NS(cont)::DFG_DETAIL_NS::ConcurrencySafeCellHandlerNo(); }
+            void operator()(const size_t nRow, const size_t nCol, const char* pData, const size_t nCount)
+            {
+                BaseClass::operator()(nRow, nCol, pData, nCount);
+                ++m_rCount;
+            }
+            size_t& m_rCount;
+        };
+        TableT tRegular;
+        tRegular.readFromFile(szPath, TableCsvReadWriteOptions(',', '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8));
+        TableCsvReadWriteOptions options(::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharAutoDetect, '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8);
+        options.setPropertyT<PropertyId::readOpt_memoryMappedCellStorage>(true);
+        TableT tMapped;
+        size_t nCellCount = 0;
+        tMapped.readFromFile(szPath, options, CountingCellHandler(tMapped, nCellCount));
+        DFGTEST_EXPECT_TRUE(tMapped.hasExternalStorage());
+        DFGTEST_EXPECT_LEFT(14u, nCellCount);
+        DFGTEST_EXPECT_TRUE(tRegular.isContentAndSizesIdenticalWith(tMapped));
+        DFGTEST_EXPECT_LEFT(DFG_UTF8("h"), tMapped.viewAt(2, 1));
+    }
+
+    // Non-existing file should result to empty table also with memory mapped storage.
+    {
+        TableCsvReadWriteOptions options(',', '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8);
+        options.setPropertyT<PropertyId::readOpt_memoryMappedCellStorage>(true);
+        TableT table;
+        table.readFromFile("testfiles/generated/memoryMappedCellStorage_nonExisting.csv", options);
+        DFGTEST_EXPECT_LEFT(0, table.rowCountByMaxRowIndex());
+        DFGTEST_EXPECT_FALSE(table.hasExternalStorage());
+    }
+}
+
+TEST(dfgCont, TableCsvLazy)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+    using LazyTableT = TableCsvLazy<char, uint32>;
+
+    // Returns true if lazy table has the same dimensions and content as the regular table.
+    const auto isIdentical = [](const TableT& table, LazyTableT& lazyTable)
+    {
+        if (table.rowCountByMaxRowIndex() != lazyTable.rowCountByMaxRowIndex() || table.colCountByMaxColIndex() != lazyTable.colCountByMaxColIndex())
+            return false;
+        for (uint32 r = 0; r < table.rowCountByMaxRowIndex(); ++r)
+        {
+            for (uint32 c = 0; c < table.colCountByMaxColIndex(); ++c)
+            {
+                const auto p0 = table(r, c);
+                const auto p1 = lazyTable(r, c);
+                if (!p0 != !p1 || (p0 && std::strcmp(p0.c_str(), p1.c_str()) != 0))
+                    return false;
+            }
+        }
+        return true;
+    };
+
+    // Comparing to regular read on randomly generated csv with enclosed and multiline cells.
+    {
+        auto randEng = ::DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+        randEng.seed(123456);
+        const auto randInt = [&](const int nMin, const int nMax) { return ::DFG_MODULE_NS(rand)::rand(randEng, nMin, nMax); };
+        const char szContentChars[] = "ab\";\n";
+        std::string sCsv;
+        for (int r = 0; r < 500; ++r)
+        {
+            const auto nColCount = randInt(1, 6);
+            for (int c = 0; c < nColCount; ++c)
+            {
+                if (c > 0)
+                    sCsv.push_back(';');
+                const auto bEnclosed = (randInt(0, 1) == 1);
+                if (bEnclosed)
+                    sCsv.push_back('"');
+                for (int i = 0, nLength = randInt(0, 5); i < nLength; ++i)
+                {
+                    const auto ch = szContentChars[randInt(0, (bEnclosed) ? static_cast<int>(DFG_COUNTOF_SZ(szContentChars)) - 1 : 1)];
+                    sCsv.push_back(ch);
+                    if (ch == '"')
+                        sCsv.push_back('"');
+                }
+                if (bEnclosed)
+                    sCsv.push_back('"');
+            }
+            if (r != 499)
+                sCsv.push_back('\n');
+        }
+
+        // Both explicit and auto-detected separator.
+        for (const auto cSep : { int32(';'), int32(::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharAutoDetect) })
+        {
+            const TableCsvReadWriteOptions options(cSep, '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8);
+            TableT table;
+            table.readFromMemory(sCsv.data(), sCsv.size(), options);
+            DFGTEST_EXPECT_LEFT(500, table.rowCountByMaxRowIndex());
+
+            LazyTableT lazyTable(64);
+            DFGTEST_EXPECT_TRUE(lazyTable.openFromMemory(sCsv.data(), sCsv.size(), options));
+            DFGTEST_EXPECT_LEFT(';', lazyTable.readFormat().separatorChar());
+            DFGTEST_EXPECT_LEFT(0, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_LEFT(500, lazyTable.rowCountByMaxRowIndex());
+
+            // Accessing a single cell should parse only the chunk containing the row.
+            DFGTEST_EXPECT_STREQ(table(200, 0).c_str(), lazyTable(200, 0).c_str());
+            DFGTEST_EXPECT_LEFT(1, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(192));
+            DFGTEST_EXPECT_FALSE(lazyTable.isRowLoaded(191));
+            DFGTEST_EXPECT_FALSE(lazyTable.isRowLoaded(256));
+
+            DFGTEST_EXPECT_TRUE(isIdentical(table, lazyTable));
+            DFGTEST_EXPECT_LEFT(8, lazyTable.loadedChunkCount());
+
+            lazyTable.releaseLoadedRows();
+            DFGTEST_EXPECT_LEFT(0, lazyTable.loadedChunkCount());
+            uint32 nCellCount = 0;
+            bool bForEachMatches = true;
+            lazyTable.forEachFwdRowInColumn(1, [&](const uint32 r, const TableT::SzPtrR psz)
+            {
+                ++nCellCount;
+                bForEachMatches = bForEachMatches && table(r, 1) && std::strcmp(table(r, 1).c_str(), psz.c_str()) == 0;
+            });
+            DFGTEST_EXPECT_TRUE(bForEachMatches);
+            uint32 nExpectedCellCount = 0;
+            table.forEachFwdRowInColumn(1, [&](Dummy, Dummy) { ++nExpectedCellCount; });
+            DFGTEST_EXPECT_LEFT(nExpectedCellCount, nCellCount);
+
+            // Bounded chunk cache: at most maxLoadedChunkCount() chunks are kept and least recently used is released first.
+            DFGTEST_EXPECT_LEFT(LazyTableT::defaultMaxLoadedChunkCount(), lazyTable.maxLoadedChunkCount());
+            lazyTable.setMaxLoadedChunkCount(2);
+            DFGTEST_EXPECT_LEFT(2, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_TRUE(isIdentical(table, lazyTable));
+            DFGTEST_EXPECT_LEFT(2, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(499));
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(384));
+            DFGTEST_EXPECT_FALSE(lazyTable.isRowLoaded(383));
+            DFGTEST_EXPECT_STREQ(table(0, 0).c_str(), lazyTable(0, 0).c_str()); // Releases chunk of rows [384, 447]
+            DFGTEST_EXPECT_FALSE(lazyTable.isRowLoaded(384));
+            DFGTEST_EXPECT_STREQ(table(450, 0).c_str(), lazyTable(450, 0).c_str()); // Marks chunk of row 450 as most recently used.
+            DFGTEST_EXPECT_STREQ(table(64, 0).c_str(), lazyTable(64, 0).c_str()); // Releases chunk of row 0.
+            DFGTEST_EXPECT_LEFT(2, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(450));
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(64));
+            DFGTEST_EXPECT_FALSE(lazyTable.isRowLoaded(0));
+
+            nCellCount = 0;
+            bForEachMatches = true;
+            size_t nMaxLoadedDuringForEach = 0;
+            lazyTable.forEachFwdRowInColumn(1, [&](const uint32 r, const TableT::SzPtrR psz)
+            {
+                ++nCellCount;
+                nMaxLoadedDuringForEach = Max(nMaxLoadedDuringForEach, lazyTable.loadedChunkCount());
+                bForEachMatches = bForEachMatches && table(r, 1) && std::strcmp(table(r, 1).c_str(), psz.c_str()) == 0;
+            });
+            DFGTEST_EXPECT_TRUE(bForEachMatches);
+            DFGTEST_EXPECT_LEFT(nExpectedCellCount, nCellCount);
+            DFGTEST_EXPECT_LEFT(2, nMaxLoadedDuringForEach);
+
+            lazyTable.setMaxLoadedChunkCount(1);
+            DFGTEST_EXPECT_LEFT(1, lazyTable.loadedChunkCount());
+            DFGTEST_EXPECT_TRUE(lazyTable.isRowLoaded(499));
+
+            // 0 = no limit
+            lazyTable.setMaxLoadedChunkCount(0);
+            DFGTEST_EXPECT_TRUE(isIdentical(table, lazyTable));
+            DFGTEST_EXPECT_LEFT(8, lazyTable.loadedChunkCount());
+        }
+    }
+
+    // Reading from file with BOM, \r\n eol, empty lines and without enclosing char.
+    {
+        const char szPath[] = "testfiles/generated/tableCsvLazy.csv";
+        const std::string sContent = "\xEF\xBB\xBF" "a,b,c\r\n\r\n\"d,e\r\n1,2\r\n,\r\n";
+        DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPath, sContent.data(), sContent.size()));
+        const TableCsvReadWriteOptions options(',', ::DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharNone, ::DFG_MODULE_NS(io)::EndOfLineTypeRN, ::DFG_MODULE_NS(io)::encodingUnknown);
+        TableT table;
+        table.readFromFile(szPath, options);
+        for (const uint32 nRowsPerChunk : { 1, 2, 10 })
+        {
+            LazyTableT lazyTable(nRowsPerChunk);
+            DFGTEST_EXPECT_TRUE(lazyTable.open(szPath, options));
+            DFGTEST_EXPECT_TRUE(isIdentical(table, lazyTable));
+            DFGTEST_EXPECT_STREQ("\"d", lazyTable(2, 0).c_str());
+            DFGTEST_EXPECT_TRUE(lazyTable(5, 0).c_str() == nullptr);
+        }
+
+        LazyTableT lazyTable;
+        DFGTEST_EXPECT_FALSE(lazyTable.open("testfiles/generated/tableCsvLazy_nonExisting.csv", options));
+        DFGTEST_EXPECT_LEFT(0, lazyTable.rowCountByMaxRowIndex());
+    }
+}
+
+TEST(dfgCont, TableCsvChunkedReader)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+    using ChunkedReaderT = TableCsvChunkedReader<char, uint32>;
+
+    std::string sCsv;
+    for (int r = 0; r < 1000; ++r)
+        sCsv += format_fmt("{0},\"a{0}\nb\",{1}\n", r, (r % 3 == 0) ? "" : "x");
+    const auto readOptions = TableCsvReadWriteOptions::fromReadTemplate_commaQuoteEolNUtf8();
+
+    // Collects chunks to single table, checking chunk properties on the way.
+    const auto createChunkCollector = [](TableT& dest, const uint32 nRowsPerChunk, bool& bChunksOk)
+    {
+        return [&, nRowsPerChunk](const TableT& chunk, const uint32 nFirstRow)
+        {
+            bChunksOk = bChunksOk && chunk.rowCountByMaxRowIndex() <= nRowsPerChunk && nFirstRow == dest.rowCountByMaxRowIndex();
+            chunk.forEachNonNullCell([&](const uint32 r, const uint32 c, const TableT::SzPtrR psz)
+            {
+                dest.setElement(nFirstRow + r, c, psz);
+            });
+        };
+    };
+
+    // Basic read
+    {
+        TableT table;
+        table.readFromMemory(sCsv.data(), sCsv.size(), readOptions);
+        ChunkedReaderT reader(64);
+        TableT collected;
+        bool bChunksOk = true;
+        DFGTEST_EXPECT_TRUE(reader.readFromMemory(sCsv.data(), sCsv.size(), readOptions, createChunkCollector(collected, 64, bChunksOk)));
+        DFGTEST_EXPECT_TRUE(bChunksOk);
+        DFGTEST_EXPECT_LEFT(16, reader.chunkCount());
+        DFGTEST_EXPECT_TRUE(table.isContentAndSizesIdenticalWith(collected));
+        DFGTEST_EXPECT_LEFT(',', reader.readFormat().separatorChar());
+    }
+
+    // Stopping read from callback
+    {
+        ChunkedReaderT reader(100);
+        uint32 nLastFirstRow = 0;
+        DFGTEST_EXPECT_FALSE(reader.readFromMemory(sCsv.data(), sCsv.size(), readOptions, [&](const TableT&, const uint32 nFirstRow)
+        {
+            nLastFirstRow = nFirstRow;
+            return nFirstRow < 200;
+        }));
+        DFGTEST_EXPECT_LEFT(3, reader.chunkCount());
+        DFGTEST_EXPECT_LEFT(200, nLastFirstRow);
+
+        // Reader should be usable after stopped read.
+        size_t nCallCount = 0;
+        DFGTEST_EXPECT_TRUE(reader.readFromMemory(sCsv.data(), sCsv.size(), readOptions, [&](const TableT&, Dummy) { ++nCallCount; }));
+        DFGTEST_EXPECT_LEFT(10, nCallCount);
+    }
+
+    // Changing chunk size from callback
+    {
+        ChunkedReaderT reader(10);
+        std::vector<uint32> firstRows;
+        DFGTEST_EXPECT_TRUE(reader.readFromMemory(sCsv.data(), sCsv.size(), readOptions, [&](const TableT&, const uint32 nFirstRow)
+        {
+            firstRows.push_back(nFirstRow);
+            reader.setRowsPerChunk(300);
+        }));
+        DFGTEST_EXPECT_LEFT(300, reader.rowsPerChunk());
+        DFGTEST_EXPECT_LEFT(std::vector<uint32>({ 0, 10, 310, 610, 910 }), firstRows);
+    }
+
+    // Filtered read: rows and content filter
+    {
+        TableT table;
+        auto tableFilter = table.createFilterCellHandler(SimpleStringMatcher(DFG_UTF8("x")), 2);
+        tableFilter.setIncludeRows(intervalSetFromString<uint32>("10:500"));
+        table.readFromMemory(sCsv.data(), sCsv.size(), readOptions, tableFilter);
+
+        ChunkedReaderT reader(50);
+        auto chunkFilter = reader.createFilterCellHandler(SimpleStringMatcher(DFG_UTF8("x")), 2);
+        chunkFilter.setIncludeRows(intervalSetFromString<uint32>("10:500"));
+        TableT collected;
+        bool bChunksOk = true;
+        DFGTEST_EXPECT_TRUE(reader.readFromMemory(sCsv.data(), sCsv.size(), readOptions, chunkFilter, createChunkCollector(collected, 50, bChunksOk)));
+        DFGTEST_EXPECT_TRUE(bChunksOk);
+        DFGTEST_EXPECT_LEFT(328, table.rowCountByMaxRowIndex());
+        DFGTEST_EXPECT_LEFT(7, reader.chunkCount());
+        DFGTEST_EXPECT_TRUE(table.isContentAndSizesIdenticalWith(collected));
+    }
+
+    // Reading from file
+    {
+        TableT table;
+        table.readFromFile("testfiles/matrix_3x3.txt", table.defaultReadFormat());
+        ChunkedReaderT reader(2);
+        TableT collected;
+        bool bChunksOk = true;
+        DFGTEST_EXPECT_TRUE(reader.readFromFile("testfiles/matrix_3x3.txt", table.defaultReadFormat(), createChunkCollector(collected, 2, bChunksOk)));
+        DFGTEST_EXPECT_TRUE(bChunksOk);
+        DFGTEST_EXPECT_LEFT(2, reader.chunkCount());
+        DFGTEST_EXPECT_TRUE(table.isContentAndSizesIdenticalWith(collected));
+    }
+}
+
+TEST(dfgCont, TableCsv_declaredTypedColumnCache)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+    std::string sCsv = "a,b\n";
+    for (int i = 0; i < 1000; ++i)
+        sCsv += format_fmt("{},{}.5\n", i, i);
+
+    for (const uint32 nThreadCount : { 1, 2 })
+    {
+        TableCsvReadWriteOptions options = TableCsvReadWriteOptions::fromReadTemplate_commaQuoteEolNUtf8();
+        options.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadCount>(nThreadCount);
+        options.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_threadBlockSizeMinimum>(0);
+        TableT table;
+        table.declareTypedColumnCache<int64>(0);
+        table.declareTypedColumnCache<double>(1);
+        table.readFromMemory(sCsv.data(), sCsv.size(), options);
+        DFGTEST_EXPECT_LEFT(1001, table.rowCountByMaxRowIndex());
+        const auto pInts = table.typedColumnCacheIfAvailable<int64>(0);
+        const auto pDoubles = table.typedColumnCacheIfAvailable<double>(1);
+        DFGTEST_ASSERT_TRUE(pInts != nullptr && pDoubles != nullptr);
+        DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+        DFGTEST_EXPECT_LEFT(1000, pInts->validCount());
+        DFGTEST_EXPECT_FALSE(pInts->isValid(0));
+        DFGTEST_EXPECT_LEFT(999, pInts->value(1000));
+        DFGTEST_EXPECT_LEFT(1000, pDoubles->validCount());
+        DFGTEST_EXPECT_LEFT(500.5, pDoubles->value(501));
+    }
+
+    // Testing that caches are built correctly also when cells refer to memory mapped file (i.e. content is not null terminated).
+    {
+        const char szPath[] = "testfiles/generated/declaredTypedColumnCache.csv";
+        DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPath, sCsv.data(), sCsv.size()));
+        TableCsvReadWriteOptions options = TableCsvReadWriteOptions::fromReadTemplate_commaQuoteEolNUtf8();
+        options.setPropertyT<TableCsvReadWriteOptions::PropertyId::readOpt_memoryMappedCellStorage>(true);
+        TableT table;
+        table.declareTypedColumnCache<int64>(0);
+        table.declareTypedColumnCache<double>(1);
+        table.readFromFile(szPath, options);
+        DFGTEST_EXPECT_TRUE(table.hasExternalStorage());
+        const auto pInts = table.typedColumnCacheIfAvailable<int64>(0);
+        const auto pDoubles = table.typedColumnCacheIfAvailable<double>(1);
+        DFGTEST_ASSERT_TRUE(pInts != nullptr && pDoubles != nullptr);
+        DFGTEST_EXPECT_LEFT(1000, pInts->validCount());
+        DFGTEST_EXPECT_LEFT(1000, pDoubles->validCount());
+        for (int i = 0; i < 1000; ++i)
+        {
+            DFGTEST_EXPECT_LEFT(i, pInts->value(static_cast<size_t>(i + 1)));
+            DFGTEST_EXPECT_LEFT(i + 0.5, pDoubles->value(static_cast<size_t>(i + 1)));
+        }
+    }
+}
+
+TEST(dfgCont, TableCsv_multiThreadedWrite)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(cont);
+    using TableT = TableCsv<char, uint32>;
+    using PropertyId = TableCsvReadWriteOptions::PropertyId;
+
+    // Non-square table with content that needs enclosing and non-ASCII content.
+    TableT table;
+    for (uint32 r = 0; r < 1000; ++r)
+    {
+        for (uint32 c = 0; c < 5; ++c)
+        {
+            if ((r + c) % 7 == 0)
+                continue;
+            const auto s = ::DFG_MODULE_NS(str)::toStrC(r * 10 + c) + ((c == 2) ? "a,\"b\"\n" : "") + ((c == 3) ? "\xc3\xa4" : "");
+            table.setElement(r, c, SzPtrUtf8(s.c_str()));
+        }
+    }
+    table.setElement(1002, 6, DFG_UTF8("last"));
+
+    const auto writeToString = [&](const TableCsvReadWriteOptions& format, const bool bMultiThreaded)
+    {
+        ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string> strm;
+        if (bMultiThreaded)
+            table.writeToStreamMultiThreaded(strm, format);
+        else
+        {
+            auto policy = TableT::createWritePolicy<decltype(strm)>(format);
+            table.writeToStream(strm, policy);
+        }
+        return strm.releaseData();
+    };
+
+    for (const auto encoding : { ::DFG_MODULE_NS(io)::encodingUTF8, ::DFG_MODULE_NS(io)::encodingUTF16Le })
+    {
+        TableCsvReadWriteOptions format(',', '"', ::DFG_MODULE_NS(io)::EndOfLineTypeRN, encoding);
+        format.bomWriting(true);
+        const auto sExpected = writeToString(format, false);
+        DFGTEST_EXPECT_FALSE(sExpected.empty());
+        const uint32 threadCounts[] = { 0, 1, 2, 7 };
+        const uint32 blockRowCounts[] = { 3, 64, 5000 };
+        const uint32 inFlightCounts[] = { 0, 1, 3 };
+        for (const auto nThreadCount : threadCounts)
+        {
+            for (const auto nBlockRowCount : blockRowCounts)
+            {
+                for (const auto nInFlightCount : inFlightCounts)
+                {
+                    format.setPropertyT<PropertyId::writeOpt_threadCount>(nThreadCount);
+                    format.setPropertyT<PropertyId::writeOpt_threadBlockRowCount>(nBlockRowCount);
+                    format.setPropertyT<PropertyId::writeOpt_maxInFlightBlockCount>(nInFlightCount);
+                    DFGTEST_EXPECT_TRUE(sExpected == writeToString(format, true));
+                }
+            }
+        }
+    }
+
+    // Testing that writeToStream(strm) uses multithreaded write if requested by save format and that policies are passed to onPolicyFinished.
+    {
+        auto saveFormat = table.saveFormat();
+        const auto sExpected = writeToString(saveFormat, false);
+        saveFormat.setPropertyT<PropertyId::writeOpt_threadCount>(3);
+        saveFormat.setPropertyT<PropertyId::writeOpt_threadBlockRowCount>(100);
+        table.saveFormat(saveFormat);
+        ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string> strm;
+        table.writeToStream(strm);
+        DFGTEST_EXPECT_TRUE(sExpected == strm.releaseData());
+
+        size_t nFinishedCount = 0;
+        ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string> strm2;
+        table.writeToStreamMultiThreaded(strm2, saveFormat, [&]() { return TableT::createWritePolicy<TableT::WriteBlockStream>(saveFormat); }, [&](const TableT::WritePolicySimple<TableT::WriteBlockStream>&) { ++nFinishedCount; });
+        DFGTEST_EXPECT_LEFT(3, nFinishedCount);
+        DFGTEST_EXPECT_TRUE(sExpected == strm2.releaseData());
+    }
+
+    // Empty table
+    {
+        TableT emptyTable;
+        TableCsvReadWriteOptions format(',', '"', ::DFG_MODULE_NS(io)::EndOfLineTypeN, ::DFG_MODULE_NS(io)::encodingUTF8);
+        format.bomWriting(false);
+        format.setPropertyT<PropertyId::writeOpt_threadCount>(4);
+        ::DFG_MODULE_NS(io)::BasicOmcByteStream<std::string> strm;
+        emptyTable.writeToStreamMultiThreaded(strm, format);
+        DFGTEST_EXPECT_TRUE(strm.releaseData().empty());
+    }
+}
+
 TEST(dfgCont, TableCsv_invalidUtfWrite)
 {
     using namespace DFG_ROOT_NS;
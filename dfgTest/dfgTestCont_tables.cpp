@@ -922,6 +922,87 @@ TEST(dfgCont, TableSz_appendTablesWithMove)
     }
 }
 
+TEST(dfgCont, TableSz_clear_noDealloc)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(cont);
+    TableSz<char> table;
+    table.setBlockSize(8);
+    table.setElement(0, 0, "abc");
+    table.setElement(1, 0, "def");
+    table.setElement(0, 1, "0123456789"); // Longer than block size, not to be reused.
+    const auto pFirst = table(0, 0);
+    table.clear_noDealloc();
+    DFGTEST_EXPECT_LEFT(0, table.rowCountByMaxRowIndex());
+    DFGTEST_EXPECT_LEFT(0, table.colCountByMaxColIndex());
+    DFGTEST_EXPECT_LEFT(0, table.contentStorageSizeInBytes());
+
+    // Storage block should get reused.
+    table.setElement(0, 2, "ghi");
+    DFGTEST_EXPECT_LEFT(pFirst, table(0, 2));
+    DFGTEST_EXPECT_STREQ("ghi", table(0, 2));
+    table.setElement(1, 2, "jkl");
+    DFGTEST_EXPECT_STREQ("ghi", table(0, 2));
+    DFGTEST_EXPECT_STREQ("jkl", table(1, 2));
+    DFGTEST_EXPECT_LEFT(8, table.contentStorageSizeInBytes());
+}
+
+TEST(dfgCont, TableSz_typedColumnCache)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(cont);
+    using TableT = TableSz<char>;
+    TableT table;
+    table.setElement(0, 0, "1.5");
+    table.setElement(1, 0, "abc");
+    table.setElement(3, 0, "-2");
+    table.setElement(0, 1, "10");
+    table.setElement(4, 1, "");
+
+    const auto& doubles = table.typedColumnCache<double>(0);
+    DFGTEST_EXPECT_LEFT(5, doubles.size());
+    DFGTEST_EXPECT_LEFT(2, doubles.validCount());
+    DFGTEST_EXPECT_LEFT(1.5, doubles.value(0));
+    DFGTEST_EXPECT_TRUE(doubles.isValid(0));
+    DFGTEST_EXPECT_FALSE(doubles.isValid(1));
+    DFGTEST_EXPECT_TRUE(std::isnan(doubles.value(1)));
+    DFGTEST_EXPECT_FALSE(doubles.isValid(2));
+    DFGTEST_EXPECT_LEFT(-2, doubles.data()[3]);
+    DFGTEST_EXPECT_FALSE(doubles.isValid(10));
+    DFGTEST_EXPECT_LEFT(&doubles, &table.typedColumnCache<double>(0)); // Cache should not get rebuilt.
+    DFGTEST_EXPECT_LEFT(&doubles, table.typedColumnCacheIfAvailable<double>(0));
+
+    const auto& ints = table.typedColumnCache<int64>(0);
+    DFGTEST_EXPECT_LEFT(1, ints.validCount());
+    DFGTEST_EXPECT_FALSE(ints.isValid(0));
+    DFGTEST_EXPECT_LEFT(-2, ints.value(3));
+    DFGTEST_EXPECT_LEFT(10, table.typedColumnCache<int64>(1).value(0));
+    DFGTEST_EXPECT_FALSE(table.typedColumnCache<int64>(1).isValid(4));
+    DFGTEST_EXPECT_LEFT(0, table.typedColumnCache<double>(5).size()); // Non-existing column
+
+    // Modifying column should invalidate caches of that column only.
+    table.setElement(1, 0, "3");
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<int64>(0) == nullptr);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<int64>(1) != nullptr);
+    DFGTEST_EXPECT_LEFT(3, table.typedColumnCache<double>(0).value(1));
+
+    // Structural changes invalidate all caches
+    table.typedColumnCache<double>(0);
+    table.insertRowsAt(0, 1);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<int64>(1) == nullptr);
+    DFGTEST_EXPECT_LEFT(1.5, table.typedColumnCache<double>(0).value(1));
+    table.sortByColumn(1);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+    table.typedColumnCache<double>(0);
+    table.clearCell(2, 0);
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+    table.typedColumnCache<double>(0);
+    table.clear();
+    DFGTEST_EXPECT_TRUE(table.typedColumnCacheIfAvailable<double>(0) == nullptr);
+}
+
 TEST(dfgCont, TableSz_clearCell)
 {
     using namespace DFG_ROOT_NS;
@@ -1467,6 +1548,66 @@ TEST(dfgCont, MapBlockIndex_iterators)
     MapBlockIndex_iteratorsImpl(MapBlockIndex<const char*, 0>(16));
 }
 
+TEST(dfgCont, MapBlockIndex_appendWithMove)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(cont)::DFG_DETAIL_NS;
+    using MapT = MapBlockIndex<const char*, 0>;
+
+    const char* const pA = "a";
+    const char* const pB = "b";
+    const char* const pC = "c";
+    const char* const pTransformed = "t";
+    const auto transform = [&](const char* p) { return (p == pB) ? pTransformed : p; };
+
+    const auto createSource = [&](const uint32 nBlockSize)
+    {
+        MapT m(nBlockSize);
+        m.set(0, pA);
+        m.set(3, pB);
+        m.set(16, pC);
+        m.set(40, pA);
+        return m;
+    };
+
+    // Aligned offset: blocks are moved.
+    // Unaligned offset: content is copied block-by-block.
+    // Different block size: items are set one-by-one.
+    for (const auto nTestCase : { 0, 1, 2 })
+    {
+        MapT dest(16);
+        dest.set(1, pC);
+        dest.set(20, pC);
+        auto src = createSource((nTestCase == 2) ? 8 : 16);
+        const uint32 nOffset = (nTestCase == 0) ? 32 : 27;
+        dest.appendWithMove(src, nOffset, transform);
+
+        DFGTEST_EXPECT_TRUE(src.empty());
+        DFGTEST_EXPECT_LEFT(6, dest.size());
+        DFGTEST_EXPECT_LEFT(pC, dest.value(1));
+        DFGTEST_EXPECT_LEFT(pC, dest.value(20));
+        DFGTEST_EXPECT_LEFT(pA, dest.value(nOffset));
+        DFGTEST_EXPECT_TRUE(dest.value(nOffset + 1) == nullptr);
+        DFGTEST_EXPECT_LEFT(pTransformed, dest.value(nOffset + 3));
+        DFGTEST_EXPECT_LEFT(pC, dest.value(nOffset + 16));
+        DFGTEST_EXPECT_LEFT(pA, dest.value(nOffset + 40));
+        DFGTEST_EXPECT_LEFT(nOffset + 40, dest.backKey());
+        DFGTEST_EXPECT_LEFT(nOffset + 3, dest.nextKey(nOffset));
+        DFGTEST_EXPECT_LEFT(nOffset + 40, dest.nextKey(nOffset + 16));
+    }
+
+    // Appending to empty map
+    {
+        MapT dest(16);
+        auto src = createSource(16);
+        dest.appendWithMove(src, 0, [](const char* p) { return p; });
+        DFGTEST_EXPECT_LEFT(4, dest.size());
+        DFGTEST_EXPECT_LEFT(0, dest.frontKey());
+        DFGTEST_EXPECT_LEFT(40, dest.backKey());
+        DFGTEST_EXPECT_LEFT(pB, dest.value(3));
+    }
+}
+
 namespace
 {
     template <class T, size_t N>
@@ -12,6 +12,7 @@
 #include <dfg/build/utils.hpp>
 #include <dfg/io/fileToByteContainer.hpp>
 #include <dfg/io/OfStream.hpp>
+#include <dfg/io/BasicIfStreamPrefetching.hpp>
 #include <dfg/time.hpp>
 #include <dfg/os/memoryMappedFile.hpp>
 #include <iostream>
@@ -126,6 +127,11 @@ namespace
         return std::unique_ptr<::DFG_MODULE_NS(io)::BasicIfStream>(new ::DFG_MODULE_NS(io)::BasicIfStream(sFilePath));
     }
 
+    std::unique_ptr<::DFG_MODULE_NS(io)::BasicIfStreamPrefetching> InitBasicIfStreamPrefetching(const std::string& sFilePath, FileByteHolder&)
+    {
+        return std::unique_ptr<::DFG_MODULE_NS(io)::BasicIfStreamPrefetching>(new ::DFG_MODULE_NS(io)::BasicIfStreamPrefetching(sFilePath));
+    }
+
     std::unique_ptr<::DFG_MODULE_NS(io)::IfStreamWithEncoding> InitIfStreamWithEncoding(const std::string& sFilePath, FileByteHolder&)
     {
         return std::unique_ptr<::DFG_MODULE_NS(io)::IfStreamWithEncoding>(new ::DFG_MODULE_NS(io)::IfStreamWithEncoding(sFilePath));
@@ -163,6 +169,7 @@ namespace
     template <> std::string StreamName<std::istringstream>() { return "std::istringstream" + fileToMemoryType(); }
     template <> std::string StreamName<DFG_MODULE_NS(io)::DFG_CLASS_NAME(BasicImStream)>() { return "dfg::io::BasicImStream" + fileToMemoryType(); }
     template <> std::string StreamName<DFG_MODULE_NS(io)::DFG_CLASS_NAME(BasicIfStream)>() { return "dfg::io::BasicIfStream"; }
+    template <> std::string StreamName<DFG_MODULE_NS(io)::BasicIfStreamPrefetching>() { return "dfg::io::BasicIfStreamPrefetching"; }
     template <> std::string StreamName<DFG_MODULE_NS(io)::DFG_CLASS_NAME(IfStreamWithEncoding)>() { return "dfg::io::IfStreamWithEncoding"; }
     
 
@@ -198,10 +205,16 @@ namespace
 
     struct FormatDefTag_compileTime         {};
     struct FormatDefTag_compileTime_noRn    {}; // Compile time format without \r\n -> \n translation
+    struct FormatDefTag_compileTime_vectorized {}; // Compile time format with vectorized scan
+    struct FormatDefTag_compileTime_enclosing {}; // Compile time format with enclosing char
+    struct FormatDefTag_compileTime_enclosingVectorized {}; // Compile time format with enclosing char and vectorized scan
     struct FormatDefTag_runtime             {};
 
     std::string formatDefTagToOutputDescription(FormatDefTag_compileTime)         { return "compile time"; }
     std::string formatDefTagToOutputDescription(FormatDefTag_compileTime_noRn)    { return "compile time & no \\r\\n translation"; }
+    std::string formatDefTagToOutputDescription(FormatDefTag_compileTime_vectorized) { return "compile time & vectorized scan"; }
+    std::string formatDefTagToOutputDescription(FormatDefTag_compileTime_enclosing) { return "compile time & enclosing char"; }
+    std::string formatDefTagToOutputDescription(FormatDefTag_compileTime_enclosingVectorized) { return "compile time & enclosing char & vectorized scan"; }
     std::string formatDefTagToOutputDescription(FormatDefTag_runtime)             { return "runtime"; }
 
     auto createFormatDef(FormatDefTag_compileTime) -> DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader)::FormatDefinitionSingleCharsCompileTime<DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader)::s_nMetaCharNone, '\n', ','>
@@ -216,6 +229,24 @@ namespace
         return DFG_CLASS_NAME(DelimitedTextReader)::FormatDefinitionSingleCharsCompileTime<DFG_CLASS_NAME(DelimitedTextReader)::s_nMetaCharNone, '\n', ',', DFG_CLASS_NAME(DelimitedTextReader)::CsvFormatFlagNoRnTranslation>();
     }
 
+    auto createFormatDef(FormatDefTag_compileTime_vectorized)->DFG_MODULE_NS(io)::DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<DFG_MODULE_NS(io)::DelimitedTextReader::s_nMetaCharNone, '\n', ',', DFG_MODULE_NS(io)::DelimitedTextReader::CsvFormatFlagVectorizedScan>
+    {
+        using namespace DFG_MODULE_NS(io);
+        return DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<DelimitedTextReader::s_nMetaCharNone, '\n', ',', DelimitedTextReader::CsvFormatFlagVectorizedScan>();
+    }
+
+    auto createFormatDef(FormatDefTag_compileTime_enclosing)->DFG_MODULE_NS(io)::DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ','>
+    {
+        using namespace DFG_MODULE_NS(io);
+        return DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ','>();
+    }
+
+    auto createFormatDef(FormatDefTag_compileTime_enclosingVectorized)->DFG_MODULE_NS(io)::DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ',', DFG_MODULE_NS(io)::DelimitedTextReader::CsvFormatFlagVectorizedScan>
+    {
+        using namespace DFG_MODULE_NS(io);
+        return DelimitedTextReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ',', DelimitedTextReader::CsvFormatFlagVectorizedScan>();
+    }
+
     auto createFormatDef(FormatDefTag_runtime) -> DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader)::FormatDefinitionSingleChars
     {
         using namespace DFG_MODULE_NS(io);
@@ -301,6 +332,15 @@ namespace
             ExecuteTestCaseDelimitedTextReader<IStrm_T, AppenderType, BufferType>(output, streamInitFunc, ReaderCreation_default(), FormatDefTag_runtime(), sFilePath, nCount, "DelimitedTextReader", "CharAppenderStringViewCBufferWithEnclosedCellSupport");
     }
 
+    // Overload for explicitly given format definition tag.
+    template <class IStrm_T, class IStrmInit_T, class FormatDefTag_T>
+    DFG_NOINLINE void ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport(std::ostream& output, IStrmInit_T streamInitFunc, const std::string& sFilePath, const size_t nCount, const FormatDefTag_T formatDefTag)
+    {
+        typedef DFG_MODULE_NS(io)::DelimitedTextReader::StringViewCBufferWithEnclosedCellSupport BufferType;
+        typedef DFG_MODULE_NS(io)::DelimitedTextReader::CharAppenderStringViewCBufferWithEnclosedCellSupport AppenderType;
+        ExecuteTestCaseDelimitedTextReader<IStrm_T, AppenderType, BufferType>(output, streamInitFunc, ReaderCreation_default(), formatDefTag, sFilePath, nCount, "DelimitedTextReader", "CharAppenderStringViewCBufferWithEnclosedCellSupport");
+    }
+
     template <class IStrm_T, class IStrmInit_T>
     DFG_NOINLINE void ExecuteTestCase_DelimitedTextReader_basicReader(std::ostream& output, IStrmInit_T streamInitFunc, const std::string& sFilePath, const size_t nCount, const bool compiletimeFormatDef)
     {
@@ -316,13 +356,16 @@ namespace
                                                                           const std::string& sFilePath,
                                                                           const size_t nCount,
                                                                           const bool compiletimeFormatDef,
-                                                                          const bool rnTranslation)
+                                                                          const bool rnTranslation,
+                                                                          const bool vectorizedScan = false)
     {
         typedef DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader)::StringViewCBuffer BufferType;
         typedef DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader)::CharAppenderStringViewCBuffer AppenderType;
         if (compiletimeFormatDef)
         {
-            if (rnTranslation)
+            if (vectorizedScan)
+                ExecuteTestCaseDelimitedTextReader<IStrm_T, AppenderType, BufferType>(output, streamInitFunc, ReaderCreation_basic(), FormatDefTag_compileTime_vectorized(), sFilePath, nCount, "DelimitedTextReader_basic", "CharAppenderStringViewCBuffer");
+            else if (rnTranslation)
                 ExecuteTestCaseDelimitedTextReader<IStrm_T, AppenderType, BufferType>(output, streamInitFunc, ReaderCreation_basic(), FormatDefTag_compileTime(), sFilePath, nCount, "DelimitedTextReader_basic", "CharAppenderStringViewCBuffer");
             else
                 ExecuteTestCaseDelimitedTextReader<IStrm_T, AppenderType, BufferType>(output, streamInitFunc, ReaderCreation_basic(), FormatDefTag_compileTime_noRn(), sFilePath, nCount, "DelimitedTextReader_basic", "CharAppenderStringViewCBuffer");
@@ -525,6 +568,54 @@ namespace
         PrintTestCaseRow(output, sFilePath, runtimes, (bMultiThreaded) ? format_fmt("\"TableCsv<char,uint32> (with {} thread(s))\"", nHwConcurrency) : "\"TableCsv<char,uint32> (single-threaded)\"", "runtime", "Read&Store", "N/A");
     }
 
+    // Measures writing of table read from sFilePath to memory stream, in multithreaded case also checks that output is identical to single-threaded output.
+    DFG_NOINLINE void ExecuteTestCase_TableCsvWrite(std::ostream& output, const std::string& sFilePath, const size_t nRepeatCount, const bool bMultiThreaded = false)
+    {
+        using namespace DFG_ROOT_NS;
+        using namespace ::DFG_MODULE_NS(io);
+
+        typedef ::DFG_MODULE_NS(cont)::TableCsv<char, uint32> Table;
+        using PropertyId = ::DFG_MODULE_NS(cont)::TableCsvReadWriteOptions::PropertyId;
+
+        Table table;
+        table.readFromFile(sFilePath, ::DFG_MODULE_NS(cont)::TableCsvReadWriteOptions(',', '"', EndOfLineTypeN, encodingUTF8));
+        EXPECT_EQ(gnRowCount + 1, table.rowCountByMaxRowIndex());
+
+        ::DFG_MODULE_NS(cont)::TableCsvReadWriteOptions options(',', '"', EndOfLineTypeN, encodingUTF8);
+        options.enclosementBehaviour(EbEncloseIfNeeded);
+        options.bomWriting(false);
+
+        std::string sExpected;
+        {
+            BasicOmcByteStream<std::string> strm;
+            auto policy = Table::createWritePolicy<decltype(strm)>(options);
+            table.writeToStream(strm, policy);
+            sExpected = strm.releaseData();
+        }
+
+        const auto nHwConcurrency = std::thread::hardware_concurrency();
+        if (bMultiThreaded)
+            options.setPropertyT<PropertyId::writeOpt_threadCount>(nHwConcurrency);
+
+        std::vector<double> runtimes;
+        for (size_t i = 0; i < nRepeatCount; ++i)
+        {
+            BasicOmcByteStream<std::string> strm;
+            strm.reserve(sExpected.size());
+            TimerType timer;
+            if (bMultiThreaded)
+                table.writeToStreamMultiThreaded(strm, options);
+            else
+            {
+                auto policy = Table::createWritePolicy<decltype(strm)>(options);
+                table.writeToStream(strm, policy);
+            }
+            runtimes.push_back(timer.elapsedWallSeconds());
+            DFGTEST_EXPECT_TRUE(sExpected == strm.releaseData());
+        }
+        PrintTestCaseRow(output, sFilePath, runtimes, (bMultiThreaded) ? format_fmt("\"TableCsv<char,uint32> (with {} thread(s))\"", nHwConcurrency) : "\"TableCsv<char,uint32> (single-threaded)\"", "runtime", "Write to memory", "BasicOmcByteStream<std::string>");
+    }
+
     template <class IStrm_T>
     size_t getThroughOriginal(IStrm_T& istrm)
     {
@@ -631,6 +722,9 @@ TEST(dfgPerformance, CsvReadPerformance)
     // BasicIfStream
     ExecuteTestCase_DelimitedTextReader_DefaultCharAppend<::DFG_MODULE_NS(io)::BasicIfStream>(ostrmTestResults, InitBasicIfstream, sFilePath, nRunCount, false);
 
+    // BasicIfStreamPrefetching
+    ExecuteTestCase_DelimitedTextReader_DefaultCharAppend<::DFG_MODULE_NS(io)::BasicIfStreamPrefetching>(ostrmTestResults, InitBasicIfStreamPrefetching, sFilePath, nRunCount, false);
+
     // IfStreamWithEncoding
     //ExecuteTestCase_DelimitedTextReader_DefaultCharAppend<::DFG_MODULE_NS(io)::IfStreamWithEncoding>(ostrmTestResults, InitIfStreamWithEncoding, sFilePath, nRunCount, false);
 
@@ -651,6 +745,10 @@ TEST(dfgPerformance, CsvReadPerformance)
     ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath        , nRunCount, true);  // Compile time format def
     ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePathEnclosed, nRunCount, false); // Runtime format def
     ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePathEnclosed, nRunCount, true);  // Compile time format def
+    ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath        , nRunCount, FormatDefTag_compileTime_enclosing());
+    ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath        , nRunCount, FormatDefTag_compileTime_enclosingVectorized());
+    ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePathEnclosed, nRunCount, FormatDefTag_compileTime_enclosing());
+    ExecuteTestCase_DelimitedTextReader_StringViewCBufferWithEnclosedCellSupport<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePathEnclosed, nRunCount, FormatDefTag_compileTime_enclosingVectorized());
 
     // BasicImStream, basicReader, default read buffer
     ExecuteTestCase_DelimitedTextReader_basicReader<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath, nRunCount, false); // Runtime format def
@@ -659,6 +757,7 @@ TEST(dfgPerformance, CsvReadPerformance)
     ExecuteTestCase_DelimitedTextReader_basicReader_stringViewBuffer<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath, nRunCount, false, true);  // Runtime format def , \r\n translation
     ExecuteTestCase_DelimitedTextReader_basicReader_stringViewBuffer<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath, nRunCount, true,  true);  // Compile time format, \r\n translation
     ExecuteTestCase_DelimitedTextReader_basicReader_stringViewBuffer<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath, nRunCount, true,  false); // Compile time format, no \r\n translation
+    ExecuteTestCase_DelimitedTextReader_basicReader_stringViewBuffer<BasicImStreamT>(ostrmTestResults, InitIBasicImStream, sFilePath, nRunCount, true,  true, true); // Compile time format, \r\n translation, vectorized scan
 
     /////////////////////////////////////////////////
     // 3rd party libraries --->
@@ -690,6 +789,10 @@ TEST(dfgPerformance, CsvReadPerformance)
     ExecuteTestCase_TableCsv(ostrmTestResults, sFilePath, nRunCount, true /* multithreaded */);
     ExecuteTestCase_TableCsv(ostrmTestResults, sFilePathEnclosed, nRunCount);
 
+    // TableCsv writing
+    ExecuteTestCase_TableCsvWrite(ostrmTestResults, sFilePath, nRunCount);
+    ExecuteTestCase_TableCsvWrite(ostrmTestResults, sFilePath, nRunCount, true /* multithreaded */);
+
     ostrmTestResults.close();
     //std::system("testfiles\\generated\\csvPerformanceResults.csv");
 }
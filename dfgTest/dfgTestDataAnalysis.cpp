@@ -7,6 +7,7 @@
 #include <dfg/rand.hpp>
 #include <deque>
 #include <dfg/numeric/average.hpp>
+#include <dfg/time/timerCpu.hpp>
 
 TEST(dfgDataAnalysis, correlation)
 {
@@ -470,4 +471,125 @@ TEST(dfgDataAnalysis, smoothWithNeighbourMedians)
     testWithRandomData(NumericTraits<size_t>::maxValue);
 }
 
+
+TEST(dfgDataAnalysis, smoothWithNeighbourParallel)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(dataAnalysis);
+
+    // Small inputs must give the same results as sequential implementations, including NaN handling.
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const std::vector<std::vector<double>> inputs = { { 1 }, { 1, 2 }, { 1, 2, 3, 4, 5 }, { 5, nan, 1, nan, nan, 2, 8, nan }, { nan, nan, 3, nan } };
+        for (const auto& input : inputs)
+        {
+            for (size_t nRadius = 0; nRadius <= 10; ++nRadius)
+            {
+                auto expectedAvg = input;
+                auto expectedMedian = input;
+                auto avg = input;
+                auto median = input;
+                smoothWithNeighbourAverages(expectedAvg, nRadius);
+                smoothWithNeighbourMedians(expectedMedian, nRadius);
+                smoothWithNeighbourAveragesParallel(avg, nRadius);
+                smoothWithNeighbourMediansParallel(median, nRadius);
+                for (size_t i = 0; i < input.size(); ++i)
+                {
+                    if (DFG_MODULE_NS(math)::isNan(expectedAvg[i]))
+                        DFGTEST_EXPECT_NAN(avg[i]);
+                    else
+                        EXPECT_NEAR(expectedAvg[i], avg[i], 1e-12);
+                    if (DFG_MODULE_NS(math)::isNan(expectedMedian[i]))
+                        DFGTEST_EXPECT_NAN(median[i]);
+                    else
+                        EXPECT_EQ(expectedMedian[i], median[i]);
+                }
+            }
+        }
+    }
+
+    // Random data with NaNs: testing that chunked processing gives the same results as sequential implementations.
+    {
+        auto randEng = DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+        randEng.seed(12345);
+        std::vector<double> data(70000);
+        std::generate(data.begin(), data.end(), [&]()
+        {
+            return (DFG_MODULE_NS(rand)::rand(randEng, 0.0, 1.0) < 0.05) ? std::numeric_limits<double>::quiet_NaN() : DFG_MODULE_NS(rand)::rand(randEng, -1000.0, 1000.0);
+        });
+        // Second half has only a few distinct values to test handling of equal values in median window.
+        std::for_each(data.begin() + data.size() / 2, data.end(), [](double& v) { v = std::round(v / 250); });
+        for (const size_t nRadius : { size_t(1), size_t(2), size_t(7), size_t(100), size_t(1000) })
+        {
+            auto expectedAvg = data;
+            auto expectedMedian = data;
+            smoothWithNeighbourAverages(expectedAvg, nRadius);
+            smoothWithNeighbourMedians(expectedMedian, nRadius);
+            for (const size_t nThreadCount : { size_t(1), size_t(4) })
+            {
+                auto avg = data;
+                auto median = data;
+                smoothWithNeighbourAveragesParallel(avg, nRadius, nThreadCount);
+                smoothWithNeighbourMediansParallel(median, nRadius, nThreadCount);
+                size_t nAvgMismatchCount = 0;
+                size_t nMedianMismatchCount = 0;
+                for (size_t i = 0; i < data.size(); ++i)
+                {
+                    if (DFG_MODULE_NS(math)::isNan(data[i]))
+                    {
+                        nAvgMismatchCount += !DFG_MODULE_NS(math)::isNan(avg[i]);
+                        nMedianMismatchCount += !DFG_MODULE_NS(math)::isNan(median[i]);
+                        continue;
+                    }
+                    nAvgMismatchCount += !(std::abs(expectedAvg[i] - avg[i]) < 1e-9);
+                    nMedianMismatchCount += (expectedMedian[i] != median[i]);
+                }
+                EXPECT_EQ(0, nAvgMismatchCount) << "radius = " << nRadius << ", threads = " << nThreadCount;
+                EXPECT_EQ(0, nMedianMismatchCount) << "radius = " << nRadius << ", threads = " << nThreadCount;
+            }
+        }
+    }
+}
+
+#if DFGTEST_ENABLE_BENCHMARKS == 1
+TEST(dfgDataAnalysis, smoothWithNeighbourParallel_benchmark)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(dataAnalysis);
+    using Timer = ::DFG_MODULE_NS(time)::TimerCpu;
+
+#if !defined(DFG_BUILD_TYPE_DEBUG)
+    const size_t nCount = 10000000;
+#else
+    const size_t nCount = 100000;
+#endif
+    auto randEng = DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+    randEng.seed(12345);
+    std::vector<double> data(nCount);
+    std::generate(data.begin(), data.end(), [&]() { return DFG_MODULE_NS(rand)::rand(randEng, -1000.0, 1000.0); });
+
+    const auto timeIt = [&](const char* pszDesc, const size_t nRadius, auto&& func)
+    {
+        auto temp = data;
+        Timer timer;
+        func(temp, nRadius);
+        DFGTEST_MESSAGE(pszDesc << ", count = " << nCount << ", radius = " << nRadius << ": " << timer.elapsedWallSeconds() << " s");
+        return temp;
+    };
+
+    // Parallel versions are timed both with one thread and with hardware concurrency so that multi-core speedup is visible.
+    const size_t nHwThreadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    DFGTEST_MESSAGE("Hardware concurrency: " << nHwThreadCount);
+    for (const size_t nRadius : { size_t(10), size_t(1000) })
+    {
+        timeIt("smoothWithNeighbourAverages                  ", nRadius, [](std::vector<double>& v, const size_t r) { smoothWithNeighbourAverages(v, r); });
+        timeIt("smoothWithNeighbourAveragesParallel, 1 thread", nRadius, [](std::vector<double>& v, const size_t r) { smoothWithNeighbourAveragesParallel(v, r, 1); });
+        timeIt("smoothWithNeighbourAveragesParallel, hw      ", nRadius, [&](std::vector<double>& v, const size_t r) { smoothWithNeighbourAveragesParallel(v, r, nHwThreadCount); });
+        timeIt("smoothWithNeighbourMedians                   ", nRadius, [](std::vector<double>& v, const size_t r) { smoothWithNeighbourMedians(v, r); });
+        timeIt("smoothWithNeighbourMediansParallel, 1 thread ", nRadius, [](std::vector<double>& v, const size_t r) { smoothWithNeighbourMediansParallel(v, r, 1); });
+        timeIt("smoothWithNeighbourMediansParallel, hw       ", nRadius, [&](std::vector<double>& v, const size_t r) { smoothWithNeighbourMediansParallel(v, r, nHwThreadCount); });
+    }
+}
+#endif // DFGTEST_ENABLE_BENCHMARKS
+
 #endif
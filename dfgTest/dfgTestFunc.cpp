@@ -81,6 +81,120 @@ TEST(dfgFunc, MemFuncAvg)
         DFG_MODULE_NS(alg)::forEachFwdFuncRef(valsInt, avg);
         EXPECT_EQ(1.5, avg.average());
     }
+
+    // merge() and feedDataPoints()
+    {
+        DFG_MODULE_NS(func)::MemFuncAvg<double> avg0;
+        DFG_MODULE_NS(func)::MemFuncAvg<double> avg1;
+        avg0(1);
+        avg1(2);
+        avg1(3);
+        avg0.merge(avg1);
+        EXPECT_EQ(3, avg0.callCount());
+        EXPECT_EQ(6, avg0.sum());
+        avg0.feedDataPoints(14, 1);
+        EXPECT_EQ(4, avg0.callCount());
+        EXPECT_EQ(5, avg0.average());
+    }
+}
+
+TEST(dfgFunc, MemFuncSumCompensated)
+{
+    using namespace DFG_MODULE_NS(func);
+    MemFuncSumCompensated<double> sum;
+    MemFuncSum<double> sumNaive;
+    MemFuncSumCompensated<double> sumParts[2];
+    for (int i = 0; i < 1000000; ++i)
+    {
+        sum(0.1);
+        sumNaive(0.1);
+        sumParts[i % 2](0.1);
+    }
+    EXPECT_NE(100000, sumNaive.value()); // Just checking that test is meaningful.
+    EXPECT_EQ(100000, sum.value());
+    sumParts[0].merge(sumParts[1]);
+    EXPECT_EQ(100000, sumParts[0].value());
+
+    // Values that cancel each other out
+    {
+        MemFuncSumCompensated<double> sum2;
+        sum2(1);
+        sum2(1e100);
+        sum2(1);
+        sum2(-1e100);
+        EXPECT_EQ(2, sum2.value());
+    }
+
+    // Non-finite sum
+    {
+        MemFuncSumCompensated<double> sum2;
+        sum2(1e308);
+        sum2(1e308);
+        sum2(1);
+        EXPECT_EQ(std::numeric_limits<double>::infinity(), sum2.value());
+    }
+
+    // Usage with MemFuncAvg
+    {
+        MemFuncAvg<double, double, size_t, MemFuncSumCompensated<double>> avg;
+        for (int i = 0; i < 1000000; ++i)
+            avg(0.1);
+        EXPECT_EQ(100000, avg.sum());
+
+        // Feeding partial sum as functor keeps compensation.
+        MemFuncAvg<double, double, size_t, MemFuncSumCompensated<double>> avg2;
+        avg2.feedDataPoints(sumParts[1], 500000);
+        avg2.feedDataPoints(sumParts[1], 500000);
+        EXPECT_EQ(1000000, avg2.callCount());
+        EXPECT_EQ(100000, avg2.sum());
+    }
+}
+
+TEST(dfgFunc, MemFuncVariance)
+{
+    using namespace DFG_MODULE_NS(func);
+    using namespace DFG_MODULE_NS(math);
+
+    {
+        MemFuncVariance<double> var;
+        EXPECT_TRUE(isNan(var.mean()));
+        EXPECT_TRUE(isNan(var.variance()));
+        EXPECT_TRUE(isNan(var.sampleVariance()));
+        var(5);
+        EXPECT_EQ(5, var.mean());
+        EXPECT_EQ(0, var.variance());
+        EXPECT_TRUE(isNan(var.sampleVariance()));
+    }
+
+    const double vals[] = { 1, 9, 2, 5, 7, 3, 3, 100 };
+    MemFuncVariance<double> var;
+    for (const auto val : vals)
+        var(val);
+    EXPECT_EQ(8u, var.callCount());
+    EXPECT_EQ(16.25, var.mean());
+    EXPECT_EQ(1008.1875, var.variance());
+    EXPECT_DOUBLE_EQ(8065.5 / 7, var.sampleVariance());
+
+    // Merging partial results in every split position.
+    for (size_t nSplit = 0; nSplit <= DFG_COUNTOF(vals); ++nSplit)
+    {
+        MemFuncVariance<double> var0;
+        MemFuncVariance<double> var1;
+        for (size_t i = 0; i < DFG_COUNTOF(vals); ++i)
+            ((i < nSplit) ? var0 : var1)(vals[i]);
+        var0.merge(var1);
+        EXPECT_EQ(var.callCount(), var0.callCount());
+        EXPECT_DOUBLE_EQ(var.mean(), var0.mean());
+        EXPECT_DOUBLE_EQ(var.variance(), var0.variance());
+    }
+
+    // Large offset: variance from sum of squares would lose all precision here.
+    {
+        MemFuncVariance<double> var2;
+        for (const auto val : vals)
+            var2(1e9 + val);
+        EXPECT_NEAR(var.variance(), var2.variance(), 1e-6);
+    }
 }
 
 TEST(dfgFunc, MemFuncMedian)
@@ -200,6 +314,106 @@ TEST(dfgFunc, MemFuncPercentile_enclosingElem)
     }
 }
 
+TEST(dfgFunc, MemFuncPercentile_approx)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(func);
+    using namespace DFG_MODULE_NS(rand);
+
+    auto randEng = createDefaultRandEngineUnseeded();
+    auto distrEng = makeDistributionEngineUniform(&randEng, -1000.0, 1000.0);
+
+    // Basic tests
+    {
+        MemFuncPercentile_approx<double> mf(26, 20);
+        DFGTEST_EXPECT_NAN(mf.percentile());
+        DFGTEST_EXPECT_LEFT(26, mf.percentage());
+        DFGTEST_EXPECT_LEFT(20, mf.compression());
+        DFGTEST_EXPECT_LEFT(100, mf.exactValueCountMaximum());
+        mf(3);
+        mf(std::numeric_limits<double>::quiet_NaN());
+        DFGTEST_EXPECT_LEFT(3, mf.percentile());
+        DFGTEST_EXPECT_LEFT(1, mf.callCount());
+        mf.clear();
+        DFGTEST_EXPECT_NAN(mf.percentile());
+        DFGTEST_EXPECT_LEFT(0, mf.callCount());
+    }
+
+    // Compression limits
+    {
+        DFGTEST_EXPECT_LEFT(10, MemFuncPercentile_approx<double>(50, 0).compression());
+        DFGTEST_EXPECT_LEFT(10, MemFuncPercentile_approx<double>(50, -std::numeric_limits<double>::infinity()).compression());
+        DFGTEST_EXPECT_LEFT(10000, MemFuncPercentile_approx<double>(50, 1e9).compression());
+        DFGTEST_EXPECT_LEFT(10000, MemFuncPercentile_approx<double>(50, std::numeric_limits<double>::infinity()).compression());
+        DFGTEST_EXPECT_LEFT(100, MemFuncPercentile_approx<double>(50, std::numeric_limits<double>::quiet_NaN()).compression());
+    }
+
+    // While within exact value count, results should be identical to MemFuncPercentile_enclosingElem
+    for (const double percentage : { 0.0, 1.0, 26.0, 50.0, 99.5, 100.0 })
+    {
+        MemFuncPercentile_approx<double> mfApprox(percentage, 20);
+        MemFuncPercentile_enclosingElem<double> mfExact(percentage);
+        for (size_t i = 0; i < mfApprox.exactValueCountMaximum() - 1; ++i)
+        {
+            const auto val = std::round(distrEng());
+            mfApprox(val);
+            mfExact(val);
+            DFGTEST_ASSERT_TRUE(mfApprox.isExact());
+            DFGTEST_ASSERT_EQ(mfExact.percentile(), mfApprox.percentile());
+        }
+        mfApprox(0);
+        DFGTEST_EXPECT_FALSE(mfApprox.isExact());
+    }
+
+    // Accuracy and merging with larger number of values.
+    {
+        const size_t nCount = 200000;
+        std::vector<double> values(nCount);
+        std::generate(values.begin(), values.end(), distrEng);
+        std::vector<double> sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+
+        // Returns rank error relative to value count.
+        const auto relativeRankError = [&](const double val, const double percentage)
+        {
+            const auto nRank = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), val) - sorted.begin());
+            return std::abs(nRank - percentage / 100.0 * nCount) / nCount;
+        };
+
+        for (const double percentage : { 0.1, 1.0, 25.0, 50.0, 90.0, 99.9 })
+        {
+            MemFuncPercentile_approx<double> mfSingle(percentage);
+            MemFuncPercentile_approx<double> mfMerged(percentage);
+            std::vector<MemFuncPercentile_approx<double>> parts(7, MemFuncPercentile_approx<double>(percentage));
+            for (size_t i = 0; i < nCount; ++i)
+            {
+                mfSingle(values[i]);
+                parts[i * parts.size() / nCount](values[i]);
+            }
+            for (const auto& part : parts)
+                mfMerged.merge(part);
+            DFGTEST_EXPECT_LEFT(nCount, mfSingle.callCount());
+            DFGTEST_EXPECT_LEFT(nCount, mfMerged.callCount());
+            DFGTEST_EXPECT_FALSE(mfMerged.isExact());
+            DFGTEST_EXPECT_LE(relativeRankError(mfSingle.percentile(), percentage), 0.002);
+            DFGTEST_EXPECT_LE(relativeRankError(mfMerged.percentile(), percentage), 0.002);
+        }
+
+        MemFuncPercentile_approx<double> mfMax(100);
+        for (const auto val : values)
+            mfMax(val);
+        DFGTEST_EXPECT_LEFT(sorted.back(), mfMax.percentile());
+    }
+
+    // With integer data
+    {
+        MemFuncPercentile_approx<int> mf(26);
+        for (int i = 1; i <= 4; ++i)
+            mf(i);
+        DFGTEST_EXPECT_LEFT(2, mf.percentile());
+    }
+}
+
 TEST(dfgFunc, CastStatic)
 {
     using namespace DFG_ROOT_NS;
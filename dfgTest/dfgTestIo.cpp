@@ -25,6 +25,7 @@
 #include <dfg/cont/tableCsv.hpp>
 #include <dfg/os/memoryMappedFile.hpp>
 #include <dfg/stdcpp/stdversion.hpp>
+#include <dfg/io/createInputStream.hpp>
 
 DFG_BEGIN_INCLUDE_WITH_DISABLED_WARNINGS
     #include <boost/lexical_cast.hpp>
@@ -341,6 +342,83 @@ TEST(dfgIo, BasicIfStream)
     }
 }
 
+TEST(dfgIo, BasicIfStreamPrefetching)
+{
+    using namespace ::DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(io);
+
+    const char szFilePath[] = "testfiles/matrix_200x200.txt";
+    const auto expected = fileToVector(szFilePath);
+    ASSERT_FALSE(expected.empty());
+
+    // Reading with get() and readBytes() using various block and buffer counts, including block size that divides file size evenly.
+    const size_t blockSizes[] = { 1000, 4096, expected.size() / 5, expected.size(), 2 * expected.size() };
+    for (const auto nBlockSize : blockSizes)
+    {
+        for (size_t nBufferCount = 1; nBufferCount <= 3; ++nBufferCount)
+        {
+            {
+                BasicIfStreamPrefetching istrm(szFilePath, nBlockSize, nBufferCount);
+                DFGTEST_EXPECT_TRUE(istrm.is_open());
+                DFGTEST_EXPECT_LEFT(Max<size_t>(2, nBufferCount), istrm.bufferCount());
+                std::vector<char> bytes;
+                for (auto c = istrm.get(); c != istrm.eofVal(); c = istrm.get())
+                    bytes.push_back(static_cast<char>(c));
+                DFGTEST_EXPECT_TRUE(bytes == expected);
+                DFGTEST_EXPECT_LEFT(static_cast<int64>(expected.size()), istrm.tellg());
+                DFGTEST_EXPECT_FALSE(istrm.good());
+                DFGTEST_EXPECT_LEFT(istrm.eofVal(), istrm.get());
+            }
+            {
+                BasicIfStreamPrefetching istrm(szFilePath, nBlockSize, nBufferCount);
+                std::vector<char> bytes(expected.size() + 10);
+                DFGTEST_EXPECT_LEFT(expected[0], istrm.get());
+                bytes[0] = expected[0];
+                DFGTEST_EXPECT_LEFT(10, istrm.readBytes(bytes.data() + 1, 10));
+                DFGTEST_EXPECT_LEFT(11, istrm.tellg());
+                DFGTEST_EXPECT_LEFT(expected.size() - 11, istrm.readBytes(bytes.data() + 11, bytes.size() - 11));
+                bytes.resize(expected.size());
+                DFGTEST_EXPECT_TRUE(bytes == expected);
+                DFGTEST_EXPECT_LEFT(0, istrm.readBytes(bytes.data(), 1));
+            }
+        }
+    }
+
+    // Destroying stream before reading everything
+    {
+        BasicIfStreamPrefetching istrm(szFilePath, 16, 2);
+        DFGTEST_EXPECT_LEFT(expected[0], istrm.get());
+    }
+
+    // Non-existing file
+    {
+        auto istrm = createInputStreamBinaryFilePrefetching("testfiles/this_file_does_not_exist.txt");
+        DFGTEST_EXPECT_FALSE(istrm.is_open());
+        DFGTEST_EXPECT_FALSE(istrm.good());
+        DFGTEST_EXPECT_LEFT(istrm.eofVal(), istrm.get());
+    }
+
+    // Reading csv with DelimitedTextReader, result should be identical to reading with BasicIfStream.
+    {
+        const char szCsvPath[] = "testfiles/csv_testfiles/csvtestUTF8_BOM_sep_2C_eol_n.csv";
+        const auto readCells = [&](auto& istrm)
+        {
+            std::vector<std::string> cells;
+            DelimitedTextReader::read<char>(istrm, ',', '"', '\n', [&](const size_t nRow, const size_t nCol, const char* const pData, const size_t nSize)
+            {
+                cells.push_back(::DFG_MODULE_NS(str)::toStrC(nRow) + "," + ::DFG_MODULE_NS(str)::toStrC(nCol) + ":" + std::string(pData, nSize));
+            });
+            return cells;
+        };
+        BasicIfStream istrmBasic(szCsvPath);
+        const auto expectedCells = readCells(istrmBasic);
+        DFGTEST_EXPECT_FALSE(expectedCells.empty());
+        auto istrmPrefetching = createInputStreamBinaryFilePrefetching(szCsvPath, 13, 3);
+        auto istrmMoved = std::move(istrmPrefetching);
+        DFGTEST_EXPECT_TRUE(expectedCells == readCells(istrmMoved));
+    }
+}
+
 TEST(dfgIo, StdIStrStreamPerformance)
 {
 #ifdef DFG_BUILD_TYPE_DEBUG
@@ -1453,6 +1453,7 @@ namespace
 
     typedef DFG_MODULE_NS(io)::DFG_CLASS_NAME(DelimitedTextReader) DelimReader;
     typedef DelimReader::FormatDefinitionSingleCharsCompileTime<DelimReader::s_nMetaCharNone, '\n', ','> CompileTimeFormatDef;
+    typedef DelimReader::FormatDefinitionSingleCharsCompileTime<DelimReader::s_nMetaCharNone, '\n', ',', DelimReader::CsvFormatFlagVectorizedScan> CompileTimeFormatDefVectorized;
 
     template <class Strm_T>
     void StringViewBufferTest() {}
@@ -1466,6 +1467,7 @@ namespace
         typedef DelimReader::CharAppenderStringViewCBufferWithEnclosedCellSupport AppenderType2;
         DelimitedTextReaderBasicTests<DFG_MODULE_NS(io)::BasicImStream, BufferType, AppenderType>(CompileTimeFormatDef());
         DelimitedTextReaderBasicTests<DFG_MODULE_NS(io)::BasicImStream, BufferType2, AppenderType2>(CompileTimeFormatDef());
+        DelimitedTextReaderBasicTests<DFG_MODULE_NS(io)::BasicImStream, BufferType, AppenderType>(CompileTimeFormatDefVectorized());
     }
 
     template <class Strm_T>
@@ -1679,6 +1681,201 @@ TEST(DfgIo, DelimitedTextReader_rnTranslation)
     DelimitedTextReader_rnTranslationImpl<std::false_type, StringViewCAppenderT>();
 }
 
+namespace
+{
+    template <class FormatDef_T>
+    static std::vector<std::tuple<size_t, size_t, std::string>> readCellsWithBasicStringViewReader(const std::string& sInput)
+    {
+        using BufferT = DelimReader::StringViewCBuffer;
+        using AppenderT = DelimReader::CharAppenderStringViewCBuffer;
+        using CellDataT = DelimReader::CellData<char, char, BufferT, AppenderT, FormatDef_T>;
+        CellDataT cd{ FormatDef_T() };
+        DFG_MODULE_NS(io)::BasicImStream strm(sInput.data(), sInput.size());
+        auto reader = DelimReader::createReader_basic(strm, cd);
+        std::vector<std::tuple<size_t, size_t, std::string>> cells;
+        DelimReader::read(reader, [&](const size_t r, const size_t c, const CellDataT& cellData)
+        {
+            cells.push_back(std::make_tuple(r, c, std::string(cellData.getBuffer().data(), cellData.getBuffer().size())));
+        });
+        return cells;
+    }
+} // unnamed namespace
+
+TEST(DfgIo, DelimitedTextReader_vectorizedScan)
+{
+    using namespace DFG_ROOT_NS;
+
+    // Testing structural char scan directly
+    {
+        std::string s(200, 'a');
+        s[0] = ',';
+        s[15] = '\n';
+        s[16] = ',';
+        s[63] = ',';
+        s[64] = '\n';
+        s[127] = ',';
+        s[150] = static_cast<char>(0xFF);
+        s[199] = '\n';
+        const std::vector<size_t> expected = { 0, 15, 16, 63, 64, 127, 199 };
+        for (const bool bVectorized : { true, false })
+        {
+            std::vector<size_t> found;
+            const auto pStop = ::DFG_MODULE_NS(io)::DFG_DETAIL_NS::forEachStructuralChar(s.data(), s.data() + s.size(), std::array<char, 2>{ ',', '\n' }, [&](const char* p)
+            {
+                found.push_back(static_cast<size_t>(p - s.data()));
+            }, bVectorized);
+            EXPECT_EQ(expected, found);
+            EXPECT_EQ(s.data() + s.size(), pStop);
+        }
+
+        // Testing that scanning can be stopped and that high bytes can be searched
+        {
+            std::vector<size_t> found;
+            const auto pStop = ::DFG_MODULE_NS(io)::DFG_DETAIL_NS::forEachStructuralChar(s.data(), s.data() + s.size(), std::array<char, 1>{ static_cast<char>(0xFF) }, [&](const char* p)
+            {
+                found.push_back(static_cast<size_t>(p - s.data()));
+                return false;
+            });
+            EXPECT_EQ(std::vector<size_t>({ 150 }), found);
+            EXPECT_EQ(s.data() + 150, pStop);
+        }
+    }
+
+    // Testing that vectorized reader produces identical output with scalar reader with inputs of various lengths.
+    {
+        auto randEng = ::DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+        randEng.seed(123456);
+        const char szChars[] = "ab,\n\r ";
+        for (size_t nLength = 0; nLength < 300; ++nLength)
+        {
+            std::string s(nLength, 'a');
+            for (auto& c : s)
+                c = szChars[::DFG_MODULE_NS(rand)::rand(randEng, 0, static_cast<int>(DFG_COUNTOF_SZ(szChars)) - 1)];
+            const auto scalarCells = readCellsWithBasicStringViewReader<CompileTimeFormatDef>(s);
+            const auto vectorizedCells = readCellsWithBasicStringViewReader<CompileTimeFormatDefVectorized>(s);
+            EXPECT_EQ(scalarCells, vectorizedCells);
+        }
+    }
+}
+
+namespace
+{
+    // Reads cells with generic reader; cell handler requests skipping rest of line for cells starting with 'b' and terminates reading on cell "xx".
+    template <class FormatDef_T>
+    static std::vector<std::tuple<size_t, size_t, std::string>> readCellsWithEnclosedStringViewReader(const std::string& sInput, const bool bTestReturnValues)
+    {
+        using BufferT = DelimReader::StringViewCBufferWithEnclosedCellSupport;
+        using AppenderT = DelimReader::CharAppenderStringViewCBufferWithEnclosedCellSupport;
+        using CellDataT = DelimReader::CellData<char, char, BufferT, AppenderT, FormatDef_T>;
+        CellDataT cd{ FormatDef_T() };
+        DFG_MODULE_NS(io)::BasicImStream strm(sInput.data(), sInput.size());
+        auto reader = DelimReader::createReader(strm, cd);
+        std::vector<std::tuple<size_t, size_t, std::string>> cells;
+        DelimReader::read(reader, [&](const size_t r, const size_t c, CellDataT& cellData)
+        {
+            const std::string sCell(cellData.getBuffer().data(), cellData.getBuffer().size());
+            cells.push_back(std::make_tuple(r, c, sCell));
+            if (!bTestReturnValues)
+                return;
+            if (!sCell.empty() && sCell.front() == 'b')
+                cellData.setReadStatus(DelimReader::cellHrvSkipRestOfLine);
+            else if (sCell == "xx")
+                cellData.setReadStatus(DelimReader::cellHrvTerminateRead);
+        });
+        return cells;
+    }
+} // unnamed namespace
+
+TEST(DfgIo, DelimitedTextReader_vectorizedScanEnclosed)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace ::DFG_MODULE_NS(io)::DFG_DETAIL_NS;
+    typedef DelimReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ','> FormatDefEnclosed;
+    typedef DelimReader::FormatDefinitionSingleCharsCompileTime<'"', '\n', ',', DelimReader::CsvFormatFlagVectorizedScan> FormatDefEnclosedVectorized;
+
+    // Testing cell end scan directly
+    {
+        const std::string s = "a,\"b,\n\"\"c\",d\n\"e\"f,g\"h,i\n\"j";
+        std::vector<size_t> found;
+        const auto endState = forEachCsvCellEnd(s.data(), s.data() + s.size(), '"', ',', '\n', CsvCellScanState::cellStart, [&](const char* p, const bool bEol)
+        {
+            found.push_back(static_cast<size_t>(p - s.data()));
+            EXPECT_EQ(bEol, *p == '\n');
+        });
+        EXPECT_EQ(std::vector<size_t>({ 1, 10, 12, 17, 21, 23 }), found);
+        EXPECT_EQ(CsvCellScanState::enclosed, endState);
+    }
+
+    // Testing basic reading
+    {
+        const std::string s = "a,\"b,\n\"\"c\",d\r\n\"e\"f,g\"h,\"i\"\r\n,\n\"\"";
+        const auto cells = readCellsWithEnclosedStringViewReader<FormatDefEnclosedVectorized>(s, false);
+        const std::vector<std::tuple<size_t, size_t, std::string>> expected =
+        {
+            { 0, 0, "a" }, { 0, 1, "b,\n\"c" }, { 0, 2, "d" },
+            { 1, 0, "e" }, { 1, 1, "g\"h" }, { 1, 2, "i" },
+            { 2, 0, "" }, { 2, 1, "" }
+        };
+        EXPECT_EQ(expected, cells);
+    }
+
+    // Testing that vectorized reading produces identical output with generic reader for random char soup and for random well-formed csv,
+    // latter having long runs of regular enclosing chars so that block-wise parity handling gets used.
+    {
+        auto randEng = ::DFG_MODULE_NS(rand)::createDefaultRandEngineUnseeded();
+        randEng.seed(123456);
+        const auto randomChar = [&](const char* psz, const size_t nCount) { return psz[::DFG_MODULE_NS(rand)::rand(randEng, 0, static_cast<int>(nCount) - 1)]; };
+        const char szSoupChars[] = "ab,\n\r\"x";
+        const char szNakedChars[] = "ab x\r";
+        const char szEnclosedChars[] = "ab,\n\"";
+        for (size_t nLength = 0; nLength < 400; ++nLength)
+        {
+            std::string sSoup(nLength, 'a');
+            for (auto& c : sSoup)
+                c = randomChar(szSoupChars, DFG_COUNTOF_SZ(szSoupChars));
+
+            std::string sCsv;
+            while (sCsv.size() < nLength)
+            {
+                const bool bEnclosed = ::DFG_MODULE_NS(rand)::rand(randEng, 0, 1) == 1;
+                const auto nCellLength = ::DFG_MODULE_NS(rand)::rand(randEng, 0, 12);
+                if (bEnclosed)
+                    sCsv.push_back('"');
+                for (int i = 0; i < nCellLength; ++i)
+                {
+                    const auto c = (bEnclosed) ? randomChar(szEnclosedChars, DFG_COUNTOF_SZ(szEnclosedChars)) : randomChar(szNakedChars, DFG_COUNTOF_SZ(szNakedChars));
+                    sCsv.push_back(c);
+                    if (c == '"')
+                        sCsv.push_back(c);
+                }
+                if (bEnclosed)
+                    sCsv.push_back('"');
+                sCsv.push_back((::DFG_MODULE_NS(rand)::rand(randEng, 0, 3) == 0) ? '\n' : ',');
+            }
+
+            for (const auto& s : { sSoup, sCsv })
+            {
+                for (const bool bTestReturnValues : { false, true })
+                {
+                    const auto scalarCells = readCellsWithEnclosedStringViewReader<FormatDefEnclosed>(s, bTestReturnValues);
+                    const auto vectorizedCells = readCellsWithEnclosedStringViewReader<FormatDefEnclosedVectorized>(s, bTestReturnValues);
+                    EXPECT_EQ(scalarCells, vectorizedCells);
+                }
+
+                // Checking that vectorized cell end scan gives same result as scalar when starting from arbitrary state.
+                for (const auto startState : { CsvCellScanState::cellStart, CsvCellScanState::naked, CsvCellScanState::enclosed, CsvCellScanState::enclosedQuote, CsvCellScanState::pastEnclosed })
+                {
+                    std::vector<size_t> scalarEnds, vectorizedEnds;
+                    const auto scalarEndState = forEachCsvCellEnd(s.data(), s.data() + s.size(), '"', ',', '\n', startState, [&](const char* p, bool) { scalarEnds.push_back(static_cast<size_t>(p - s.data())); }, false);
+                    const auto vectorizedEndState = forEachCsvCellEnd(s.data(), s.data() + s.size(), '"', ',', '\n', startState, [&](const char* p, bool) { vectorizedEnds.push_back(static_cast<size_t>(p - s.data())); }, true);
+                    EXPECT_EQ(scalarEnds, vectorizedEnds);
+                    EXPECT_EQ(scalarEndState, vectorizedEndState);
+                }
+            }
+        }
+    }
+}
+
 TEST(DfgIo, DelimitedTextReader_CharAppenderUtf)
 {
     using namespace DFG_ROOT_NS;
@@ -17,6 +17,7 @@
 #include <dfg/utf.hpp>
 #include <dfg/iter/szIterator.hpp>
 #include <dfg/str/byteCountFormatter.hpp>
+#include <dfg/str/strToBatch.hpp>
 #if DFGTEST_ENABLE_BENCHMARKS == 1
     #include <dfg/time/timerCpu.hpp>
     #include <regex>
@@ -752,6 +753,85 @@ TEST(dfgStr, strTo_bool)
     testStrToBool<wchar_t>();
 }
 
+TEST(dfgStr, strToBatch)
+{
+    using namespace DFG_ROOT_NS;
+    using namespace DFG_MODULE_NS(str);
+
+    std::vector<std::string> inputs = { "0", "-0", "1", "-1", "12345678", "123456789", "1234567812345678", "-9223372036854775808", "9223372036854775807",
+        "9223372036854775808", "00012", " 12 ", "\t12", "+5", "1.0", "1.5", "-.5", ".5", "5.", "1e5", "1E+05", "1e-5", "2.5e-3", "1.5e", "1,5",
+        "0x10", "1e400", "1e-400", "inf", "-inf", "nan", "", " ", "-", "abc", "12a", "0.1", "0.3", "123456789012345678901234", "9007199254740993",
+        "9007199254740992", "1e22", "1e23", "1.7976931348623157e308", "4.9e-324", "3.14159265358979323846", "12345678.87654321", "1e-22", "1e-23" };
+    // Adding random numbers in different formats.
+    auto randEng = rand::createDefaultRandEngineUnseeded();
+    randEng.seed(12345);
+    auto randDistr = rand::makeDistributionEngineUniform(&randEng, -1e6, 1e6);
+    char buffer[64];
+    for (int i = 0; i < 300; ++i)
+    {
+        const auto d = randDistr();
+        inputs.push_back(floatingPointToStr(d, buffer, 1 + i % 17));
+        inputs.push_back(toStrC(static_cast<int64>(d * ((i % 2 == 0) ? 1e12 : 1))));
+    }
+
+    std::vector<StringViewC> views(inputs.begin(), inputs.end());
+
+    // double
+    {
+        std::vector<double> outputs(views.size());
+        std::vector<bool> validity;
+        const auto nValidCount = strToBatch(views.data(), views.size(), outputs.data(), &validity);
+        ASSERT_EQ(views.size(), validity.size());
+        size_t nExpectedValidCount = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            bool bOk = false;
+            const auto expected = strTo<double>(inputs[i], &bOk);
+            EXPECT_EQ(bOk, validity[i]) << "input: '" << inputs[i] << "'";
+            if (bOk)
+            {
+                ++nExpectedValidCount;
+                if (std::isnan(expected))
+                    EXPECT_TRUE(std::isnan(outputs[i]));
+                else
+                    EXPECT_EQ(0, std::memcmp(&expected, &outputs[i], sizeof(double))) << "input: '" << inputs[i] << "'"; // Bitwise comparison to check e.g. sign of zero.
+            }
+            else
+                EXPECT_TRUE(std::isnan(outputs[i]));
+        }
+        EXPECT_EQ(nExpectedValidCount, nValidCount);
+    }
+
+    // int64
+    {
+        std::vector<int64> outputs(views.size());
+        std::vector<bool> validity;
+        const auto nValidCount = strToBatch(views.data(), views.size(), outputs.data(), &validity);
+        size_t nExpectedValidCount = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            bool bOk = false;
+            const auto expected = strTo<int64>(inputs[i], &bOk);
+            EXPECT_EQ(bOk, validity[i]) << "input: '" << inputs[i] << "'";
+            EXPECT_EQ((bOk) ? expected : 0, outputs[i]) << "input: '" << inputs[i] << "'";
+            if (bOk)
+                ++nExpectedValidCount;
+        }
+        EXPECT_EQ(nExpectedValidCount, nValidCount);
+        EXPECT_EQ(12, strToFast<int64>(StringViewC("00012")));
+    }
+
+    // Without validity output
+    {
+        const StringViewC items[] = { "1", "a", "2.5" };
+        double outputs[3];
+        EXPECT_EQ(2, strToBatch(items, 3, outputs));
+        EXPECT_EQ(1, outputs[0]);
+        EXPECT_TRUE(std::isnan(outputs[1]));
+        EXPECT_EQ(2.5, outputs[2]);
+    }
+}
+
 namespace
 {
     template <class T>
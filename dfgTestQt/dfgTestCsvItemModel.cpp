@@ -1,4 +1,6 @@
 #include <dfg/qt/CsvItemModel.hpp>
+#include <dfg/qt/CsvItemModelChartDataSource.hpp>
+#include <dfg/cont/table.hpp>
 #include <dfg/io.hpp>
 #include <dfg/io/OmcByteStream.hpp>
 #include <dfg/qt/containerUtils.hpp>
@@ -160,6 +162,373 @@ TEST(dfgQt, CsvItemModel_removeRows)
     EXPECT_EQ(0, model.rowCount());
 }
 
+TEST(dfgQt, CsvItemModel_displayStringCache)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    CsvItemModel model;
+    DFGTEST_EXPECT_TRUE(model.openString("a,b\n1,2\n3,4\n5,\n"));
+    DFGTEST_EXPECT_LEFT(0, model.displayStringCacheSize());
+    DFGTEST_EXPECT_LEFT("1", model.data(model.index(0, 0)).toString());
+    DFGTEST_EXPECT_LEFT("1", model.data(model.index(0, 0)).toString());
+    DFGTEST_EXPECT_LEFT(1, model.displayStringCacheSize());
+    DFGTEST_EXPECT_FALSE(model.data(model.index(2, 1)).isValid()); // Empty cells are not cached and data() should still return invalid QVariant.
+    DFGTEST_EXPECT_LEFT(1, model.displayStringCacheSize());
+
+    // Edits must invalidate cached strings
+    model.setDataNoUndo(0, 0, DFG_UTF8("10"));
+    DFGTEST_EXPECT_LEFT("10", model.data(model.index(0, 0)).toString());
+    model.insertRows(0, 1);
+    DFGTEST_EXPECT_LEFT(0, model.displayStringCacheSize());
+    DFGTEST_EXPECT_FALSE(model.data(model.index(0, 0)).isValid());
+    DFGTEST_EXPECT_LEFT("10", model.data(model.index(1, 0)).toString());
+    model.removeRows(0, 2);
+    DFGTEST_EXPECT_LEFT("3", model.data(model.index(0, 0)).toString());
+
+    // Prefetch
+    model.prefetchDisplayStrings({ 0, 1, 2, 100 }, { 0, 1 });
+    for (int i = 0; i < 500 && model.displayStringCacheSize() < 3; ++i)
+        QThread::msleep(10);
+    DFGTEST_EXPECT_LEFT(3, model.displayStringCacheSize()); // "3", "4" and "5"
+    DFGTEST_EXPECT_LEFT("4", model.data(model.index(0, 1)).toString());
+    DFGTEST_EXPECT_LEFT("5", model.data(model.index(1, 0)).toString());
+
+    // After cancelling prefetch, model should be promptly available for editing.
+    model.prefetchDisplayStrings({ 0, 1, 2 }, { 0, 1 });
+    model.cancelDisplayStringPrefetch();
+    bool bLocked = false;
+    for (int i = 0; i < 100 && !bLocked; ++i)
+    {
+        bLocked = model.tryLockForEdit().isLocked();
+        if (!bLocked)
+            QThread::msleep(1);
+    }
+    DFGTEST_EXPECT_TRUE(bLocked);
+}
+
+TEST(dfgQt, CsvItemModel_columnNumericSummary)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    using NumericSummary = CsvItemModel::NumericSummary;
+    const int nRowCount = 10000;
+    QString sData = "a,b\n";
+    for (int i = 0; i < nRowCount; ++i)
+    {
+        if (i % 7 == 0)
+            sData += QString("x%1,\n").arg(i);
+        else
+            sData += QString("%1,\"%2,5\"\n").arg(i).arg(i % 100);
+    }
+    CsvItemModel model;
+    DFGTEST_ASSERT_TRUE(model.openString(sData));
+    DFGTEST_ASSERT_EQ(nRowCount, model.rowCount());
+
+    // Reference implementation corresponding to the documented interpretation.
+    const auto expectedSummary = [&](const int nCol, const int nFirst, const int nLast)
+    {
+        NumericSummary summary;
+        for (int r = nFirst; r <= nLast; ++r)
+        {
+            bool bOk = false;
+            const auto val = model.data(model.index(r, nCol)).toString().replace(',', '.').toDouble(&bOk);
+            if (bOk)
+                summary.addValue(val);
+            else
+                ++summary.m_nExcludedCount;
+        }
+        return summary;
+    };
+
+    const auto testRange = [&](const int nCol, const int nFirst, const int nLast)
+    {
+        NumericSummary summary;
+        DFGTEST_EXPECT_TRUE(model.columnNumericSummary(nCol, nFirst, nLast, summary));
+        const auto expected = expectedSummary(nCol, nFirst, nLast);
+        DFGTEST_EXPECT_EQ(expected.m_nIncludedCount, summary.m_nIncludedCount);
+        DFGTEST_EXPECT_EQ(expected.m_nExcludedCount, summary.m_nExcludedCount);
+        DFGTEST_EXPECT_EQ(expected.sum(), summary.sum()); // Values are small integers and halves so sums are exact regardless of summation order.
+        DFGTEST_EXPECT_EQ(expected.m_min, summary.m_min);
+        DFGTEST_EXPECT_EQ(expected.m_max, summary.m_max);
+    };
+
+    // Whole columns, partial blocks at both ends and range within a single block.
+    for (int nPass = 0; nPass < 2; ++nPass) // Second pass uses already computed blocks.
+    {
+        testRange(0, 0, nRowCount - 1);
+        testRange(1, 0, nRowCount - 1);
+        testRange(0, 100, 9000);
+        testRange(1, 4096, 8191);
+        testRange(0, 10, 20);
+    }
+
+    // Edits must invalidate affected blocks
+    model.setDataNoUndo(5000, 0, DFG_UTF8("-100000"));
+    model.setDataNoUndo(9999, 0, DFG_UTF8("abc"));
+    testRange(0, 0, nRowCount - 1);
+    model.insertRows(0, 1);
+    model.setDataNoUndo(0, 0, DFG_UTF8("1e6"));
+    testRange(0, 0, model.rowCount() - 1);
+    model.removeRows(1, 4096);
+    testRange(0, 0, model.rowCount() - 1);
+    testRange(1, 0, model.rowCount() - 1);
+
+    // Out-of-range arguments
+    {
+        NumericSummary summary;
+        DFGTEST_EXPECT_TRUE(model.columnNumericSummary(2, 0, 10, summary));
+        DFGTEST_EXPECT_TRUE(model.columnNumericSummary(0, -5, -1, summary));
+        DFGTEST_EXPECT_EQ(0u, summary.m_nIncludedCount + summary.m_nExcludedCount);
+        DFGTEST_EXPECT_TRUE(model.columnNumericSummary(0, model.rowCount() - 2, model.rowCount() + 100, summary));
+        DFGTEST_EXPECT_EQ(2u, summary.m_nIncludedCount + summary.m_nExcludedCount);
+    }
+
+    // Cancellation
+    {
+        NumericSummary summary;
+        DFGTEST_EXPECT_FALSE(model.columnNumericSummary(0, 0, model.rowCount() - 1, summary, []() { return true; }));
+    }
+
+    // Sum is compensated: naive summation of 10000 * 0.1 gives 1000.0000000001588
+    {
+        QString sTenths = "a\n";
+        for (int i = 0; i < nRowCount; ++i)
+            sTenths += "0.1\n";
+        CsvItemModel modelTenths;
+        DFGTEST_ASSERT_TRUE(modelTenths.openString(sTenths));
+        NumericSummary summary;
+        DFGTEST_EXPECT_TRUE(modelTenths.columnNumericSummary(0, 0, nRowCount - 1, summary));
+        DFGTEST_EXPECT_EQ(1000.0, summary.sum());
+        DFGTEST_EXPECT_EQ(static_cast<size_t>(nRowCount), summary.m_nIncludedCount);
+    }
+}
+
+TEST(dfgQt, CsvItemModel_readMemoryMappedCellStorage)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    const char szPath[] = "testfiles/generated/CsvItemModel_readMemoryMappedCellStorage.csv";
+    const std::string sContent = "a,b,c\n1,\"x,y\",3\nlong cell content,\"z\"\"\",\n";
+    DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPath, sContent.data(), sContent.size()));
+
+    CsvItemModel modelRegular;
+    DFGTEST_ASSERT_TRUE(modelRegular.openFile(szPath));
+
+    CsvItemModel model;
+    auto options = model.getLoadOptionsForFile(szPath);
+    options.setProperty(CsvOptionProperty_readMemoryMappedCellStorage, "1");
+    options.setDefaultProperties(&model);
+    DFGTEST_ASSERT_TRUE(model.openFile(szPath, options));
+    DFGTEST_ASSERT_EQ(modelRegular.rowCount(), model.rowCount());
+    DFGTEST_ASSERT_EQ(modelRegular.columnCount(), model.columnCount());
+    for (int r = 0; r < model.rowCount(); ++r)
+    {
+        for (int c = 0; c < model.columnCount(); ++c)
+        {
+            DFGTEST_EXPECT_LEFT(modelRegular.data(modelRegular.index(r, c)), model.data(model.index(r, c)));
+            const auto valRegular = modelRegular.cellDataAsDouble(r, c);
+            const auto val = model.cellDataAsDouble(r, c);
+            DFGTEST_EXPECT_TRUE(valRegular == val || (std::isnan(valRegular) && std::isnan(val)));
+        }
+    }
+    DFGTEST_EXPECT_LEFT(QString("long cell content"), viewToQString(model.rawStringViewAt(1, 0)));
+
+    // Edits are stored to model's own storage as usual.
+    DFGTEST_EXPECT_TRUE(model.setDataNoUndo(0, 0, DFG_UTF8("2")));
+    DFGTEST_EXPECT_LEFT(2, model.cellDataAsDouble(0, 0));
+    DFGTEST_EXPECT_LEFT(sContent, ::DFG_MODULE_NS(io)::fileToByteContainer<std::string>(szPath));
+}
+
+TEST(dfgQt, CsvItemModel_readNumericColumnCaches)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    const char szPath[] = "testfiles/generated/CsvItemModel_readNumericColumnCaches.csv";
+    const std::string sContent = "a,b,c\n1,x,2020-01-02\n-2.5,,2020-01-03\n1e3,\"1,5\",2020-01-04\n";
+    DFGTEST_ASSERT_TRUE(::DFG_MODULE_NS(io)::OfStream::dumpBytesToFile_overwriting(szPath, sContent.data(), sContent.size()));
+
+    CsvItemModel modelRegular;
+    DFGTEST_ASSERT_TRUE(modelRegular.openFile(szPath));
+    DFGTEST_EXPECT_TRUE(modelRegular.m_table.numericColumnCacheIfAvailable(0) == nullptr);
+
+    CsvItemModel model;
+    auto options = model.getLoadOptionsForFile(szPath);
+    options.setProperty(CsvOptionProperty_readNumericColumnCaches, "1");
+    DFGTEST_ASSERT_TRUE(model.openFile(szPath, options));
+    {
+        const auto pCache = model.m_table.numericColumnCacheIfAvailable(0);
+        DFGTEST_ASSERT_TRUE(pCache != nullptr);
+        DFGTEST_EXPECT_LEFT(3u, pCache->size()); // Header is not included.
+        DFGTEST_EXPECT_LEFT(3u, pCache->validCount());
+        DFGTEST_EXPECT_LEFT(-2.5, pCache->value(1));
+        DFGTEST_EXPECT_LEFT(1000, pCache->value(2));
+    }
+
+    const auto fetchValues = [](CsvItemModel& rModel, const DataSourceIndex nCol)
+    {
+        CsvItemModelChartDataSource source(&rModel, "table");
+        std::vector<double> values;
+        source.forEachElement_byColumn(nCol, DataQueryDetails(DataQueryDetails::DataMaskNumerics), [&](const SourceDataSpan& sourceSpan)
+        {
+            values.insert(values.end(), sourceSpan.doubles().begin(), sourceSpan.doubles().end());
+        });
+        return values;
+    };
+    const auto isSameOrBothNan = [](const double a, const double b) { return a == b || (std::isnan(a) && std::isnan(b)); };
+
+    // Values from chart data source should be identical whether or not cache is available.
+    for (DataSourceIndex c = 0; c < 3; ++c)
+    {
+        const auto valuesRegular = fetchValues(modelRegular, c);
+        const auto values = fetchValues(model, c);
+        DFGTEST_EXPECT_LEFT(3u, values.size());
+        DFGTEST_EXPECT_TRUE(std::equal(valuesRegular.begin(), valuesRegular.end(), values.begin(), values.end(), isSameOrBothNan));
+    }
+
+    // Edit should invalidate the cache of edited column and values should come from the edited content.
+    DFGTEST_EXPECT_TRUE(model.setDataNoUndo(0, 0, DFG_UTF8("7")));
+    DFGTEST_EXPECT_TRUE(model.m_table.numericColumnCacheIfAvailable(0) == nullptr);
+    DFGTEST_EXPECT_TRUE(model.m_table.numericColumnCacheIfAvailable(1) != nullptr);
+    DFGTEST_EXPECT_LEFT(std::vector<double>({ 7, -2.5, 1000 }), fetchValues(model, 0));
+}
+
+TEST(dfgQt, CsvItemModel_openFileProgressive)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    const QString sPath = "testfiles/generated/csvItemModel_progressiveOpen.csv";
+    QString sCsv = "a,b\n";
+    for (int r = 0; r < 100; ++r)
+        sCsv += (r < 50) ? QString("%1,\"x\n%1\"\n").arg(r) : QString("%1,y,z%1\n").arg(r); // Last rows have more columns than header.
+    {
+        CsvItemModel model;
+        DFGTEST_ASSERT_TRUE(model.openString(sCsv));
+        DFGTEST_ASSERT_TRUE(model.saveToFile(sPath));
+    }
+    CsvItemModel expected;
+    DFGTEST_ASSERT_TRUE(expected.openFile(sPath));
+    DFGTEST_ASSERT_LEFT(100, expected.rowCount());
+
+    CsvItemModel model;
+    bool bFinished = false;
+    bool bCompleted = false;
+    DFG_QT_VERIFY_CONNECT(QObject::connect(&model, &CsvItemModel::sigProgressiveLoadFinished, [&](const bool b) { bFinished = true; bCompleted = b; }));
+    const auto waitUntilFinished = [&]()
+    {
+        for (int i = 0; i < 1000 && !bFinished; ++i)
+        {
+            QCoreApplication::processEvents();
+            QThread::msleep(1);
+        }
+    };
+
+    // Full read
+    {
+        DFGTEST_EXPECT_TRUE(model.openFileProgressive(sPath, model.getLoadOptionsForFile(sPath), 10, 25));
+        DFGTEST_EXPECT_TRUE(model.isProgressiveLoadActive());
+        DFGTEST_EXPECT_LEFT(10, model.rowCount());
+        DFGTEST_EXPECT_LEFT(2, model.columnCount());
+        DFGTEST_EXPECT_LEFT(QString("a"), model.getHeaderName(0));
+        DFGTEST_EXPECT_FALSE(model.isCellEditable(0, 0));
+        waitUntilFinished();
+        DFGTEST_EXPECT_TRUE(bFinished);
+        DFGTEST_EXPECT_TRUE(bCompleted);
+        DFGTEST_EXPECT_FALSE(model.isProgressiveLoadActive());
+        DFGTEST_EXPECT_TRUE(model.isCellEditable(0, 0));
+        DFGTEST_EXPECT_FALSE(model.isModified());
+        DFGTEST_EXPECT_LEFT(QFileInfo(sPath).absoluteFilePath(), model.getFilePath());
+        DFGTEST_ASSERT_LEFT(expected.rowCount(), model.rowCount());
+        DFGTEST_ASSERT_LEFT(expected.columnCount(), model.columnCount());
+        for (int r = 0; r < expected.rowCount(); ++r)
+            for (int c = 0; c < expected.columnCount(); ++c)
+                DFGTEST_EXPECT_LEFT(viewToQString(expected.rawStringViewAt(r, c)), viewToQString(model.rawStringViewAt(r, c)));
+    }
+
+    // Cancelling
+    {
+        bFinished = false;
+        DFGTEST_EXPECT_TRUE(model.openFileProgressive(sPath, model.getLoadOptionsForFile(sPath), 10, 25));
+        model.cancelProgressiveLoad();
+        DFGTEST_EXPECT_TRUE(bFinished);
+        DFGTEST_EXPECT_FALSE(bCompleted);
+        DFGTEST_EXPECT_FALSE(model.isProgressiveLoadActive());
+        DFGTEST_EXPECT_LEFT(10, model.rowCount());
+        DFGTEST_EXPECT_TRUE(model.getFilePath().isEmpty()); // Path of partly read file should not be kept.
+        waitUntilFinished(); // Handling possibly queued events, which should have no effect.
+        DFGTEST_EXPECT_LEFT(10, model.rowCount());
+    }
+
+    // Saving after progressive open should use format of the read file like after openFile().
+    {
+        const QString sPathSemicolon = "testfiles/generated/csvItemModel_progressiveOpenSemicolon.csv";
+        {
+            CsvItemModel modelSemicolon;
+            DFGTEST_ASSERT_TRUE(modelSemicolon.openString(sCsv));
+            auto saveOptions = modelSemicolon.getSaveOptions();
+            saveOptions.separatorChar(';');
+            DFGTEST_ASSERT_TRUE(modelSemicolon.saveToFile(sPathSemicolon, saveOptions));
+        }
+        CsvItemModel expectedSemicolon;
+        DFGTEST_ASSERT_TRUE(expectedSemicolon.openFile(sPathSemicolon));
+        const auto expectedBytes = expectedSemicolon.saveToByteString();
+        DFGTEST_EXPECT_TRUE(expectedBytes.find(";y;z99") != std::string::npos);
+
+        // Saving after completed load
+        bFinished = false;
+        DFGTEST_EXPECT_TRUE(model.openFileProgressive(sPathSemicolon, model.getLoadOptionsForFile(sPathSemicolon), 10, 25));
+        waitUntilFinished();
+        DFGTEST_EXPECT_TRUE(bCompleted);
+        DFGTEST_EXPECT_LEFT(';', model.getSaveOptions().separatorChar());
+        DFGTEST_EXPECT_LEFT(expectedBytes, model.saveToByteString());
+
+        // Saving after cancelled load uses format detected from the beginning of the file.
+        bFinished = false;
+        DFGTEST_EXPECT_TRUE(model.openFileProgressive(sPathSemicolon, model.getLoadOptionsForFile(sPathSemicolon), 10, 25));
+        model.cancelProgressiveLoad();
+        DFGTEST_EXPECT_FALSE(bCompleted);
+        DFGTEST_EXPECT_LEFT(';', model.getSaveOptions().separatorChar());
+        DFGTEST_EXPECT_TRUE(model.saveToByteString().find("9;\"x\n9\"") != std::string::npos);
+    }
+}
+
+TEST(dfgQt, CsvLazyReadOnlyItemModel)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    const QString sPath = "testfiles/generated/csvLazyReadOnlyItemModel.csv";
+    QString sCsv = "a,,c\n";
+    for (int r = 0; r < 3000; ++r)
+        sCsv += (r % 7 == 0) ? QString("%1,\"x\n%1\",%2\n").arg(r).arg(QChar(0xE4)) : QString("%1,y%1\n").arg(r);
+    {
+        CsvItemModel model;
+        DFGTEST_ASSERT_TRUE(model.openString(sCsv));
+        DFGTEST_ASSERT_TRUE(model.saveToFile(sPath));
+    }
+    CsvItemModel expected;
+    DFGTEST_ASSERT_TRUE(expected.openFile(sPath));
+
+    CsvLazyReadOnlyItemModel model;
+    DFGTEST_ASSERT_TRUE(model.openFile(sPath));
+    DFGTEST_EXPECT_LEFT(sPath, model.getFilePath());
+    DFGTEST_EXPECT_LEFT(0, model.loadedChunkCount());
+    DFGTEST_ASSERT_LEFT(expected.rowCount(), model.rowCount());
+    DFGTEST_ASSERT_LEFT(expected.columnCount(), model.columnCount());
+    DFGTEST_EXPECT_LEFT(QString("a"), model.headerData(0, Qt::Horizontal).toString());
+    DFGTEST_EXPECT_LEFT(QString("2"), model.headerData(1, Qt::Horizontal).toString()); // Empty header name shows column number.
+    DFGTEST_EXPECT_LEFT(QString("1"), model.headerData(0, Qt::Vertical).toString());
+    DFGTEST_EXPECT_FALSE(model.flags(model.index(0, 0)).testFlag(Qt::ItemIsEditable));
+
+    model.setMaxLoadedChunkCount(1);
+    bool bAllIdentical = true;
+    for (int r = 0; r < expected.rowCount(); ++r)
+    {
+        for (int c = 0; c < expected.columnCount(); ++c)
+            bAllIdentical = bAllIdentical && (expected.data(expected.index(r, c)).toString() == model.data(model.index(r, c)).toString());
+    }
+    DFGTEST_EXPECT_TRUE(bAllIdentical);
+    DFGTEST_EXPECT_LEFT(1, model.loadedChunkCount());
+    DFGTEST_EXPECT_LEFT(QString("x\n2996"), model.data(model.index(2996, 1)).toString());
+    DFGTEST_EXPECT_LEFT(QString(QChar(0xE4)), model.data(model.index(2996, 2)).toString());
+
+    DFGTEST_EXPECT_FALSE(model.openFile("testfiles/generated/csvLazyReadOnlyItemModel_nonExisting.csv"));
+    DFGTEST_EXPECT_LEFT(0, model.rowCount());
+    DFGTEST_EXPECT_TRUE(model.getFilePath().isEmpty());
+}
+
 TEST(dfgQt, CsvItemModel_filteredRead)
 {
     using namespace DFG_MODULE_NS(qt);
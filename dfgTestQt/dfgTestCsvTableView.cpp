@@ -485,6 +485,76 @@ TEST(dfgQt, CsvTableView_replace)
     EXPECT_STREQ("d", csvModel.rawStringPtrAt(1, 1).c_str());
 }
 
+TEST(dfgQt, CsvTableView_findHitList)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    CsvItemModel csvModel;
+    CsvTableView view(nullptr, nullptr);
+    QSortFilterProxyModel viewModel;
+    viewModel.setSourceModel(&csvModel);
+    view.setModel(&viewModel);
+
+    // Table big enough to get searched in multiple blocks and threads.
+    const int nRowCount = 20000;
+    DFGTEST_ASSERT_TRUE(csvModel.setSize(nRowCount, 2));
+    std::vector<std::pair<int, int>> expectedHits;
+    for (int r = 0; r < nRowCount; r += 500)
+    {
+        const bool bA = (r % 1000 == 0);
+        const int c = (bA) ? (r / 1000) % 2 : 1;
+        csvModel.setDataNoUndo(r, c, (bA) ? DFG_UTF8("a") : DFG_UTF8("Ab"));
+        expectedHits.push_back(std::pair<int, int>(r, c));
+    }
+
+    using StringMatchDef = CsvTableView::StringMatchDef;
+    view.setFindText(StringMatchDef("a", Qt::CaseInsensitive, PatternMatcher::Wildcard), -1);
+    DFGTEST_EXPECT_LEFT(expectedHits.size(), view.countFindMatches().value_or(0));
+
+    // Find next should go through hits in row-major order and wrap around; without current cell, search starts from the first cell.
+    view.setCurrentIndex(QModelIndex());
+    for (size_t i = 0; i <= expectedHits.size(); ++i)
+    {
+        view.onFindNext();
+        const auto& expected = expectedHits[i % expectedHits.size()];
+        DFGTEST_EXPECT_LEFT(expected.first, view.m_latestFoundIndex.row());
+        DFGTEST_EXPECT_LEFT(expected.second, view.m_latestFoundIndex.column());
+    }
+    view.onFindPrevious();
+    DFGTEST_EXPECT_LEFT(expectedHits.back().first, view.m_latestFoundIndex.row());
+    view.onFindPrevious();
+    DFGTEST_EXPECT_LEFT(expectedHits[expectedHits.size() - 2].first, view.m_latestFoundIndex.row());
+
+    // Column restricted find
+    view.setFindText(StringMatchDef("a", Qt::CaseInsensitive, PatternMatcher::Wildcard), 1);
+    DFGTEST_EXPECT_LEFT(30u, view.countFindMatches().value_or(0));
+    view.onFindNext();
+    DFGTEST_EXPECT_LEFT(19500, view.m_latestFoundIndex.row()); // Search continues from current cell.
+
+    // Narrowing find definitions
+    view.setFindText(StringMatchDef("ab", Qt::CaseInsensitive, PatternMatcher::Wildcard), -1);
+    DFGTEST_EXPECT_LEFT(20u, view.countFindMatches().value_or(0));
+    view.setFindText(StringMatchDef("ab", Qt::CaseSensitive, PatternMatcher::Wildcard), -1);
+    DFGTEST_EXPECT_LEFT(0u, view.countFindMatches().value_or(1));
+
+    // Content change should invalidate hits.
+    view.setFindText(StringMatchDef("a", Qt::CaseInsensitive, PatternMatcher::Wildcard), -1);
+    DFGTEST_EXPECT_LEFT(40u, view.countFindMatches().value_or(0));
+    csvModel.setDataNoUndo(1, 1, DFG_UTF8("a"));
+    DFGTEST_EXPECT_LEFT(41u, view.countFindMatches().value_or(0));
+
+    // Replace in whole table and undo
+    DFGTEST_EXPECT_LEFT(20u, view.replace(QVariantMap({{"find", "A"}, {"replace", "x"}, {"scope", "all"}})));
+    EXPECT_STREQ("xb", csvModel.rawStringPtrAt(500, 1).c_str());
+    EXPECT_STREQ("a", csvModel.rawStringPtrAt(1000, 1).c_str());
+    view.setFindText(StringMatchDef("xb", Qt::CaseSensitive, PatternMatcher::Wildcard), -1);
+    DFGTEST_EXPECT_LEFT(20u, view.countFindMatches().value_or(0));
+    view.undo();
+    DFGTEST_EXPECT_LEFT(0u, view.countFindMatches().value_or(1));
+    EXPECT_STREQ("Ab", csvModel.rawStringPtrAt(500, 1).c_str());
+    view.redo();
+    DFGTEST_EXPECT_LEFT(20u, view.countFindMatches().value_or(0));
+}
+
 TEST(dfgQt, CsvTableView_evaluateSelectionAsFormula)
 {
     using namespace ::DFG_MODULE_NS(qt);
@@ -1477,6 +1547,31 @@ TEST(dfgQt, CsvTableView_sorting)
         tableWidget.sortByColumn(1, Qt::AscendingOrder);
         DFGTEST_EXPECT_LEFT(",\n3,3|1|2020\n1,1|1|2021\n4,4|1|2022\n2,2|1|2023\n", saveToString(tableWidget));
     }
+
+    // Multi-column sorting
+    {
+        CsvTableWidget tableWidget;
+        DFGTEST_EXPECT_TRUE(tableWidget.getCsvModel().openString(
+            "a,b\n"
+            "x,2\n"
+            "y,1\n"
+            "x,1\n"
+            "y,3\n"
+            ",2\n"
+        ));
+        tableWidget.setColumnType(ColumnIndex_data(1), CsvItemModelColumnType::number);
+        auto pProxy = qobject_cast<CsvTableViewSortFilterProxyModel*>(tableWidget.getProxyModelPtr());
+        DFGTEST_ASSERT_TRUE(pProxy != nullptr);
+        pProxy->sortByColumns({ {0, Qt::AscendingOrder}, {1, Qt::DescendingOrder} });
+        DFGTEST_EXPECT_LEFT("a,b\nx,2\nx,1\ny,3\ny,1\n,2\n", saveToString(tableWidget));
+        pProxy->sortByColumns({ {0, Qt::DescendingOrder}, {1, Qt::AscendingOrder} });
+        DFGTEST_EXPECT_LEFT("a,b\n,2\ny,1\ny,3\nx,1\nx,2\n", saveToString(tableWidget));
+        pProxy->sortByColumns({ {1, Qt::AscendingOrder}, {0, Qt::DescendingOrder} });
+        DFGTEST_EXPECT_LEFT("a,b\ny,1\nx,1\n,2\nx,2\ny,3\n", saveToString(tableWidget));
+        // Plain sort() after multi-column sort uses only the given column: numerically equal values are ordered by row index.
+        pProxy->sort(1, Qt::DescendingOrder);
+        DFGTEST_EXPECT_LEFT("a,b\ny,3\n,2\nx,2\nx,1\ny,1\n", saveToString(tableWidget));
+    }
 }
 
 TEST(dfgQt, CsvTableView_populateCsvConfig)
@@ -1951,6 +2046,23 @@ TEST(dfgQt, CsvTableView_filterFromSelection)
 #undef DFGTEST_TEMP_TEST_ROW
 }
 
+TEST(dfgQt, CsvTableView_rowFilterWithDataChanges)
+{
+    using namespace ::DFG_MODULE_NS(qt);
+    CsvTableWidget viewWidget;
+    DFGTEST_EXPECT_TRUE(viewWidget.getCsvModel().openString("a\nx1\ny2\nx3\ny4\n"));
+    auto& rProxy = viewWidget.getViewModel();
+    DFGTEST_EXPECT_TRUE(rProxy.setFilterFromNewLineSeparatedJsonList(R"({ "text": "x" })"));
+    DFGTEST_EXPECT_LEFT(2, rProxy.rowCount());
+    // Editing cell so that it matches the filter: precomputed filter result must not prevent edited row from getting accepted.
+    viewWidget.getCsvModel().setDataNoUndo(1, 0, DFG_UTF8("x2"));
+    DFGTEST_EXPECT_LEFT(3, rProxy.rowCount());
+    DFGTEST_EXPECT_TRUE(rProxy.setFilterFromNewLineSeparatedJsonList(R"({ "text": "y" })"));
+    DFGTEST_EXPECT_LEFT(1, rProxy.rowCount());
+    DFGTEST_EXPECT_TRUE(rProxy.setFilterFromNewLineSeparatedJsonList(QByteArray()));
+    DFGTEST_EXPECT_LEFT(4, rProxy.rowCount());
+}
+
 TEST(dfgQt, CsvTableView_sortSettingsFromConfFile)
 {
     using namespace ::DFG_MODULE_NS(qt);
@@ -251,6 +251,7 @@ a,7
     pDetailPanel->addDetail({ {"id", "test_product" }, {"type", "accumulator"}, {"formula", "acc * value"}, {"initial_value", "1"} } );
     pDetailPanel->addDetail({ {"id", "percentile_33" }, {"type", "percentile"}, {"percentage", "33"} } );
     pDetailPanel->addDetail({ {"id", "percentile_34" }, {"type", "percentile"}, {"percentage", "34"} } );
+    pDetailPanel->addDetail({ {"id", "percentile_approx_34" }, {"type", "percentile_approx"}, {"percentage", "34"}, {"compression", "50"} } );
     pDetailPanel->setEnableStatusForAll(true);
 
     QString sResult;
@@ -269,8 +270,53 @@ a,7
     DFGTEST_ASSERT_TRUE(!sResult.isEmpty());
 
     // Note: numeric precision in results is subject to change.
-    const char szExpectedRegExp[] = R"(Included: 3, Excluded: 1, Sum: 12, Avg: 4, Median: 2, Min: 1, Max: 9, Variance: 12\.666666666666668, StdDev \(pop\): 3\.559026084010437.*, StdDev \(smp\): 4\.358898943540674, Is sorted \(num\): no \(asc for 2 first\), test_product: 18, percentile_33: 1, percentile_34: 2)";
+    const char szExpectedRegExp[] = R"(Included: 3, Excluded: 1, Sum: 12, Avg: 4, Median: 2, Min: 1, Max: 9, Variance: 12\.666666666666666, StdDev \(pop\): 3\.559026084010437.*, StdDev \(smp\): 4\.358898943540674, Is sorted \(num\): no \(asc for 2 first\), test_product: 18, percentile_33: 1, percentile_34: 2, percentile_approx_34: 2)";
     DFGTEST_EXPECT_LEFT(0, sResult.indexOf(QRegularExpression(szExpectedRegExp)));
+
+    // With default details all results are computable from column numeric summaries of the model.
+    pDetailPanel->setEnableStatusForAll(false);
+    pDetailPanel->setDefaultDetails();
+    sResult.clear();
+    pView->selectColumn(1);
+    for (int i = 0; i < 10 && (sResult.isEmpty() || !sResult.startsWith("Included")); ++i)
+    {
+        QCoreApplication::processEvents();
+        QThread::msleep(10);
+    }
+    DFGTEST_EXPECT_LEFT("Included: 4, Excluded: 0, Sum: 26, Avg: 6.5, Min: 5, Max: 8", sResult);
+
+    // Testing that large selection gives the same result when evaluated concurrently in chunks.
+    {
+        QString sContent = "a,b\r\n";
+        for (int i = 0; i < 100000; ++i)
+            sContent += QString("%1,%2\r\n").arg((i % 3 == 0) ? QString("x") : QString::number(i % 1000)).arg(i);
+        tableEditor.m_spTableModel->openString(sContent);
+        pDetailPanel->setEnableStatusForAll(true);
+        const auto evaluateSelectionWithThreadCount = [&](const int nThreadCount)
+        {
+            pDetailPanel->setThreadCountMaximum(nThreadCount);
+            sResult.clear();
+            pView->clearSelection();
+            pView->selectAll();
+            for (int i = 0; i < 1000 && (sResult.isEmpty() || !sResult.startsWith("Included")); ++i)
+            {
+                QCoreApplication::processEvents();
+                QThread::msleep(10);
+            }
+            return sResult;
+        };
+        // Last digits of variance details and approximate percentile may differ between sequential and merged evaluation so removing them from comparison.
+        const auto withoutInexactDetails = [](const QString& s) { return QString(s).remove(QRegularExpression(R"(, (Variance|StdDev \((pop|smp)\)|percentile_approx_34): [^,]*)")); };
+        const auto approxPercentile = [](const QString& s) { return QRegularExpression(R"(percentile_approx_34: ([^,]*))").match(s).captured(1).toDouble(); };
+        const auto sSequential = evaluateSelectionWithThreadCount(1);
+        const auto sConcurrent = evaluateSelectionWithThreadCount(4);
+        DFGTEST_EXPECT_TRUE(sSequential.startsWith("Included: 166666, Excluded: 33334"));
+        DFGTEST_EXPECT_LEFT(withoutInexactDetails(sSequential), withoutInexactDetails(sConcurrent));
+        // Concurrent evaluation merges per-chunk t-digests so result should be close to the sequential one: 34th percentile falls among values of range [0, 999] having about 68 values per unit.
+        DFGTEST_EXPECT_TRUE(sConcurrent.contains("percentile_approx_34: "));
+        DFGTEST_EXPECT_LE(std::abs(approxPercentile(sSequential) - approxPercentile(sConcurrent)), 100);
+        pDetailPanel->setThreadCountMaximum(0);
+    }
 }
 
 TEST(dfgQt, TableEditor_filterPanelSettingsFromConfFile)
@@ -455,6 +501,35 @@ TEST(dfgQt, StringMatchDefinition)
         DFGTEST_EXPECT_TRUE( StringMatchDefinition("abc", Qt::CaseInsensitive, PatternMatcher::FixedString, false).isMatchWith(QString("abc")));
         DFGTEST_EXPECT_FALSE(StringMatchDefinition("abc", Qt::CaseInsensitive, PatternMatcher::FixedString, true).isMatchWith(QString("abc")));
     }
+
+    // isKnownToBeNarrowingOf()
+    {
+        using Smd = StringMatchDefinition;
+        DFGTEST_EXPECT_TRUE( Smd("abc", Qt::CaseInsensitive, PatternMatcher::Wildcard).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseInsensitive, PatternMatcher::Wildcard)));
+        DFGTEST_EXPECT_TRUE( Smd("xAbc", Qt::CaseSensitive, PatternMatcher::FixedString).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseInsensitive, PatternMatcher::Wildcard)));
+        DFGTEST_EXPECT_FALSE(Smd("ab", Qt::CaseInsensitive, PatternMatcher::Wildcard).isKnownToBeNarrowingOf(Smd("abc", Qt::CaseInsensitive, PatternMatcher::Wildcard)));
+        DFGTEST_EXPECT_FALSE(Smd("xAbc", Qt::CaseSensitive, PatternMatcher::FixedString).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseSensitive, PatternMatcher::FixedString)));
+        DFGTEST_EXPECT_FALSE(Smd("abc", Qt::CaseInsensitive, PatternMatcher::Wildcard).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseSensitive, PatternMatcher::Wildcard)));
+        DFGTEST_EXPECT_FALSE(Smd("abc", Qt::CaseInsensitive, PatternMatcher::Wildcard, true).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseInsensitive, PatternMatcher::Wildcard, true)));
+        DFGTEST_EXPECT_FALSE(Smd("a*c", Qt::CaseInsensitive, PatternMatcher::Wildcard).isKnownToBeNarrowingOf(Smd("a", Qt::CaseInsensitive, PatternMatcher::Wildcard)));
+        DFGTEST_EXPECT_FALSE(Smd("abc", Qt::CaseInsensitive, PatternMatcher::RegExp).isKnownToBeNarrowingOf(Smd("ab", Qt::CaseInsensitive, PatternMatcher::RegExp)));
+        // Identical definitions are always narrowing of each other.
+        DFGTEST_EXPECT_TRUE( Smd("a|b", Qt::CaseInsensitive, PatternMatcher::RegExp, true).isKnownToBeNarrowingOf(Smd("a|b", Qt::CaseInsensitive, PatternMatcher::RegExp, true)));
+
+        // MultiMatchDefinition: adding characters to text or adding AND-term is narrowing, adding OR-term is not.
+        using Mmd = MultiMatchDefinition<CsvItemModelStringMatcher>;
+        const auto mmdA = Mmd::fromJson(DFG_UTF8(R"({"text": "a"})"));
+        const auto mmdAb = Mmd::fromJson(DFG_UTF8(R"({"text": "ab"})"));
+        const auto mmdAnd = Mmd::fromJson(DFG_UTF8("{\"text\": \"a\"}\n{\"text\": \"c\"}"));
+        const auto mmdOr = Mmd::fromJson(DFG_UTF8("{\"text\": \"a\"}\n{\"text\": \"c\", \"and_group\": \"b\"}"));
+        DFGTEST_EXPECT_TRUE( mmdAb.isKnownToBeNarrowingOf(mmdA));
+        DFGTEST_EXPECT_FALSE(mmdA.isKnownToBeNarrowingOf(mmdAb));
+        DFGTEST_EXPECT_TRUE( mmdAnd.isKnownToBeNarrowingOf(mmdA));
+        DFGTEST_EXPECT_FALSE(mmdOr.isKnownToBeNarrowingOf(mmdA));
+        DFGTEST_EXPECT_TRUE( mmdA.isKnownToBeNarrowingOf(mmdOr));
+        // Different apply_columns is not known to be narrowing.
+        DFGTEST_EXPECT_FALSE(Mmd::fromJson(DFG_UTF8(R"({"text": "ab", "apply_columns": "1"})")).isKnownToBeNarrowingOf(mmdA));
+    }
 }
 
 namespace
@@ -981,3 +1056,47 @@ TEST(dfgQt, DataQueryDetails_maskHandling)
         DFGTEST_EXPECT_FALSE(DataQueryDetails(DataQueryDetails::DataMaskNumerics | DataQueryDetails::DataMaskStrings).areOnlyRowsOrNumbersRequested());
     }
 }
+
+TEST(dfgQt, DataSourceChangedParam)
+{
+    using namespace DFG_MODULE_NS(qt);
+    using IndexPair = std::pair<DataSourceIndex, DataSourceIndex>;
+
+    // Default param means unspecified change
+    {
+        const auto param = DataSourceChangedParam::fromSignalParam(DataSourceChangedParam().toSignalParam());
+        DFGTEST_EXPECT_FALSE(param.getInvalidatedColumnRange().has_value());
+        DFGTEST_EXPECT_FALSE(param.getInvalidatedRowRange().has_value());
+        DFGTEST_EXPECT_FALSE(DataSourceChangedParam::fromSignalParam("a,b").getInvalidatedColumnRange().has_value());
+        DFGTEST_EXPECT_FALSE(DataSourceChangedParam::fromSignalParam("1,2,3").getInvalidatedColumnRange().has_value());
+    }
+
+    // Column range only
+    {
+        const auto param = DataSourceChangedParam::fromSignalParam(DataSourceChangedParam::fromInvalidColumnRange(2, 3).toSignalParam());
+        DFGTEST_EXPECT_LEFT(IndexPair(2, 3), param.getInvalidatedColumnRange().value());
+        DFGTEST_EXPECT_FALSE(param.getInvalidatedRowRange().has_value());
+    }
+
+    // Column and row range
+    {
+        const auto param = DataSourceChangedParam::fromSignalParam(DataSourceChangedParam::fromInvalidCellRange(2, 3, 10, 20).toSignalParam());
+        DFGTEST_EXPECT_LEFT(IndexPair(2, 3), param.getInvalidatedColumnRange().value());
+        DFGTEST_EXPECT_LEFT(IndexPair(10, 20), param.getInvalidatedRowRange().value());
+    }
+
+    // unite()
+    {
+        auto param = DataSourceChangedParam::fromInvalidCellRange(2, 3, 10, 20);
+        param.unite(DataSourceChangedParam::fromInvalidCellRange(5, 5, 1, 2));
+        DFGTEST_EXPECT_LEFT(IndexPair(2, 5), param.getInvalidatedColumnRange().value());
+        DFGTEST_EXPECT_LEFT(IndexPair(1, 20), param.getInvalidatedRowRange().value());
+
+        param.unite(DataSourceChangedParam::fromInvalidColumnRange(0, 1));
+        DFGTEST_EXPECT_LEFT(IndexPair(0, 5), param.getInvalidatedColumnRange().value());
+        DFGTEST_EXPECT_FALSE(param.getInvalidatedRowRange().has_value());
+
+        param.unite(DataSourceChangedParam());
+        DFGTEST_EXPECT_FALSE(param.getInvalidatedColumnRange().has_value());
+    }
+}